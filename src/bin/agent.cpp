@@ -29,16 +29,21 @@
 
 #include <boost/program_options.hpp>
 
+#include <logging/legacy/event.hpp>
+#include <metrics/exporters.hpp>
 #include <sdpa/daemon/Agent.hpp>
 #include <we/layer.hpp>
+#include <we/snapshot.hpp>
 #include <boost/filesystem/path.hpp>
 #include <fhg/util/boost/program_options/validators/existing_path.hpp>
 #include <fhg/util/boost/program_options/validators/nonempty_string.hpp>
+#include <fhg/util/boost/program_options/validators/positive_integral.hpp>
 #include <fhg/util/signal_handler_manager.hpp>
 #include <fhg/util/thread/event.hpp>
 
 #include <boost/tokenizer.hpp>
 
+#include <chrono>
 #include <functional>
 
 namespace bfs = boost::filesystem;
@@ -50,6 +55,23 @@ namespace
   {
     constexpr const char* vmem_socket {"vmem-socket"};
     constexpr const char* ssl_certificates {"ssl-certificates"};
+    constexpr const char* runtime_statistics_snapshot
+      {"runtime-statistics-snapshot"};
+    constexpr const char* schedule_by_runtime_statistics
+      {"schedule-by-runtime-statistics"};
+    constexpr const char* prefer_workers_caching_global_memory
+      {"prefer-workers-caching-global-memory"};
+    constexpr const char* speculative_backup_runtime_multiple
+      {"speculative-backup-runtime-multiple"};
+    constexpr const char* workflow_snapshot_directory
+      {"workflow-snapshot-directory"};
+    constexpr const char* workflow_snapshot_interval
+      {"workflow-snapshot-interval"};
+    constexpr const char* network_threads {"network-threads"};
+    constexpr const char* network_batching_window
+      {"network-batching-window"};
+    constexpr const char* network_batching_max_bytes
+      {"network-batching-max-bytes"};
   }
 }
 
@@ -66,6 +88,7 @@ int main (int argc, char **argv)
     std::vector<std::string> arrMasterNames;
     boost::optional<bfs::path> vmem_socket;
     fhg::com::Certificates ssl_certificates;
+    boost::optional<bfs::path> runtime_statistics_snapshot;
 
     po::options_description desc("Allowed options");
     desc.add_options()
@@ -80,13 +103,62 @@ int main (int argc, char **argv)
       , po::value<bfs::path>()
       , "folder containing SSL certificates"
       )
+      ( option_name::runtime_statistics_snapshot
+      , po::value<bfs::path>()
+      , "file to load observed job runtimes from at startup and to save them"
+        " to every 100 finished jobs and at shutdown"
+      )
+      ( option_name::schedule_by_runtime_statistics
+      , po::bool_switch()
+      , "use the observed job runtime in seconds as computational cost when"
+        " scheduling, once a transition finished at least 5 times"
+      )
+      ( option_name::prefer_workers_caching_global_memory
+      , po::bool_switch()
+      , "discount the transfer cost on workers that recently read the same"
+        " global memory ranges, to be used with worker side caching"
+      )
+      ( option_name::speculative_backup_runtime_multiple
+      , po::value<double>()
+      , "launch a backup copy of a job of a side effect free transition on"
+        " an idle worker once it runs longer than this multiple of the 90th"
+        " percentile of the observed runtimes (disabled if not given)"
+      )
+      ( option_name::workflow_snapshot_directory
+      , po::value<bfs::path>()
+      , "directory to periodically write snapshots of the running workflows"
+        " to and to resume them from at startup (disabled if not given)"
+      )
+      ( option_name::workflow_snapshot_interval
+      , po::value<validators::positive_integral<std::size_t>>()
+          ->default_value (60)
+      , "seconds between writing the snapshots of changed workflows"
+      )
+      ( option_name::network_threads
+      , po::value<validators::positive_integral<std::size_t>>()->default_value (1)
+      , "number of threads handling connections to masters and workers"
+      )
+      ( option_name::network_batching_window
+      , po::value<validators::positive_integral<std::size_t>>()
+      , "send events to the same destination within this many microseconds"
+        " as one message (disabled if not given)"
+      )
+      ( option_name::network_batching_max_bytes
+      , po::value<validators::positive_integral<std::size_t>>()
+          ->default_value (std::size_t (64) << 10)
+      , "send a batch of events early once it exceeds this size"
+      )
       ;
+    desc.add (fhg::metrics::options::exporters());
 
     po::variables_map vm;
     po::store( po::command_line_parser( argc, argv ).options(desc).run(), vm );
 
     po::notify (vm);
 
+    fhg::metrics::exporters const metrics_exporters
+      (fhg::metrics::process_registry(), vm);
+
     if (vm.count (option_name::vmem_socket))
     {
       vmem_socket = bfs::path (vm.at (option_name::vmem_socket).as<validators::nonempty_string>());
@@ -97,6 +169,44 @@ int main (int argc, char **argv)
       ssl_certificates = vm.at (option_name::ssl_certificates).as<bfs::path>();
     }
 
+    if (vm.count (option_name::runtime_statistics_snapshot))
+    {
+      runtime_statistics_snapshot
+        = vm.at (option_name::runtime_statistics_snapshot).as<bfs::path>();
+    }
+
+    boost::optional<double> speculative_backup_runtime_multiple;
+    if (vm.count (option_name::speculative_backup_runtime_multiple))
+    {
+      speculative_backup_runtime_multiple
+        = vm.at (option_name::speculative_backup_runtime_multiple).as<double>();
+    }
+
+    boost::optional<we::snapshot_settings> workflow_snapshots;
+    if (vm.count (option_name::workflow_snapshot_directory))
+    {
+      workflow_snapshots = we::snapshot_settings
+        { vm.at (option_name::workflow_snapshot_directory).as<bfs::path>()
+        , std::chrono::seconds
+            ( vm.at (option_name::workflow_snapshot_interval)
+                .as<validators::positive_integral<std::size_t>>()
+            )
+        };
+    }
+
+    boost::optional<sdpa::com::batching> network_batching;
+    if (vm.count (option_name::network_batching_window))
+    {
+      network_batching = sdpa::com::batching
+        { std::chrono::microseconds
+            ( vm.at (option_name::network_batching_window)
+                .as<validators::positive_integral<std::size_t>>()
+            )
+        , vm.at (option_name::network_batching_max_bytes)
+            .as<validators::positive_integral<std::size_t>>()
+        };
+    }
+
     sdpa::master_info_t masters;
     for (auto const& host_port : arrMasterNames)
     {
@@ -122,6 +232,14 @@ int main (int argc, char **argv)
       , std::move (masters)
       , true
       , ssl_certificates
+      , runtime_statistics_snapshot
+      , vm.at (option_name::schedule_by_runtime_statistics).as<bool>()
+      , vm.at (option_name::network_threads)
+          .as<validators::positive_integral<std::size_t>>()
+      , network_batching
+      , vm.at (option_name::prefer_workers_caching_global_memory).as<bool>()
+      , speculative_backup_runtime_multiple
+      , workflow_snapshots
       );
 
     fhg::util::thread::event<> stop_requested;
@@ -132,6 +250,12 @@ int main (int argc, char **argv)
     fhg::util::scoped_log_backtrace_and_exit_for_critical_errors const
       crit_error_handler (signal_handlers, agent.log_emitter());
 
+    for (auto const& endpoint : metrics_exporters.endpoints())
+    {
+      agent.log_emitter().emit
+        (endpoint, fhg::logging::legacy::category_level_info);
+    }
+
     fhg::util::scoped_signal_handler const SIGTERM_handler
       (signal_handlers, SIGTERM, std::bind (request_stop));
     fhg::util::scoped_signal_handler const SIGINT_handler
@@ -36,6 +36,10 @@
 #include <gpi-space/gpi/gaspi.hpp>
 #include <gpi-space/pc/container/manager.hpp>
 
+#include <logging/legacy/event.hpp>
+
+#include <metrics/exporters.hpp>
+
 #include <rif/started_process_promise.hpp>
 
 #include <vmem/gaspi_context.hpp>
@@ -59,6 +63,7 @@ namespace
     constexpr const char* const port ("port");
     constexpr const char* const socket ("socket");
     constexpr const char* const netdev ("netdev");
+    constexpr const char* const broadcast_fan_out ("broadcast-fan-out");
   }
 }
 
@@ -93,7 +98,14 @@ int main (int argc, char** argv)
       , boost::program_options::value<fhg::vmem::netdev_id>()->required()
       , "the network device to use"
       )
+      ( option::broadcast_fan_out
+      , boost::program_options::value
+          <fhg::util::boost::program_options::positive_integral<std::size_t>>()
+          ->default_value (4)
+      , "number of ranks each rank forwards global allocations to"
+      )
       ;
+    options_description.add (fhg::metrics::options::exporters());
 
     boost::program_options::variables_map vm;
     boost::program_options::store
@@ -105,6 +117,9 @@ int main (int argc, char** argv)
 
     boost::program_options::notify (vm);
 
+    fhg::metrics::exporters const metrics_exporters
+      (fhg::metrics::process_registry(), vm);
+
     boost::filesystem::path const socket_path
       ( vm.at (option::socket)
         .as<fhg::util::boost::program_options::nonexisting_path_in_existing_directory>()
@@ -126,6 +141,11 @@ int main (int argc, char** argv)
     fhg::util::scoped_log_backtrace_and_exit_for_critical_errors const
       crit_error_handler (signal_handler, log_emitter);
 
+    for (auto const& endpoint : metrics_exporters.endpoints())
+    {
+      log_emitter.emit (endpoint, fhg::logging::legacy::category_level_info);
+    }
+
     //! \todo more than one thread, parameter
     fhg::util::scoped_boost_asio_io_service_with_threads
       topology_server_io_service (8);
@@ -148,6 +168,8 @@ int main (int argc, char** argv)
       , socket_path.string()
       , gaspi_context
       , std::move (topology_rpc_server)
+      , vm.at (option::broadcast_fan_out)
+        .as<fhg::util::boost::program_options::positive_integral<std::size_t>>()
       );
 
     fhg::util::thread::event<> stop_requested;
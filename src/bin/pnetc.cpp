@@ -28,6 +28,7 @@
 #include <we/type/activity.hpp>
 
 #include <iostream>
+#include <stdexcept>
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
@@ -220,6 +221,7 @@ int main (int argc, char** argv)
 {
   std::string input ("/dev/stdin");
   std::string output ("/dev/stdout");
+  std::string output_format ("text");
 
   namespace po = boost::program_options;
 
@@ -236,6 +238,10 @@ int main (int argc, char** argv)
     , po::value<std::string>(&output)->default_value(output)
     , "output file name, - for stdout, second positional parameter, empty for no output (syntax check + generate only)"
     )
+    ( "output-format"
+    , po::value<std::string>(&output_format)->default_value(output_format)
+    , "encoding of the output: text (portable) or binary (faster to load, not portable between architectures)"
+    )
     ;
 
   xml::parse::state::type state;
@@ -280,6 +286,13 @@ try
     return EXIT_SUCCESS;
   }
 
+  auto const encoding
+    ( output_format == "binary" ? we::type::activity_encoding::binary
+    : output_format == "text" ? we::type::activity_encoding::text
+    : throw std::invalid_argument
+        ("invalid output format '" + output_format + "'")
+    );
+
   if (input == "-")
   {
     input = "/dev/stdin";
@@ -322,8 +335,9 @@ try
 
     if (!output.empty())
     {
-      std::ofstream out (output.c_str());
-      out << we::type::activity_t (xml::parse::xml_to_we (function, state)).to_string();
+      std::ofstream out (output.c_str(), std::ios::binary);
+      we::type::activity_t (xml::parse::xml_to_we (function, state))
+        .write (out, encoding);
     }
 
   return EXIT_SUCCESS;
@@ -0,0 +1,122 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <we/type/net.hpp> // recursive wrapper of transition_t fails otherwise.
+#include <we/type/activity.hpp>
+
+#include <fhg/revision.hpp>
+#include <util-generic/print_exception.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int main (int argc, char** argv)
+try
+{
+  std::string input;
+  std::string output;
+  std::string output_format;
+
+  boost::program_options::options_description desc ("General");
+
+  desc.add_options()
+    ( "help,h", "this message")
+    ( "version,V", "print version information")
+    ( "input,i"
+    , boost::program_options::value<std::string> (&input)->default_value ("-")
+    , "compiled net in any encoding, - for stdin, first positional parameter"
+    )
+    ( "output,o"
+    , boost::program_options::value<std::string> (&output)->default_value ("-")
+    , "output file name, - for stdout, second positional parameter"
+    )
+    ( "output-format"
+    , boost::program_options::value<std::string> (&output_format)
+        ->default_value ("text")
+    , "encoding of the output: binary or text"
+    );
+
+  boost::program_options::positional_options_description p;
+  p.add ("input", 1).add ("output", 2);
+
+  boost::program_options::variables_map vm;
+  boost::program_options::store
+    ( boost::program_options::command_line_parser (argc, argv)
+    . options (desc).positional (p).run()
+    , vm
+    );
+  boost::program_options::notify (vm);
+
+  if (vm.count ("help"))
+  {
+    std::cout << argv[0] << ": convert compiled nets between encodings"
+              << std::endl;
+    std::cout << desc << std::endl;
+
+    return EXIT_SUCCESS;
+  }
+
+  if (vm.count ("version"))
+  {
+    std::cout << fhg::project_info ("pnetconv");
+
+    return EXIT_SUCCESS;
+  }
+
+  auto const encoding
+    ( output_format == "binary" ? we::type::activity_encoding::binary
+    : output_format == "text" ? we::type::activity_encoding::text
+    : throw std::invalid_argument
+        ("invalid output format '" + output_format + "'")
+    );
+
+  we::type::activity_t const activity
+    ( input == "-"
+    ? we::type::activity_t (std::cin)
+    : we::type::activity_t (boost::filesystem::path (input))
+    );
+
+  if (output == "-")
+  {
+    activity.write (std::cout, encoding);
+  }
+  else
+  {
+    std::ofstream ostream (output.c_str(), std::ios::binary);
+
+    if (!ostream)
+    {
+      throw std::runtime_error ("failed to open " + output + " for writing");
+    }
+
+    activity.write (ostream, encoding);
+  }
+
+  return EXIT_SUCCESS;
+}
+catch (...)
+{
+  std::cerr << "pnetconv: failed: " << fhg::util::current_exception_printer()
+            << '\n';
+
+  return EXIT_FAILURE;
+}
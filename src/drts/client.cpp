@@ -109,6 +109,31 @@ namespace gspc
     return _->_client.submitJob (workflow._->_activity);
   }
 
+  job_id_t client::submit
+    ( class workflow const& workflow
+    , std::multimap< std::string
+                   , pnet::type::value::value_type
+                   > const& values_on_ports
+    , int priority
+    , double weight
+    )
+  {
+    for (auto const& value_on_port : values_on_ports)
+    {
+      workflow._->_activity.add_input (value_on_port.first, value_on_port.second);
+    }
+
+    return _->_client.submitJob
+      (workflow._->_activity, sdpa::scheduling_parameters (priority, weight));
+  }
+
+  void client::set_scheduling_parameters
+    (job_id_t job_id, int priority, double weight)
+  {
+    _->_client.set_scheduling_parameters
+      (job_id, sdpa::scheduling_parameters (priority, weight));
+  }
+
   void client::put_token ( job_id_t job_id
                          , std::string place_name
                          , pnet::type::value::value_type value
@@ -117,8 +142,28 @@ namespace gspc
     _->_client.put_token (job_id, place_name, value);
   }
 
+  void client::put_tokens ( job_id_t job_id
+                          , std::string place_name
+                          , std::list<pnet::type::value::value_type> values
+                          )
+  {
+    _->_client.put_tokens (job_id, place_name, std::move (values));
+  }
+
   namespace
   {
+    //! \todo decorate the exception with the most progressed activity
+    std::runtime_error job_failed
+      (job_id_t job_id, sdpa::client::job_info_t const& job_info)
+    {
+      return std::runtime_error
+        (( boost::format ("Job %1%: failed: error-message := %2%")
+         % job_id
+         % job_info.error_message
+         ).str()
+        );
+    }
+
     void wait_for_terminal_state (job_id_t job_id, sdpa::client::Client& client)
     {
       sdpa::client::job_info_t job_info;
@@ -128,13 +173,7 @@ namespace gspc
 
       if (sdpa::status::FAILED == status)
       {
-        //! \todo decorate the exception with the most progressed activity
-        throw std::runtime_error
-          (( boost::format ("Job %1%: failed: error-message := %2%")
-           % job_id
-           % job_info.error_message
-           ).str()
-          );
+        throw job_failed (job_id, job_info);
       }
     }
 
@@ -180,4 +219,84 @@ namespace gspc
   {
     return _->_client.workflow_response (job_id, place_name, value);
   }
+
+  std::future<job_id_t> client::submit_async
+    ( class workflow const& workflow
+    , std::multimap< std::string
+                   , pnet::type::value::value_type
+                   > const& values_on_ports
+    )
+  {
+    for (auto const& value_on_port : values_on_ports)
+    {
+      workflow._->_activity.add_input (value_on_port.first, value_on_port.second);
+    }
+
+    return _->_client.submit_job_async (workflow._->_activity);
+  }
+
+  std::future<void> client::wait_async (job_id_t job_id) const
+  {
+    auto const promise (std::make_shared<std::promise<void>>());
+    std::future<void> terminated (promise->get_future());
+
+    _->_client.on_terminal_state
+      ( job_id
+      , [promise, job_id] (sdpa::client::terminal_state_t const& state)
+        {
+          if (sdpa::status::FAILED == state.status)
+          {
+            promise->set_exception
+              (std::make_exception_ptr (job_failed (job_id, state.job_info)));
+          }
+          else
+          {
+            promise->set_value();
+          }
+        }
+      , [promise] (std::exception_ptr error)
+        {
+          promise->set_exception (error);
+        }
+      );
+
+    return terminated;
+  }
+
+  std::future<void> client::cancel_async (job_id_t job_id) const
+  {
+    return _->_client.cancel_job_async (job_id);
+  }
+
+  std::future<void> client::put_token_async
+    ( job_id_t job_id
+    , std::string place_name
+    , pnet::type::value::value_type value
+    )
+  {
+    return _->_client.put_token_async (job_id, place_name, value);
+  }
+
+  std::future<void> client::put_tokens_async
+    ( job_id_t job_id
+    , std::string place_name
+    , std::list<pnet::type::value::value_type> values
+    )
+  {
+    return _->_client.put_tokens_async (job_id, place_name, std::move (values));
+  }
+
+  std::future<pnet::type::value::value_type> client::workflow_response_async
+    ( job_id_t job_id
+    , std::string place_name
+    , pnet::type::value::value_type value
+    )
+  {
+    return _->_client.workflow_response_async (job_id, place_name, value);
+  }
+
+  job_id_t client::wait_any (std::vector<job_id_t> const& job_ids) const
+  {
+    return _->_client.wait_for_any_terminal_state (job_ids);
+  }
 }
@@ -27,6 +27,8 @@
 #include <boost/noncopyable.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <future>
+#include <list>
 #include <map>
 #include <string>
 #include <vector>
@@ -62,6 +64,20 @@ namespace gspc
                      , pnet::type::value::value_type
                      > const& values_on_ports
       );
+    //! \note jobs of a higher priority are started first, jobs of
+    //! equal priority share the workers in proportion to their
+    //! weight, the default is priority 0 and weight 1
+    job_id_t submit
+      ( workflow const&
+      , std::multimap< std::string
+                     , pnet::type::value::value_type
+                     > const& values_on_ports
+      , int priority
+      , double weight
+      );
+    //! \note affects the jobs not yet started
+    void set_scheduling_parameters
+      (job_id_t, int priority, double weight);
     void wait (job_id_t) const;
     void cancel (job_id_t) const;
     std::multimap<std::string, pnet::type::value::value_type>
@@ -84,10 +100,41 @@ namespace gspc
                    , std::string place_name
                    , pnet::type::value::value_type
                    );
+    //! \note puts all values at once: one event, one update of the
+    //! net and one acknowledgement for the whole list
+    void put_tokens ( job_id_t
+                    , std::string place_name
+                    , std::list<pnet::type::value::value_type>
+                    );
 
     pnet::type::value::value_type synchronous_workflow_response
       (job_id_t, std::string place_name, pnet::type::value::value_type);
 
+    //! \note Asynchronous variants: any number of requests may be
+    //! outstanding at the same time. Failures are reported by the
+    //! returned futures.
+    std::future<job_id_t> submit_async
+      ( workflow const&
+      , std::multimap< std::string
+                     , pnet::type::value::value_type
+                     > const& values_on_ports
+      );
+    std::future<void> wait_async (job_id_t) const;
+    std::future<void> cancel_async (job_id_t) const;
+    std::future<void> put_token_async
+      (job_id_t, std::string place_name, pnet::type::value::value_type);
+    std::future<void> put_tokens_async
+      ( job_id_t
+      , std::string place_name
+      , std::list<pnet::type::value::value_type>
+      );
+    std::future<pnet::type::value::value_type> workflow_response_async
+      (job_id_t, std::string place_name, pnet::type::value::value_type);
+
+    //! \note returns the first of the given jobs to terminate, also
+    //! if it failed: wait() on it to learn whether it did
+    job_id_t wait_any (std::vector<job_id_t> const&) const;
+
     PIMPL (client);
   };
 }
@@ -178,6 +178,9 @@ namespace gspc
       , bool worker_env_copy_current
       , std::vector<boost::filesystem::path> worker_env_copy_file
       , std::vector<std::string> worker_env_set_variable
+      , std::vector<std::string> worker_preload_module
+      , boost::optional<boost::filesystem::path> worker_module_cache
+      , boost::optional<unsigned long> worker_global_memory_cache_size
       , gspc::installation_path installation_path
       , boost::optional<std::chrono::seconds> vmem_startup_timeout
       , std::vector<worker_description> worker_descriptions
@@ -198,6 +201,9 @@ namespace gspc
     , _worker_env_copy_current (worker_env_copy_current)
     , _worker_env_copy_file (std::move (worker_env_copy_file))
     , _worker_env_set_variable (std::move (worker_env_set_variable))
+    , _worker_preload_module (std::move (worker_preload_module))
+    , _worker_module_cache (std::move (worker_module_cache))
+    , _worker_global_memory_cache_size (worker_global_memory_cache_size)
     , _installation_path (installation_path)
     , _logging_rif_entry_point (logging_rif_entry_point)
     , _worker_descriptions (worker_descriptions)
@@ -310,6 +316,9 @@ namespace gspc
               , _worker_env_copy_current
               , _worker_env_copy_file
               , _worker_env_set_variable
+              , _worker_preload_module
+              , _worker_module_cache
+              , _worker_global_memory_cache_size
               , _installation_path
               , _info_output
               , FHG_UTIL_MAKE_OPTIONAL
@@ -384,6 +393,9 @@ namespace gspc
           , get_worker_env_copy_current (vm).get_value_or (false)
           , get_worker_env_copy_file (vm).get_value_or ({})
           , get_worker_env_set_variable (vm).get_value_or ({})
+          , get_worker_preload_module (vm).get_value_or ({})
+          , get_worker_module_cache (vm)
+          , get_worker_global_memory_cache_size (vm)
           , installation.gspc_home()
           , _virtual_memory_startup_timeout
           , parse_worker_descriptions (topology_description)
@@ -74,6 +74,9 @@ namespace gspc
                              , bool worker_env_copy_current
                              , std::vector<boost::filesystem::path> worker_env_copy_file
                              , std::vector<std::string> worker_env_set_variable
+                             , std::vector<std::string> worker_preload_module
+                             , boost::optional<boost::filesystem::path> worker_module_cache
+                             , boost::optional<unsigned long> worker_global_memory_cache_size
                              , installation_path
                              , boost::optional<std::chrono::seconds> vmem_startup_timeout
                              , std::vector<worker_description> worker_descriptions
@@ -116,6 +119,9 @@ namespace gspc
       bool _worker_env_copy_current;
       std::vector<boost::filesystem::path> _worker_env_copy_file;
       std::vector<std::string> _worker_env_set_variable;
+      std::vector<std::string> _worker_preload_module;
+      boost::optional<boost::filesystem::path> _worker_module_cache;
+      boost::optional<unsigned long> _worker_global_memory_cache_size;
       installation_path _installation_path;
       boost::optional<fhg::rif::entry_point> _logging_rif_entry_point;
       boost::optional<fhg::rif::protocol::start_logging_demultiplexer_result>
@@ -62,6 +62,12 @@ namespace gspc
         {OPTION_NAME_WORKER_ENV_COPY_FILE};
       constexpr char const* const worker_env_set_variable
         {"worker-env-set-variable"};
+      constexpr char const* const worker_preload_module
+        {"worker-preload-module"};
+      constexpr char const* const worker_module_cache
+        {"worker-module-cache"};
+      constexpr char const* const worker_global_memory_cache_size
+        {"worker-global-memory-cache-size"};
 
       constexpr char const* const virtual_memory_socket
         {"virtual-memory-socket"};
@@ -263,6 +269,30 @@ namespace gspc
           ", " OPTION_NAME_WORKER_ENV_COPY_CURRENT " and "
           OPTION_NAME_WORKER_ENV_COPY_FILE "."
         )
+        ( name::worker_preload_module
+        , boost::program_options::value<std::vector<std::string>>()
+            ->default_value ({}, "none")
+        , "Load the given module in every worker at startup instead of at "
+          "its first use."
+        )
+        ( name::worker_module_cache
+        , boost::program_options::value<boost::filesystem::path>()
+        , "Node-local directory (absolute path) that is filled once per node "
+          "with a content addressed copy of the preloaded modules. Workers "
+          "load the modules from there instead of from the application "
+          "search path."
+        )
+        ( name::worker_global_memory_cache_size
+        , boost::program_options::value
+            <validators::positive_integral<unsigned long>>()
+        , "Part of the shared memory of every worker with shared memory to "
+          "keep global memory ranges in across jobs. Only the gets of "
+          "transitions with the property "
+          "fhg.drts.global_memory_gets_are_read_only are cached. This is "
+          "a promise of the application that nobody writes these ranges "
+          "while the workers run: writes to the global memory are not "
+          "detected and do not invalidate the cache."
+        )
         ;
 
       return drts;
@@ -553,6 +583,9 @@ namespace gspc
   ACCESS_VECTOR
     (worker_env_copy_file, boost::filesystem::path, validators::existing_path)
   ACCESS_VECTOR (worker_env_set_variable, std::string, validators::env_kvpair)
+  ACCESS_VECTOR (worker_preload_module, std::string, std::string)
+  ACCESS_PATH (worker_module_cache, boost::filesystem::path)
+  ACCESS_POSITIVE_INTEGRAL (worker_global_memory_cache_size, unsigned long)
 
   ACCESS_STRING (log_host, validators::nonempty_string)
   ACCESS_POSITIVE_INTEGRAL (log_port, unsigned short)
@@ -70,6 +70,19 @@ namespace gspc
   //! \todo Let this be a `map<string, string>` for UX?
   ACCESS (worker_env_set_variable, std::vector<std::string>);
 
+  //! Load the given modules in every worker at startup instead of at
+  //! their first use.
+  ACCESS (worker_preload_module, std::vector<std::string>);
+  //! Node-local directory that the rifd fills with a content
+  //! addressed copy of the preloaded modules. Workers load the
+  //! modules from there instead of from the application search path.
+  ACCESS (worker_module_cache, boost::filesystem::path);
+  //! Part of the shared memory of every worker to keep global memory
+  //! ranges in across jobs. Opt-in per transition: cached ranges are
+  //! not invalidated by writes, the transitions promise that nobody
+  //! writes them.
+  ACCESS (worker_global_memory_cache_size, unsigned long);
+
   ACCESS (virtual_memory_socket, boost::filesystem::path);
   ACCESS (virtual_memory_port, unsigned short);
   ACCESS (virtual_memory_startup_timeout, unsigned long);
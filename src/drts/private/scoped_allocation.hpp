@@ -31,9 +31,11 @@ namespace gspc
         ( std::unique_ptr<gpi::pc::client::api_t> const& virtual_memory
         , std::string const& description
         , unsigned long size
+        , gpi::pc::segment::placement placement
         )
           : _virtual_memory (virtual_memory)
-          , _segment (_virtual_memory->register_segment (description, size))
+          , _segment
+              (_virtual_memory->register_segment (description, size, placement))
       {}
 
       ~scoped_segment()
@@ -56,9 +58,11 @@ namespace gspc
       ( std::unique_ptr<gpi::pc::client::api_t> const& virtual_memory
       , std::string const& description
       , unsigned long size
+      , gpi::pc::segment::placement placement = {}
       )
         : _virtual_memory (virtual_memory)
-        , _scoped_segment (scoped_segment (_virtual_memory, description, size))
+        , _scoped_segment
+            (scoped_segment (_virtual_memory, description, size, placement))
         , _handle (_virtual_memory->alloc
                     ( _scoped_segment
                     , size
@@ -201,6 +201,9 @@ namespace fhg
     , bool worker_env_copy_current
     , std::vector<boost::filesystem::path> const& worker_env_copy_file
     , std::vector<std::string> const& worker_env_set_variable
+    , std::vector<std::string> const& worker_preload_module
+    , boost::optional<boost::filesystem::path> const& worker_module_cache
+    , boost::optional<unsigned long> const& worker_global_memory_cache_size
     , gspc::installation_path const& installation_path
     , std::ostream& info_output
     , boost::optional<std::pair<fhg::rif::entry_point, pid_t>> top_level_log
@@ -238,12 +241,26 @@ namespace fhg
      arguments.emplace_back
        (build_parent_with_hostinfo (master_name, master_hostinfo));
 
+     //! \note the cache is searched first: it only holds the
+     //! preloaded modules, everything else comes from the app path
+     if (worker_module_cache)
+     {
+       arguments.emplace_back ("--library-search-path");
+       arguments.emplace_back (worker_module_cache->string());
+     }
+
      for (boost::filesystem::path const& path : app_path)
      {
        arguments.emplace_back ("--library-search-path");
        arguments.emplace_back (path.string());
      }
 
+     for (std::string const& module : worker_preload_module)
+     {
+       arguments.emplace_back ("--preload-module");
+       arguments.emplace_back (module);
+     }
+
      if (description.shm_size)
      {
        arguments.emplace_back ("--capability");
@@ -252,6 +269,22 @@ namespace fhg
        arguments.emplace_back (gpi_socket.get().string());
        arguments.emplace_back ("--shared-memory-size");
        arguments.emplace_back (std::to_string (description.shm_size));
+
+       if (!description.shm_huge_pages.empty())
+       {
+         arguments.emplace_back ("--shared-memory-huge-pages");
+         arguments.emplace_back (description.shm_huge_pages);
+       }
+       if (description.shm_numa_local)
+       {
+         arguments.emplace_back ("--shared-memory-numa-local");
+       }
+       if (worker_global_memory_cache_size)
+       {
+         arguments.emplace_back ("--global-memory-cache-size");
+         arguments.emplace_back
+           (std::to_string (*worker_global_memory_cache_size));
+       }
      }
 
      for (std::string const& capability : description.capabilities)
@@ -303,6 +336,30 @@ namespace fhg
                             >
                  > futures;
 
+      //! \note filled once per node, for all nodes in parallel,
+      //! before any worker on that node is started
+      std::unordered_map<fhg::rif::entry_point, std::future<void>>
+        module_cache_filled;
+
+      if (worker_module_cache)
+      {
+        std::size_t nodes (0);
+
+        for (auto& connection : rif_connections)
+        {
+          if (description.max_nodes != 0 && nodes++ >= description.max_nodes)
+          {
+            break;
+          }
+
+          module_cache_filled.emplace
+            ( connection.second
+            , connection.first.fill_module_cache
+                (*worker_module_cache, app_path, worker_preload_module)
+            );
+        }
+      }
+
       for (auto& connection : rif_connections)
       {
         //! \todo does this work correctly for multi-segments?!
@@ -313,6 +370,21 @@ namespace fhg
           break;
         }
 
+        if (worker_module_cache)
+        {
+          try
+          {
+            module_cache_filled.at (connection.second).get();
+          }
+          catch (...)
+          {
+            exceptions[connection.second].emplace_back
+              (std::current_exception());
+
+            continue;
+          }
+        }
+
         for ( unsigned long identity (0)
             ; identity < description.num_per_node
             ; ++identity
@@ -478,7 +550,11 @@ namespace fhg
       (std::size_t def_num_proc, std::string const& cap_spec)
     {
       static std::regex const cap_spec_regex
-        ("^([^#:]+)(#([0-9]+))?(:([0-9]+)(x([0-9]+))?(,([0-9]+))?(/([0-9]+))?)?$");
+        ( "^([^#:]+)(#([0-9]+))?"
+          "(:([0-9]+)(x([0-9]+))?"
+          "(,([0-9]+)(\\+(transparent|preallocated)_huge_pages)?(\\+numa_local)?)?"
+          "(/([0-9]+))?)?$"
+        );
       enum class cap_spec_regex_part
       {
         capabilities = 1,
@@ -486,7 +562,9 @@ namespace fhg
         num_per_node = 5,
         max_nodes = 7,
         shm = 9,
-        base_port = 11
+        shm_huge_pages = 11,
+        shm_numa_local = 12,
+        base_port = 14
       };
 
       std::smatch cap_spec_match;
@@ -515,6 +593,10 @@ namespace fhg
           .get_value_or (0)
         , get_match<std::size_t> (cap_spec_match, cap_spec_regex_part::socket)
         , get_match<unsigned short> (cap_spec_match, cap_spec_regex_part::base_port)
+        , get_match<std::string> (cap_spec_match, cap_spec_regex_part::shm_huge_pages)
+          .get_value_or ("none")
+        , !!get_match<std::string>
+            (cap_spec_match, cap_spec_regex_part::shm_numa_local)
         };
     }
 
@@ -104,6 +104,9 @@ namespace fhg
       , bool worker_env_copy_current
       , std::vector<boost::filesystem::path> const& worker_env_copy_file
       , std::vector<std::string> const& worker_env_set_variable
+      , std::vector<std::string> const& worker_preload_module
+      , boost::optional<boost::filesystem::path> const& worker_module_cache
+      , boost::optional<unsigned long> const& worker_global_memory_cache_size
       , gspc::installation_path const&
       , std::ostream& info_output
       , boost::optional<std::pair<fhg::rif::entry_point, pid_t>> top_level_log
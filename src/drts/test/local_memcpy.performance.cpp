@@ -0,0 +1,132 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include <drts/drts.hpp>
+#include <drts/private/option.hpp>
+#include <drts/private/scoped_allocation.hpp>
+#include <drts/scoped_rifd.hpp>
+#include <drts/virtual_memory.hpp>
+
+#include <gpi-space/pc/client/api.hpp>
+
+#include <logging/stream_emitter.hpp>
+
+#include <test/parse_command_line.hpp>
+#include <test/scoped_nodefile_from_environment.hpp>
+#include <test/shared_directory.hpp>
+#include <test/virtual_memory_socket_name_for_localhost.hpp>
+
+#include <util-generic/cxx14/make_unique.hpp>
+#include <util-generic/temporary_path.hpp>
+#include <util-generic/testing/measure_average_time.hpp>
+#include <util-generic/testing/printer/chrono.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+BOOST_AUTO_TEST_CASE
+  (local_shm_copies_are_at_most_20_us_slower_than_plain_memcpy)
+{
+  boost::program_options::options_description options_description;
+
+  options_description.add (test::options::shared_directory());
+  options_description.add (gspc::options::installation());
+  options_description.add (gspc::options::drts());
+  options_description.add (gspc::options::scoped_rifd());
+  options_description.add (gspc::options::virtual_memory());
+
+  boost::program_options::variables_map vm
+    ( test::parse_command_line
+        ( boost::unit_test::framework::master_test_suite().argc
+        , boost::unit_test::framework::master_test_suite().argv
+        , options_description
+        )
+    );
+
+  fhg::util::temporary_path const shared_directory
+    (test::shared_directory (vm) / "local_memcpy");
+
+  test::scoped_nodefile_from_environment const nodefile_from_environment
+    (shared_directory, vm);
+
+  test::set_virtual_memory_socket_name_for_localhost (vm);
+
+  vm.notify();
+
+  gspc::installation const installation (vm);
+
+  gspc::scoped_rifds const rifds ( gspc::rifd::strategy {vm}
+                                 , gspc::rifd::hostnames {vm}
+                                 , gspc::rifd::port {vm}
+                                 , installation
+                                 );
+
+  gspc::scoped_runtime_system const drts
+    (vm, installation, "worker:1", rifds.entry_points());
+
+  fhg::logging::stream_emitter logger;
+  std::unique_ptr<gpi::pc::client::api_t> const virtual_memory
+    ( fhg::util::cxx14::make_unique<gpi::pc::client::api_t>
+        (logger, gspc::require_virtual_memory_socket (vm).string())
+    );
+
+  for (unsigned long size (4 << 10); size <= (4 << 20); size <<= 1)
+  {
+    gspc::scoped_allocation const source
+      (virtual_memory, "local_memcpy_source", size);
+    gspc::scoped_allocation const destination
+      (virtual_memory, "local_memcpy_destination", size);
+
+    char* const source_ptr
+      (static_cast<char*> (virtual_memory->ptr (source)));
+    char* const destination_ptr
+      (static_cast<char*> (virtual_memory->ptr (destination)));
+
+    std::memset (source_ptr, 0x2a, size);
+
+    std::size_t const repetitions (std::max (10UL, (64UL << 20) / size));
+
+    auto const plain
+      ( fhg::util::testing::measure_average_time<std::chrono::microseconds>
+          ( [&] { std::memcpy (destination_ptr, source_ptr, size); }
+          , repetitions
+          )
+      );
+    auto const local
+      ( fhg::util::testing::measure_average_time<std::chrono::microseconds>
+          ( [&]
+            {
+              virtual_memory->memcpy_and_wait
+                ({destination, 0}, {source, 0}, size);
+            }
+          , repetitions
+          )
+      );
+
+    BOOST_TEST_MESSAGE ( size << " bytes: memcpy " << plain.count()
+                       << " us, memcpy_and_wait " << local.count() << " us"
+                       );
+
+    BOOST_REQUIRE_EQUAL (destination_ptr[size - 1], 0x2a);
+    BOOST_REQUIRE_LE (local, plain + std::chrono::microseconds (20));
+  }
+}
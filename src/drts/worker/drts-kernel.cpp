@@ -17,6 +17,8 @@
 #include <drts/worker/drts.hpp>
 
 #include <fhg/util/boost/program_options/validators/existing_path.hpp>
+#include <logging/legacy/event.hpp>
+#include <metrics/exporters.hpp>
 #include <util-generic/cxx14/make_unique.hpp>
 #include <util-generic/getenv.hpp>
 #include <util-generic/print_exception.hpp>
@@ -24,6 +26,7 @@
 #include <fhg/util/thread/event.hpp>
 
 #include <boost/asio/io_service.hpp>
+#include <boost/optional.hpp>
 #include <boost/program_options.hpp>
 #include <boost/tokenizer.hpp>
 
@@ -47,15 +50,23 @@ namespace
       {"virtual-memory-socket"};
     constexpr char const* const shared_memory_size
       {"shared-memory-size"};
+    constexpr char const* const shared_memory_huge_pages
+      {"shared-memory-huge-pages"};
+    constexpr char const* const shared_memory_numa_local
+      {"shared-memory-numa-local"};
+    constexpr char const* const global_memory_cache_size
+      {"global-memory-cache-size"};
     constexpr char const* const capability {"capability"};
     constexpr char const* const backlog_length {"backlog-length"};
     constexpr char const* const library_search_path {"library-search-path"};
+    constexpr char const* const preload_module {"preload-module"};
     constexpr char const* const socket {"socket"};
     constexpr char const* const master {"master"};
     constexpr char const* const certificates {"certificates"};
   }
 
-  void set_numa_socket (std::size_t target_socket)
+  //! \returns the NUMA node local to the socket, if there is one
+  boost::optional<unsigned int> set_numa_socket (std::size_t target_socket)
   {
     hwloc_topology_t topology;
 
@@ -118,7 +129,13 @@ namespace
         );
     }
 
+    int const numa_node
+      (obj->nodeset ? hwloc_bitmap_first (obj->nodeset) : -1);
+
     hwloc_topology_destroy (topology);
+
+    return boost::make_optional<unsigned int>
+      (numa_node >= 0, static_cast<unsigned int> (numa_node));
   }
 }
 
@@ -147,6 +164,23 @@ int main(int ac, char **av)
       , po::value<unsigned long>()
       , "size of shared memory associated with the kernel"
       )
+      ( option_name::shared_memory_huge_pages
+      , po::value<gpi::pc::segment::huge_page_policy>()
+        ->default_value (gpi::pc::segment::huge_page_policy::none)
+      , "back the shared memory by huge pages: none, transparent or"
+        " preallocated (falls back to transparent)"
+      )
+      ( option_name::shared_memory_numa_local
+      , po::bool_switch()
+      , "bind the shared memory to the NUMA node of --socket"
+      )
+      ( option_name::global_memory_cache_size
+      , po::value<unsigned long>()->default_value (0)
+      , "part of the shared memory to keep global memory ranges in across"
+        " jobs, disabled if 0, used for the gets of transitions with"
+        " fhg.drts.global_memory_gets_are_read_only only, which promise"
+        " that nobody writes them: writes are not detected"
+      )
       ( "port,p"
       , po::value<unsigned short>(&comm_port)->default_value(0)
       , "workers's communication port"
@@ -165,6 +199,11 @@ int main(int ac, char **av)
         ->default_value (std::vector<boost::filesystem::path>(), "{}")
       , "paths to search for module call libraries"
       )
+      ( option_name::preload_module
+      , po::value<std::vector<std::string>>()
+        ->default_value (std::vector<std::string>(), "{}")
+      , "modules to load at startup instead of at their first use"
+      )
       ( option_name::socket
       , po::value<std::size_t>()
       , "socket to pin worker on"
@@ -178,13 +217,20 @@ int main(int ac, char **av)
       , "folder containing SSL certificates"
       )
       ;
+    desc.add (fhg::metrics::options::exporters());
 
     po::variables_map vm;
 
     po::store (po::command_line_parser (ac, av).options(desc).run(), vm);
     po::notify (vm);
 
-    fhg::logging::stream_emitter log_emitter;
+    fhg::metrics::exporters const metrics_exporters
+      (fhg::metrics::process_registry(), vm);
+
+    //! \note modules log from the job executing thread, which should
+    //! not wait for the receivers
+    fhg::logging::stream_emitter log_emitter
+      {fhg::logging::asynchronous_emission{}};
 
     fhg::util::thread::event<> stop_requested;
     const std::function<void()> request_stop
@@ -194,6 +240,11 @@ int main(int ac, char **av)
     fhg::util::scoped_log_backtrace_and_exit_for_critical_errors const
       crit_error_handler (signal_handlers, log_emitter);
 
+    for (auto const& endpoint : metrics_exporters.endpoints())
+    {
+      log_emitter.emit (endpoint, fhg::logging::legacy::category_level_info);
+    }
+
     fhg::util::scoped_signal_handler const SIGTERM_handler
       (signal_handlers, SIGTERM, std::bind (request_stop));
     fhg::util::scoped_signal_handler const SIGINT_handler
@@ -211,6 +262,22 @@ int main(int ac, char **av)
           )
       : nullptr
       );
+    boost::optional<unsigned int> numa_node;
+
+    if (vm.count (option_name::socket))
+    {
+      numa_node = set_numa_socket (vm.at (option_name::socket).as<std::size_t>());
+    }
+
+    if (vm.at (option_name::shared_memory_numa_local).as<bool>() && !numa_node)
+    {
+      throw std::invalid_argument
+        ( std::string ("--") + option_name::shared_memory_numa_local
+        + " requires --" + option_name::socket
+        + " to be given and to have a NUMA node"
+        );
+    }
+
     std::unique_ptr<gspc::scoped_allocation> const shared_memory
       ( ( virtual_memory_api
         && vm.count (option_name::shared_memory_size)
@@ -220,10 +287,30 @@ int main(int ac, char **av)
         ( virtual_memory_api
         , kernel_name + "-shared_memory"
         , vm.at (option_name::shared_memory_size).as<unsigned long>()
+        , gpi::pc::segment::placement
+            ( vm.at (option_name::shared_memory_huge_pages)
+              .as<gpi::pc::segment::huge_page_policy>()
+            , vm.at (option_name::shared_memory_numa_local).as<bool>()
+              ? numa_node : boost::none
+            )
         )
       : nullptr
       );
 
+    auto const global_memory_cache_size
+      (vm.at (option_name::global_memory_cache_size).as<unsigned long>());
+
+    if ( global_memory_cache_size > 0
+       && (!shared_memory || global_memory_cache_size >= shared_memory->size())
+       )
+    {
+      throw std::invalid_argument
+        ( std::string ("--") + option_name::global_memory_cache_size
+        + " requires more --" + option_name::shared_memory_size
+        + " to be allocated"
+        );
+    }
+
     std::vector<DRTSImpl::master_info> master_info;
     std::set<std::string> seen_master_names;
     for ( std::string const& master
@@ -250,11 +337,6 @@ int main(int ac, char **av)
         (fhg::com::host_t (parts[1]), fhg::com::port_t (parts[2]));
     }
 
-    if (vm.count (option_name::socket))
-    {
-      set_numa_socket (vm.at (option_name::socket).as<std::size_t>());
-    }
-
     fhg::com::Certificates certificates;
 
     if (vm.count (option_name::certificates))
@@ -269,11 +351,14 @@ int main(int ac, char **av)
       , comm_port
       , virtual_memory_api.get()
       , shared_memory.get()
+      , global_memory_cache_size
       , master_info
       , vm.at (option_name::capability)
       .as<std::vector<std::string>>()
       , vm.at (option_name::library_search_path)
       .as<std::vector<boost::filesystem::path>>()
+      , vm.at (option_name::preload_module)
+      .as<std::vector<std::string>>()
       , vm.at (option_name::backlog_length)
       .as<std::size_t>()
       , log_emitter
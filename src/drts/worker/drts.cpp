@@ -20,6 +20,7 @@
 #include <drts/worker/context_impl.hpp>
 
 #include <sdpa/capability.hpp>
+#include <sdpa/com/batching.hpp>
 #include <sdpa/events/BacklogNoLongerFullEvent.hpp>
 #include <sdpa/events/CancelJobAckEvent.hpp>
 #include <sdpa/events/CancelJobEvent.hpp>
@@ -41,6 +42,7 @@
 #include <we/type/activity.hpp>
 
 #include <fhg/util/macros.hpp>
+#include <util-generic/cxx14/make_unique.hpp>
 #include <util-generic/hostname.hpp>
 #include <util-generic/nest_exceptions.hpp>
 #include <util-generic/print_exception.hpp>
@@ -124,9 +126,11 @@ DRTSImpl::DRTSImpl
     , unsigned short comm_port
     , gpi::pc::client::api_t /*const*/* virtual_memory_api
     , gspc::scoped_allocation /*const*/* shared_memory
+    , unsigned long global_memory_cache_size
     , std::vector<master_info> const& masters
     , std::vector<std::string> const& capability_names
     , std::vector<boost::filesystem::path> const& library_path
+    , std::vector<std::string> const& preload_modules
     , std::size_t backlog_length
     , fhg::logging::stream_emitter& log_emitter
     , fhg::com::Certificates const& certificates
@@ -137,8 +141,28 @@ DRTSImpl::DRTSImpl
   , _currently_executed_tasks()
   , m_loader ({library_path.begin(), library_path.end()})
   , _log_emitter (log_emitter)
+  , _job_execution_duration
+      ( fhg::metrics::process_registry().histogram_for
+          ( "gspc_worker_job_execution_seconds"
+          , "time to execute a job"
+          , {{"worker", m_my_name}}
+          )
+      )
+  , _jobs_executed
+      ( fhg::metrics::process_registry().counter_for
+          ( "gspc_worker_jobs_executed_total"
+          , "number of jobs executed"
+          , {{"worker", m_my_name}}
+          )
+      )
   , _virtual_memory_api (virtual_memory_api)
   , _shared_memory (shared_memory)
+  , _global_memory_cache
+      ( global_memory_cache_size > 0
+      ? fhg::util::cxx14::make_unique<we::loader::global_memory_cache>
+          (global_memory_cache_size)
+      : nullptr
+      )
   , m_pending_jobs (backlog_length)
   , _peer ( std::move (peer_io_service)
           , fhg::com::host_t ("*")
@@ -150,6 +174,10 @@ DRTSImpl::DRTSImpl
   , m_execution_thread (&DRTSImpl::job_execution_thread, this)
   , _interrupt_execution_thread (m_pending_jobs)
 {
+  //! \note before registration: the first job shall not pay for
+  //! resolving and loading the modules
+  m_loader.preload ({preload_modules.begin(), preload_modules.end()});
+
   start_receiver();
 
   std::set<sdpa::Capability> const capabilities
@@ -172,9 +200,12 @@ DRTSImpl::DRTSImpl
       ( master_address
       , m_my_name
       , capabilities
-      , (_shared_memory != nullptr) ? _shared_memory->size() : 0
+      , (_shared_memory != nullptr)
+        ? _shared_memory->size() - global_memory_cache_size
+        : 0
       , false
       , fhg::util::hostname()
+      , _global_memory_cache ? _global_memory_cache->capacity() : 0
       );
   }
 
@@ -523,10 +554,15 @@ try
           _currently_executed_tasks.emplace (job->id, &task);
         }
 
+        fhg::metrics::scoped_timer const execution_timer
+          (_job_execution_duration);
+        _jobs_executed.increment();
+
         task.activity.execute
           ( m_loader
           , _virtual_memory_api
           , _shared_memory
+          , _global_memory_cache.get()
           , task.target_impl
           , &task.context
           );
@@ -653,12 +689,15 @@ void DRTSImpl::start_receiver()
 
         if (!ec)
         {
-          m_event_queue.put
-            ( source.get()
-            , sdpa::events::SDPAEvent::Ptr
-                ( codec.decode
-                    (std::string (message.data.begin(), message.data.end()))
-                )
+          sdpa::com::batch::for_each_event
+            ( message.data.data(), message.data.size()
+            , [&] (char const* data, std::size_t size)
+              {
+                m_event_queue.put
+                  ( source.get()
+                  , sdpa::events::SDPAEvent::Ptr (codec.decode (data, size))
+                  );
+              }
             );
 
           start_receiver();
@@ -696,5 +735,10 @@ template<typename Event, typename... Args>
                             )
 {
   static sdpa::events::Codec codec;
-  _peer.send (destination, codec.encode<Event> (std::forward<Args> (args)...));
+
+  Event const event (std::forward<Args> (args)...);
+  fhg::com::buffer serialized_event (_peer.buffers().get (0));
+  codec.encode (&event, serialized_event);
+
+  _peer.send (destination, std::move (serialized_event));
 }
@@ -21,6 +21,7 @@
 
 #include <fhgcom/peer.hpp>
 #include <logging/stream_emitter.hpp>
+#include <metrics/registry.hpp>
 
 #include <gpi-space/pc/client/api.hpp>
 
@@ -30,6 +31,7 @@
 #include <sdpa/events/EventHandler.hpp>
 #include <sdpa/events/SDPAEvent.hpp>
 
+#include <we/loader/global_memory_cache.hpp>
 #include <we/loader/loader.hpp>
 
 #include <boost/asio/io_service.hpp>
@@ -105,9 +107,11 @@ public:
     , unsigned short comm_port
     , gpi::pc::client::api_t /*const*/* virtual_memory_socket
     , gspc::scoped_allocation /*const*/* shared_memory
+    , unsigned long global_memory_cache_size
     , std::vector<master_info> const& masters
     , std::vector<std::string> const& capability_names
     , std::vector<boost::filesystem::path> const& library_path
+    , std::vector<std::string> const& preload_modules
     , std::size_t backlog_length
     , fhg::logging::stream_emitter& log_emitter
     , fhg::com::Certificates const& certificates
@@ -148,10 +152,14 @@ private:
   we::loader::loader m_loader;
 
   fhg::logging::stream_emitter& _log_emitter;
+  fhg::metrics::histogram& _job_execution_duration;
+  fhg::metrics::counter& _jobs_executed;
   void emit_gantt (wfe_task_t const&, sdpa::daemon::NotificationEvent::state_t);
 
   gpi::pc::client::api_t /*const*/* _virtual_memory_api;
   gspc::scoped_allocation /*const*/* _shared_memory;
+  //! \note reserves the end of the shared memory, none if disabled
+  std::unique_ptr<we::loader::global_memory_cache> _global_memory_cache;
 
   //! \todo Two sets for connected and unconnected masters?
   masters_t m_masters;
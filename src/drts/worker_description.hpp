@@ -18,17 +18,46 @@
 #include <boost/optional.hpp>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace gspc
 {
   struct worker_description
   {
+    //! \note not an aggregate to be able to default the members
+    //! added later, which keeps brace initialization of the older
+    //! members working in C++11
+    worker_description() = default;
+    worker_description ( std::vector<std::string> capabilities_
+                       , std::size_t num_per_node_
+                       , std::size_t max_nodes_
+                       , std::size_t shm_size_
+                       , boost::optional<std::size_t> socket_
+                       , boost::optional<unsigned short> base_port_
+                       , std::string shm_huge_pages_ = std::string()
+                       , bool shm_numa_local_ = false
+                       )
+      : capabilities (std::move (capabilities_))
+      , num_per_node (num_per_node_)
+      , max_nodes (max_nodes_)
+      , shm_size (shm_size_)
+      , socket (std::move (socket_))
+      , base_port (std::move (base_port_))
+      , shm_huge_pages (std::move (shm_huge_pages_))
+      , shm_numa_local (shm_numa_local_)
+    {}
+
     std::vector<std::string> capabilities;
-    std::size_t num_per_node;
-    std::size_t max_nodes;
-    std::size_t shm_size;
+    std::size_t num_per_node = 0;
+    std::size_t max_nodes = 0;
+    std::size_t shm_size = 0;
     boost::optional<std::size_t> socket;
     boost::optional<unsigned short> base_port;
+    //! backing of the shared memory: empty or "none", "transparent"
+    //! or "preallocated" huge pages
+    std::string shm_huge_pages;
+    //! bind the shared memory to the NUMA node of \a socket
+    bool shm_numa_local = false;
   };
 }
@@ -135,6 +135,8 @@ namespace fhg
         logger.emit ( fhg::util::make_backtrace (log_message.str())
                     , fhg::logging::legacy::category_level_error
                     );
+        //! \note deliver even if the emission is asynchronous
+        logger.flush();
 
         _exit (EXIT_FAILURE);
       }
@@ -0,0 +1,152 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <fhgcom/buffer.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+namespace fhg
+{
+  namespace com
+  {
+    buffer::buffer()
+      : _storage (std::make_shared<std::vector<char>>())
+    {}
+    buffer::buffer (std::size_t size)
+      : _storage (std::make_shared<std::vector<char>> (size))
+    {}
+    buffer::buffer (char const* data, std::size_t size)
+      : _storage (std::make_shared<std::vector<char>> (data, data + size))
+    {}
+    buffer::buffer (std::shared_ptr<std::vector<char>> storage)
+      : _storage (std::move (storage))
+    {}
+
+    void buffer::assign (std::string const& x)
+    {
+      _storage->assign (x.begin(), x.end());
+    }
+
+    bool operator== (buffer const& lhs, buffer const& rhs)
+    {
+      return lhs.size() == rhs.size()
+        && std::equal (lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    struct buffer_pool::state
+    {
+      state (std::size_t max_buffers, std::size_t max_capacity)
+        : _max_buffers (max_buffers)
+        , _max_capacity (max_capacity)
+      {}
+
+      std::unique_ptr<std::vector<char>> take (std::size_t size)
+      {
+        std::lock_guard<std::mutex> const lock (_guard);
+
+        if (_free.empty())
+        {
+          return nullptr;
+        }
+
+        //! \note Prefer the smallest buffer that fits without
+        //! reallocation, else the largest one to grow the least.
+        auto best (_free.begin());
+        for (auto it (_free.begin()); it != _free.end(); ++it)
+        {
+          bool const fits ((*it)->capacity() >= size);
+          bool const best_fits ((*best)->capacity() >= size);
+
+          if ( (fits && (!best_fits || (*it)->capacity() < (*best)->capacity()))
+             || (!fits && !best_fits && (*it)->capacity() > (*best)->capacity())
+             )
+          {
+            best = it;
+          }
+        }
+
+        std::unique_ptr<std::vector<char>> storage (std::move (*best));
+        _free.erase (best);
+        return storage;
+      }
+
+      void give_back (std::vector<char>* storage)
+      {
+        std::unique_ptr<std::vector<char>> owned (storage);
+
+        if (owned->capacity() > _max_capacity)
+        {
+          return;
+        }
+
+        std::lock_guard<std::mutex> const lock (_guard);
+
+        if (_free.size() < _max_buffers)
+        {
+          _free.emplace_back (std::move (owned));
+        }
+      }
+
+      std::size_t const _max_buffers;
+      std::size_t const _max_capacity;
+      mutable std::mutex _guard;
+      std::vector<std::unique_ptr<std::vector<char>>> _free;
+    };
+
+    buffer_pool::buffer_pool
+        (std::size_t max_pooled_buffers, std::size_t max_pooled_capacity)
+      : _state ( std::make_shared<state>
+                   (max_pooled_buffers, max_pooled_capacity)
+               )
+    {}
+
+    buffer buffer_pool::get (std::size_t size)
+    {
+      std::unique_ptr<std::vector<char>> storage (_state->take (size));
+      if (!storage)
+      {
+        storage.reset (new std::vector<char>);
+      }
+      storage->resize (size);
+
+      std::weak_ptr<state> const pool (_state);
+      return buffer
+        ( std::shared_ptr<std::vector<char>>
+            ( storage.release()
+            , [pool] (std::vector<char>* released)
+              {
+                if (auto const state = pool.lock())
+                {
+                  state->give_back (released);
+                }
+                else
+                {
+                  delete released;
+                }
+              }
+            )
+        );
+    }
+
+    std::size_t buffer_pool::pooled_buffers() const
+    {
+      std::lock_guard<std::mutex> const lock (_state->_guard);
+      return _state->_free.size();
+    }
+  }
+}
@@ -0,0 +1,117 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <boost/iostreams/concepts.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fhg
+{
+  namespace com
+  {
+    //! \note A contiguous, reference counted byte buffer. Copies
+    //! share their storage, so a copy is cheap but a modification is
+    //! visible to all copies. Storage obtained from a buffer_pool is
+    //! handed back to that pool when the last copy is destructed.
+    class buffer
+    {
+    public:
+      buffer();
+      explicit buffer (std::size_t size);
+      buffer (char const* data, std::size_t size);
+      template<typename Iterator>
+        buffer (Iterator begin, Iterator end)
+          : _storage (std::make_shared<std::vector<char>> (begin, end))
+      {}
+
+      char* data() { return _storage->data(); }
+      char const* data() const { return _storage->data(); }
+      std::size_t size() const { return _storage->size(); }
+      bool empty() const { return _storage->empty(); }
+
+      char* begin() { return data(); }
+      char* end() { return data() + size(); }
+      char const* begin() const { return data(); }
+      char const* end() const { return data() + size(); }
+
+      char& operator[] (std::size_t i) { return (*_storage)[i]; }
+      char const& operator[] (std::size_t i) const { return (*_storage)[i]; }
+
+      //! \note Does not release capacity: a buffer shrunk and grown
+      //! again only initializes the bytes beyond its old size.
+      void resize (std::size_t size) { _storage->resize (size); }
+      void append (char const* data, std::size_t size)
+      {
+        _storage->insert (_storage->end(), data, data + size);
+      }
+      void assign (std::string const&);
+
+      std::size_t capacity() const { return _storage->capacity(); }
+      long use_count() const { return _storage.use_count(); }
+
+    private:
+      friend class buffer_pool;
+      explicit buffer (std::shared_ptr<std::vector<char>>);
+
+      std::shared_ptr<std::vector<char>> _storage;
+    };
+
+    bool operator== (buffer const&, buffer const&);
+
+    //! \note Recycles the storage of buffers: the vectors of released
+    //! buffers are kept (up to a limit on count and capacity) and
+    //! handed out again, so that steady traffic of similarly sized
+    //! messages does not allocate. Buffers may outlive their pool, in
+    //! which case their storage is freed normally. Thread safe.
+    class buffer_pool
+    {
+    public:
+      buffer_pool ( std::size_t max_pooled_buffers = 64
+                  , std::size_t max_pooled_capacity = std::size_t (64) << 20
+                  );
+
+      //! \note The content of the returned buffer is unspecified.
+      buffer get (std::size_t size);
+
+      std::size_t pooled_buffers() const;
+
+    private:
+      struct state;
+      std::shared_ptr<state> _state;
+    };
+
+    //! \note Allows to serialize straight into a buffer, e.g. via
+    //! boost::iostreams::stream<buffer_sink>.
+    struct buffer_sink : boost::iostreams::sink
+    {
+      buffer_sink (buffer& buffer) : _buffer (buffer) {}
+
+      std::streamsize write (char_type const* s, std::streamsize n)
+      {
+        _buffer.append (s, n);
+        return n;
+      }
+
+    private:
+      buffer& _buffer;
+    };
+  }
+}
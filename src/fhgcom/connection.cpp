@@ -112,14 +112,15 @@ namespace fhg
     connection_t::connection_t
       ( boost::asio::io_service & io_service
       , boost::asio::ssl::context* ctx
-      , boost::asio::io_service::strand const& strand
+      , buffer_pool& receive_buffers
       , std::function<void (ptr_t connection, std::unique_ptr<message_t>)> handle_hello_message
       , std::function<void (ptr_t connection, std::unique_ptr<message_t>)> handle_user_data
       , std::function<void (ptr_t connection, const boost::system::error_code&)> handle_error
       , peer_t* peer
       )
       : _peer (peer)
-      , strand_(strand)
+      , strand_ (io_service)
+      , _receive_buffers (receive_buffers)
       , socket_ (make_socket (io_service, ctx))
       , _raw_socket (raw_socket (socket_))
       , _handle_hello_message (handle_hello_message)
@@ -250,11 +251,12 @@ namespace fhg
         fhg_assert (bytes_transferred == sizeof(p2p::header_t));
 
         // WORK HERE: convert for local endianess!
-        in_message_->resize ();
+        in_message_->data = _receive_buffers.get (in_message_->header.length);
 
         async_read_wrapper
           ( socket_
-          , boost::asio::buffer (in_message_->data)
+          , boost::asio::buffer
+              (in_message_->data.data(), in_message_->data.size())
           , strand_.wrap
               ( std::bind ( &connection_t::handle_read_data
                           , shared_from_this()
@@ -379,7 +381,8 @@ namespace fhg
       buffers.reserve (2);
       buffers.push_back
         (boost::asio::buffer (&_message.header, sizeof (p2p::header_t)));
-      buffers.push_back (boost::asio::buffer (_message.data));
+      buffers.push_back
+        (boost::asio::buffer (_message.data.data(), _message.data.size()));
     }
   }
 }
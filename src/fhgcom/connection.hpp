@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <fhgcom/buffer.hpp>
 #include <fhgcom/header.hpp>
 #include <fhgcom/message.hpp>
 
@@ -81,7 +82,7 @@ namespace fhg
       connection_t
         ( boost::asio::io_service & io_service
         , boost::asio::ssl::context* ctx
-        , boost::asio::io_service::strand const& strand
+        , buffer_pool& receive_buffers
         , std::function<void (ptr_t connection, std::unique_ptr<message_t>)> handle_hello_message
         , std::function<void (ptr_t connection, std::unique_ptr<message_t>)> handle_user_data
         , std::function<void (ptr_t connection, const boost::system::error_code&)> handle_error
@@ -92,6 +93,10 @@ namespace fhg
 
       boost::asio::ip::tcp::socket & socket();
 
+      //! All callbacks into the peer are invoked from within this
+      //! strand, which is not shared with other connections.
+      boost::asio::io_service::strand& strand() { return strand_; }
+
       void async_send (message_t msg, completion_handler_t hdl);
 
       template <typename SettableSocketOption>
@@ -112,14 +117,14 @@ namespace fhg
         m_remote_addr = a;
       }
 
-      //! Assumes to be called from within strand. Will call back
-      //! peer_t::request_handshake_response via strand, never from
-      //! within this call stack.
+      //! Assumes no other operation on the connection to be running.
+      //! Will call back peer_t::request_handshake_response via
+      //! strand, never from within this call stack.
       void request_handshake
         (std::shared_ptr<util::thread::event<std::exception_ptr>> connect_done);
-      //! Assumes to be called from within strand. Will call back
-      //! peer_t::acknowledge_handshake_response via strand, never
-      //! from within this call stack.
+      //! Assumes no other operation on the connection to be running.
+      //! Will call back peer_t::acknowledge_handshake_response via
+      //! strand, never from within this call stack.
       void acknowledge_handshake();
 
     private:
@@ -147,6 +152,7 @@ namespace fhg
       peer_t* _peer;
 
       boost::asio::io_service::strand strand_;
+      buffer_pool& _receive_buffers;
       socket_t socket_;
       tcp_socket_t& _raw_socket;
       std::function<void (ptr_t connection, std::unique_ptr<message_t>)> _handle_hello_message;
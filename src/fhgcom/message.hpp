@@ -16,11 +16,12 @@
 
 #pragma once
 
+#include <fhgcom/buffer.hpp>
 #include <fhgcom/header.hpp>
 
 #include <cstddef>
 #include <string>
-#include <vector>
+#include <utility>
 
 namespace fhg
 {
@@ -44,6 +45,13 @@ namespace fhg
         : data(begin, end)
       {}
 
+      explicit
+      message_t (buffer b)
+        : data (std::move (b))
+      {
+        header.length = data.size();
+      }
+
       void resize (const std::size_t n)
       {
         data.resize (n);
@@ -57,15 +65,15 @@ namespace fhg
 
       void assign (std::string const& x)
       {
-        data.assign(x.begin(), x.end());
+        data.assign (x);
         header.length = data.size ();
       }
 
-      const char * buf () const { return &data[0]; }
+      const char * buf () const { return data.data(); }
       std::size_t size () const { return data.size(); }
 
       p2p::header_t header;
-      std::vector<char> data;
+      buffer data;
     };
   }
 }
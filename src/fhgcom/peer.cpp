@@ -25,8 +25,11 @@
 #include <boost/make_shared.hpp>
 #include <boost/system/system_error.hpp>
 
+#include <algorithm>
+#include <future>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace fhg
 {
@@ -50,21 +53,31 @@ namespace fhg
                    , host_t const & host
                    , port_t const & port
                    , Certificates const& certificates
+                   , std::size_t io_threads
                    )
       : stopping_ (false)
       , host_(host)
       , port_(port)
+      , _buffers()
       , io_service_ (std::move (io_service))
       , strand_ (*io_service_)
       , io_service_work_(*io_service_)
       , acceptor_(*io_service_)
       , connections_()
       , TESTING_ONLY_handshake_exception_ (nullptr)
-      , _io_thread ([this] { io_service_->run(); })
+      , _io_threads()
     {
+      if (io_threads == 0)
+      {
+        throw std::invalid_argument ("peer requires at least one io thread");
+      }
+
       try
       {
-        lock_type const _ (mutex_);
+        while (io_threads --> 0)
+        {
+          _io_threads.emplace_back ([this] { io_service_->run(); });
+        }
 
         if (certificates)
         {
@@ -134,42 +147,64 @@ namespace fhg
 
     peer_t::~peer_t()
     {
-      stopping_ = true;
-
-      auto cancels_done (std::make_shared<util::thread::event<void>>());
+      std::set<connection_t::ptr_t> to_cancel;
 
-      strand_.dispatch
-        ( [this, cancels_done]
-          {
-            lock_type const lock (mutex_);
+      {
+        lock_type const lock (mutex_);
 
-            acceptor_.close ();
+        stopping_ = true;
 
-            using namespace boost::system;
-            auto const error_code
-              (errc::make_error_code (errc::operation_canceled));
+        if (listen_)
+        {
+          to_cancel.emplace (listen_);
+        }
+        for (auto const& connection : connections_)
+        {
+          if (connection.second.connection)
+          {
+            to_cancel.emplace (connection.second.connection);
+          }
+        }
+        to_cancel.insert (backlog_.begin(), backlog_.end());
+      }
 
-            if (listen_)
+      {
+        util::thread::event<void> acceptor_closed;
+        strand_.dispatch
+          ( [this, &acceptor_closed]
             {
-              handle_error (listen_, error_code);
+              acceptor_.close ();
+              acceptor_closed.notify();
             }
+          );
+        acceptor_closed.wait();
+      }
 
-            while (!connections_.empty())
-            {
-              handle_error
-                (connections_.begin()->second.connection, error_code);
-            }
+      using namespace boost::system;
+      auto const error_code (errc::make_error_code (errc::operation_canceled));
+
+      //! \note Every connection is canceled from within its own
+      //! strand, as socket operations of a connection must not run
+      //! concurrently.
+      std::vector<std::future<void>> cancels_done;
+      for (auto const& connection : to_cancel)
+      {
+        auto cancel_done (std::make_shared<std::promise<void>>());
+        cancels_done.emplace_back (cancel_done->get_future());
 
-            while (!backlog_.empty())
+        connection->strand().dispatch
+          ( [this, connection, error_code, cancel_done]
             {
-              handle_error (*backlog_.begin(), error_code);
+              handle_error (connection, error_code);
+              cancel_done->set_value();
             }
+          );
+      }
 
-            cancels_done->notify();
-          }
-        );
-
-      cancels_done->wait();
+      for (auto& cancel_done : cancels_done)
+      {
+        cancel_done.wait();
+      }
 
       io_service_->stop();
     }
@@ -179,15 +214,6 @@ namespace fhg
       std::string const fake_name (std::string (host) + ":" + std::string (port));
       p2p::address_t const addr (fake_name);
 
-      {
-        std::unique_lock<std::recursive_mutex> const _ (mutex_);
-
-        if (connections_.find (addr) != connections_.end())
-        {
-          throw std::logic_error ("already connected to " + fake_name);
-        }
-      }
-
       // \note Only detects `hostname` (as we use that to create
       // my_addr_), not `localhost` or `::1` or equivalent
       // ones. Those will just hang as we can't connect and accept
@@ -197,39 +223,49 @@ namespace fhg
         throw std::logic_error ("unable to connect to self");
       }
 
+      {
+        lock_type const _ (mutex_);
+
+        if (!connections_.emplace (addr, connection_data_t()).second)
+        {
+          throw std::logic_error ("already connected to " + fake_name);
+        }
+      }
+
       auto connect_done
         (std::make_shared<util::thread::event<std::exception_ptr>>());
 
-      connections_.emplace (addr, connection_data_t());
-
       strand_.dispatch
         ( [this, addr, host, port, connect_done]
           {
             try
             {
-              std::unique_lock<std::recursive_mutex> const _ (mutex_);
-
-              connection_data_t& cd (connections_.at (addr));
-
-              cd.connection = boost::make_shared<connection_t>
-                ( *io_service_
-                , ctx_.get()
-                , strand_
-                , std::bind (&peer_t::handle_hello_message, this, std::placeholders::_1, std::placeholders::_2)
-                , std::bind (&peer_t::handle_user_data, this, std::placeholders::_1, std::placeholders::_2)
-                , std::bind (&peer_t::handle_error, this, std::placeholders::_1, std::placeholders::_2)
-                , this
+              auto const connection
+                ( boost::make_shared<connection_t>
+                    ( *io_service_
+                    , ctx_.get()
+                    , _buffers
+                    , std::bind (&peer_t::handle_hello_message, this, std::placeholders::_1, std::placeholders::_2)
+                    , std::bind (&peer_t::handle_user_data, this, std::placeholders::_1, std::placeholders::_2)
+                    , std::bind (&peer_t::handle_error, this, std::placeholders::_1, std::placeholders::_2)
+                    , this
+                    )
                 );
-              cd.connection->local_address (my_addr_.get());
-              cd.connection->remote_address (addr);
+              connection->local_address (my_addr_.get());
+              connection->remote_address (addr);
+
+              {
+                lock_type const _ (mutex_);
+                connections_.at (addr).connection = connection;
+              }
 
               boost::asio::connect
-                ( cd.connection->socket()
+                ( connection->socket()
                 , boost::asio::ip::tcp::resolver (*io_service_)
                     .resolve ({host, port})
                 );
 
-              cd.connection->request_handshake (std::move (connect_done));
+              connection->request_handshake (std::move (connect_done));
               // control flow continues in `request_handshake_response`.
             }
             catch (...)
@@ -254,8 +290,6 @@ namespace fhg
       , boost::system::error_code const& ec
       )
     {
-      REQUIRE_ON_STRAND();
-
       try
       {
         lock_type const lock (mutex_);
@@ -278,11 +312,19 @@ namespace fhg
     void peer_t::send ( p2p::address_t const& addr
                       , const std::string & data
                       )
+    {
+      buffer message (_buffers.get (data.size()));
+      std::copy (data.begin(), data.end(), message.begin());
+
+      send (addr, std::move (message));
+    }
+
+    void peer_t::send (p2p::address_t const& addr, buffer data)
     {
       typedef fhg::util::thread::event<boost::system::error_code> async_op_t;
       async_op_t send_finished;
       async_send
-        ( addr, data
+        ( addr, std::move (data)
         , std::bind (&async_op_t::notify, &send_finished, std::placeholders::_1)
         );
 
@@ -297,25 +339,36 @@ namespace fhg
                             , const std::string & data
                             , peer_t::handler_t completion_handler
                             )
+    {
+      buffer message (_buffers.get (data.size()));
+      std::copy (data.begin(), data.end(), message.begin());
+
+      async_send (addr, std::move (message), std::move (completion_handler));
+    }
+
+    void peer_t::async_send ( p2p::address_t const& addr
+                            , buffer data
+                            , peer_t::handler_t completion_handler
+                            )
     {
       fhg_assert (completion_handler);
 
-      lock_type const lock (mutex_);
+      lock_type lock (mutex_);
 
       if (stopping_)
       {
+        lock.unlock();
+
         using namespace boost::system;
         completion_handler (errc::make_error_code (errc::network_down));
         return;
       }
 
-      // TODO: io_service_->post (...);
-
       connection_data_t & cd = connections_.at (addr);
       to_send_t to_send;
+      to_send.message = message_t (std::move (data));
       to_send.message.header.src = my_addr_.get();
       to_send.message.header.dst = addr;
-      to_send.message.assign (data);
       to_send.handler = completion_handler;
       cd.o_queue.push_back (std::move (to_send));
 
@@ -339,6 +392,8 @@ namespace fhg
 
       if (stopping_)
       {
+        lock.unlock();
+
         using namespace boost::system;
         completion_handler
           (errc::make_error_code (errc::network_down), boost::none, {});
@@ -386,59 +441,48 @@ namespace fhg
 
     void peer_t::handle_send (const p2p::address_t a, boost::system::error_code const & ec)
     {
-      lock_type lock (mutex_);
+      handler_t handler;
 
-      if (connections_.find (a) == connections_.end())
       {
-        if (ec)
+        lock_type lock (mutex_);
+
+        if (connections_.find (a) == connections_.end())
         {
-          throw boost::system::system_error (ec);
+          if (ec)
+          {
+            throw boost::system::system_error (ec);
+          }
+          return;
         }
-        return;
-      }
 
-      connection_data_t & cd = connections_.at (a);
-      if (cd.o_queue.empty ())
-      {
-        if (cd.send_in_progress)
+        connection_data_t & cd = connections_.at (a);
+        if (cd.o_queue.empty ())
         {
-          throw std::logic_error
-            ("inconsistent output queue: " + ec.message());
+          if (cd.send_in_progress)
+          {
+            throw std::logic_error
+              ("inconsistent output queue: " + ec.message());
+          }
+          return;
         }
-        return;
-      }
 
-      cd.o_queue.front().handler (ec);
-      cd.o_queue.pop_front();
+        handler = std::move (cd.o_queue.front().handler);
+        cd.o_queue.pop_front();
 
-      if (ec)
-      {
-        throw boost::system::system_error (ec);
-      }
+        cd.send_in_progress = false;
 
-      if (! ec)
-      {
-        if (! cd.o_queue.empty())
+        if (! ec)
         {
-          cd.connection->async_send ( std::move (cd.o_queue.front().message)
-                                    , strand_.wrap
-                                        ( std::bind ( &peer_t::handle_send
-                                                    , this
-                                                    , a
-                                                    , std::placeholders::_1
-                                                    )
-                                        )
-                                    );
-        }
-        else
-        {
-          cd.send_in_progress = false;
+          start_sender (lock, cd);
         }
+        // TODO: else close connection
       }
-      else
+
+      handler (ec);
+
+      if (ec)
       {
-        cd.send_in_progress = false;
-        // TODO: close connection
+        throw boost::system::system_error (ec);
       }
     }
 
@@ -454,18 +498,18 @@ namespace fhg
       cd.send_in_progress = true;
       cd.connection->async_send
         ( std::move (cd.o_queue.front().message)
-        , strand_.wrap
-            ( std::bind ( &peer_t::handle_send
-                        , this
-                        , cd.connection->remote_address()
-                        , std::placeholders::_1
-                        )
-            )
+        , std::bind ( &peer_t::handle_send
+                    , this
+                    , cd.connection->remote_address()
+                    , std::placeholders::_1
+                    )
         );
     }
 
     void peer_t::handle_accept (const boost::system::error_code & ec)
     {
+      REQUIRE_ON_STRAND();
+
       if (! ec && !stopping_)
       {
         fhg_assert (listen_);
@@ -478,39 +522,48 @@ namespace fhg
     void peer_t::acknowledge_handshake_response
       (connection_t::ptr_t connection, boost::system::error_code const& ec)
     {
-      REQUIRE_ON_STRAND();
+      {
+        lock_type const lock (mutex_);
 
-      // \todo Allow accepting a new connection while still
-      // handshaking this one: denial of service attack possible.
-      fhg_assert (connection == listen_);
+        // \todo Allow accepting a new connection while still
+        // handshaking this one: denial of service attack possible.
+        fhg_assert (connection == listen_);
 
-      if (ec)
-      {
-        TESTING_ONLY_handshake_exception_
-          = std::make_exception_ptr (handshake_exception (ec));
-      }
-      else
-      {
-        // TODO: work here schedule timeout
-        backlog_.insert (connection);
+        if (ec)
+        {
+          TESTING_ONLY_handshake_exception_
+            = std::make_exception_ptr (handshake_exception (ec));
+        }
+        else if (!stopping_)
+        {
+          // TODO: work here schedule timeout
+          backlog_.insert (connection);
 
-        // the connection will call us back when it got the hello packet
-        // or will timeout
-        connection->start();
+          // the connection will call us back when it got the hello packet
+          // or will timeout
+          connection->start();
+        }
       }
 
-      accept_new();
+      strand_.post ([this] { accept_new(); });
     }
 
     void peer_t::accept_new ()
     {
       REQUIRE_ON_STRAND();
 
+      lock_type const lock (mutex_);
+
+      if (stopping_)
+      {
+        return;
+      }
+
       listen_ = connection_t::ptr_t
         ( new connection_t
           ( *io_service_
           , ctx_.get()
-          , strand_
+          , _buffers
           , std::bind (&peer_t::handle_hello_message, this, std::placeholders::_1, std::placeholders::_2)
           , std::bind (&peer_t::handle_user_data, this, std::placeholders::_1, std::placeholders::_2)
           , std::bind (&peer_t::handle_error, this, std::placeholders::_1, std::placeholders::_2)
@@ -530,12 +583,12 @@ namespace fhg
 
     void peer_t::handle_hello_message (connection_t::ptr_t c, std::unique_ptr<message_t> m)
     {
-      REQUIRE_ON_STRAND();
-
       lock_type lock (mutex_);
 
       if (backlog_.find (c) == backlog_.end())
       {
+        lock.unlock();
+
         handle_error (c, boost::system::errc::make_error_code (boost::system::errc::connection_reset));
       }
       else
@@ -556,62 +609,48 @@ namespace fhg
     void peer_t::handle_user_data
       (connection_t::ptr_t connection, std::unique_ptr<message_t> m)
     {
-      REQUIRE_ON_STRAND();
-
       fhg_assert (m);
 
       lock_type lock (mutex_);
+
+      if (m_to_recv.empty())
       {
-        if (m_to_recv.empty())
-        {
-          // TODO: maybe add a flag to the message indicating whether it should be delivered
-          // at all costs or not
-          // if (m->header.flags & IMPORTANT)
-          m_pending.emplace_back (std::move (*m));
-        }
-        else
-        {
-          auto const to_recv (std::move (m_to_recv.front()));
-          m_to_recv.pop_front();
+        // TODO: maybe add a flag to the message indicating whether it should be delivered
+        // at all costs or not
+        // if (m->header.flags & IMPORTANT)
+        m_pending.emplace_back (std::move (*m));
+      }
+      else
+      {
+        auto const to_recv (std::move (m_to_recv.front()));
+        m_to_recv.pop_front();
 
-          using namespace boost::system;
+        lock.unlock ();
 
-          lock.unlock ();
-          to_recv ( errc::make_error_code (errc::success)
-                  , connection->remote_address()
-                  , std::move (*m)
-                  );
-          lock.lock ();
-        }
+        using namespace boost::system;
+        to_recv ( errc::make_error_code (errc::success)
+                , connection->remote_address()
+                , std::move (*m)
+                );
       }
     }
 
     void peer_t::handle_error (connection_t::ptr_t c, const boost::system::error_code & ec)
     {
-      REQUIRE_ON_STRAND();
-
       fhg_assert ( c != nullptr );
 
       lock_type lock (mutex_);
 
-      if (connections_.find (c->remote_address()) != connections_.end())
-      {
-        connection_data_t & cd = connections_.at (c->remote_address());
-
-        c->stop();
-
-        // deactivate asynchronous sender
-        cd.send_in_progress = false;
+      auto const connection (connections_.find (c->remote_address()));
 
-        while (! cd.o_queue.empty())
-        {
-          to_send_t to_send (std::move (cd.o_queue.front()));
-          cd.o_queue.pop_front();
+      if ( connection != connections_.end()
+         && connection->second.connection == c
+         )
+      {
+        std::deque<to_send_t> o_queue;
+        std::swap (o_queue, connection->second.o_queue);
 
-          lock.unlock ();
-          to_send.handler (ec);
-          lock.lock ();
-        }
+        connections_.erase (connection);
 
         // \todo Instead, deliver them? The sender may assume they
         // were delivered as there was no error in sending.
@@ -623,24 +662,26 @@ namespace fhg
           );
 
         // the handler might async recv again...
-        std::list<to_recv_t> tmp;
-        std::swap (tmp, m_to_recv);
+        std::list<to_recv_t> to_recv;
+        std::swap (to_recv, m_to_recv);
+
+        lock.unlock ();
 
-        while (! tmp.empty())
+        c->stop();
+
+        for (auto const& to_send : o_queue)
         {
-          auto const to_recv (std::move (tmp.front()));
-          tmp.pop_front();
+          to_send.handler (ec);
+        }
 
+        for (auto const& handler : to_recv)
+        {
           message_t m;
           m.header.src = c->remote_address();
           m.header.dst = c->local_address();
 
-          lock.unlock ();
-          to_recv (ec, c->remote_address(), std::move (m));
-          lock.lock ();
+          handler (ec, c->remote_address(), std::move (m));
         }
-
-        connections_.erase(c->remote_address());
       }
       else if (backlog_.find (c) != backlog_.end ())
       {
@@ -648,12 +689,16 @@ namespace fhg
       }
       else // should be listen_
       {
+        lock.unlock ();
+
         c->stop ();
       }
     }
 
     std::exception_ptr peer_t::TESTING_ONLY_handshake_exception() const
     {
+      lock_type const lock (mutex_);
+
       return TESTING_ONLY_handshake_exception_;
     }
   }
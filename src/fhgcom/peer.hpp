@@ -18,6 +18,7 @@
 
 #include <drts/certificates.hpp>
 
+#include <fhgcom/buffer.hpp>
 #include <fhgcom/connection.hpp>
 #include <fhgcom/header.hpp>
 #include <fhgcom/message.hpp>
@@ -33,6 +34,8 @@
 #include <boost/thread/scoped_thread.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <deque>
 #include <exception>
 #include <functional>
@@ -57,10 +60,15 @@ namespace fhg
     public:
       typedef std::function <void (boost::system::error_code const &)> handler_t;
 
+      //! \note The io_service is run by io_threads threads. Every
+      //! connection has its own strand, so traffic (including TLS) of
+      //! different connections is handled concurrently while messages
+      //! of one connection stay in order.
       peer_t ( std::unique_ptr<boost::asio::io_service>
              , host_t const& host
              , port_t const& port
              , Certificates const& certificates
+             , std::size_t io_threads = 1
              );
 
       virtual ~peer_t ();
@@ -81,6 +89,22 @@ namespace fhg
                 , std::string const & data
                 );
 
+      //! \note Sends the buffer without copying it: the peer keeps a
+      //! reference until the message is written, so the caller must
+      //! not modify it until the handler was called.
+      void async_send ( p2p::address_t const& addr
+                      , buffer data
+                      , handler_t h
+                      );
+      void send ( p2p::address_t const& addr
+                , buffer data
+                );
+
+      //! \note Buffers to serialize outgoing messages into. Messages
+      //! handed out by async_recv() are backed by buffers of the same
+      //! pool, so dropping them recycles their storage.
+      buffer_pool& buffers() { return _buffers; }
+
       void async_recv
         ( std::function<void ( boost::system::error_code
                              , boost::optional<fhg::com::p2p::address_t> source
@@ -131,7 +155,10 @@ namespace fhg
         std::deque<to_send_t> o_queue;
       };
 
-      typedef std::recursive_mutex mutex_type;
+      //! \note Guards the connection table and the receive queues
+      //! only. It is never held while calling user handlers or
+      //! blocking socket operations.
+      typedef std::mutex mutex_type;
       typedef std::unique_lock<mutex_type> lock_type;
 
       void accept_new ();
@@ -152,14 +179,18 @@ namespace fhg
 
       mutable mutex_type mutex_;
 
-      bool stopping_;
+      std::atomic<bool> stopping_;
       std::string host_;
       std::string port_;
       boost::optional<p2p::address_t> my_addr_;
 
       std::unique_ptr<boost::asio::ssl::context> ctx_;
 
+      buffer_pool _buffers;
+
       std::unique_ptr<boost::asio::io_service> io_service_;
+      //! \note Serializes accepting and connecting only: every
+      //! connection has a strand of its own.
       boost::asio::io_service::strand strand_;
       boost::asio::io_service::work io_service_work_;
       boost::asio::ip::tcp::acceptor acceptor_;
@@ -174,7 +205,7 @@ namespace fhg
       std::list<message_t> m_pending;
 
       std::exception_ptr TESTING_ONLY_handshake_exception_;
-      boost::strict_scoped_thread<> _io_thread;
+      std::list<boost::strict_scoped_thread<>> _io_threads;
     };
   }
 }
@@ -0,0 +1,110 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <fhgcom/buffer.hpp>
+
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+
+#include <boost/iostreams/stream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+BOOST_AUTO_TEST_CASE (copies_of_a_buffer_share_storage)
+{
+  fhg::com::buffer const original ("abc", 3);
+  fhg::com::buffer copy (original);
+
+  BOOST_REQUIRE_EQUAL (original.data(), copy.data());
+  BOOST_REQUIRE_EQUAL (original.use_count(), 2);
+
+  copy[0] = 'x';
+  BOOST_REQUIRE_EQUAL (original[0], 'x');
+}
+
+BOOST_AUTO_TEST_CASE (buffer_is_returned_to_pool_when_last_copy_is_gone)
+{
+  fhg::com::buffer_pool pool;
+
+  char const* storage (nullptr);
+  {
+    fhg::com::buffer const buffer (pool.get (1 << 10));
+    storage = buffer.data();
+
+    {
+      fhg::com::buffer const copy (buffer);
+    }
+    BOOST_REQUIRE_EQUAL (pool.pooled_buffers(), 0);
+  }
+  BOOST_REQUIRE_EQUAL (pool.pooled_buffers(), 1);
+
+  fhg::com::buffer const recycled (pool.get (1 << 9));
+  BOOST_REQUIRE_EQUAL (recycled.data(), storage);
+  BOOST_REQUIRE_EQUAL (recycled.size(), 1 << 9);
+  BOOST_REQUIRE_EQUAL (pool.pooled_buffers(), 0);
+}
+
+BOOST_AUTO_TEST_CASE (pool_prefers_the_smallest_fitting_buffer)
+{
+  fhg::com::buffer_pool pool;
+
+  char const* small_storage (nullptr);
+  {
+    fhg::com::buffer const large (pool.get (1 << 20));
+    fhg::com::buffer const small (pool.get (1 << 10));
+    small_storage = small.data();
+  }
+  BOOST_REQUIRE_EQUAL (pool.pooled_buffers(), 2);
+
+  BOOST_REQUIRE_EQUAL (pool.get (1 << 8).data(), small_storage);
+}
+
+BOOST_AUTO_TEST_CASE (pool_limits_count_and_capacity_of_pooled_buffers)
+{
+  fhg::com::buffer_pool pool (1, 1 << 10);
+
+  {
+    fhg::com::buffer const a (pool.get (1 << 8));
+    fhg::com::buffer const b (pool.get (1 << 8));
+    fhg::com::buffer const too_large (pool.get (1 << 11));
+  }
+
+  BOOST_REQUIRE_EQUAL (pool.pooled_buffers(), 1);
+}
+
+BOOST_AUTO_TEST_CASE (buffer_may_outlive_its_pool)
+{
+  fhg::com::buffer buffer;
+
+  {
+    fhg::com::buffer_pool pool;
+    buffer = pool.get (1 << 10);
+  }
+
+  BOOST_REQUIRE_EQUAL (buffer.size(), 1 << 10);
+}
+
+BOOST_AUTO_TEST_CASE (sink_appends_to_buffer)
+{
+  fhg::com::buffer buffer ("a", 1);
+
+  {
+    boost::iostreams::stream<fhg::com::buffer_sink> stream (buffer);
+    stream << "bc" << 42;
+  }
+
+  BOOST_REQUIRE_EQUAL (std::string (buffer.begin(), buffer.end()), "abc42");
+}
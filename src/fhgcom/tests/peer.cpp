@@ -38,14 +38,18 @@
 #include <boost/version.hpp>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <exception>
 #include <functional>
+#include <list>
 #include <mutex>
+#include <numeric>
 #include <ostream>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -469,12 +473,128 @@ BOOST_DATA_TEST_CASE
           BOOST_CHECK_EQUAL (message.header.type_of_msg, 0);
           BOOST_CHECK_EQUAL (message.header.length, payload.size());
           BOOST_CHECK_EQUAL
-            (message.data, std::vector<char> (payload.begin(), payload.end()));
+            ( std::vector<char> (message.data.begin(), message.data.end())
+            , std::vector<char> (payload.begin(), payload.end())
+            );
         }
       );
   }
 }
 
+BOOST_DATA_TEST_CASE
+  ( messages_of_each_connection_arrive_in_order_with_multiple_io_threads
+  , certificates_data
+  , certificates
+  )
+{
+  std::size_t const senders (8);
+  std::size_t const messages_per_sender (250);
+
+  fhg::com::peer_t receiver
+    ( fhg::util::cxx14::make_unique<boost::asio::io_service>()
+    , fhg::com::host_t ("localhost")
+    , fhg::com::port_t ("0")
+    , certificates
+    , 4
+    );
+
+  std::mutex received_guard;
+  std::condition_variable all_received;
+  std::unordered_map<fhg::com::p2p::address_t, std::vector<std::size_t>>
+    received;
+  std::size_t received_count (0);
+
+  std::function< void ( boost::system::error_code
+                      , boost::optional<fhg::com::p2p::address_t>
+                      , fhg::com::message_t
+                      )
+               > receive
+    ( [&] ( boost::system::error_code ec
+          , boost::optional<fhg::com::p2p::address_t> source
+          , fhg::com::message_t message
+          )
+      {
+        BOOST_REQUIRE (!ec);
+
+        {
+          std::lock_guard<std::mutex> const lock (received_guard);
+
+          received[source.get()].emplace_back
+            (std::stoul (std::string (message.data.begin(), message.data.end())));
+
+          if (++received_count == senders * messages_per_sender)
+          {
+            all_received.notify_one();
+            return;
+          }
+        }
+
+        receiver.async_recv (receive);
+      }
+    );
+  receiver.async_recv (receive);
+
+  std::list<fhg::com::peer_t> sending_peers;
+  for (std::size_t i (0); i < senders; ++i)
+  {
+    sending_peers.emplace_back
+      ( fhg::util::cxx14::make_unique<boost::asio::io_service>()
+      , fhg::com::host_t ("localhost")
+      , fhg::com::port_t ("0")
+      , certificates
+      , 2
+      );
+  }
+
+  {
+    std::list<std::thread> sending_threads;
+    for (auto& sender : sending_peers)
+    {
+      sending_threads.emplace_back
+        ( [&]
+          {
+            auto const address
+              ( sender.connect_to ( host (receiver.local_endpoint())
+                                  , port (receiver.local_endpoint())
+                                  )
+              );
+
+            for (std::size_t i (0); i < messages_per_sender; ++i)
+            {
+              sender.async_send
+                ( address
+                , std::to_string (i)
+                , [] (boost::system::error_code const& ec)
+                  {
+                    BOOST_REQUIRE (!ec);
+                  }
+                );
+            }
+          }
+        );
+    }
+    for (auto& thread : sending_threads)
+    {
+      thread.join();
+    }
+  }
+
+  std::vector<std::size_t> expected (messages_per_sender);
+  std::iota (expected.begin(), expected.end(), 0);
+
+  std::unique_lock<std::mutex> lock (received_guard);
+  all_received.wait
+    ( lock
+    , [&] { return received_count == senders * messages_per_sender; }
+    );
+
+  BOOST_REQUIRE_EQUAL (received.size(), senders);
+  for (auto const& from_sender : received)
+  {
+    BOOST_REQUIRE_EQUAL (from_sender.second, expected);
+  }
+}
+
 BOOST_AUTO_TEST_CASE (require_certificates_location_to_exist)
 {
   using namespace fhg::com;
@@ -0,0 +1,384 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <fhgcom/buffer.hpp>
+#include <fhgcom/peer.hpp>
+
+#include <test/certificates_data.hpp>
+
+#include <util-generic/connectable_to_address_string.hpp>
+#include <util-generic/cxx14/make_unique.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/printer/optional.hpp>
+#include <util-generic/this_bound_mem_fn.hpp>
+
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  std::vector<std::size_t> powers_of_two (std::size_t from, std::size_t to)
+  {
+    std::vector<std::size_t> result;
+    for (std::size_t exponent (from); exponent <= to; ++exponent)
+    {
+      result.emplace_back (std::size_t (1) << exponent);
+    }
+    return result;
+  }
+
+  std::unique_ptr<fhg::com::peer_t> make_peer
+    ( std::size_t io_threads
+    , fhg::com::Certificates const& certificates = fhg::com::Certificates{}
+    )
+  {
+    return fhg::util::cxx14::make_unique<fhg::com::peer_t>
+      ( fhg::util::cxx14::make_unique<boost::asio::io_service>()
+      , fhg::com::host_t ("localhost")
+      , fhg::com::port_t ("0")
+      , certificates
+      , io_threads
+      );
+  }
+
+  fhg::com::p2p::address_t connect (fhg::com::peer_t& from, fhg::com::peer_t& to)
+  {
+    return from.connect_to
+      ( fhg::com::host_t
+          ( fhg::util::connectable_to_address_string
+              (to.local_endpoint().address())
+          )
+      , fhg::com::port_t (std::to_string (to.local_endpoint().port()))
+      );
+  }
+
+  //! \note Keeps receiving on the given peer until count messages of
+  //! the given size arrived.
+  class receive_messages
+  {
+  public:
+    receive_messages ( fhg::com::peer_t& receiver
+                     , std::size_t size
+                     , std::size_t count
+                     )
+      : _receiver (receiver)
+      , _size (size)
+      , _count (count)
+    {
+      _receiver.async_recv (fhg::util::bind_this (this, &receive_messages::receive));
+    }
+
+    void wait()
+    {
+      std::unique_lock<std::mutex> lock (_guard);
+      _all_received.wait
+        (lock, [&] { return _received == _count || !!_receive_error; });
+
+      BOOST_REQUIRE (!_receive_error);
+      BOOST_REQUIRE_EQUAL (_received_with_wrong_size, 0);
+    }
+
+  private:
+    void receive ( boost::system::error_code ec
+                 , boost::optional<fhg::com::p2p::address_t>
+                 , fhg::com::message_t message
+                 )
+    {
+      {
+        std::lock_guard<std::mutex> const lock (_guard);
+
+        if (ec)
+        {
+          _receive_error = ec;
+          _all_received.notify_one();
+          return;
+        }
+
+        _received_with_wrong_size += message.data.size() != _size;
+
+        if (++_received == _count)
+        {
+          _all_received.notify_one();
+          return;
+        }
+      }
+
+      //! \note Outside the lock: may call receive() recursively.
+      _receiver.async_recv (fhg::util::bind_this (this, &receive_messages::receive));
+    }
+
+    fhg::com::peer_t& _receiver;
+    std::size_t const _size;
+    std::size_t const _count;
+
+    std::mutex _guard;
+    std::condition_variable _all_received;
+    std::size_t _received {0};
+    std::size_t _received_with_wrong_size {0};
+    boost::system::error_code _receive_error;
+  };
+
+  //! \note Counts the completions of sends. Errors are only recorded
+  //! in the io threads and checked by wait() in the test thread.
+  class sent_messages
+  {
+  public:
+    sent_messages (std::size_t count)
+      : _count (count)
+    {}
+
+    fhg::com::peer_t::handler_t handler()
+    {
+      return [this] (boost::system::error_code const& ec)
+        {
+          std::lock_guard<std::mutex> const lock (_guard);
+
+          if (ec && !_send_error)
+          {
+            _send_error = ec;
+          }
+
+          if (++_sent == _count)
+          {
+            _all_sent.notify_one();
+          }
+        };
+    }
+
+    void wait()
+    {
+      std::unique_lock<std::mutex> lock (_guard);
+      _all_sent.wait (lock, [&] { return _sent == _count; });
+
+      BOOST_REQUIRE (!_send_error);
+    }
+
+  private:
+    std::size_t const _count;
+
+    std::mutex _guard;
+    std::condition_variable _all_sent;
+    std::size_t _sent {0};
+    boost::system::error_code _send_error;
+  };
+
+  enum class payload_buffers
+  {
+    //! the same buffer from the sender's pool for every message
+    pooled,
+    //! a newly allocated copy per message, as sending a std::string
+    //! did before buffers were pooled
+    unpooled,
+  };
+
+  void send_messages ( fhg::com::peer_t& sender
+                     , fhg::com::p2p::address_t const& address
+                     , std::size_t size
+                     , std::size_t count
+                     , sent_messages& sent
+                     , payload_buffers buffers = payload_buffers::pooled
+                     )
+  {
+    fhg::com::buffer payload (sender.buffers().get (size));
+    std::fill (payload.begin(), payload.end(), 'X');
+
+    for (std::size_t i (0); i < count; ++i)
+    {
+      sender.async_send
+        ( address
+        , buffers == payload_buffers::pooled
+          ? payload
+          : fhg::com::buffer (payload.data(), payload.size())
+        , sent.handler()
+        );
+    }
+  }
+
+  //! \note Sends count messages of the given size from one peer to
+  //! another and returns the time until all of them were received.
+  std::chrono::duration<double> transfer ( std::size_t size
+                                         , std::size_t count
+                                         , payload_buffers buffers
+                                         )
+  {
+    auto const receiver (make_peer (1));
+    auto const sender (make_peer (1));
+
+    receive_messages received (*receiver, size, count);
+    sent_messages sent (count);
+    auto const address (connect (*sender, *receiver));
+
+    auto const start (std::chrono::steady_clock::now());
+
+    send_messages (*sender, address, size, count, sent, buffers);
+    sent.wait();
+    received.wait();
+
+    return std::chrono::steady_clock::now() - start;
+  }
+
+  //! \note Pooling shall not cost anything measurable, so allow for
+  //! noise only.
+  constexpr double const tolerated_slowdown {0.9};
+}
+
+BOOST_DATA_TEST_CASE
+  ( below_64kib_message_rate_with_pooled_buffers_shall_not_be_lower
+  , powers_of_two (10, 15)
+  , size
+  )
+{
+  std::size_t const count (10000);
+
+  double const unpooled
+    (count / transfer (size, count, payload_buffers::unpooled).count());
+  double const pooled
+    (count / transfer (size, count, payload_buffers::pooled).count());
+
+  BOOST_TEST_MESSAGE ( size << " bytes: " << pooled << " messages/s pooled, "
+                     << unpooled << " messages/s unpooled"
+                     );
+  BOOST_REQUIRE_GE (pooled, tolerated_slowdown * unpooled);
+}
+
+BOOST_DATA_TEST_CASE
+  ( above_64kib_throughput_with_pooled_buffers_shall_not_be_lower
+  , powers_of_two (16, 26)
+  , size
+  )
+{
+  std::size_t const count (std::max<std::size_t> (4, (std::size_t (1) << 30) / size));
+
+  auto const throughput
+    ( [&] (payload_buffers buffers)
+      {
+        return double (count) * double (size) / double (1 << 20)
+          / transfer (size, count, buffers).count();
+      }
+    );
+
+  double const unpooled (throughput (payload_buffers::unpooled));
+  double const pooled (throughput (payload_buffers::pooled));
+
+  BOOST_TEST_MESSAGE ( size << " bytes: " << pooled << " MiB/s pooled, "
+                     << unpooled << " MiB/s unpooled"
+                     );
+  BOOST_REQUIRE_GE (pooled, tolerated_slowdown * unpooled);
+}
+
+namespace
+{
+  //! \note Sends from 16 peers to one receiver, each sender in its
+  //! own thread, and returns the receiver's message rate.
+  double many_connections_message_rate
+    ( std::size_t io_threads
+    , fhg::com::Certificates const& certificates
+    )
+  {
+    std::size_t const senders (16);
+    std::size_t const messages_per_sender (2000);
+    std::size_t const size (1 << 10);
+
+    auto const receiver (make_peer (io_threads, certificates));
+    receive_messages received (*receiver, size, senders * messages_per_sender);
+    sent_messages sent (senders * messages_per_sender);
+
+    std::list<std::unique_ptr<fhg::com::peer_t>> sending_peers;
+    std::list<fhg::com::p2p::address_t> addresses;
+    for (std::size_t i (0); i < senders; ++i)
+    {
+      sending_peers.emplace_back (make_peer (1, certificates));
+      addresses.emplace_back (connect (*sending_peers.back(), *receiver));
+    }
+
+    auto const start (std::chrono::steady_clock::now());
+
+    {
+      std::list<std::thread> sending_threads;
+      auto address (addresses.begin());
+      for (auto& sender : sending_peers)
+      {
+        sending_threads.emplace_back
+          ( [&sender, &sent, address, size, messages_per_sender]
+            {
+              send_messages
+                (*sender, *address, size, messages_per_sender, sent);
+            }
+          );
+        ++address;
+      }
+      for (auto& thread : sending_threads)
+      {
+        thread.join();
+      }
+    }
+
+    sent.wait();
+    received.wait();
+
+    std::chrono::duration<double> const duration
+      (std::chrono::steady_clock::now() - start);
+
+    return senders * messages_per_sender / duration.count();
+  }
+
+  std::size_t const io_threads_to_compare (4);
+
+  boost::test_tools::assertion_result enough_cores_for_senders_and_receiver
+    (boost::unit_test::test_unit_id)
+  {
+    //! \note the senders compete for cores with the receiver
+    boost::test_tools::assertion_result result
+      (std::thread::hardware_concurrency() >= 2 * io_threads_to_compare);
+    result.message() << "needs at least " << 2 * io_threads_to_compare
+                     << " hardware threads to observe a speedup";
+    return result;
+  }
+}
+
+//! \note With TLS, decrypting is the bulk of the receiver's work, which
+//! the io threads share between connections.
+BOOST_TEST_DECORATOR
+  (*boost::unit_test::precondition (enough_cores_for_senders_and_receiver))
+BOOST_DATA_TEST_CASE
+  ( many_connections_message_rate_shall_scale_with_io_threads
+  , certificates_data
+  , certificates
+  )
+{
+  double const single (many_connections_message_rate (1, certificates));
+  double const multiple
+    (many_connections_message_rate (io_threads_to_compare, certificates));
+
+  BOOST_TEST_MESSAGE ( (certificates ? "TLS: " : "plain: ")
+                     << single << " messages/s with 1 io thread, "
+                     << multiple << " messages/s with "
+                     << io_threads_to_compare << " io threads"
+                     );
+  BOOST_REQUIRE_GE (multiple, 1.5 * single);
+}
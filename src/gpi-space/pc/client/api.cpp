@@ -20,6 +20,7 @@
 #include <gpi-space/pc/type/flags.hpp>
 
 #include <fhg/assert.hpp>
+#include <util-generic/finally.hpp>
 #include <util-generic/print_exception.hpp>
 #include <util-generic/syscall.hpp>
 
@@ -28,6 +29,8 @@
 #include <boost/format.hpp>
 #include <boost/range/adaptor/map.hpp>
 
+#include <cstring>
+
 #include <sys/un.h>
 
 namespace
@@ -97,6 +100,8 @@ namespace gpi
           m_socket = -1;
 
           m_segments.clear();
+          m_local_handles.clear();
+          m_outstanding_memcpys.clear();
         }
       }
 
@@ -168,6 +173,27 @@ namespace gpi
         {
           proto::memory::message_t mem_msg (boost::get<proto::memory::message_t>(reply));
           proto::memory::alloc_reply_t alloc_rpl (boost::get<proto::memory::alloc_reply_t>(mem_msg));
+
+          bool const is_local
+            ( [&]
+              {
+                lock_type lock (m_mutex);
+                return m_segments.count (seg) != 0;
+              }()
+            );
+
+          if (is_local)
+          {
+            auto const descriptor (info (alloc_rpl.handle));
+
+            //! \note the segment might have been unregistered meanwhile
+            lock_type lock (m_mutex);
+            if (m_segments.count (seg))
+            {
+              m_local_handles.emplace (alloc_rpl.handle, descriptor);
+            }
+          }
+
           return alloc_rpl.handle;
         }
         catch (boost::bad_get const & ex)
@@ -184,6 +210,11 @@ namespace gpi
 
       void api_t::free (const gpi::pc::type::handle_id_t hdl)
       {
+        {
+          lock_type lock (m_mutex);
+          m_local_handles.erase (hdl);
+        }
+
         proto::memory::free_t rqst;
         rqst.handle = hdl;
 
@@ -310,6 +341,16 @@ namespace gpi
       void *
       api_t::ptr(const gpi::pc::type::handle_t h)
       {
+          {
+            lock_type lock (m_mutex);
+            auto const local (m_local_handles.find (h));
+            if (local != m_local_handles.end())
+            {
+              return m_segments.at (local->second.segment)->ptr<char>()
+                + local->second.offset;
+            }
+          }
+
           gpi::pc::type::handle::descriptor_t
             descriptor = info(h);
 
@@ -342,6 +383,10 @@ namespace gpi
         {
           proto::memory::message_t mem_msg (boost::get<proto::memory::message_t>(reply));
           proto::memory::memcpy_reply_t memcpy_rpl (boost::get<proto::memory::memcpy_reply_t>(mem_msg));
+
+          lock_type lock (m_mutex);
+          m_outstanding_memcpys.emplace (memcpy_rpl.memcpy_id);
+
           return memcpy_rpl.memcpy_id;
         }
         catch (boost::bad_get const & ex)
@@ -356,11 +401,93 @@ namespace gpi
         }
       }
 
+      char* api_t::local_ptr ( type::memory_location_t const& location
+                             , type::size_t amount
+                             ) const
+      {
+        auto const local (m_local_handles.find (location.handle));
+        if (local == m_local_handles.end())
+        {
+          return nullptr;
+        }
+
+        type::handle::descriptor_t const& descriptor (local->second);
+
+        //! \note same check and message as area_t::check_bounds
+        if (! ( location.offset < descriptor.size
+              && (location.offset + amount) <= descriptor.size
+              )
+           )
+        {
+          throw std::invalid_argument
+            ( ( boost::format ("out-of-bounds: access to %1%-handle %2%:"
+                              " range [%3%,%4%) is not withing [0,%5%)"
+                              )
+              % descriptor.id
+              % descriptor.name
+              % location.offset
+              % (location.offset + amount)
+              % descriptor.size
+              ).str()
+            );
+        }
+
+        return m_segments.at (descriptor.segment)->ptr<char>()
+          + descriptor.offset + location.offset;
+      }
+
+      void api_t::memcpy_and_wait ( type::memory_location_t const& dst
+                                  , type::memory_location_t const& src
+                                  , type::size_t const amount
+                                  )
+      {
+        {
+          lock_type lock (m_mutex);
+
+          //! \note a direct copy would overtake transfers still
+          //! queued in the server, which may touch the same memory
+          if ( m_outstanding_memcpys.empty()
+             && m_local_handles.count (dst.handle)
+             && m_local_handles.count (src.handle)
+             )
+          {
+            char* const dst_ptr (local_ptr (dst, amount));
+            char const* const src_ptr (local_ptr (src, amount));
+
+            //! \note keep mapped while copying unlocked
+            segment_ptr const dst_segment
+              (m_segments.at (m_local_handles.at (dst.handle).segment));
+            segment_ptr const src_segment
+              (m_segments.at (m_local_handles.at (src.handle).segment));
+
+            lock.unlock();
+
+            fhg::metrics::scoped_timer const transfer_timer
+              (_direct_transfer_duration);
+            _direct_transferred_bytes.increment (amount);
+
+            std::memmove (dst_ptr, src_ptr, amount);
+
+            return;
+          }
+        }
+
+        wait (memcpy (dst, src, amount));
+      }
+
       void api_t::wait (type::memcpy_id_t const& memcpy_id)
       {
         proto::memory::wait_t rqst;
         rqst.memcpy_id = memcpy_id;
 
+        FHG_UTIL_FINALLY
+          ( [&]
+            {
+              lock_type lock (m_mutex);
+              m_outstanding_memcpys.erase (memcpy_id);
+            }
+          );
+
         proto::message_t reply(communicate (proto::memory::message_t (rqst)));
 
         try
@@ -384,9 +511,13 @@ namespace gpi
       gpi::pc::type::segment_id_t
       api_t::register_segment( std::string const & name
                              , const gpi::pc::type::size_t sz
+                             , gpi::pc::segment::placement placement
                              )
       {
-        segment_ptr seg (new gpi::pc::segment::segment_t(name, sz));
+        segment_ptr seg
+          ( new gpi::pc::segment::segment_t
+              (name, sz, gpi::pc::type::segment::SEG_INVAL, placement)
+          );
 
         try
         {
@@ -411,6 +542,7 @@ namespace gpi
           proto::segment::register_t rqst;
           rqst.name = name;
           rqst.size = sz;
+          rqst.placement = seg->placement();
 
           proto::message_t rply (communicate (proto::segment::message_t (rqst)));
           try
@@ -487,6 +619,20 @@ namespace gpi
 
         // remove local
         lock_type lock (m_mutex);
+        for ( auto handle (m_local_handles.begin())
+            ; handle != m_local_handles.end()
+            ;
+            )
+        {
+          if (handle->second.segment == id)
+          {
+            handle = m_local_handles.erase (handle);
+          }
+          else
+          {
+            ++handle;
+          }
+        }
         m_segments.erase (id);
       }
 
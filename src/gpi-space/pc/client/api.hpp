@@ -17,10 +17,12 @@
 #pragma once
 
 #include <logging/stream_emitter.hpp>
+#include <metrics/registry.hpp>
 
 #include <gpi-space/pc/proto/message.hpp>
 #include <gpi-space/pc/segment/segment.hpp>
 #include <gpi-space/pc/type/flags.hpp>
+#include <gpi-space/pc/type/handle_descriptor.hpp>
 #include <gpi-space/pc/type/typedefs.hpp>
 #include <gpi-space/pc/type/memory_location.hpp>
 
@@ -33,6 +35,7 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -76,13 +79,14 @@ namespace gpi
         void wait (type::memcpy_id_t const&);
 
       public:
+        //! \note If both handles were allocated by this client in
+        //! segments registered by this client, the segments are
+        //! mapped into this process and the copy is done directly,
+        //! without a round trip to the server.
         void memcpy_and_wait ( type::memory_location_t const& dst
                              , type::memory_location_t const& src
                              , type::size_t const amount
-                             )
-        {
-          wait (memcpy (dst, src, amount));
-        }
+                             );
 
         std::function<double (std::string const&)>
         transfer_costs (std::list<std::pair<we::local::range, we::global::range>> const&);
@@ -94,6 +98,7 @@ namespace gpi
 
         gpi::pc::type::segment_id_t register_segment( std::string const & name
                                                     , const gpi::pc::type::size_t sz
+                                                    , gpi::pc::segment::placement = {}
                                                     );
         void unregister_segment(const gpi::pc::type::segment_id_t);
 
@@ -105,6 +110,11 @@ namespace gpi
         type::segment_id_t create_segment (std::string const& info);
         void delete_segment (type::segment_id_t);
 
+        //! \note requires m_mutex to be locked
+        char* local_ptr ( type::memory_location_t const&
+                        , type::size_t amount
+                        ) const;
+
         typedef std::recursive_mutex mutex_type;
         typedef std::unique_lock<mutex_type> lock_type;
 
@@ -114,6 +124,24 @@ namespace gpi
         mutable mutex_type m_mutex;
         int m_socket;
         segment_map_t m_segments;
+        //! handles allocated by this client in m_segments
+        std::map<type::handle_id_t, type::handle::descriptor_t> m_local_handles;
+        //! transfers started via memcpy() and not yet wait()ed for,
+        //! which direct copies must not overtake
+        std::set<type::memcpy_id_t> m_outstanding_memcpys;
+
+        fhg::metrics::counter& _direct_transferred_bytes
+          { fhg::metrics::process_registry().counter_for
+              ( "gspc_vmem_direct_transferred_bytes_total"
+              , "number of bytes copied by clients without the server"
+              )
+          };
+        fhg::metrics::histogram& _direct_transfer_duration
+          { fhg::metrics::process_registry().histogram_for
+              ( "gspc_vmem_direct_transfer_seconds"
+              , "time to execute a transfer without the server"
+              )
+          };
 
         friend struct remote_segment;
       };
@@ -255,6 +255,7 @@ namespace gpi
                                        , register_segment.name
                                        , register_segment.size
                                        , _memory_manager.handle_generator()
+                                       , register_segment.placement
                                        )
               );
 
@@ -523,6 +524,7 @@ namespace gpi
                            , std::string const & p
                            , fhg::vmem::gaspi_context& gaspi_context
                            , std::unique_ptr<fhg::rpc::service_tcp_provider_with_deferred_dispatcher> topology_rpc_server
+                           , std::size_t topology_broadcast_fan_out
                            )
         : _logger (logger)
         , m_path (p)
@@ -533,6 +535,7 @@ namespace gpi
         , _topology ( _memory_manager
                     , gaspi_context
                     , std::move (topology_rpc_server)
+                    , topology_broadcast_fan_out
                     )
       {
         fhg::util::nest_exceptions<std::runtime_error>
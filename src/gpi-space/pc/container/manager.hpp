@@ -45,6 +45,7 @@ namespace gpi
                   , std::string const & p
                   , fhg::vmem::gaspi_context&
                   , std::unique_ptr<fhg::rpc::service_tcp_provider_with_deferred_dispatcher> topology_rpc_server
+                  , std::size_t topology_broadcast_fan_out
                   );
 
         ~manager_t ();
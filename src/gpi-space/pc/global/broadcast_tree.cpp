@@ -0,0 +1,195 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <gpi-space/pc/global/broadcast_tree.hpp>
+
+#include <util-generic/cxx14/make_unique.hpp>
+#include <util-generic/wait_and_collect_exceptions.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace gpi
+{
+  namespace pc
+  {
+    namespace global
+    {
+      namespace
+      {
+        void require_valid ( std::size_t rank
+                           , std::size_t root
+                           , std::size_t number_of_nodes
+                           , std::size_t fan_out
+                           )
+        {
+          if (rank >= number_of_nodes || root >= number_of_nodes)
+          {
+            throw std::invalid_argument
+              ( "broadcast tree: rank " + std::to_string (rank)
+              + " or root " + std::to_string (root)
+              + " not in [0, " + std::to_string (number_of_nodes) + ")"
+              );
+          }
+          if (fan_out == 0)
+          {
+            throw std::invalid_argument ("broadcast tree: fan out is zero");
+          }
+        }
+      }
+
+      std::vector<std::size_t> children_in_broadcast_tree
+        ( std::size_t rank
+        , std::size_t root
+        , std::size_t number_of_nodes
+        , std::size_t fan_out
+        )
+      {
+        require_valid (rank, root, number_of_nodes, fan_out);
+
+        std::size_t const relative
+          ((rank + number_of_nodes - root) % number_of_nodes);
+
+        std::vector<std::size_t> children;
+
+        for ( std::size_t child (relative * fan_out + 1)
+            ; child <= relative * fan_out + fan_out && child < number_of_nodes
+            ; ++child
+            )
+        {
+          children.emplace_back ((child + root) % number_of_nodes);
+        }
+
+        return children;
+      }
+
+      std::size_t height_in_broadcast_tree
+        ( std::size_t rank
+        , std::size_t root
+        , std::size_t number_of_nodes
+        , std::size_t fan_out
+        )
+      {
+        require_valid (rank, root, number_of_nodes, fan_out);
+
+        std::size_t height (0);
+
+        //! \note the leftmost path is the longest one
+        for ( std::size_t relative
+                ((rank + number_of_nodes - root) % number_of_nodes)
+            ; relative * fan_out + 1 < number_of_nodes
+            ; relative = relative * fan_out + 1
+            )
+        {
+          ++height;
+        }
+
+        return height;
+      }
+
+      broadcast_tree::broadcast_tree
+          ( std::size_t rank
+          , std::size_t number_of_nodes
+          , std::size_t fan_out
+          , endpoint_of_rank endpoint_of_rank_
+          , std::chrono::milliseconds timeout
+          )
+        : _rank (rank)
+        , _number_of_nodes (number_of_nodes)
+        , _fan_out (fan_out)
+        , _endpoint_of_rank (std::move (endpoint_of_rank_))
+        , _timeout (timeout)
+        //! \note a broadcast uses at most fan_out connections concurrently
+        , _io_service (std::min<std::size_t> (fan_out, 8))
+      {
+        require_valid (_rank, _rank, _number_of_nodes, _fan_out);
+      }
+
+      fhg::rpc::remote_tcp_endpoint& broadcast_tree::lease_endpoint
+        (leased_endpoints& endpoints, std::size_t rank)
+      {
+        endpoint_ptr endpoint;
+
+        {
+          std::lock_guard<std::mutex> const _ (_endpoints_guard);
+
+          auto idle (_idle_endpoints.find (rank));
+
+          if (idle != _idle_endpoints.end() && !idle->second.empty())
+          {
+            endpoint = std::move (idle->second.back());
+            idle->second.pop_back();
+          }
+        }
+
+        if (!endpoint)
+        {
+          endpoint = fhg::util::cxx14::make_unique<fhg::rpc::remote_tcp_endpoint>
+            (_io_service, _endpoint_of_rank (rank));
+        }
+
+        endpoints.emplace_back (rank, std::move (endpoint));
+
+        return *endpoints.back().second;
+      }
+
+      void broadcast_tree::return_endpoints (leased_endpoints& endpoints)
+      {
+        std::lock_guard<std::mutex> const _ (_endpoints_guard);
+
+        for (auto& endpoint : endpoints)
+        {
+          _idle_endpoints[endpoint.first].emplace_back
+            (std::move (endpoint.second));
+        }
+
+        endpoints.clear();
+      }
+
+      void broadcast_tree::wait
+        (std::vector<std::future<void>>& results, std::size_t root) const
+      {
+        //! \note children wait for their children as well
+        auto const deadline
+          ( std::chrono::steady_clock::now()
+          + _timeout
+          * height_in_broadcast_tree (_rank, root, _number_of_nodes, _fan_out)
+          );
+
+        std::size_t fail_count (0);
+
+        for (std::future<void>& result : results)
+        {
+          if (result.wait_until (deadline) != std::future_status::ready)
+          {
+            ++fail_count;
+          }
+        }
+
+        if (fail_count)
+        {
+          throw std::runtime_error ( std::to_string (fail_count)
+                                   + " of "
+                                   + std::to_string (results.size())
+                                   + " operations timed out"
+                                   );
+        }
+
+        fhg::util::wait_and_collect_exceptions (results);
+      }
+    }
+  }
+}
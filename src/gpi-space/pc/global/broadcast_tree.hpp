@@ -0,0 +1,249 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <rpc/future.hpp>
+#include <rpc/remote_function.hpp>
+#include <rpc/remote_tcp_endpoint.hpp>
+
+#include <util-generic/finally.hpp>
+#include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
+#include <util-generic/wait_and_collect_exceptions.hpp>
+
+#include <boost/asio/spawn.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gpi
+{
+  namespace pc
+  {
+    namespace global
+    {
+      //! The ranks \a rank forwards a broadcast started by \a root to:
+      //! ranks are renumbered relative to \a root and arranged in a
+      //! complete \a fan_out-ary tree, so that a broadcast reaches all
+      //! ranks after ceil (log_fan_out (number_of_nodes)) hops and no
+      //! rank sends more than \a fan_out messages.
+      //! \note fan_out == number_of_nodes - 1 is the flat broadcast
+      std::vector<std::size_t> children_in_broadcast_tree
+        ( std::size_t rank
+        , std::size_t root
+        , std::size_t number_of_nodes
+        , std::size_t fan_out
+        );
+
+      //! Number of hops from \a rank to the farthest rank below it.
+      std::size_t height_in_broadcast_tree
+        ( std::size_t rank
+        , std::size_t root
+        , std::size_t number_of_nodes
+        , std::size_t fan_out
+        );
+
+      //! Forwards rpc calls along the broadcast tree. The functions
+      //! called have the root as first argument, so that the receiving
+      //! rank can forward the call to its own children.
+      class broadcast_tree : boost::noncopyable
+      {
+      public:
+        using endpoint_of_rank
+          = std::function<std::pair<std::string, unsigned short> (std::size_t)>;
+
+        //! \a timeout is the time allowed per hop
+        broadcast_tree ( std::size_t rank
+                       , std::size_t number_of_nodes
+                       , std::size_t fan_out
+                       , endpoint_of_rank
+                       , std::chrono::milliseconds timeout
+                       );
+
+        std::size_t rank() const
+        {
+          return _rank;
+        }
+
+        //! Call \a Description with \a root and \a args on all children
+        //! of this rank and wait for them to return.
+        //! \note throws the collected exceptions of all children,
+        //! including the ones they collected from their children
+        template<typename Description, typename... Args>
+          void forward (std::size_t root, Args const&... args);
+
+        //! Call \a Description with \a root and \a args on all children
+        //! of this rank, then apply \a local to \a args while the
+        //! children are busy and wait for both. To be used by yielding
+        //! service handlers receiving a broadcast.
+        //! \note the children are called first, so that a collective
+        //! operation in \a local finds all ranks taking part in it
+        //! \note \a local runs in its own thread and the children are
+        //! waited for via \a yield, so concurrent broadcasts do not
+        //! block the threads of the server
+        //! \note there is no deadline: the root waiting in forward()
+        //! enforces it for the whole tree
+        template<typename Description, typename Local, typename... Args>
+          void apply_and_forward ( boost::asio::yield_context yield
+                                 , Local&& local
+                                 , std::size_t root
+                                 , Args const&... args
+                                 );
+
+      private:
+        using endpoint_ptr = std::unique_ptr<fhg::rpc::remote_tcp_endpoint>;
+        using leased_endpoints = std::vector<std::pair<std::size_t, endpoint_ptr>>;
+
+        //! \note a connection is used by one call at a time: the
+        //! server handles the requests of a connection one after the
+        //! other, so concurrent broadcasts sharing it would wait for
+        //! each other and may deadlock on collective operations
+        fhg::rpc::remote_tcp_endpoint& lease_endpoint
+          (leased_endpoints&, std::size_t rank);
+        //! \note only called after all calls succeeded: the
+        //! connection of a timed out call might still be busy
+        void return_endpoints (leased_endpoints&);
+        void wait (std::vector<std::future<void>>&, std::size_t root) const;
+
+        std::size_t const _rank;
+        std::size_t const _number_of_nodes;
+        std::size_t const _fan_out;
+        endpoint_of_rank const _endpoint_of_rank;
+        std::chrono::milliseconds const _timeout;
+
+        fhg::util::scoped_boost_asio_io_service_with_threads _io_service;
+        std::mutex _endpoints_guard;
+        std::unordered_map<std::size_t, std::vector<endpoint_ptr>>
+          _idle_endpoints;
+      };
+
+      template<typename Description, typename... Args>
+        void broadcast_tree::forward (std::size_t root, Args const&... args)
+      {
+        leased_endpoints endpoints;
+        std::vector<std::future<void>> results;
+
+        for ( std::size_t child
+            : children_in_broadcast_tree
+                (_rank, root, _number_of_nodes, _fan_out)
+            )
+        {
+          results.emplace_back
+            ( fhg::rpc::remote_function<Description>
+                (lease_endpoint (endpoints, child)) (root, args...)
+            );
+        }
+
+        wait (results, root);
+
+        return_endpoints (endpoints);
+      }
+
+      template<typename Description, typename Local, typename... Args>
+        void broadcast_tree::apply_and_forward
+          ( boost::asio::yield_context yield
+          , Local&& local
+          , std::size_t root
+          , Args const&... args
+          )
+      {
+        leased_endpoints endpoints;
+        std::vector<fhg::rpc::future<void>> results;
+
+        for ( std::size_t child
+            : children_in_broadcast_tree
+                (_rank, root, _number_of_nodes, _fan_out)
+            )
+        {
+          //! \note keep going to not leave the other children without
+          //! their part of a collective operation
+          try
+          {
+            results.emplace_back
+              ( fhg::rpc::remote_function<Description, fhg::rpc::future>
+                  (lease_endpoint (endpoints, child)) (root, args...)
+              );
+          }
+          catch (...)
+          {
+            fhg::rpc::promise<void> failed (_io_service);
+            failed.set_exception (std::current_exception());
+            results.emplace_back (failed.get_future());
+          }
+        }
+
+        fhg::rpc::promise<void> local_done (_io_service);
+        fhg::rpc::future<void> local_done_future (local_done.get_future());
+        std::future<void> local_result
+          ( std::async ( std::launch::async
+                       , [&]
+                         {
+                           FHG_UTIL_FINALLY ([&] { local_done.set_value(); });
+
+                           local (args...);
+                         }
+                       )
+          );
+
+        local_done_future.get (yield);
+
+        std::vector<std::exception_ptr> exceptions;
+
+        try
+        {
+          local_result.get();
+        }
+        catch (...)
+        {
+          exceptions.emplace_back (std::current_exception());
+        }
+
+        for (fhg::rpc::future<void>& result : results)
+        {
+          try
+          {
+            result.get (yield);
+          }
+          catch (...)
+          {
+            exceptions.emplace_back (std::current_exception());
+          }
+        }
+
+        if (exceptions.empty())
+        {
+          return_endpoints (endpoints);
+        }
+        else if (exceptions.size() == 1)
+        {
+          std::rethrow_exception (exceptions.front());
+        }
+
+        fhg::util::throw_collected_exceptions (exceptions);
+      }
+    }
+  }
+}
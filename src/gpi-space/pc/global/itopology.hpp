@@ -20,6 +20,8 @@
 #include <gpi-space/pc/type/typedefs.hpp>
 #include <gpi-space/pc/type/handle.hpp>
 
+#include <vector>
+
 namespace gpi
 {
   namespace pc
@@ -44,6 +46,9 @@ namespace gpi
 
         virtual void free (const gpi::pc::type::handle_t) = 0;
 
+        //! batched variant: one collective operation for all handles
+        virtual void free (std::vector<gpi::pc::type::handle_t> const&) = 0;
+
         virtual void add_memory ( const gpi::pc::type::segment_id_t seg_id
                                 , std::string const & url
                                 ) = 0;
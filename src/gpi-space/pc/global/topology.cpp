@@ -22,7 +22,7 @@
 
 #include <util-generic/wait_and_collect_exceptions.hpp>
 
-#include <future>
+#include <chrono>
 
 namespace gpi
 {
@@ -33,49 +33,118 @@ namespace gpi
       topology_t::topology_t ( memory::manager_t& memory_manager
                              , fhg::vmem::gaspi_context& gaspi_context
                              , std::unique_ptr<fhg::rpc::service_tcp_provider_with_deferred_dispatcher> server
+                             , std::size_t broadcast_fan_out
                              )
         : _gaspi_context (gaspi_context)
+        , _broadcast ( _gaspi_context.rank()
+                     , _gaspi_context.number_of_nodes()
+                     , broadcast_fan_out
+                     , [this] (std::size_t rank)
+                       {
+                         return std::make_pair
+                           ( _gaspi_context.hostname_of_rank (rank)
+                           , _gaspi_context.communication_port_of_rank (rank)
+                           );
+                       }
+                     , std::chrono::seconds (30)
+                     )
         , _service_dispatcher()
         , _alloc ( _service_dispatcher
-                 , [&memory_manager] ( type::segment_id_t seg
-                                     , type::handle_t hdl
-                                     , type::offset_t offset
-                                     , type::size_t size
-                                     , type::size_t local_size
-                                     , std::string name
-                                     )
+                 , [&memory_manager, this] ( boost::asio::yield_context yield
+                                           , std::size_t root
+                                           , type::segment_id_t seg
+                                           , type::handle_t hdl
+                                           , type::offset_t off
+                                           , type::size_t sz
+                                           , type::size_t local_sz
+                                           , std::string name_s
+                                           )
                    {
-                     memory_manager.remote_alloc
-                       (seg, hdl, offset, size, local_size, name);
+                     _broadcast.apply_and_forward<alloc_desc>
+                       ( yield
+                       , [&memory_manager] ( type::segment_id_t segment
+                                           , type::handle_t handle
+                                           , type::offset_t offset
+                                           , type::size_t size
+                                           , type::size_t local_size
+                                           , std::string const& name
+                                           )
+                         {
+                           memory_manager.remote_alloc
+                             (segment, handle, offset, size, local_size, name);
+                         }
+                       , root
+                       , seg, hdl, off, sz, local_sz, name_s
+                       );
                    }
-                 , fhg::rpc::not_yielding
+                 , fhg::rpc::yielding
                  )
         , _free ( _service_dispatcher
-                , [&memory_manager] (type::handle_t hdl)
+                , [&memory_manager, this]
+                    ( boost::asio::yield_context yield
+                    , std::size_t root
+                    , std::vector<type::handle_t> handles
+                    )
                   {
-                    memory_manager.remote_free (hdl);
+                    _broadcast.apply_and_forward<free_desc>
+                      ( yield
+                      , [&memory_manager]
+                          (std::vector<type::handle_t> const& hdls)
+                        {
+                          fhg::util::apply_for_each_and_collect_exceptions
+                            ( hdls
+                            , [&memory_manager] (type::handle_t hdl)
+                              {
+                                memory_manager.remote_free (hdl);
+                              }
+                            );
+                        }
+                      , root
+                      , handles
+                      );
                   }
-                , fhg::rpc::not_yielding
+                , fhg::rpc::yielding
                 )
         , _add_memory ( _service_dispatcher
-                      , [&memory_manager, this] ( type::segment_id_t seg_id
+                      , [&memory_manager, this] ( boost::asio::yield_context yield
+                                                , std::size_t root
+                                                , type::segment_id_t seg_id
                                                 , std::string url_s
                                                 )
                         {
-                          memory_manager.remote_add_memory
-                            (seg_id, url_s, *this);
+                          _broadcast.apply_and_forward<add_memory_desc>
+                            ( yield
+                            , [&memory_manager, this]
+                                (type::segment_id_t seg, std::string const& url)
+                              {
+                                memory_manager.remote_add_memory
+                                  (seg, url, *this);
+                              }
+                            , root
+                            , seg_id
+                            , url_s
+                            );
                         }
-                      , fhg::rpc::not_yielding
+                      , fhg::rpc::yielding
                       )
         , _del_memory ( _service_dispatcher
-                      , [&memory_manager, this] (type::segment_id_t seg_id)
+                      , [&memory_manager, this] ( boost::asio::yield_context yield
+                                                , std::size_t root
+                                                , type::segment_id_t seg_id
+                                                )
                         {
-                          memory_manager.remote_del_memory (seg_id, *this);
+                          _broadcast.apply_and_forward<del_memory_desc>
+                            ( yield
+                            , [&memory_manager, this] (type::segment_id_t seg)
+                              {
+                                memory_manager.remote_del_memory (seg, *this);
+                              }
+                            , root
+                            , seg_id
+                            );
                         }
-                      , fhg::rpc::not_yielding
+                      , fhg::rpc::yielding
                       )
-        //! \todo count as parameter
-        , _client_io_service (8)
         , _server (std::move (server))
       {
         _server->set_dispatcher (&_service_dispatcher);
@@ -86,70 +155,20 @@ namespace gpi
         return 0 == _gaspi_context.rank();
       }
 
-      namespace
+      template<typename Description, typename... Args>
+        void topology_t::request (Args const&... args)
       {
-        template<typename Duration, typename ContainerOfFutures>
-          void wait_for (ContainerOfFutures& futures, Duration duration)
-        {
-          auto const deadline
-            (std::chrono::steady_clock::now() + duration);
-
-          std::size_t fail_count (0);
-
-          for (std::future<void>& future : futures)
-          {
-            if (future.wait_until (deadline) != std::future_status::ready)
-            {
-              ++fail_count;
-            }
-          }
-
-          if (fail_count)
-          {
-            throw std::runtime_error ( std::to_string (fail_count)
-                                     + " of "
-                                     + std::to_string (futures.size())
-                                     + " operations timed out"
-                                     );
-          }
-        }
+        _broadcast.forward<Description> (_broadcast.rank(), args...);
       }
 
-      template<typename Description, typename... Args>
-        void topology_t::request (Args&&... args)
+      void topology_t::free (const gpi::pc::type::handle_t hdl)
       {
-        //! \todo never store but just always create: calls are very rare
-        if (_others.empty())
-        {
-          for (std::size_t rank (0); rank < _gaspi_context.number_of_nodes(); ++rank)
-          {
-            if (_gaspi_context.rank() == rank)
-            {
-              continue;
-            }
-
-            _others.emplace_back
-              ( _client_io_service
-              , _gaspi_context.hostname_of_rank (rank)
-              , _gaspi_context.communication_port_of_rank (rank)
-              );
-          }
-        }
-
-        std::vector<std::future<void>> results;
-        for (fhg::rpc::remote_tcp_endpoint& other : _others)
-        {
-          results.emplace_back
-            (fhg::rpc::remote_function<Description> (other) (args...));
-        }
-
-        wait_for (results, std::chrono::seconds (30));
-        fhg::util::wait_and_collect_exceptions (results);
+        free (std::vector<type::handle_t> {hdl});
       }
 
-      void topology_t::free (const gpi::pc::type::handle_t hdl)
+      void topology_t::free (std::vector<gpi::pc::type::handle_t> const& hdls)
       {
-        request<free_desc> (hdl);
+        request<free_desc> (hdls);
       }
 
       void topology_t::alloc ( const gpi::pc::type::segment_id_t seg
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <gpi-space/pc/global/broadcast_tree.hpp>
 #include <gpi-space/pc/global/itopology.hpp>
 #include <gpi-space/pc/memory/manager.hpp>
 
@@ -25,15 +26,15 @@
 #include <rpc/service_dispatcher.hpp>
 #include <rpc/service_handler.hpp>
 
-#include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
-
 #include <vmem/gaspi_context.hpp>
 
 #include <boost/noncopyable.hpp>
+#include <boost/serialization/vector.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
-#include <list>
+#include <vector>
 
 namespace gpi
 {
@@ -48,6 +49,7 @@ namespace gpi
         topology_t ( memory::manager_t& memory_manager
                    , fhg::vmem::gaspi_context&
                    , std::unique_ptr<fhg::rpc::service_tcp_provider_with_deferred_dispatcher>
+                   , std::size_t broadcast_fan_out
                    );
 
 
@@ -63,6 +65,8 @@ namespace gpi
 
         virtual void free (const gpi::pc::type::handle_t) override;
 
+        virtual void free (std::vector<gpi::pc::type::handle_t> const&) override;
+
         virtual void add_memory ( const gpi::pc::type::segment_id_t seg_id
                                 , const std::string & url
                                 ) override;
@@ -73,8 +77,11 @@ namespace gpi
 
         fhg::vmem::gaspi_context& _gaspi_context;
 
+        //! \note all functions get the rank which started the
+        //! broadcast, to forward it to the children in the tree
         FHG_RPC_FUNCTION_DESCRIPTION ( alloc_desc
-                                     , void ( type::segment_id_t
+                                     , void ( std::size_t root
+                                            , type::segment_id_t
                                             , type::handle_t
                                             , type::offset_t
                                             , type::size_t size
@@ -83,31 +90,35 @@ namespace gpi
                                             )
                                      );
         FHG_RPC_FUNCTION_DESCRIPTION ( free_desc
-                                     , void (type::handle_t)
+                                     , void ( std::size_t root
+                                            , std::vector<type::handle_t>
+                                            )
                                      );
 
         FHG_RPC_FUNCTION_DESCRIPTION ( add_memory_desc
-                                     , void ( type::segment_id_t
+                                     , void ( std::size_t root
+                                            , type::segment_id_t
                                             , std::string
                                             )
                                      );
         FHG_RPC_FUNCTION_DESCRIPTION ( del_memory_desc
-                                     , void (type::segment_id_t)
+                                     , void ( std::size_t root
+                                            , type::segment_id_t
+                                            )
                                      );
 
+        broadcast_tree _broadcast;
+
         fhg::rpc::service_dispatcher _service_dispatcher;
         fhg::rpc::service_handler<alloc_desc> _alloc;
         fhg::rpc::service_handler<free_desc> _free;
         fhg::rpc::service_handler<add_memory_desc> _add_memory;
         fhg::rpc::service_handler<del_memory_desc> _del_memory;
 
-        fhg::util::scoped_boost_asio_io_service_with_threads _client_io_service;
-        std::list<fhg::rpc::remote_tcp_endpoint> _others;
-
         std::unique_ptr<fhg::rpc::service_tcp_provider_with_deferred_dispatcher> _server;
 
         template<typename Description, typename... Args>
-          void request (Args&&...);
+          void request (Args const&...);
       };
     }
   }
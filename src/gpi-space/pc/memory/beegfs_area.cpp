@@ -371,6 +371,21 @@ namespace gpi
         m_topology.free(hdl.id);
       }
 
+      void beegfs_area_t::free_hooks
+        (std::vector<gpi::pc::type::handle::descriptor_t> const& hdls)
+      {
+        std::vector<gpi::pc::type::handle_t> handles;
+        for (gpi::pc::type::handle::descriptor_t const& hdl : hdls)
+        {
+          handles.emplace_back (hdl.id);
+        }
+
+        if (!handles.empty())
+        {
+          m_topology.free (handles);
+        }
+      }
+
       bool
       beegfs_area_t::is_range_local( const gpi::pc::type::handle::descriptor_t &
                                 , const gpi::pc::type::offset_t
@@ -66,6 +66,8 @@ namespace gpi
 
         virtual void alloc_hook (const gpi::pc::type::handle::descriptor_t &) override;
         virtual void  free_hook (const gpi::pc::type::handle::descriptor_t &) override;
+        virtual void free_hooks
+          (std::vector<gpi::pc::type::handle::descriptor_t> const&) override;
 
       private:
         virtual bool is_range_local ( const gpi::pc::type::handle::descriptor_t &
@@ -175,6 +175,24 @@ namespace gpi
         }
       }
 
+      void gaspi_area_t::free_hooks
+        (std::vector<gpi::pc::type::handle::descriptor_t> const& hdls)
+      {
+        std::vector<gpi::pc::type::handle_t> global_handles;
+        for (gpi::pc::type::handle::descriptor_t const& hdl : hdls)
+        {
+          if (gpi::flag::is_set (hdl.flags, gpi::pc::F_GLOBAL))
+          {
+            global_handles.emplace_back (hdl.id);
+          }
+        }
+
+        if (!global_handles.empty())
+        {
+          _topology.free (global_handles);
+        }
+      }
+
       bool
       gaspi_area_t::is_range_local( const gpi::pc::type::handle::descriptor_t &hdl
                                   , const gpi::pc::type::offset_t begin
@@ -72,6 +72,8 @@ namespace gpi
 
         virtual void alloc_hook (const gpi::pc::type::handle::descriptor_t &) override;
         virtual void  free_hook (const gpi::pc::type::handle::descriptor_t &) override;
+        virtual void free_hooks
+          (std::vector<gpi::pc::type::handle::descriptor_t> const&) override;
 
         virtual std::packaged_task<void()> get_send_task
           ( area_t & src_area
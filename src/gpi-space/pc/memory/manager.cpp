@@ -87,7 +87,12 @@ namespace gpi
                     {
                       for (;;)
                       {
-                        _tasks.get()();
+                        auto task (_tasks.get());
+                        _queued_transfers.decrement();
+
+                        fhg::metrics::scoped_timer const transfer_timer
+                          (_transfer_duration);
+                        task();
                       }
                     }
                     catch (decltype (_tasks)::interrupted const&)
@@ -458,6 +463,8 @@ namespace gpi
         type::memcpy_id_t const memcpy_id (_next_memcpy_id++);
 
         _task_by_id.emplace (memcpy_id, task.get_future());
+        _queued_transfers.increment();
+        _transferred_bytes.increment (amount);
         _tasks.put (std::move (task));
 
         return memcpy_id;
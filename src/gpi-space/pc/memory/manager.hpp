@@ -21,6 +21,8 @@
 
 #include <logging/stream_emitter.hpp>
 
+#include <metrics/registry.hpp>
+
 #include <gpi-space/pc/type/typedefs.hpp>
 #include <gpi-space/pc/memory/memory_area.hpp>
 
@@ -153,6 +155,25 @@ namespace gpi
         handle_to_segment_t m_handle_to_segment;
         fhg::vmem::gaspi_context& _gaspi_context;
 
+        fhg::metrics::gauge& _queued_transfers
+          { fhg::metrics::process_registry().gauge_for
+              ( "gspc_vmem_queued_transfers"
+              , "number of transfers waiting for a transfer thread"
+              )
+          };
+        fhg::metrics::counter& _transferred_bytes
+          { fhg::metrics::process_registry().counter_for
+              ( "gspc_vmem_transferred_bytes_total"
+              , "number of bytes requested to be transferred"
+              )
+          };
+        fhg::metrics::histogram& _transfer_duration
+          { fhg::metrics::process_registry().histogram_for
+              ( "gspc_vmem_transfer_seconds"
+              , "time to execute a transfer"
+              )
+          };
+
         std::mutex _memcpy_task_guard;
         std::size_t _next_memcpy_id;
         fhg::util::interruptible_threadsafe_queue<std::packaged_task<void()>>
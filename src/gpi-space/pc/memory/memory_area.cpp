@@ -16,7 +16,8 @@
 
 #include <gpi-space/pc/memory/memory_area.hpp>
 
-#include <stack>
+#include <exception>
+#include <vector>
 
 #include <fhg/assert.hpp>
 
@@ -28,6 +29,7 @@
 #include <gpi-space/pc/type/handle.hpp>
 
 #include <util-generic/unreachable.hpp>
+#include <util-generic/wait_and_collect_exceptions.hpp>
 
 namespace gpi
 {
@@ -87,16 +89,18 @@ namespace gpi
       {
         lock_type lock (m_mutex);
 
-        while (! m_handles.empty())
+        std::vector<gpi::pc::type::handle_t> garbage_handles;
+        for (auto const& handle : m_handles)
+        {
+          garbage_handles.emplace_back (handle.first);
+        }
+
+        try
+        {
+          this->free (garbage_handles);
+        }
+        catch (std::exception const & ex)
         {
-          gpi::pc::type::handle::descriptor_t d (m_handles.begin()->second);
-          try
-          {
-            this->free ( d.id );
-          }
-          catch (std::exception const & ex)
-          {
-          }
         }
       }
 
@@ -104,7 +108,7 @@ namespace gpi
       void area_t::garbage_collect (const gpi::pc::type::process_id_t pid)
       {
         lock_type lock (m_mutex);
-        std::stack<gpi::pc::type::handle_t> garbage_handles;
+        std::vector<gpi::pc::type::handle_t> garbage_handles;
         for ( handle_descriptor_map_t::const_iterator hdl_it(m_handles.begin())
             ; hdl_it != m_handles.end()
             ; ++hdl_it
@@ -112,16 +116,11 @@ namespace gpi
         {
           if (hdl_it->second.creator == pid)
           {
-            garbage_handles.push (hdl_it->first);
+            garbage_handles.push_back (hdl_it->first);
           }
         }
 
-        while (!garbage_handles.empty())
-        {
-          gpi::pc::type::handle_t hdl (garbage_handles.top ());
-          garbage_handles.pop ();
-          this->free (hdl);
-        }
+        this->free (garbage_handles);
       }
 
       bool area_t::in_use () const
@@ -363,6 +362,57 @@ namespace gpi
       {
         lock_type lock (m_mutex);
 
+        const gpi::pc::type::handle::descriptor_t desc (free_locally (hdl));
+        try
+        {
+          free_hook (desc);
+        }
+        catch (std::exception const & ex)
+        {
+          std::throw_with_nested (std::runtime_error ("free_hook failed"));
+        }
+      }
+
+      void area_t::free (std::vector<gpi::pc::type::handle_t> const& hdls)
+      {
+        lock_type lock (m_mutex);
+
+        std::vector<gpi::pc::type::handle::descriptor_t> descs;
+        std::exception_ptr local_errors;
+
+        try
+        {
+          fhg::util::apply_for_each_and_collect_exceptions
+            ( hdls
+            , [&] (gpi::pc::type::handle_t hdl)
+              {
+                descs.emplace_back (free_locally (hdl));
+              }
+            );
+        }
+        catch (...)
+        {
+          local_errors = std::current_exception();
+        }
+
+        try
+        {
+          free_hooks (descs);
+        }
+        catch (std::exception const & ex)
+        {
+          std::throw_with_nested (std::runtime_error ("free_hook failed"));
+        }
+
+        if (local_errors)
+        {
+          std::rethrow_exception (local_errors);
+        }
+      }
+
+      gpi::pc::type::handle::descriptor_t
+        area_t::free_locally (const gpi::pc::type::handle_t hdl)
+      {
         if (m_handles.find(hdl) == m_handles.end())
         {
           throw std::runtime_error
@@ -385,14 +435,8 @@ namespace gpi
         m_mmgr.free (hdl, arena);
         m_handles.erase (hdl);
         update_descriptor_from_mmgr ();
-        try
-        {
-          free_hook (desc);
-        }
-        catch (std::exception const & ex)
-        {
-          std::throw_with_nested (std::runtime_error ("free_hook failed"));
-        }
+
+        return desc;
       }
 
       void area_t::remote_free (const gpi::pc::type::handle_t hdl)
@@ -94,6 +94,11 @@ namespace gpi
         void
         free (const gpi::pc::type::handle_t hdl);
 
+        //! \note the hooks are called once for all handles, so that
+        //! global handles are freed in a single collective operation
+        void
+        free (std::vector<gpi::pc::type::handle_t> const& hdls);
+
         void defrag (const gpi::pc::type::size_t free_at_least = 0);
 
         gpi::pc::type::segment::descriptor_t const &
@@ -215,6 +220,14 @@ namespace gpi
          */
         virtual void alloc_hook (const gpi::pc::type::handle::descriptor_t &) {}
         virtual void  free_hook (const gpi::pc::type::handle::descriptor_t &) {}
+        virtual void free_hooks
+          (std::vector<gpi::pc::type::handle::descriptor_t> const& hdls)
+        {
+          for (auto const& hdl : hdls)
+          {
+            free_hook (hdl);
+          }
+        }
       private:
         typedef std::recursive_mutex mutex_type;
         typedef std::unique_lock<mutex_type> lock_type;
@@ -226,6 +239,9 @@ namespace gpi
         void update_descriptor_from_mmgr ();
 
         void internal_alloc (gpi::pc::type::handle::descriptor_t &);
+        //! \note requires m_mutex to be locked, does not call hooks
+        gpi::pc::type::handle::descriptor_t
+          free_locally (const gpi::pc::type::handle_t hdl);
 
       protected:
         fhg::logging::stream_emitter& _logger;
@@ -41,13 +41,26 @@ namespace gpi
     {
       namespace detail
       {
-        static void unlink (std::string const &p)
+        static void unlink
+          ( std::string const &p
+          , boost::optional<boost::filesystem::path> const& hugetlbfs_path
+          )
         {
-          fhg::util::syscall::shm_unlink (p.c_str());
+          if (hugetlbfs_path)
+          {
+            fhg::util::syscall::unlink (hugetlbfs_path->string().c_str());
+          }
+          else
+          {
+            fhg::util::syscall::shm_unlink (p.c_str());
+          }
         }
 
         static void* open ( std::string const & path
+                          , boost::optional<boost::filesystem::path> const& hugetlbfs_path
+                          , segment::huge_page_policy huge_pages
                           , gpi::pc::type::size_t & size
+                          , gpi::pc::type::size_t & mapped_size
                           , const int open_flags
                           , const mode_t open_mode = 0
                           )
@@ -55,8 +68,11 @@ namespace gpi
           int fd (-1);
           void *ptr (nullptr);
 
-          fd = fhg::util::syscall::shm_open
-                 (path.c_str(), open_flags, open_mode);
+          fd = hugetlbfs_path
+            ? fhg::util::syscall::open
+                (hugetlbfs_path->string().c_str(), open_flags, open_mode)
+            : fhg::util::syscall::shm_open
+                (path.c_str(), open_flags, open_mode);
           FHG_UTIL_FINALLY ([fd] { fhg::util::syscall::close (fd); });
 
           int prot (0);
@@ -80,10 +96,12 @@ namespace gpi
             fhg::util::syscall::ftruncate (fd, size);
           }
 
+          mapped_size = segment::mapping_size (fd, huge_pages, size);
+
           try
           {
             ptr = fhg::util::syscall::mmap ( nullptr
-                                           , size
+                                           , mapped_size
                                            , prot
                                            , MAP_SHARED
                                            , fd
@@ -94,7 +112,7 @@ namespace gpi
           {
             if (open_flags & O_CREAT)
             {
-              detail::unlink (path.c_str ());
+              detail::unlink (path.c_str (), hugetlbfs_path);
             }
 
             throw;
@@ -117,6 +135,7 @@ namespace gpi
                              , type::name_t const& name
                              , const gpi::pc::type::size_t user_size
                              , handle_generator_t& handle_generator
+                             , segment::placement placement
                              )
         : area_t ( logger
                  , shm_area_t::area_type
@@ -127,6 +146,7 @@ namespace gpi
                  , handle_generator
                  )
         , m_ptr (nullptr)
+        , m_mapped_size (0)
       {
         if (name.empty())
         {
@@ -142,12 +162,34 @@ namespace gpi
 
         int open_flags = O_RDWR;
 
+        if (placement.huge_pages == segment::huge_page_policy::preallocated)
+        {
+          m_hugetlbfs_path = segment::hugetlbfs_path (m_path);
+
+          if (!m_hugetlbfs_path)
+          {
+            throw std::runtime_error
+              ( "shm segment " + m_path
+              + " is backed by preallocated huge pages"
+              + " but no hugetlbfs is mounted"
+              );
+          }
+        }
+
         m_ptr = detail::open ( m_path
+                             , m_hugetlbfs_path
+                             , placement.huge_pages
                              , size
+                             , m_mapped_size
                              , open_flags
                              , 0600
                              );
 
+        //! \note the memory policy is a property of the shared object
+        //! and has already been set by the creator, only the huge
+        //! page advice is per mapping
+        segment::apply ({placement.huge_pages, boost::none}, m_ptr, m_mapped_size);
+
         if (0 == user_size)
         {
           descriptor ().local_size = size;
@@ -159,9 +201,9 @@ namespace gpi
       {
         try
         {
-          detail::close (m_ptr, descriptor().local_size);
+          detail::close (m_ptr, m_mapped_size);
           m_ptr = nullptr;
-          detail::unlink (m_path);
+          detail::unlink (m_path, m_hugetlbfs_path);
         }
         catch (...)
         {
@@ -18,6 +18,10 @@
 
 #include <gpi-space/pc/type/segment_type.hpp>
 #include <gpi-space/pc/memory/memory_area.hpp>
+#include <gpi-space/pc/segment/placement.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
 
 namespace gpi
 {
@@ -35,6 +39,7 @@ namespace gpi
                    , type::name_t const&
                    , const gpi::pc::type::size_t size
                    , handle_generator_t&
+                   , segment::placement = {}
                    );
 
         ~shm_area_t ();
@@ -63,6 +68,8 @@ namespace gpi
 
         void *m_ptr;
         std::string m_path;
+        boost::optional<boost::filesystem::path> m_hugetlbfs_path;
+        gpi::pc::type::size_t m_mapped_size;
       };
     }
   }
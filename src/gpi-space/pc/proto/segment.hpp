@@ -23,6 +23,7 @@
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/variant.hpp>
 
+#include <gpi-space/pc/segment/placement.hpp>
 #include <gpi-space/pc/type/typedefs.hpp>
 #include <gpi-space/pc/type/segment_descriptor.hpp>
 
@@ -38,6 +39,8 @@ namespace gpi
         {
           gpi::pc::type::name_t  name;
           gpi::pc::type::size_t  size;
+          //! \note as actually used by the creator of the segment
+          gpi::pc::segment::placement placement;
 
         private:
           friend class boost::serialization::access;
@@ -46,6 +49,7 @@ namespace gpi
           {
             ar & BOOST_SERIALIZATION_NVP( name );
             ar & BOOST_SERIALIZATION_NVP( size );
+            ar & BOOST_SERIALIZATION_NVP( placement );
           }
         };
 
@@ -0,0 +1,162 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <gpi-space/pc/segment/placement.hpp>
+
+#include <boost/system/system_error.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <errno.h>
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+namespace gpi
+{
+  namespace pc
+  {
+    namespace segment
+    {
+      std::ostream& operator<< (std::ostream& os, huge_page_policy policy)
+      {
+        switch (policy)
+        {
+        case huge_page_policy::none: return os << "none";
+        case huge_page_policy::transparent: return os << "transparent";
+        case huge_page_policy::preallocated: return os << "preallocated";
+        }
+
+        throw std::logic_error ("invalid huge_page_policy");
+      }
+
+      std::istream& operator>> (std::istream& is, huge_page_policy& policy)
+      {
+        std::string word;
+        is >> word;
+
+        if (word == "none")
+        {
+          policy = huge_page_policy::none;
+        }
+        else if (word == "transparent")
+        {
+          policy = huge_page_policy::transparent;
+        }
+        else if (word == "preallocated")
+        {
+          policy = huge_page_policy::preallocated;
+        }
+        else
+        {
+          is.setstate (std::ios::failbit);
+        }
+
+        return is;
+      }
+
+      placement::placement
+          (huge_page_policy huge_pages_, boost::optional<unsigned int> numa_node_)
+        : huge_pages (huge_pages_)
+        , numa_node (numa_node_)
+      {}
+
+      boost::optional<boost::filesystem::path> hugetlbfs_path
+        (std::string const& segment_name)
+      {
+        std::ifstream mounts ("/proc/mounts");
+
+        std::string line;
+        while (std::getline (mounts, line))
+        {
+          std::istringstream fields (line);
+          std::string device;
+          std::string mount_point;
+          std::string type;
+
+          if ((fields >> device >> mount_point >> type) && type == "hugetlbfs")
+          {
+            return boost::filesystem::path (mount_point)
+              / ("gpispace-" + segment_name.substr (segment_name.find_first_not_of ('/')));
+          }
+        }
+
+        return boost::none;
+      }
+
+      std::size_t mapping_size
+        (int fd, huge_page_policy huge_pages, std::size_t size)
+      {
+        if (huge_pages != huge_page_policy::preallocated)
+        {
+          return size;
+        }
+
+        struct statfs fs;
+        if (::fstatfs (fd, &fs) != 0)
+        {
+          throw boost::system::system_error
+            (boost::system::error_code (errno, boost::system::system_category()));
+        }
+
+        std::size_t const huge_page_size (fs.f_bsize);
+
+        return (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+      }
+
+      void apply (placement const& placement, void* address, std::size_t size)
+      {
+        if (placement.huge_pages == huge_page_policy::transparent)
+        {
+          //! \note best effort, see header
+          ::madvise (address, size, MADV_HUGEPAGE);
+        }
+
+        if (placement.numa_node)
+        {
+          std::size_t const bits_per_word (8 * sizeof (unsigned long));
+          std::vector<unsigned long> nodemask
+            (*placement.numa_node / bits_per_word + 1, 0);
+          nodemask[*placement.numa_node / bits_per_word]
+            |= 1UL << (*placement.numa_node % bits_per_word);
+
+          if ( ::syscall ( SYS_mbind
+                         , address
+                         , size
+                         , MPOL_BIND
+                         , nodemask.data()
+                         , nodemask.size() * bits_per_word + 1
+                         , MPOL_MF_MOVE
+                         ) != 0
+             )
+          {
+            throw boost::system::system_error
+              ( boost::system::error_code (errno, boost::system::system_category())
+              , "binding segment to NUMA node "
+              + std::to_string (*placement.numa_node)
+              );
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,87 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/optional.hpp>
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+namespace gpi
+{
+  namespace pc
+  {
+    namespace segment
+    {
+      enum class huge_page_policy
+      {
+        //! regular pages
+        none,
+        //! ask the kernel to back the segment with transparent huge
+        //! pages, effective only if shmem_enabled allows advising
+        transparent,
+        //! back the segment by a file on hugetlbfs, i.e. by huge pages
+        //! reserved by the administrator, falling back to transparent
+        //! if there is no hugetlbfs or not enough reserved pages
+        preallocated,
+      };
+
+      std::ostream& operator<< (std::ostream&, huge_page_policy);
+      //! \note for program_options: none, transparent, preallocated
+      std::istream& operator>> (std::istream&, huge_page_policy&);
+
+      //! How the memory of a shared memory segment is placed.
+      struct placement
+      {
+        huge_page_policy huge_pages = huge_page_policy::none;
+        //! bind the pages of the segment to this NUMA node
+        boost::optional<unsigned int> numa_node;
+
+        placement() = default;
+        placement (huge_page_policy, boost::optional<unsigned int>);
+
+        template<typename Archive>
+          void serialize (Archive& ar, unsigned int)
+        {
+          ar & BOOST_SERIALIZATION_NVP (huge_pages);
+          ar & BOOST_SERIALIZATION_NVP (numa_node);
+        }
+      };
+
+      //! The hugetlbfs file backing a segment with preallocated huge
+      //! pages, or none if no hugetlbfs is mounted.
+      boost::optional<boost::filesystem::path> hugetlbfs_path
+        (std::string const& segment_name);
+
+      //! \note mappings of files on hugetlbfs have to be multiples of
+      //! the huge page size
+      std::size_t mapping_size
+        (int fd, huge_page_policy, std::size_t size);
+
+      //! Advise transparent huge pages and bind to the NUMA node as
+      //! requested, for an existing mapping. Pages already faulted in
+      //! are moved to the node if possible.
+      //! \note Failing to advise is ignored: the kernel might not
+      //! support huge pages for shared memory. Failing to bind throws.
+      void apply (placement const&, void* address, std::size_t size);
+    }
+  }
+}
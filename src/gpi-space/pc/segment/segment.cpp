@@ -37,6 +37,18 @@ namespace gpi
   {
     namespace segment
     {
+      namespace
+      {
+        struct close_on_scope_exit
+        {
+          ~close_on_scope_exit()
+          {
+            fhg::util::syscall::close (_fd);
+          }
+          int _fd;
+        };
+      }
+
       segment_t::~segment_t()
       {
           close ();
@@ -45,8 +57,11 @@ namespace gpi
       segment_t::segment_t ( std::string const & name
                            , const type::size_t sz
                            , const type::segment_id_t id
+                           , segment::placement placement
                            )
-        : m_ptr (nullptr)
+        : m_placement (placement)
+        , m_mapped_size (sz)
+        , m_ptr (nullptr)
       {
         if (name.empty())
           throw std::runtime_error ("invalid name argument to segment_t(): name must not be empty");
@@ -58,10 +73,71 @@ namespace gpi
         m_descriptor.local_size = sz;
         m_descriptor.avail = sz;
         m_descriptor.id = id;
+
+        if (m_placement.huge_pages == huge_page_policy::preallocated)
+        {
+          m_hugetlbfs_path = hugetlbfs_path (this->name());
+        }
+      }
+
+      int segment_t::open_hugetlbfs (int flags, mode_t mode)
+      {
+        return fhg::util::syscall::open
+          (m_hugetlbfs_path->string().c_str(), flags, mode);
+      }
+
+      void segment_t::attach (int fd)
+      {
+        m_ptr = fhg::util::syscall::mmap ( nullptr
+                                         , m_mapped_size
+                                         , PROT_READ | PROT_WRITE
+                                         , MAP_SHARED
+                                         , fd
+                                         , 0
+                                         );
+
+        apply (m_placement, m_ptr, m_mapped_size);
       }
 
       void segment_t::create (const mode_t mode)
       {
+        if (m_hugetlbfs_path)
+        {
+          //! \note reserved huge pages are a scarce resource: if there
+          //! are not enough of them left, mmap fails with ENOMEM
+          try
+          {
+            int const fd
+              (open_hugetlbfs (O_RDWR | O_CREAT | O_EXCL, mode));
+            close_on_scope_exit const _ {fd};
+
+            try
+            {
+              m_mapped_size = mapping_size (fd, m_placement.huge_pages, size());
+              fhg::util::syscall::ftruncate (fd, m_mapped_size);
+              attach (fd);
+            }
+            catch (...)
+            {
+              close();
+              fhg::util::syscall::unlink (m_hugetlbfs_path->string().c_str());
+              throw;
+            }
+
+            return;
+          }
+          catch (boost::system::system_error const&)
+          {
+            m_hugetlbfs_path = boost::none;
+            m_mapped_size = size();
+            m_placement.huge_pages = huge_page_policy::transparent;
+          }
+        }
+        else if (m_placement.huge_pages == huge_page_policy::preallocated)
+        {
+          m_placement.huge_pages = huge_page_policy::transparent;
+        }
+
         int fd (-1);
 
         try
@@ -76,14 +152,7 @@ namespace gpi
             );
         }
 
-        struct close_on_scope_exit
-        {
-          ~close_on_scope_exit()
-          {
-            fhg::util::syscall::close (_fd);
-          }
-          int _fd;
-        } _ = {fd};
+        close_on_scope_exit const _ {fd};
 
         try
         {
@@ -101,13 +170,7 @@ namespace gpi
 
         try
         {
-          m_ptr = fhg::util::syscall::mmap ( nullptr
-                                           , size()
-                                           , PROT_READ | PROT_WRITE
-                                           , MAP_SHARED
-                                           , fd
-                                           , 0
-                                           );
+          attach (fd);
         }
         catch (boost::system::system_error const&)
         {
@@ -124,7 +187,8 @@ namespace gpi
 
         try
         {
-          fd = fhg::util::syscall::shm_open (name().c_str(), O_RDWR, 0);
+          fd = m_hugetlbfs_path ? open_hugetlbfs (O_RDWR, 0)
+            : fhg::util::syscall::shm_open (name().c_str(), O_RDWR, 0);
         }
         catch (boost::system::system_error const& se)
         {
@@ -134,24 +198,12 @@ namespace gpi
             );
         }
 
-        struct close_on_scope_exit
-        {
-          ~close_on_scope_exit()
-          {
-            fhg::util::syscall::close (_fd);
-          }
-          int _fd;
-        } _ = {fd};
+        close_on_scope_exit const _ {fd};
 
         try
         {
-          m_ptr = fhg::util::syscall::mmap ( nullptr
-                                           , size()
-                                           , PROT_READ | PROT_WRITE
-                                           , MAP_SHARED
-                                           , fd
-                                           , 0
-                                           );
+          m_mapped_size = mapping_size (fd, m_placement.huge_pages, size());
+          attach (fd);
         }
         catch (boost::system::system_error const& se)
         {
@@ -166,14 +218,21 @@ namespace gpi
       {
         if (m_ptr)
         {
-          fhg::util::syscall::munmap (m_ptr, size());
+          fhg::util::syscall::munmap (m_ptr, m_mapped_size);
           m_ptr = nullptr;
         }
       }
 
       void segment_t::unlink ()
       {
-        fhg::util::syscall::shm_unlink(name().c_str());
+        if (m_hugetlbfs_path)
+        {
+          fhg::util::syscall::unlink (m_hugetlbfs_path->string().c_str());
+        }
+        else
+        {
+          fhg::util::syscall::shm_unlink(name().c_str());
+        }
       }
 
       void *segment_t::ptr ()
@@ -17,8 +17,11 @@
 #pragma once
 
 #include <string>
+#include <boost/filesystem/path.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
 
+#include <gpi-space/pc/segment/placement.hpp>
 #include <gpi-space/pc/type/segment_descriptor.hpp>
 
 namespace gpi
@@ -33,6 +36,7 @@ namespace gpi
         segment_t ( std::string const & name
                   , const type::size_t sz
                   , const type::segment_id_t id = type::segment::SEG_INVAL
+                  , segment::placement = {}
                   );
 
         ~segment_t ();
@@ -46,6 +50,9 @@ namespace gpi
         void assign_id (const type::segment_id_t);
         type::segment_id_t id () const { return m_descriptor.id; }
         type::size_t size () const { return m_descriptor.local_size; }
+        //! \note after create(), the placement actually used: requested
+        //! preallocated huge pages fall back to transparent ones
+        segment::placement const& placement() const { return m_placement; }
 
         type::segment::descriptor_t const & descriptor() const { return m_descriptor; }
         type::segment::descriptor_t & descriptor() { return m_descriptor; }
@@ -56,7 +63,13 @@ namespace gpi
         void *ptr ();
         const void *ptr () const;
       private:
+        int open_hugetlbfs (int flags, mode_t mode);
+        void attach (int fd);
+
         gpi::pc::type::segment::descriptor_t m_descriptor;
+        segment::placement m_placement;
+        boost::optional<boost::filesystem::path> m_hugetlbfs_path;
+        type::size_t m_mapped_size;
         void *m_ptr;
       };
     }
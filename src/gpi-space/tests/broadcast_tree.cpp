@@ -0,0 +1,353 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <gpi-space/pc/global/broadcast_tree.hpp>
+
+#include <rpc/function_description.hpp>
+#include <rpc/service_dispatcher.hpp>
+#include <rpc/service_handler.hpp>
+#include <rpc/service_tcp_provider.hpp>
+
+#include <util-generic/connectable_to_address_string.hpp>
+#include <util-generic/cxx14/make_unique.hpp>
+#include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/require_exception.hpp>
+#include <util-generic/wait_and_collect_exceptions.hpp>
+
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gpi
+{
+  namespace pc
+  {
+    namespace global
+    {
+      BOOST_DATA_TEST_CASE
+        ( every_rank_but_the_root_is_reached_exactly_once
+        , boost::unit_test::data::make ({1, 2, 3, 7, 16, 33})
+        * boost::unit_test::data::make ({1, 2, 3, 4, 64})
+        , number_of_nodes
+        , fan_out
+        )
+      {
+        std::size_t const n (number_of_nodes);
+
+        for (std::size_t root (0); root < n; ++root)
+        {
+          std::vector<std::size_t> reached (n, 0);
+          std::size_t max_depth (0);
+
+          std::list<std::pair<std::size_t, std::size_t>> pending {{root, 0}};
+          while (!pending.empty())
+          {
+            std::size_t const rank (pending.front().first);
+            std::size_t const depth (pending.front().second);
+            pending.pop_front();
+
+            max_depth = std::max (max_depth, depth);
+
+            auto const children
+              (children_in_broadcast_tree (rank, root, n, fan_out));
+
+            BOOST_REQUIRE_LE (children.size(), std::size_t (fan_out));
+
+            for (std::size_t child : children)
+            {
+              ++reached.at (child);
+              pending.emplace_back (child, depth + 1);
+            }
+          }
+
+          for (std::size_t rank (0); rank < n; ++rank)
+          {
+            BOOST_REQUIRE_EQUAL (reached[rank], std::size_t (rank == root ? 0 : 1));
+          }
+
+          BOOST_REQUIRE_EQUAL
+            (height_in_broadcast_tree (root, root, n, fan_out), max_depth);
+        }
+      }
+
+      BOOST_AUTO_TEST_CASE (height_is_logarithmic_in_number_of_nodes)
+      {
+        BOOST_REQUIRE_EQUAL (height_in_broadcast_tree (0, 0, 1, 4), 0);
+        BOOST_REQUIRE_EQUAL (height_in_broadcast_tree (0, 0, 5, 4), 1);
+        BOOST_REQUIRE_EQUAL (height_in_broadcast_tree (0, 0, 6, 4), 2);
+        BOOST_REQUIRE_EQUAL (height_in_broadcast_tree (0, 0, 1024, 2), 10);
+        BOOST_REQUIRE_EQUAL (height_in_broadcast_tree (3, 3, 1024, 1023), 1);
+      }
+
+      BOOST_AUTO_TEST_CASE (invalid_arguments_are_rejected)
+      {
+        fhg::util::testing::require_exception
+          ( [] { children_in_broadcast_tree (4, 0, 4, 2); }
+          , std::invalid_argument
+              ("broadcast tree: rank 4 or root 0 not in [0, 4)")
+          );
+        fhg::util::testing::require_exception
+          ( [] { children_in_broadcast_tree (0, 0, 4, 0); }
+          , std::invalid_argument ("broadcast tree: fan out is zero")
+          );
+      }
+
+      namespace
+      {
+        FHG_RPC_FUNCTION_DESCRIPTION
+          (visit, void (std::size_t root, std::string payload));
+
+        //! \note every rank has its own server and clients, like the
+        //! gpi-space processes on different nodes
+        struct rank
+        {
+          rank ( std::size_t rank_
+               , std::size_t number_of_nodes
+               , std::size_t fan_out
+               , std::vector<unsigned short> const& ports
+               , std::function<void (std::size_t, std::string const&)> on_visit
+               )
+            : _broadcast
+                ( rank_
+                , number_of_nodes
+                , fan_out
+                , [&ports] (std::size_t r)
+                  {
+                    return std::make_pair (std::string ("localhost"), ports.at (r));
+                  }
+                , std::chrono::seconds (5)
+                )
+            , _visit
+                ( _service_dispatcher
+                , [this, on_visit] ( boost::asio::yield_context yield
+                                   , std::size_t root
+                                   , std::string payload
+                                   )
+                  {
+                    _broadcast.apply_and_forward<visit>
+                      ( yield
+                      , [this, &on_visit] (std::string const& p)
+                        {
+                          on_visit (_broadcast.rank(), p);
+                        }
+                      , root
+                      , payload
+                      );
+                  }
+                , fhg::rpc::yielding
+                )
+            //! \note a single thread: a handler blocking it would
+            //! stall every other broadcast passing this rank
+            , _io_service (1)
+            , _server (_io_service, _service_dispatcher)
+          {}
+
+          broadcast_tree _broadcast;
+          fhg::rpc::service_dispatcher _service_dispatcher;
+          fhg::rpc::service_handler<visit> _visit;
+          fhg::util::scoped_boost_asio_io_service_with_threads _io_service;
+          fhg::rpc::service_tcp_provider _server;
+        };
+      }
+
+      BOOST_DATA_TEST_CASE
+        ( broadcast_over_rpc_reaches_every_rank_once
+        , boost::unit_test::data::make ({1, 2, 3, 8})
+        , fan_out
+        )
+      {
+        std::size_t const number_of_nodes (9);
+
+        std::mutex visits_guard;
+        std::vector<std::vector<std::string>> visits (number_of_nodes);
+
+        std::vector<unsigned short> ports (number_of_nodes);
+        std::vector<std::unique_ptr<rank>> ranks;
+        for (std::size_t r (0); r < number_of_nodes; ++r)
+        {
+          ranks.emplace_back
+            ( fhg::util::cxx14::make_unique<rank>
+                ( r, number_of_nodes, fan_out, ports
+                , [&] (std::size_t visited, std::string const& payload)
+                  {
+                    std::lock_guard<std::mutex> const _ (visits_guard);
+                    visits.at (visited).emplace_back (payload);
+                  }
+                )
+            );
+          ports[r] = ranks.back()->_server.local_endpoint().port();
+        }
+
+        for (std::size_t root (0); root < number_of_nodes; ++root)
+        {
+          std::string const payload ("from " + std::to_string (root));
+
+          ranks.at (root)->_broadcast.forward<visit> (root, payload);
+
+          for (std::size_t r (0); r < number_of_nodes; ++r)
+          {
+            BOOST_REQUIRE_EQUAL
+              (visits[r].size(), r <= root ? root : root + 1);
+            if (r != root)
+            {
+              BOOST_REQUIRE_EQUAL (visits[r].back(), payload);
+            }
+          }
+        }
+      }
+
+      BOOST_AUTO_TEST_CASE (failures_below_are_reported_to_the_root)
+      {
+        std::size_t const number_of_nodes (7);
+
+        std::vector<unsigned short> ports (number_of_nodes);
+        std::vector<std::unique_ptr<rank>> ranks;
+        for (std::size_t r (0); r < number_of_nodes; ++r)
+        {
+          ranks.emplace_back
+            ( fhg::util::cxx14::make_unique<rank>
+                ( r, number_of_nodes, 2, ports
+                , [] (std::size_t visited, std::string const&)
+                  {
+                    if (visited == 5)
+                    {
+                      throw std::runtime_error ("rank 5 failed");
+                    }
+                  }
+                )
+            );
+          ports[r] = ranks.back()->_server.local_endpoint().port();
+        }
+
+        BOOST_REQUIRE_THROW
+          (ranks.at (0)->_broadcast.forward<visit> (0, ""), std::exception);
+      }
+
+      //! \note stands in for a collective operation like the gaspi
+      //! segment creation in add_memory: nobody returns before all
+      //! \a expected ranks entered it
+      //! \note not in an anonymous namespace, as the test cases
+      //! capture it in lambdas (-Wsubobject-linkage)
+      struct barrier
+      {
+        void arrive_and_wait (std::string const& key, std::size_t expected)
+        {
+          std::unique_lock<std::mutex> lock (_guard);
+
+          ++_arrived[key];
+          _arrival.notify_all();
+
+          if (!_arrival.wait_for
+                ( lock
+                , std::chrono::seconds (10)
+                , [&] { return _arrived[key] == expected; }
+                )
+             )
+          {
+            throw std::runtime_error ("barrier " + key + " timed out");
+          }
+        }
+
+      private:
+        std::mutex _guard;
+        std::condition_variable _arrival;
+        std::map<std::string, std::size_t> _arrived;
+      };
+
+      BOOST_DATA_TEST_CASE
+        ( children_are_called_before_the_local_part_blocks
+        , boost::unit_test::data::make ({1, 2, 3})
+        , fan_out
+        )
+      {
+        std::size_t const number_of_nodes (9);
+
+        barrier collective;
+
+        std::vector<unsigned short> ports (number_of_nodes);
+        std::vector<std::unique_ptr<rank>> ranks;
+        for (std::size_t r (0); r < number_of_nodes; ++r)
+        {
+          ranks.emplace_back
+            ( fhg::util::cxx14::make_unique<rank>
+                ( r, number_of_nodes, fan_out, ports
+                , [&] (std::size_t, std::string const& payload)
+                  {
+                    collective.arrive_and_wait (payload, number_of_nodes - 1);
+                  }
+                )
+            );
+          ports[r] = ranks.back()->_server.local_endpoint().port();
+        }
+
+        ranks.at (0)->_broadcast.forward<visit> (0, "collective");
+      }
+
+      BOOST_AUTO_TEST_CASE (concurrent_broadcasts_do_not_starve_the_servers)
+      {
+        std::size_t const number_of_nodes (9);
+
+        barrier collective;
+
+        std::vector<unsigned short> ports (number_of_nodes);
+        std::vector<std::unique_ptr<rank>> ranks;
+        for (std::size_t r (0); r < number_of_nodes; ++r)
+        {
+          ranks.emplace_back
+            ( fhg::util::cxx14::make_unique<rank>
+                ( r, number_of_nodes, 2, ports
+                , [&] (std::size_t, std::string const& payload)
+                  {
+                    collective.arrive_and_wait (payload, number_of_nodes - 1);
+                  }
+                )
+            );
+          ports[r] = ranks.back()->_server.local_endpoint().port();
+        }
+
+        std::vector<std::future<void>> broadcasts;
+        for (std::size_t root (0); root < number_of_nodes; ++root)
+        {
+          broadcasts.emplace_back
+            ( std::async
+                ( std::launch::async
+                , [&ranks, root]
+                  {
+                    ranks.at (root)->_broadcast.forward<visit>
+                      (root, "from " + std::to_string (root));
+                  }
+                )
+            );
+        }
+
+        fhg::util::wait_and_collect_exceptions (broadcasts);
+      }
+    }
+  }
+}
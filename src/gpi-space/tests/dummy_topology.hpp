@@ -37,6 +37,9 @@ namespace gpi
       virtual void free (const gpi::pc::type::handle_t) override
       {}
 
+      virtual void free (std::vector<gpi::pc::type::handle_t> const&) override
+      {}
+
       virtual void add_memory ( const gpi::pc::type::segment_id_t
                      , const std::string &
                      ) override
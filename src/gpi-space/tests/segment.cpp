@@ -22,6 +22,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <string>
 
 BOOST_AUTO_TEST_CASE (sequence_of_create_close_unlink_does_not_throw)
@@ -36,3 +37,90 @@ BOOST_AUTO_TEST_CASE (sequence_of_create_close_unlink_does_not_throw)
 
   seg.close();
 }
+
+namespace
+{
+  std::string unique_segment_name (std::string const& suffix)
+  {
+    return "seg-test-" + boost::lexical_cast<std::string> (getpid())
+      + "-" + suffix;
+  }
+}
+
+BOOST_AUTO_TEST_CASE (transparent_huge_pages_are_best_effort)
+{
+  gpi::pc::segment::segment_t seg
+    ( unique_segment_name ("transparent")
+    , 4 << 20
+    , gpi::pc::type::segment::SEG_INVAL
+    , {gpi::pc::segment::huge_page_policy::transparent, boost::none}
+    );
+
+  seg.create();
+  FHG_UTIL_FINALLY ([&] { seg.unlink(); });
+
+  BOOST_REQUIRE
+    ( seg.placement().huge_pages
+    == gpi::pc::segment::huge_page_policy::transparent
+    );
+
+  std::fill_n (seg.ptr<char>(), seg.size(), 'x');
+
+  seg.close();
+}
+
+BOOST_AUTO_TEST_CASE (preallocated_huge_pages_fall_back_to_transparent_ones)
+{
+  gpi::pc::segment::segment_t seg
+    ( unique_segment_name ("preallocated")
+    , 1024
+    , gpi::pc::type::segment::SEG_INVAL
+    , {gpi::pc::segment::huge_page_policy::preallocated, boost::none}
+    );
+
+  seg.create();
+  FHG_UTIL_FINALLY ([&] { seg.unlink(); });
+
+  //! \note depends on hugetlbfs being mounted with enough reserved
+  //! pages, but either way the segment is usable
+  BOOST_REQUIRE
+    ( seg.placement().huge_pages
+    != gpi::pc::segment::huge_page_policy::none
+    );
+
+  std::fill_n (seg.ptr<char>(), seg.size(), 'x');
+
+  gpi::pc::segment::segment_t other
+    ( seg.name()
+    , seg.size()
+    , gpi::pc::type::segment::SEG_INVAL
+    , seg.placement()
+    );
+  other.open();
+
+  BOOST_REQUIRE_EQUAL (other.ptr<char>()[seg.size() - 1], 'x');
+
+  other.close();
+  seg.close();
+}
+
+BOOST_AUTO_TEST_CASE (huge_page_policy_can_be_read_from_its_output)
+{
+  for ( auto policy : { gpi::pc::segment::huge_page_policy::none
+                      , gpi::pc::segment::huge_page_policy::transparent
+                      , gpi::pc::segment::huge_page_policy::preallocated
+                      }
+      )
+  {
+    BOOST_REQUIRE
+      ( boost::lexical_cast<gpi::pc::segment::huge_page_policy>
+          (boost::lexical_cast<std::string> (policy))
+      == policy
+      );
+  }
+
+  BOOST_REQUIRE_THROW
+    ( boost::lexical_cast<gpi::pc::segment::huge_page_policy> ("gigantic")
+    , boost::bad_lexical_cast
+    );
+}
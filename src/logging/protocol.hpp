@@ -30,6 +30,8 @@ namespace fhg
     namespace protocol
     {
       FHG_RPC_FUNCTION_DESCRIPTION (receive, void (message));
+      FHG_RPC_FUNCTION_DESCRIPTION
+        (receive_batch, void (std::vector<message>));
       FHG_RPC_FUNCTION_DESCRIPTION (register_receiver, void (endpoint));
 
       namespace receiver
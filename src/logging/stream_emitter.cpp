@@ -28,7 +28,9 @@
 #include <util-generic/this_bound_mem_fn.hpp>
 #include <util-generic/wait_and_collect_exceptions.hpp>
 
+#include <algorithm>
 #include <future>
+#include <iterator>
 #include <vector>
 
 namespace fhg
@@ -50,18 +52,43 @@ namespace fhg
                         )
     {}
 
+    asynchronous_emission::asynchronous_emission
+        (std::size_t capacity_, overflow_policy on_overflow_)
+      : capacity (capacity_)
+      , on_overflow (on_overflow_)
+    {}
+
+    stream_emitter::stream_emitter (asynchronous_emission configuration)
+      : stream_emitter()
+    {
+      _asynchronous_sender = util::cxx14::make_unique<asynchronous_sender>
+        (*this, std::move (configuration));
+    }
+
+    stream_emitter::~stream_emitter() = default;
+
     endpoint stream_emitter::local_endpoint() const
     {
       return _local_endpoint;
     }
 
+    std::vector<rpc::remote_endpoint*> stream_emitter::receivers()
+    {
+      std::lock_guard<std::mutex> const lock (_receivers_guard);
+
+      std::vector<rpc::remote_endpoint*> receivers;
+      for (auto const& receiver : _receivers)
+      {
+        receivers.emplace_back (receiver.get());
+      }
+
+      return receivers;
+    }
+
     namespace
     {
-      template < template<typename> class Future
-               , typename Receivers
-               , typename... Yield
-               >
-        void emit_message_impl ( Receivers& receivers
+      template<template<typename> class Future, typename... Yield>
+        void emit_message_impl ( std::vector<rpc::remote_endpoint*> const& receivers
                                , message const& forwarded_message
                                , Yield... yield
                                )
@@ -91,13 +118,215 @@ namespace fhg
 
     void stream_emitter::emit_message (message const& forwarded_message)
     {
-      return emit_message_impl<std::future> (_receivers, forwarded_message);
+      if (_asynchronous_sender)
+      {
+        return _asynchronous_sender->push (forwarded_message);
+      }
+
+      return emit_message_impl<std::future> (receivers(), forwarded_message);
     }
     void stream_emitter::emit_message
       (message const& forwarded_message, boost::asio::yield_context yield)
     {
+      if (_asynchronous_sender)
+      {
+        return _asynchronous_sender->push (forwarded_message, yield);
+      }
+
       return emit_message_impl<rpc::future>
-        (_receivers, forwarded_message, yield);
+        (receivers(), forwarded_message, yield);
+    }
+
+    void stream_emitter::flush()
+    {
+      if (_asynchronous_sender)
+      {
+        _asynchronous_sender->flush();
+      }
+    }
+
+    std::size_t stream_emitter::dropped_messages() const
+    {
+      return _asynchronous_sender ? _asynchronous_sender->_dropped.load() : 0;
+    }
+
+    stream_emitter::asynchronous_sender::asynchronous_sender
+        (stream_emitter& emitter, asynchronous_emission configuration)
+      : _emitter (emitter)
+      , _configuration (std::move (configuration))
+      , _buffer (std::max<std::size_t> (1, _configuration.capacity))
+      , _thread (&asynchronous_sender::send_batches, this)
+    {}
+
+    stream_emitter::asynchronous_sender::~asynchronous_sender()
+    {
+      {
+        std::unique_lock<std::mutex> lock (_guard);
+        _stopping = true;
+        notify_space_available (lock);
+      }
+      _messages_available.notify_all();
+
+      _thread.join();
+    }
+
+    void stream_emitter::asynchronous_sender::push (message const& m)
+    {
+      return push_impl
+        ( m
+        , [&] (std::unique_lock<std::mutex>& lock)
+          {
+            _space_available.wait
+              (lock, [&] { return _stopping || !_buffer.full(); });
+          }
+        );
+    }
+
+    void stream_emitter::asynchronous_sender::push
+      (message const& m, boost::asio::yield_context yield)
+    {
+      return push_impl
+        ( m
+        , [&] (std::unique_lock<std::mutex>& lock)
+          {
+            while (!_stopping && _buffer.full())
+            {
+              auto const waiter
+                ( std::make_shared<rpc::promise<void>>
+                    (_emitter._io_service)
+                );
+              auto space_available (waiter->get_future());
+              _space_waiters.emplace_back (waiter);
+
+              lock.unlock();
+              space_available.get (yield);
+              lock.lock();
+            }
+          }
+        );
+    }
+
+    void stream_emitter::asynchronous_sender::notify_space_available
+      (std::unique_lock<std::mutex>& lock)
+    {
+      std::list<std::shared_ptr<rpc::promise<void>>> waiters;
+      waiters.swap (_space_waiters);
+
+      lock.unlock();
+
+      _space_available.notify_all();
+      for (auto const& waiter : waiters)
+      {
+        waiter->set_value();
+      }
+
+      lock.lock();
+    }
+
+    template<typename WaitForSpace>
+      void stream_emitter::asynchronous_sender::push_impl
+        (message const& m, WaitForSpace&& wait_for_space)
+    {
+      std::unique_lock<std::mutex> lock (_guard);
+
+      if (_buffer.full())
+      {
+        switch (_configuration.on_overflow)
+        {
+        case asynchronous_emission::overflow_policy::block:
+          wait_for_space (lock);
+          break;
+
+        case asynchronous_emission::overflow_policy::drop_oldest:
+          ++_dropped;
+          break;
+
+        case asynchronous_emission::overflow_policy::sample:
+          ++_dropped;
+          if ( ++_overflow_count
+             % std::max<std::size_t> (1, _configuration.sample_every)
+             )
+          {
+            return;
+          }
+          break;
+        }
+      }
+      else
+      {
+        _overflow_count = 0;
+      }
+
+      //! \note overwrites the oldest message when full
+      _buffer.push_back (m);
+
+      lock.unlock();
+      _messages_available.notify_one();
+    }
+
+    void stream_emitter::asynchronous_sender::flush()
+    {
+      std::unique_lock<std::mutex> lock (_guard);
+      _all_sent.wait
+        (lock, [&] { return _buffer.empty() && _in_flight == 0; });
+    }
+
+    void stream_emitter::asynchronous_sender::send_batches()
+    {
+      std::vector<message> batch;
+      std::vector<rpc::remote_endpoint*> receivers;
+
+      for (;;)
+      {
+        {
+          std::unique_lock<std::mutex> lock (_guard);
+
+          _in_flight = 0;
+          _all_sent.notify_all();
+
+          _messages_available.wait
+            (lock, [&] { return _stopping || !_buffer.empty(); });
+
+          if (_buffer.empty())
+          {
+            return;
+          }
+
+          auto const count
+            ( std::min<std::size_t>
+                ( _buffer.size()
+                , std::max<std::size_t> (1, _configuration.max_batch_size)
+                )
+            );
+
+          batch.assign ( std::make_move_iterator (_buffer.begin())
+                       , std::make_move_iterator (_buffer.begin() + count)
+                       );
+          _buffer.erase_begin (count);
+          _in_flight = count;
+
+          notify_space_available (lock);
+        }
+
+        receivers = _emitter.receivers();
+
+        std::vector<std::future<void>> receiver_results;
+
+        for (auto const& receiver : receivers)
+        {
+          using fun = rpc::remote_function<protocol::receive_batch>;
+          receiver_results.emplace_back (fun {*receiver} (batch));
+        }
+
+        try
+        {
+          util::wait_and_collect_exceptions (receiver_results);
+        }
+        catch (...)
+        {
+          //! \todo Ignore for now, same as in synchronous emission.
+        }
+      }
     }
 
     void stream_emitter::emit ( decltype (message::_content) content
@@ -114,17 +343,23 @@ namespace fhg
         ( endpoint.best (_local_endpoint.as_socket->host)
         , [&] (socket_endpoint const& as_socket)
           {
-            _receivers.emplace_back
+            auto receiver
               ( util::cxx14::make_unique<rpc::remote_socket_endpoint>
                   (_io_service, yield, as_socket.socket)
               );
+
+            std::lock_guard<std::mutex> const lock (_receivers_guard);
+            _receivers.emplace_back (std::move (receiver));
           }
         , [&] (tcp_endpoint const& as_tcp)
           {
-            _receivers.emplace_back
+            auto receiver
               ( util::cxx14::make_unique<rpc::remote_tcp_endpoint>
                   (_io_service, yield, as_tcp)
               );
+
+            std::lock_guard<std::mutex> const lock (_receivers_guard);
+            _receivers.emplace_back (std::move (receiver));
           }
         );
     }
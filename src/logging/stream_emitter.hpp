@@ -20,6 +20,7 @@
 #include <logging/message.hpp>
 #include <logging/protocol.hpp>
 
+#include <rpc/future.hpp>
 #include <rpc/remote_endpoint.hpp>
 #include <rpc/service_dispatcher.hpp>
 #include <rpc/service_handler.hpp>
@@ -28,17 +29,54 @@
 
 #include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
 
+#include <boost/circular_buffer.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace fhg
 {
   namespace logging
   {
+    //! Emission mode where messages are put into a bounded buffer and
+    //! sent by a background thread, many per call. The emitting thread
+    //! does not wait for receivers.
+    //! \note Receivers have to provide protocol::receive_batch, which
+    //! stream_receiver does.
+    struct asynchronous_emission
+    {
+      enum class overflow_policy
+      {
+        //! wait until the sender made room
+        block,
+        //! overwrite the oldest buffered message
+        drop_oldest,
+        //! while full, let only every sample_every-th message
+        //! overwrite the oldest buffered one and drop all others
+        sample,
+      };
+
+      asynchronous_emission() = default;
+      asynchronous_emission (std::size_t capacity, overflow_policy);
+
+      std::size_t capacity = 1 << 16;
+      std::size_t max_batch_size = 1 << 10;
+      overflow_policy on_overflow = overflow_policy::block;
+      std::size_t sample_every = 16;
+    };
+
     class stream_emitter
     {
     public:
       stream_emitter();
+      explicit stream_emitter (asynchronous_emission);
+      ~stream_emitter();
 
       endpoint local_endpoint() const;
 
@@ -46,11 +84,55 @@ namespace fhg
       void emit_message (message const&, boost::asio::yield_context);
       void emit (decltype (message::_content), decltype (message::_category));
 
+      //! Wait until all messages emitted so far have been delivered.
+      //! No-op for synchronous emission.
+      void flush();
+
+      //! Number of messages discarded due to the overflow policy.
+      std::size_t dropped_messages() const;
+
     private:
       rpc::service_dispatcher _service_dispatcher;
       util::scoped_boost_asio_io_service_with_threads _io_service;
 
+      std::mutex _receivers_guard;
       std::list<std::unique_ptr<rpc::remote_endpoint>> _receivers;
+      //! \note receivers are never removed, so the pointers stay valid
+      std::vector<rpc::remote_endpoint*> receivers();
+
+      struct asynchronous_sender
+      {
+        asynchronous_sender (stream_emitter&, asynchronous_emission);
+        ~asynchronous_sender();
+
+        void push (message const&);
+        void push (message const&, boost::asio::yield_context);
+        void flush();
+
+        template<typename WaitForSpace>
+          void push_impl (message const&, WaitForSpace&&);
+        void notify_space_available (std::unique_lock<std::mutex>&);
+
+        stream_emitter& _emitter;
+        asynchronous_emission const _configuration;
+
+        std::mutex _guard;
+        std::condition_variable _messages_available;
+        std::condition_variable _space_available;
+        //! \note emitters waiting via a yield context for room
+        std::list<std::shared_ptr<rpc::promise<void>>> _space_waiters;
+        std::condition_variable _all_sent;
+        boost::circular_buffer<message> _buffer;
+        std::size_t _in_flight {0};
+        std::size_t _overflow_count {0};
+        bool _stopping {false};
+
+        std::atomic<std::size_t> _dropped {0};
+
+        void send_batches();
+        std::thread _thread;
+      };
+      std::unique_ptr<asynchronous_sender> _asynchronous_sender;
 
       void register_receiver (boost::asio::yield_context, endpoint const&);
       rpc::service_handler<protocol::register_receiver> const
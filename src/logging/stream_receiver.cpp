@@ -38,7 +38,20 @@ namespace fhg
 
     stream_receiver::stream_receiver (yielding_callback_t callback)
       : _io_service (1)
-      , _receive (_service_dispatcher, std::move (callback), rpc::yielding)
+      , _receive (_service_dispatcher, callback, rpc::yielding)
+      , _receive_batch
+          ( _service_dispatcher
+          , [callback] ( boost::asio::yield_context yield
+                       , std::vector<message> const& messages
+                       )
+            {
+              for (auto const& m : messages)
+              {
+                callback (yield, m);
+              }
+            }
+          , rpc::yielding
+          )
       , _service_tcp_provider (_io_service, _service_dispatcher)
       , _service_socket_provider (_io_service, _service_dispatcher)
       , _local_endpoint ( util::connectable_to_address_string
@@ -57,7 +70,18 @@ namespace fhg
                                      , callback_t callback
                                      )
       : _io_service (1)
-      , _receive (_service_dispatcher, std::move (callback), rpc::not_yielding)
+      , _receive (_service_dispatcher, callback, rpc::not_yielding)
+      , _receive_batch
+          ( _service_dispatcher
+          , [callback] (std::vector<message> const& messages)
+            {
+              for (auto const& m : messages)
+              {
+                callback (m);
+              }
+            }
+          , rpc::not_yielding
+          )
       , _service_tcp_provider (_io_service, _service_dispatcher)
       , _service_socket_provider (_io_service, _service_dispatcher)
       , _local_endpoint ( util::connectable_to_address_string
@@ -56,6 +56,7 @@ namespace fhg
       rpc::service_dispatcher _service_dispatcher;
       util::scoped_boost_asio_io_service_with_threads _io_service;
       rpc::service_handler<protocol::receive> const _receive;
+      rpc::service_handler<protocol::receive_batch> const _receive_batch;
       rpc::service_tcp_provider const _service_tcp_provider;
       rpc::service_socket_provider const _service_socket_provider;
       endpoint const _local_endpoint;
@@ -15,6 +15,7 @@
 // along with this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <logging/stream_emitter.hpp>
+#include <logging/stream_receiver.hpp>
 #include <logging/test/message.hpp>
 
 #include <rpc/remote_function.hpp>
@@ -26,13 +27,22 @@
 #include <rpc/service_tcp_provider.hpp>
 
 #include <util-generic/connectable_to_address_string.hpp>
+#include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
 #include <util-generic/testing/printer/future.hpp>
+#include <util-generic/testing/printer/vector.hpp>
 #include <util-generic/testing/random.hpp>
 
+#include <boost/asio/spawn.hpp>
 #include <boost/mpl/list.hpp>
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <vector>
+
 namespace fhg
 {
   namespace logging
@@ -134,5 +144,166 @@ namespace fhg
 
       BOOST_REQUIRE_EQUAL (received_future.get(), sent);
     }
+
+    BOOST_AUTO_TEST_CASE
+      (asynchronous_emitter_delivers_all_messages_in_order)
+    {
+      std::vector<message> sent (1000);
+      std::generate (sent.begin(), sent.end(), util::testing::random<message>{});
+
+      stream_emitter emitter
+        ( asynchronous_emission
+            (16, asynchronous_emission::overflow_policy::block)
+        );
+
+      std::mutex received_guard;
+      std::vector<message> received;
+      stream_receiver const receiver
+        ( emitter.local_endpoint()
+        , [&] (message const& m)
+          {
+            std::lock_guard<std::mutex> const lock (received_guard);
+            received.emplace_back (m);
+          }
+        );
+
+      for (auto const& m : sent)
+      {
+        emitter.emit_message (m);
+      }
+
+      emitter.flush();
+
+      std::lock_guard<std::mutex> const lock (received_guard);
+      BOOST_REQUIRE_EQUAL (received, sent);
+      BOOST_REQUIRE_EQUAL (emitter.dropped_messages(), 0u);
+    }
+
+    BOOST_AUTO_TEST_CASE
+      (asynchronous_emitter_drops_oldest_messages_on_overflow)
+    {
+      auto const first (util::testing::random<message>{}());
+      auto const dropped (util::testing::random<message>{}());
+      auto const last (util::testing::random<message>{}());
+
+      stream_emitter emitter
+        ( asynchronous_emission
+            (1, asynchronous_emission::overflow_policy::drop_oldest)
+        );
+
+      std::promise<void> first_arrived;
+      std::promise<void> continue_receiving;
+      auto continue_receiving_future (continue_receiving.get_future());
+
+      std::vector<message> received;
+      stream_receiver const receiver
+        ( emitter.local_endpoint()
+        , [&] (message const& m)
+          {
+            received.emplace_back (m);
+
+            if (received.size() == 1)
+            {
+              first_arrived.set_value();
+              continue_receiving_future.wait();
+            }
+          }
+        );
+
+      emitter.emit_message (first);
+      first_arrived.get_future().wait();
+
+      emitter.emit_message (dropped);
+      emitter.emit_message (dropped);
+      emitter.emit_message (last);
+
+      continue_receiving.set_value();
+      emitter.flush();
+
+      BOOST_REQUIRE_EQUAL (received, (std::vector<message> {first, last}));
+      BOOST_REQUIRE_EQUAL (emitter.dropped_messages(), 2u);
+    }
+
+    BOOST_AUTO_TEST_CASE
+      (asynchronous_emitter_blocking_with_yield_does_not_block_the_thread)
+    {
+      auto const first (util::testing::random<message>{}());
+      auto const second (util::testing::random<message>{}());
+      auto const third (util::testing::random<message>{}());
+
+      stream_emitter emitter
+        ( asynchronous_emission
+            (1, asynchronous_emission::overflow_policy::block)
+        );
+
+      std::promise<void> first_arrived;
+      std::promise<void> continue_receiving;
+      auto continue_receiving_future (continue_receiving.get_future());
+
+      std::mutex received_guard;
+      std::vector<message> received;
+      stream_receiver const receiver
+        ( emitter.local_endpoint()
+        , [&] (message const& m)
+          {
+            {
+              std::lock_guard<std::mutex> const lock (received_guard);
+              received.emplace_back (m);
+            }
+
+            if (m == first)
+            {
+              first_arrived.set_value();
+              continue_receiving_future.wait();
+            }
+          }
+        );
+
+      emitter.emit_message (first);
+      first_arrived.get_future().wait();
+
+      //! \note fills the buffer while first is still being received
+      emitter.emit_message (second);
+
+      std::promise<void> third_emitted;
+      std::promise<void> other_coroutine_ran;
+
+      util::scoped_boost_asio_io_service_with_threads io_service (1);
+
+      boost::asio::spawn
+        ( io_service
+        , [&] (boost::asio::yield_context yield)
+          {
+            emitter.emit_message (third, yield);
+            third_emitted.set_value();
+          }
+        );
+      boost::asio::spawn
+        ( io_service
+        , [&] (boost::asio::yield_context)
+          {
+            other_coroutine_ran.set_value();
+          }
+        );
+
+      BOOST_REQUIRE ( other_coroutine_ran.get_future().wait_for
+                        (std::chrono::seconds (10))
+                    == std::future_status::ready
+                    );
+
+      auto third_emitted_future (third_emitted.get_future());
+      BOOST_REQUIRE ( third_emitted_future.wait_for (std::chrono::seconds (0))
+                    == std::future_status::timeout
+                    );
+
+      continue_receiving.set_value();
+      third_emitted_future.get();
+      emitter.flush();
+
+      std::lock_guard<std::mutex> const lock (received_guard);
+      BOOST_REQUIRE_EQUAL
+        (received, (std::vector<message> {first, second, third}));
+      BOOST_REQUIRE_EQUAL (emitter.dropped_messages(), 0u);
+    }
   }
 }
@@ -0,0 +1,101 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <logging/stream_emitter.hpp>
+#include <logging/stream_receiver.hpp>
+#include <logging/test/message.hpp>
+
+#include <util-generic/testing/measure_average_time.hpp>
+#include <util-generic/testing/printer/chrono.hpp>
+#include <util-generic/testing/random.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace fhg
+{
+  namespace logging
+  {
+    namespace
+    {
+      std::chrono::microseconds const receiver_delay (200);
+      std::size_t const emit_count (2000);
+
+      std::chrono::nanoseconds average_emit_latency
+        (stream_emitter& emitter, std::string const& description)
+      {
+        stream_receiver const slow_receiver
+          ( emitter.local_endpoint()
+          , [] (message const&)
+            {
+              std::this_thread::sleep_for (receiver_delay);
+            }
+          );
+
+        auto const m (util::testing::random<message>{}());
+
+        auto const latency
+          ( util::testing::measure_average_time<std::chrono::nanoseconds>
+              ([&] { emitter.emit_message (m); }, emit_count)
+          );
+
+        emitter.flush();
+
+        std::cout << description << ": " << latency.count()
+                  << " ns per emit, " << emitter.dropped_messages()
+                  << " dropped\n";
+
+        return latency;
+      }
+    }
+
+    BOOST_AUTO_TEST_CASE
+      (asynchronous_emission_decouples_emit_latency_from_slow_receiver)
+    {
+      using policy = asynchronous_emission::overflow_policy;
+
+      stream_emitter synchronous;
+      stream_emitter asynchronous_blocking
+        (asynchronous_emission (emit_count, policy::block));
+      stream_emitter asynchronous_drop_oldest
+        (asynchronous_emission (emit_count / 10, policy::drop_oldest));
+      stream_emitter asynchronous_sample
+        (asynchronous_emission (emit_count / 10, policy::sample));
+
+      auto const synchronous_latency
+        (average_emit_latency (synchronous, "synchronous"));
+
+      BOOST_REQUIRE_GE (synchronous_latency, receiver_delay);
+
+      BOOST_REQUIRE_LT
+        ( average_emit_latency (asynchronous_blocking, "asynchronous (block)")
+        , synchronous_latency / 10
+        );
+      BOOST_REQUIRE_LT
+        ( average_emit_latency
+            (asynchronous_drop_oldest, "asynchronous (drop oldest)")
+        , synchronous_latency / 10
+        );
+      BOOST_REQUIRE_LT
+        ( average_emit_latency (asynchronous_sample, "asynchronous (sample)")
+        , synchronous_latency / 10
+        );
+    }
+  }
+}
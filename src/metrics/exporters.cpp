@@ -0,0 +1,227 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <metrics/exporters.hpp>
+
+#include <metrics/prometheus.hpp>
+
+#include <util-generic/cxx14/make_unique.hpp>
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <string>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    rpc_exporter::rpc_exporter (registry const& registry, unsigned short port)
+      : _prometheus_exposition
+          ( _service_dispatcher
+          , [&registry]
+            {
+              return prometheus_exposition (registry);
+            }
+          )
+      , _service_tcp_provider
+          ( _io_service
+          , _service_dispatcher
+          , boost::asio::ip::tcp::endpoint (boost::asio::ip::tcp::v4(), port)
+          )
+    {}
+
+    boost::asio::ip::tcp::endpoint rpc_exporter::local_endpoint() const
+    {
+      return _service_tcp_provider.local_endpoint();
+    }
+
+    namespace
+    {
+      //! \note Requests are only read up to their header's end. The
+      //! limit makes async_read_until fail for clients that never send
+      //! one, instead of buffering for them without bound.
+      constexpr std::size_t const maximum_request_size {16 << 10};
+
+      struct connection
+      {
+        connection (boost::asio::io_service& io_service)
+          : socket (io_service)
+          , request (maximum_request_size)
+        {}
+
+        boost::asio::ip::tcp::socket socket;
+        boost::asio::streambuf request;
+        std::string response;
+      };
+    }
+
+    text_exporter::text_exporter (registry const& registry, unsigned short port)
+      : _registry (registry)
+      , _io_service()
+      , _acceptor
+          ( _io_service
+          , boost::asio::ip::tcp::endpoint (boost::asio::ip::tcp::v4(), port)
+          )
+    {
+      accept();
+
+      _thread = std::thread ([this] { _io_service.run(); });
+    }
+
+    text_exporter::~text_exporter()
+    {
+      _io_service.stop();
+      _thread.join();
+    }
+
+    boost::asio::ip::tcp::endpoint text_exporter::local_endpoint() const
+    {
+      return _acceptor.local_endpoint();
+    }
+
+    void text_exporter::accept()
+    {
+      auto const client (std::make_shared<connection> (_io_service));
+
+      _acceptor.async_accept
+        ( client->socket
+        , [this, client] (boost::system::error_code const& accept_error)
+          {
+            if (accept_error == boost::asio::error::operation_aborted)
+            {
+              return;
+            }
+
+            accept();
+
+            if (accept_error)
+            {
+              return;
+            }
+
+            //! \note The request is not interpreted: there is only one
+            //! resource. Reading its header before responding avoids
+            //! resetting connections of clients still sending.
+            boost::asio::async_read_until
+              ( client->socket
+              , client->request
+              , "\r\n\r\n"
+              , [this, client] (boost::system::error_code const& read_error, std::size_t)
+                {
+                  if (read_error)
+                  {
+                    return;
+                  }
+
+                  std::string const body (prometheus_exposition (_registry));
+
+                  client->response
+                    = "HTTP/1.0 200 OK\r\n"
+                      "Content-Type: text/plain; version=0.0.4\r\n"
+                      "Content-Length: " + std::to_string (body.size()) + "\r\n"
+                      "Connection: close\r\n"
+                      "\r\n"
+                    + body;
+
+                  boost::asio::async_write
+                    ( client->socket
+                    , boost::asio::buffer (client->response)
+                    , [client] (boost::system::error_code const&, std::size_t)
+                      {
+                        boost::system::error_code ignored;
+                        client->socket.shutdown
+                          (boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                      }
+                    );
+                }
+              );
+          }
+        );
+    }
+
+    namespace
+    {
+      namespace option_name
+      {
+        constexpr char const* const port {"metrics-port"};
+        constexpr char const* const rpc_port {"metrics-rpc-port"};
+      }
+    }
+
+    namespace options
+    {
+      boost::program_options::options_description exporters()
+      {
+        boost::program_options::options_description options ("metrics");
+        options.add_options()
+          ( option_name::port
+          , boost::program_options::value<unsigned short>()
+          , "port to provide metrics on via HTTP in the Prometheus text format"
+            " (0 for any)"
+          )
+          ( option_name::rpc_port
+          , boost::program_options::value<unsigned short>()
+          , "port to provide metrics on via rpc (0 for any)"
+          )
+          ;
+        return options;
+      }
+    }
+
+    exporters::exporters
+        ( registry const& registry
+        , boost::program_options::variables_map const& vm
+        )
+    {
+      if (vm.count (option_name::port))
+      {
+        _text_exporter = util::cxx14::make_unique<text_exporter>
+          (registry, vm.at (option_name::port).as<unsigned short>());
+      }
+
+      if (vm.count (option_name::rpc_port))
+      {
+        _rpc_exporter = util::cxx14::make_unique<rpc_exporter>
+          (registry, vm.at (option_name::rpc_port).as<unsigned short>());
+      }
+    }
+
+    std::vector<std::string> exporters::endpoints() const
+    {
+      std::vector<std::string> endpoints;
+
+      if (_text_exporter)
+      {
+        endpoints.emplace_back
+          ( "metrics via HTTP on port "
+          + std::to_string (_text_exporter->local_endpoint().port())
+          );
+      }
+
+      if (_rpc_exporter)
+      {
+        endpoints.emplace_back
+          ( "metrics via rpc on port "
+          + std::to_string (_rpc_exporter->local_endpoint().port())
+          );
+      }
+
+      return endpoints;
+    }
+  }
+}
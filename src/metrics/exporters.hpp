@@ -0,0 +1,105 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <metrics/protocol.hpp>
+#include <metrics/registry.hpp>
+
+#include <rpc/service_dispatcher.hpp>
+#include <rpc/service_handler.hpp>
+#include <rpc/service_tcp_provider.hpp>
+
+#include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/optional.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    //! Provides protocol::prometheus_exposition via rpc.
+    class rpc_exporter
+    {
+    public:
+      rpc_exporter (registry const&, unsigned short port = 0);
+
+      boost::asio::ip::tcp::endpoint local_endpoint() const;
+
+    private:
+      rpc::service_dispatcher _service_dispatcher;
+      rpc::service_handler<protocol::prometheus_exposition> const
+        _prometheus_exposition;
+      util::scoped_boost_asio_io_service_with_threads _io_service {1};
+      rpc::service_tcp_provider const _service_tcp_provider;
+    };
+
+    //! Answers every HTTP request with the Prometheus text exposition,
+    //! to be scraped by a Prometheus server directly.
+    class text_exporter
+    {
+    public:
+      text_exporter (registry const&, unsigned short port = 0);
+      ~text_exporter();
+
+      text_exporter (text_exporter const&) = delete;
+      text_exporter& operator= (text_exporter const&) = delete;
+      text_exporter (text_exporter&&) = delete;
+      text_exporter& operator= (text_exporter&&) = delete;
+
+      boost::asio::ip::tcp::endpoint local_endpoint() const;
+
+    private:
+      registry const& _registry;
+      boost::asio::io_service _io_service;
+      boost::asio::ip::tcp::acceptor _acceptor;
+
+      void accept();
+
+      std::thread _thread;
+    };
+
+    namespace options
+    {
+      //! --metrics-port, --metrics-rpc-port
+      boost::program_options::options_description exporters();
+    }
+
+    //! The exporters requested by options::exporters(), if any.
+    class exporters
+    {
+    public:
+      exporters (registry const&, boost::program_options::variables_map const&);
+
+      //! Human readable endpoints of the exporters, one per exporter,
+      //! e.g. to report the ports chosen when 0 was requested.
+      std::vector<std::string> endpoints() const;
+
+    private:
+      std::unique_ptr<text_exporter> _text_exporter;
+      std::unique_ptr<rpc_exporter> _rpc_exporter;
+    };
+  }
+}
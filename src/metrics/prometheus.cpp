@@ -0,0 +1,186 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <metrics/prometheus.hpp>
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    namespace
+    {
+      std::string escaped (std::string const& value, bool escape_quotes)
+      {
+        std::string result;
+        result.reserve (value.size());
+
+        for (char c : value)
+        {
+          switch (c)
+          {
+          case '\\': result += "\\\\"; break;
+          case '\n': result += "\\n"; break;
+          case '"':
+            result += escape_quotes ? "\\\"" : "\"";
+            break;
+          default: result += c; break;
+          }
+        }
+
+        return result;
+      }
+
+      void write_labels ( std::ostream& os
+                        , labels const& labels
+                        , std::string const& le = std::string()
+                        )
+      {
+        if (labels.empty() && le.empty())
+        {
+          return;
+        }
+
+        os << '{';
+        bool first (true);
+        for (auto const& label : labels)
+        {
+          os << (first ? "" : ",")
+             << label.first << "=\"" << escaped (label.second, true) << '"';
+          first = false;
+        }
+        if (!le.empty())
+        {
+          os << (first ? "" : ",") << "le=\"" << le << '"';
+        }
+        os << '}';
+      }
+
+      //! \note exact decimal representation, so that bucket bounds
+      //! stay identical between scrapes and processes
+      std::string le_of_bucket (std::size_t bucket)
+      {
+        std::uint64_t const microseconds (std::uint64_t (1) << bucket);
+
+        std::ostringstream os;
+        os << microseconds / 1000000 << '.'
+           << std::setw (6) << std::setfill ('0') << microseconds % 1000000;
+
+        std::string le (os.str());
+        le.erase (le.find_last_not_of ('0') + 1);
+        if (le.back() == '.')
+        {
+          le.pop_back();
+        }
+        return le;
+      }
+
+      char const* type_name (registry::metric_type type)
+      {
+        switch (type)
+        {
+        case registry::metric_type::counter: return "counter";
+        case registry::metric_type::gauge: return "gauge";
+        case registry::metric_type::histogram: return "histogram";
+        }
+
+        throw std::logic_error ("unknown metric type");
+      }
+    }
+
+    void write_prometheus_exposition (std::ostream& os, registry const& registry)
+    {
+      auto const precision (os.precision());
+      os << std::setprecision (std::numeric_limits<double>::max_digits10);
+
+      registry.visit
+        ( [&] (std::string const& name, registry::family const& family)
+          {
+            os << "# HELP " << name << ' ' << escaped (family.help, false) << '\n'
+               << "# TYPE " << name << ' ' << type_name (family.type) << '\n';
+
+            for (auto const& labelled : family.metrics)
+            {
+              auto const& labels (labelled.first);
+
+              switch (family.type)
+              {
+              case registry::metric_type::counter:
+                os << name;
+                write_labels (os, labels);
+                os << ' '
+                   << static_cast<counter const*> (labelled.second.get())->value()
+                   << '\n';
+                break;
+
+              case registry::metric_type::gauge:
+                os << name;
+                write_labels (os, labels);
+                os << ' '
+                   << static_cast<gauge const*> (labelled.second.get())->value()
+                   << '\n';
+                break;
+
+              case registry::metric_type::histogram:
+                {
+                  auto const snapshot
+                    ( static_cast<histogram const*> (labelled.second.get())
+                    ->value()
+                    );
+
+                  std::uint64_t cumulative (0);
+                  for (std::size_t bucket (0); bucket < histogram::bucket_count; ++bucket)
+                  {
+                    cumulative += snapshot.buckets[bucket];
+
+                    os << name << "_bucket";
+                    write_labels (os, labels, le_of_bucket (bucket));
+                    os << ' ' << cumulative << '\n';
+                  }
+
+                  os << name << "_bucket";
+                  write_labels (os, labels, "+Inf");
+                  os << ' ' << snapshot.count << '\n';
+
+                  os << name << "_sum";
+                  write_labels (os, labels);
+                  os << ' ' << snapshot.sum_in_seconds << '\n';
+
+                  os << name << "_count";
+                  write_labels (os, labels);
+                  os << ' ' << snapshot.count << '\n';
+                }
+                break;
+              }
+            }
+          }
+        );
+
+      os.precision (precision);
+    }
+
+    std::string prometheus_exposition (registry const& registry)
+    {
+      std::ostringstream os;
+      write_prometheus_exposition (os, registry);
+      return os.str();
+    }
+  }
+}
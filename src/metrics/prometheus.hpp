@@ -0,0 +1,33 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <metrics/registry.hpp>
+
+#include <ostream>
+#include <string>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    //! Writes all metrics of the registry in the Prometheus text
+    //! exposition format, version 0.0.4. Durations are in seconds.
+    void write_prometheus_exposition (std::ostream&, registry const&);
+    std::string prometheus_exposition (registry const&);
+  }
+}
@@ -0,0 +1,176 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <metrics/registry.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    namespace detail
+    {
+      std::size_t shard_of_this_thread()
+      {
+        static std::atomic<std::size_t> next_shard {0};
+        static thread_local std::size_t const shard
+          (next_shard.fetch_add (1, std::memory_order_relaxed) % shard_count);
+
+        return shard;
+      }
+    }
+
+    std::uint64_t counter::value() const
+    {
+      std::uint64_t sum (0);
+      for (auto const& shard : _shards)
+      {
+        sum += shard.value.load (std::memory_order_relaxed);
+      }
+      return sum;
+    }
+
+    std::int64_t gauge::value() const
+    {
+      return _value.load (std::memory_order_relaxed);
+    }
+
+    histogram::shard::shard()
+      : sum_in_nanoseconds (0)
+    {
+      for (auto& bucket : buckets)
+      {
+        bucket.store (0, std::memory_order_relaxed);
+      }
+    }
+
+    void histogram::observe (std::chrono::nanoseconds duration)
+    {
+      std::uint64_t const nanoseconds
+        (std::max<std::chrono::nanoseconds::rep> (duration.count(), 0));
+      //! \note rounded up: the bucket is the first with an upper bound
+      //! not less than the duration
+      std::uint64_t const microseconds ((nanoseconds + 999) / 1000);
+
+      std::size_t const bucket
+        ( microseconds <= 1 ? 0
+        : std::min<std::size_t>
+            (64 - __builtin_clzll (microseconds - 1), bucket_count)
+        );
+
+      auto& shard (_shards[detail::shard_of_this_thread()]);
+      shard.buckets[bucket].fetch_add (1, std::memory_order_relaxed);
+      shard.sum_in_nanoseconds.fetch_add
+        (nanoseconds, std::memory_order_relaxed);
+    }
+
+    double histogram::upper_bound (std::size_t bucket)
+    {
+      return double (std::uint64_t (1) << bucket) * 1e-6;
+    }
+
+    histogram::snapshot histogram::value() const
+    {
+      snapshot snapshot;
+      snapshot.buckets.fill (0);
+      snapshot.count = 0;
+
+      std::uint64_t sum_in_nanoseconds (0);
+
+      for (auto const& shard : _shards)
+      {
+        for (std::size_t bucket (0); bucket < shard.buckets.size(); ++bucket)
+        {
+          auto const count
+            (shard.buckets[bucket].load (std::memory_order_relaxed));
+          snapshot.buckets[bucket] += count;
+          snapshot.count += count;
+        }
+        sum_in_nanoseconds
+          += shard.sum_in_nanoseconds.load (std::memory_order_relaxed);
+      }
+
+      snapshot.sum_in_seconds = double (sum_in_nanoseconds) * 1e-9;
+
+      return snapshot;
+    }
+
+    scoped_timer::scoped_timer (histogram& histogram)
+      : _histogram (histogram)
+      , _start (std::chrono::steady_clock::now())
+    {}
+    scoped_timer::~scoped_timer()
+    {
+      _histogram.observe (std::chrono::steady_clock::now() - _start);
+    }
+
+    template<typename Metric>
+      Metric& registry::get_or_add ( metric_type type
+                                   , std::string const& name
+                                   , std::string const& help
+                                   , labels const& labels
+                                   )
+    {
+      std::lock_guard<std::mutex> const _ (_guard);
+
+      auto family (_families.find (name));
+      if (family == _families.end())
+      {
+        family = _families.emplace (name, registry::family {type, help, {}}).first;
+      }
+      else if (family->second.type != type)
+      {
+        throw std::logic_error
+          ("metric '" + name + "' already registered with a different type");
+      }
+
+      auto& metric (family->second.metrics[labels]);
+      if (!metric)
+      {
+        metric = std::make_shared<Metric>();
+      }
+
+      return *static_cast<Metric*> (metric.get());
+    }
+
+    counter& registry::counter_for
+      (std::string const& name, std::string const& help, labels const& labels)
+    {
+      return get_or_add<metrics::counter>
+        (metric_type::counter, name, help, labels);
+    }
+    gauge& registry::gauge_for
+      (std::string const& name, std::string const& help, labels const& labels)
+    {
+      return get_or_add<metrics::gauge>
+        (metric_type::gauge, name, help, labels);
+    }
+    histogram& registry::histogram_for
+      (std::string const& name, std::string const& help, labels const& labels)
+    {
+      return get_or_add<metrics::histogram>
+        (metric_type::histogram, name, help, labels);
+    }
+
+    registry& process_registry()
+    {
+      static registry registry;
+      return registry;
+    }
+  }
+}
@@ -0,0 +1,205 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    //! Number of shards per metric. Every thread updates the shard
+    //! assigned to it on first use, readers sum over all shards.
+    constexpr std::size_t const shard_count = 16;
+
+    namespace detail
+    {
+      std::size_t shard_of_this_thread();
+
+      //! \note padded so that the values of neighbouring shards never
+      //! share a cache line
+      template<typename T>
+        struct shard
+      {
+        std::atomic<T> value {0};
+        char _padding[64 - sizeof (std::atomic<T>)];
+      };
+    }
+
+    //! Monotonically increasing count. Lock-free.
+    class counter
+    {
+    public:
+      void increment (std::uint64_t by = 1)
+      {
+        _shards[detail::shard_of_this_thread()].value.fetch_add
+          (by, std::memory_order_relaxed);
+      }
+
+      std::uint64_t value() const;
+
+    private:
+      std::array<detail::shard<std::uint64_t>, shard_count> _shards;
+    };
+
+    //! Current value that may go up and down, e.g. a queue depth.
+    //! Lock-free.
+    class gauge
+    {
+    public:
+      void set (std::int64_t value)
+      {
+        _value.store (value, std::memory_order_relaxed);
+      }
+      void increment (std::int64_t by = 1)
+      {
+        _value.fetch_add (by, std::memory_order_relaxed);
+      }
+      void decrement (std::int64_t by = 1)
+      {
+        _value.fetch_sub (by, std::memory_order_relaxed);
+      }
+
+      std::int64_t value() const;
+
+    private:
+      std::atomic<std::int64_t> _value {0};
+    };
+
+    //! Distribution of durations in buckets with exponentially growing
+    //! upper bounds of 1us, 2us, 4us, ..., 2^(bucket_count - 1)us and
+    //! an overflow bucket. Lock-free.
+    class histogram
+    {
+    public:
+      static constexpr std::size_t const bucket_count = 26;
+
+      void observe (std::chrono::nanoseconds);
+
+      //! upper bound of the bucket in seconds
+      static double upper_bound (std::size_t bucket);
+
+      struct snapshot
+      {
+        //! \note not cumulative, the last element is the overflow
+        //! bucket
+        std::array<std::uint64_t, bucket_count + 1> buckets;
+        std::uint64_t count;
+        double sum_in_seconds;
+      };
+      snapshot value() const;
+
+    private:
+      struct shard
+      {
+        std::array<std::atomic<std::uint64_t>, bucket_count + 1> buckets;
+        std::atomic<std::uint64_t> sum_in_nanoseconds;
+        char _padding[64];
+
+        shard();
+      };
+      std::array<shard, shard_count> _shards;
+    };
+
+    //! Observes the time from construction to destruction.
+    class scoped_timer
+    {
+    public:
+      scoped_timer (histogram&);
+      ~scoped_timer();
+
+      scoped_timer (scoped_timer const&) = delete;
+      scoped_timer& operator= (scoped_timer const&) = delete;
+      scoped_timer (scoped_timer&&) = delete;
+      scoped_timer& operator= (scoped_timer&&) = delete;
+
+    private:
+      histogram& _histogram;
+      std::chrono::steady_clock::time_point const _start;
+    };
+
+    using labels = std::map<std::string, std::string>;
+
+    //! Named metrics, grouped into families of the same name that
+    //! differ in their labels. Looking up a metric locks, updating it
+    //! does not: look up once, keep the reference.
+    //! \note Metrics are never removed, references stay valid for the
+    //! lifetime of the registry.
+    class registry
+    {
+    public:
+      enum class metric_type
+      {
+        counter,
+        gauge,
+        histogram,
+      };
+
+      //! \note throws if name is registered with a different type
+      metrics::counter& counter_for
+        (std::string const& name, std::string const& help, labels const& = {});
+      metrics::gauge& gauge_for
+        (std::string const& name, std::string const& help, labels const& = {});
+      metrics::histogram& histogram_for
+        (std::string const& name, std::string const& help, labels const& = {});
+
+      struct family
+      {
+        metric_type type;
+        std::string help;
+        std::map<labels, std::shared_ptr<void>> metrics;
+      };
+
+      //! \note calls with all families, ordered by name, while holding
+      //! the lock on the registry
+      template<typename Fun>
+        void visit (Fun&& fun) const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+        for (auto const& family : _families)
+        {
+          fun (family.first, family.second);
+        }
+      }
+
+    private:
+      template<typename Metric>
+        Metric& get_or_add
+          ( metric_type
+          , std::string const&
+          , std::string const&
+          , labels const&
+          );
+
+      mutable std::mutex _guard;
+      std::map<std::string, family> _families;
+    };
+
+    //! The registry the components of this process are instrumented
+    //! with.
+    registry& process_registry();
+  }
+}
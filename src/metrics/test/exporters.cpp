@@ -0,0 +1,186 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <metrics/exporters.hpp>
+#include <metrics/prometheus.hpp>
+
+#include <rpc/remote_function.hpp>
+#include <rpc/remote_tcp_endpoint.hpp>
+
+#include <util-generic/connectable_to_address_string.hpp>
+#include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    namespace
+    {
+      std::string http_get (boost::asio::ip::tcp::endpoint const& endpoint)
+      {
+        boost::asio::io_service io_service;
+        boost::asio::ip::tcp::socket socket (io_service);
+        socket.connect
+          ( boost::asio::ip::tcp::endpoint
+              (boost::asio::ip::address_v4::loopback(), endpoint.port())
+          );
+
+        std::string const request
+          ("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+        boost::asio::write (socket, boost::asio::buffer (request));
+
+        std::string response;
+        boost::system::error_code error;
+        std::array<char, 4096> buffer;
+        while (!error)
+        {
+          response.append
+            (buffer.data(), socket.read_some (boost::asio::buffer (buffer), error));
+        }
+
+        BOOST_REQUIRE_EQUAL (error, boost::asio::error::eof);
+
+        return response;
+      }
+
+      std::string body_of (std::string const& response)
+      {
+        auto const end_of_header (response.find ("\r\n\r\n"));
+        BOOST_REQUIRE_NE (end_of_header, std::string::npos);
+        return response.substr (end_of_header + 4);
+      }
+    }
+
+    BOOST_AUTO_TEST_CASE (rpc_exporter_provides_prometheus_exposition)
+    {
+      registry registry;
+      registry.counter_for ("c", "h").increment (7);
+
+      rpc_exporter const exporter (registry);
+
+      util::scoped_boost_asio_io_service_with_threads io_service (1);
+      rpc::remote_tcp_endpoint endpoint
+        ( io_service
+        , util::connectable_to_address_string (exporter.local_endpoint())
+        );
+
+      BOOST_REQUIRE_EQUAL
+        ( rpc::sync_remote_function<protocol::prometheus_exposition> {endpoint}()
+        , prometheus_exposition (registry)
+        );
+
+      registry.counter_for ("c", "h").increment();
+
+      BOOST_REQUIRE_EQUAL
+        ( rpc::sync_remote_function<protocol::prometheus_exposition> {endpoint}()
+        , prometheus_exposition (registry)
+        );
+    }
+
+    BOOST_AUTO_TEST_CASE (text_exporter_answers_http_requests)
+    {
+      registry registry;
+      registry.gauge_for ("g", "h").set (3);
+
+      text_exporter const exporter (registry);
+
+      for (int i (0); i < 3; ++i)
+      {
+        auto const response (http_get (exporter.local_endpoint()));
+
+        BOOST_REQUIRE_EQUAL
+          (response.substr (0, response.find ("\r\n")), "HTTP/1.0 200 OK");
+        BOOST_REQUIRE_EQUAL (body_of (response), prometheus_exposition (registry));
+      }
+    }
+
+    BOOST_AUTO_TEST_CASE (text_exporter_drops_clients_sending_oversized_requests)
+    {
+      registry registry;
+
+      text_exporter const exporter (registry);
+
+      boost::asio::io_service io_service;
+      boost::asio::ip::tcp::socket socket (io_service);
+      socket.connect
+        ( boost::asio::ip::tcp::endpoint
+            ( boost::asio::ip::address_v4::loopback()
+            , exporter.local_endpoint().port()
+            )
+        );
+
+      //! \note never ends the header
+      std::string const request
+        ("GET /metrics HTTP/1.1\r\n" + std::string (1 << 20, 'x'));
+      boost::system::error_code ignored;
+      boost::asio::write (socket, boost::asio::buffer (request), ignored);
+
+      std::string response;
+      boost::system::error_code error;
+      std::array<char, 4096> buffer;
+      while (!error)
+      {
+        response.append
+          (buffer.data(), socket.read_some (boost::asio::buffer (buffer), error));
+      }
+
+      BOOST_REQUIRE_EQUAL (response, std::string());
+    }
+
+    BOOST_AUTO_TEST_CASE (exporters_are_started_only_if_requested)
+    {
+      registry registry;
+
+      auto const parse
+        ( [] (std::vector<std::string> const& arguments)
+          {
+            boost::program_options::variables_map vm;
+            boost::program_options::store
+              ( boost::program_options::command_line_parser (arguments)
+                .options (options::exporters())
+                .run()
+              , vm
+              );
+            boost::program_options::notify (vm);
+            return vm;
+          }
+        );
+
+      exporters const none (registry, parse ({}));
+      exporters const both
+        (registry, parse ({"--metrics-port", "0", "--metrics-rpc-port", "0"}));
+
+      BOOST_REQUIRE (none.endpoints().empty());
+
+      auto const endpoints (both.endpoints());
+      BOOST_REQUIRE_EQUAL (endpoints.size(), 2);
+      for (auto const& endpoint : endpoints)
+      {
+        BOOST_REQUIRE_NE (endpoint.find ("port "), std::string::npos);
+        BOOST_REQUIRE_NE (endpoint.substr (endpoint.find ("port ") + 5), "0");
+      }
+    }
+  }
+}
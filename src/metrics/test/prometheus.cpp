@@ -0,0 +1,104 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <metrics/prometheus.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <string>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    BOOST_AUTO_TEST_CASE (empty_registry_has_empty_exposition)
+    {
+      BOOST_REQUIRE_EQUAL (prometheus_exposition (registry{}), "");
+    }
+
+    BOOST_AUTO_TEST_CASE (counters_and_gauges_are_exposed_with_their_labels)
+    {
+      registry registry;
+
+      registry.counter_for ("requests_total", "number of requests").increment (3);
+      registry.counter_for
+        ("requests_total", "number of requests", {{"a", "x"}, {"b", "y"}})
+        .increment();
+      registry.gauge_for ("queue_size", "size of\nthe \\ queue").set (-2);
+
+      BOOST_REQUIRE_EQUAL
+        ( prometheus_exposition (registry)
+        , "# HELP queue_size size of\\nthe \\\\ queue\n"
+          "# TYPE queue_size gauge\n"
+          "queue_size -2\n"
+          "# HELP requests_total number of requests\n"
+          "# TYPE requests_total counter\n"
+          "requests_total 3\n"
+          "requests_total{a=\"x\",b=\"y\"} 1\n"
+        );
+    }
+
+    BOOST_AUTO_TEST_CASE (label_values_are_escaped)
+    {
+      registry registry;
+
+      registry.counter_for ("c", "h", {{"l", "\"\\\n"}});
+
+      BOOST_REQUIRE_EQUAL
+        ( prometheus_exposition (registry)
+        , "# HELP c h\n"
+          "# TYPE c counter\n"
+          "c{l=\"\\\"\\\\\\n\"} 0\n"
+        );
+    }
+
+    BOOST_AUTO_TEST_CASE (histogram_buckets_are_cumulative)
+    {
+      registry registry;
+
+      auto& histogram
+        (registry.histogram_for ("duration_seconds", "h", {{"l", "v"}}));
+      histogram.observe (std::chrono::microseconds (1));
+      histogram.observe (std::chrono::microseconds (3));
+      histogram.observe (std::chrono::seconds (100));
+
+      std::string expected
+        ( "# HELP duration_seconds h\n"
+          "# TYPE duration_seconds histogram\n"
+          "duration_seconds_bucket{l=\"v\",le=\"0.000001\"} 1\n"
+          "duration_seconds_bucket{l=\"v\",le=\"0.000002\"} 1\n"
+        );
+      char const* const cumulative_two[] =
+        { "0.000004", "0.000008", "0.000016", "0.000032", "0.000064"
+        , "0.000128", "0.000256", "0.000512", "0.001024", "0.002048"
+        , "0.004096", "0.008192", "0.016384", "0.032768", "0.065536"
+        , "0.131072", "0.262144", "0.524288", "1.048576", "2.097152"
+        , "4.194304", "8.388608", "16.777216", "33.554432"
+        };
+      for (char const* le : cumulative_two)
+      {
+        expected += "duration_seconds_bucket{l=\"v\",le=\"" + std::string (le)
+                  + "\"} 2\n";
+      }
+      expected += "duration_seconds_bucket{l=\"v\",le=\"+Inf\"} 3\n"
+                  "duration_seconds_sum{l=\"v\"} 100.000004\n"
+                  "duration_seconds_count{l=\"v\"} 3\n";
+
+      BOOST_REQUIRE_EQUAL (prometheus_exposition (registry), expected);
+    }
+  }
+}
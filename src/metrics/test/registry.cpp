@@ -0,0 +1,173 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <metrics/registry.hpp>
+
+#include <util-generic/testing/printer/chrono.hpp>
+#include <util-generic/testing/require_exception.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace fhg
+{
+  namespace metrics
+  {
+    BOOST_AUTO_TEST_CASE (counter_sums_increments_of_all_threads)
+    {
+      counter counter;
+
+      std::size_t const thread_count (2 * shard_count);
+      std::size_t const increments (10000);
+
+      std::vector<std::thread> threads;
+      for (std::size_t i (0); i < thread_count; ++i)
+      {
+        threads.emplace_back
+          ( [&]
+            {
+              for (std::size_t j (0); j < increments; ++j)
+              {
+                counter.increment();
+              }
+              counter.increment (2);
+            }
+          );
+      }
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+      BOOST_REQUIRE_EQUAL (counter.value(), thread_count * (increments + 2));
+    }
+
+    BOOST_AUTO_TEST_CASE (gauge_goes_up_and_down)
+    {
+      gauge gauge;
+      BOOST_REQUIRE_EQUAL (gauge.value(), 0);
+
+      gauge.increment (3);
+      gauge.decrement();
+      BOOST_REQUIRE_EQUAL (gauge.value(), 2);
+
+      gauge.decrement (5);
+      BOOST_REQUIRE_EQUAL (gauge.value(), -3);
+
+      gauge.set (42);
+      BOOST_REQUIRE_EQUAL (gauge.value(), 42);
+    }
+
+    BOOST_AUTO_TEST_CASE (histogram_sorts_into_first_bucket_with_upper_bound_not_less)
+    {
+      histogram histogram;
+
+      histogram.observe (std::chrono::nanoseconds (0));
+      histogram.observe (std::chrono::microseconds (1));
+      histogram.observe (std::chrono::nanoseconds (1001));
+      histogram.observe (std::chrono::microseconds (2));
+      histogram.observe (std::chrono::microseconds (3));
+      histogram.observe (std::chrono::microseconds (1024));
+      histogram.observe (std::chrono::hours (1));
+
+      auto const snapshot (histogram.value());
+
+      BOOST_REQUIRE_EQUAL (snapshot.count, 7);
+      BOOST_REQUIRE_EQUAL (snapshot.buckets[0], 2);
+      BOOST_REQUIRE_EQUAL (snapshot.buckets[1], 2);
+      BOOST_REQUIRE_EQUAL (snapshot.buckets[2], 1);
+      BOOST_REQUIRE_EQUAL (snapshot.buckets[10], 1);
+      BOOST_REQUIRE_EQUAL (snapshot.buckets[histogram::bucket_count], 1);
+      BOOST_REQUIRE_CLOSE
+        (snapshot.sum_in_seconds, 3600.0 + 1031.001e-6, 1e-9);
+    }
+
+    BOOST_AUTO_TEST_CASE (upper_bounds_double_starting_at_one_microsecond)
+    {
+      BOOST_REQUIRE_EQUAL (histogram::upper_bound (0), 1e-6);
+      for (std::size_t bucket (1); bucket < histogram::bucket_count; ++bucket)
+      {
+        BOOST_REQUIRE_EQUAL
+          (histogram::upper_bound (bucket), 2 * histogram::upper_bound (bucket - 1));
+      }
+    }
+
+    BOOST_AUTO_TEST_CASE (scoped_timer_observes_its_lifetime)
+    {
+      histogram histogram;
+
+      {
+        scoped_timer const timer (histogram);
+        std::this_thread::sleep_for (std::chrono::milliseconds (2));
+      }
+
+      auto const snapshot (histogram.value());
+      BOOST_REQUIRE_EQUAL (snapshot.count, 1);
+      BOOST_REQUIRE_GE (snapshot.sum_in_seconds, 2e-3);
+    }
+
+    BOOST_AUTO_TEST_CASE (registry_returns_the_same_metric_for_same_name_and_labels)
+    {
+      registry registry;
+
+      auto& a (registry.counter_for ("a", "help"));
+      auto& a_again (registry.counter_for ("a", "other help"));
+      auto& a_labelled (registry.counter_for ("a", "help", {{"x", "1"}}));
+      auto& a_labelled_again (registry.counter_for ("a", "help", {{"x", "1"}}));
+      auto& a_other_label (registry.counter_for ("a", "help", {{"x", "2"}}));
+
+      BOOST_REQUIRE_EQUAL (&a, &a_again);
+      BOOST_REQUIRE_EQUAL (&a_labelled, &a_labelled_again);
+      BOOST_REQUIRE_NE (&a, &a_labelled);
+      BOOST_REQUIRE_NE (&a_labelled, &a_other_label);
+
+      std::size_t families (0);
+      registry.visit
+        ( [&] (std::string const& name, registry::family const& family)
+          {
+            ++families;
+            BOOST_REQUIRE_EQUAL (name, "a");
+            BOOST_REQUIRE_EQUAL (family.help, "help");
+            BOOST_REQUIRE_EQUAL (family.metrics.size(), 3);
+          }
+        );
+      BOOST_REQUIRE_EQUAL (families, 1);
+    }
+
+    BOOST_AUTO_TEST_CASE (registry_throws_when_types_differ)
+    {
+      registry registry;
+
+      registry.counter_for ("a", "help");
+
+      util::testing::require_exception
+        ( [&] { registry.gauge_for ("a", "help"); }
+        , std::logic_error
+            ("metric 'a' already registered with a different type")
+        );
+      util::testing::require_exception
+        ( [&] { registry.histogram_for ("a", "help"); }
+        , std::logic_error
+            ("metric 'a' already registered with a different type")
+        );
+    }
+  }
+}
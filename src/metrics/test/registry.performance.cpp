@@ -0,0 +1,119 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <metrics/registry.hpp>
+
+#include <util-generic/testing/measure_average_time.hpp>
+#include <util-generic/testing/printer/chrono.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+//! \note The instrumented hot paths do a few updates per event, job or
+//! transfer, each taking microseconds at least: updates need to stay
+//! in the order of nanoseconds to keep the overhead below 1%.
+
+namespace fhg
+{
+  namespace metrics
+  {
+    namespace
+    {
+      std::size_t const repetitions (1 << 20);
+
+      template<typename Update>
+        std::chrono::nanoseconds average_update_time_with_concurrent_threads
+          (std::size_t thread_count, Update update)
+      {
+        std::vector<std::future<std::chrono::nanoseconds>> times;
+        for (std::size_t i (0); i < thread_count; ++i)
+        {
+          times.emplace_back
+            ( std::async
+                ( std::launch::async
+                , [&]
+                  {
+                    return util::testing::measure_average_time
+                      <std::chrono::nanoseconds> (update, repetitions);
+                  }
+                )
+            );
+        }
+
+        std::chrono::nanoseconds max (0);
+        for (auto& time : times)
+        {
+          max = std::max (max, time.get());
+        }
+        return max;
+      }
+
+      std::size_t concurrency()
+      {
+        return std::max (2u, std::thread::hardware_concurrency());
+      }
+    }
+
+    BOOST_AUTO_TEST_CASE (counter_increment_is_cheap_even_when_contended)
+    {
+      counter counter;
+
+      BOOST_REQUIRE_LE
+        ( average_update_time_with_concurrent_threads
+            (1, [&] { counter.increment(); })
+        , std::chrono::nanoseconds (20)
+        );
+      BOOST_REQUIRE_LE
+        ( average_update_time_with_concurrent_threads
+            (concurrency(), [&] { counter.increment(); })
+        , std::chrono::nanoseconds (100)
+        );
+    }
+
+    BOOST_AUTO_TEST_CASE (histogram_observation_is_cheap_even_when_contended)
+    {
+      histogram histogram;
+
+      BOOST_REQUIRE_LE
+        ( average_update_time_with_concurrent_threads
+            (1, [&] { histogram.observe (std::chrono::microseconds (20)); })
+        , std::chrono::nanoseconds (30)
+        );
+      BOOST_REQUIRE_LE
+        ( average_update_time_with_concurrent_threads
+            ( concurrency()
+            , [&] { histogram.observe (std::chrono::microseconds (20)); }
+            )
+        , std::chrono::nanoseconds (150)
+        );
+    }
+
+    BOOST_AUTO_TEST_CASE (scoped_timer_is_cheap)
+    {
+      histogram histogram;
+
+      BOOST_REQUIRE_LE
+        ( average_update_time_with_concurrent_threads
+            (1, [&] { scoped_timer const timer (histogram); })
+        , std::chrono::nanoseconds (150)
+        );
+    }
+  }
+}
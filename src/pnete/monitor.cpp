@@ -15,6 +15,8 @@
 // along with this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <pnete/ui/execution_monitor.hpp>
+#include <pnete/ui/execution_monitor_time_buckets.hpp>
+#include <pnete/ui/execution_monitor_worker_model.hpp>
 #include <pnete/ui/log_monitor.hpp>
 
 #include <logging/stream_receiver.hpp>
@@ -22,19 +24,26 @@
 
 #include <fhg/revision.hpp>
 #include <fhg/util/boost/program_options/generic.hpp>
+#include <fhg/util/boost/program_options/validators/existing_directory.hpp>
 #include <fhg/util/boost/program_options/validators/positive_integral.hpp>
+#include <fhg/util/signal_handler_manager.hpp>
 #include <util-generic/print_exception.hpp>
 #include <util-generic/wait_and_collect_exceptions.hpp>
 
 #include <util-qt/message_box.hpp>
 #include <util-qt/scoped_until_qt_owned_ptr.hpp>
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 #include <boost/program_options.hpp>
 #include <boost/utility/in_place_factory.hpp>
 
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMetaObject>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
+#include <QtCore/QTimer>
 #include <QtWidgets/QAction>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QInputDialog>
@@ -42,7 +51,11 @@
 #include <QtWidgets/QMenuBar>
 #include <QtWidgets/QTabWidget>
 
+#include <atomic>
+#include <csignal>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -56,6 +69,138 @@ namespace
       {"emitters", "list of tcp emitters"};
     po::option<unsigned short> const port
       {"port", "a port to listen on for new emitters"};
+
+    po::option<boost::filesystem::path> const headless_trace
+      { "headless-trace"
+      , "do not open a window but periodically write the aggregated "
+        "execution trace to the given file"
+      };
+    po::option<long, po::positive_integral<long>> const
+      headless_trace_resolution
+        { "headless-trace-resolution"
+        , "width in msec of the buckets aggregated in the headless trace, "
+          "at least 1000: it is rounded down to 1000 * 4^n and every line of "
+          "the trace is a single bucket, neighbours are not merged"
+        , 1000L
+        };
+    po::option<std::size_t, po::positive_integral<std::size_t>> const
+      max_intervals_in_memory
+        { "max-intervals-in-memory"
+        , "per worker, move older intervals to the spill directory once "
+          "there are more than this many"
+        };
+    po::option<boost::filesystem::path, po::existing_directory> const
+      spill_directory
+        { "spill-directory"
+        , "directory to move intervals to (default: temporary directory)"
+        };
+  }
+
+  //! \note write to a sibling and rename, so that readers never see
+  //! a partially written trace
+  void write_aggregated_trace
+    ( fhg::pnete::ui::worker_model const& model
+    , boost::filesystem::path const& path
+    , long resolution
+    )
+  {
+    boost::filesystem::path const temporary (path.string() + ".tmp");
+    {
+      std::ofstream stream (temporary.string());
+      model.write_aggregated_trace (stream, resolution);
+      if (!stream)
+      {
+        throw std::runtime_error ("could not write " + temporary.string());
+      }
+    }
+    boost::filesystem::rename (temporary, path);
+  }
+
+  int headless
+    ( int ac, char *av[]
+    , boost::program_options::variables_map const& vm
+    , boost::filesystem::path const& trace
+    , boost::optional<fhg::pnete::ui::worker_model::memory_bound> memory_bound
+    )
+  {
+    QCoreApplication a (ac, av);
+
+    fhg::pnete::ui::worker_model model (nullptr, memory_bound);
+
+    fhg::logging::stream_receiver log_receiver
+      ( option::emitters.get_from_or_value (vm, {})
+      , [&] (fhg::logging::message const& message)
+        {
+          model.append_event (message);
+        }
+      );
+
+    boost::optional<fhg::logging::tcp_server_providing_add_emitters>
+      tcp_server_providing_add_emitters;
+    auto const port (option::port.get<unsigned short> (vm));
+    if (port)
+    {
+      tcp_server_providing_add_emitters = boost::in_place (&log_receiver, *port);
+    }
+
+    long const resolution
+      (option::headless_trace_resolution.get_from (vm));
+    if (resolution < fhg::pnete::ui::time_bucket_index::default_finest_width)
+    {
+      throw std::invalid_argument
+        ( "--headless-trace-resolution has to be at least "
+        + std::to_string
+            (fhg::pnete::ui::time_bucket_index::default_finest_width)
+        + " msec"
+        );
+    }
+    auto const write_trace
+      ( [&]
+        {
+          //! \note include what is still queued in the model
+          QMetaObject::invokeMethod (&model, "handle_events");
+
+          try
+          {
+            write_aggregated_trace (model, trace, resolution);
+          }
+          catch (...)
+          {
+            std::cerr << "could not write trace: "
+                      << fhg::util::current_exception_printer() << '\n';
+          }
+        }
+      );
+
+    QTimer periodic_write;
+    QObject::connect (&periodic_write, &QTimer::timeout, write_trace);
+    periodic_write.start (10000);
+
+    std::atomic<bool> stop_requested (false);
+    fhg::util::signal_handler_manager signal_handlers;
+    fhg::util::scoped_signal_handler const SIGTERM_handler
+      (signal_handlers, SIGTERM, [&] (int, siginfo_t*, void*) { stop_requested = true; });
+    fhg::util::scoped_signal_handler const SIGINT_handler
+      (signal_handlers, SIGINT, [&] (int, siginfo_t*, void*) { stop_requested = true; });
+
+    QTimer check_stop_requested;
+    QObject::connect
+      ( &check_stop_requested, &QTimer::timeout
+      , [&]
+        {
+          if (stop_requested)
+          {
+            QCoreApplication::quit();
+          }
+        }
+      );
+    check_stop_requested.start (100);
+
+    int const result (a.exec());
+
+    write_trace();
+
+    return result;
   }
 }
 
@@ -66,9 +211,28 @@ try
     ( fhg::util::boost::program_options::options ("GPI-Space monitor")
     . add (option::emitters)
     . add (option::port)
+    . add (option::headless_trace)
+    . add (option::headless_trace_resolution)
+    . add (option::max_intervals_in_memory)
+    . add (option::spill_directory)
     . store_and_notify (ac, av)
     );
 
+  boost::optional<fhg::pnete::ui::worker_model::memory_bound> memory_bound;
+  if (auto const intervals = option::max_intervals_in_memory.get (vm))
+  {
+    memory_bound = fhg::pnete::ui::worker_model::memory_bound
+      { *intervals
+      , option::spill_directory.get_from_or_value
+          (vm, boost::filesystem::temp_directory_path())
+      };
+  }
+
+  if (auto const trace = option::headless_trace.get (vm))
+  {
+    return headless (ac, av, vm, *trace, memory_bound);
+  }
+
   QApplication a (ac, av);
 
   QApplication::setApplicationName ("gspc-monitor");
@@ -82,7 +246,8 @@ try
   QMainWindow window;
   fhg::util::qt::scoped_until_qt_owned_ptr<QTabWidget> tabs;
   fhg::util::qt::scoped_until_qt_owned_ptr<log_monitor> logging;
-  fhg::util::qt::scoped_until_qt_owned_ptr<fhg::pnete::ui::execution_monitor> gantt;
+  fhg::util::qt::scoped_until_qt_owned_ptr<fhg::pnete::ui::execution_monitor>
+    gantt (memory_bound);
   tabs->addTab (gantt.release(), QObject::tr ("Execution Monitor"));
   tabs->addTab (logging.release(), QObject::tr ("Logging"));
   window.setCentralWidget (tabs.release());
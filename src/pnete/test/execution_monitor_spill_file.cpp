@@ -0,0 +1,101 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <pnete/ui/execution_monitor_spill_file.hpp>
+
+#include <util-generic/temporary_path.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace fhg
+{
+  namespace pnete
+  {
+    namespace ui
+    {
+      namespace
+      {
+        interval_spill_file::interval interval_at (long timestamp)
+        {
+          return { timestamp
+                 , 5
+                 , sdpa::daemon::NotificationEvent::STATE_FINISHED
+                 , "id-" + std::to_string (timestamp)
+                 , "name"
+                 };
+        }
+      }
+
+      BOOST_AUTO_TEST_CASE (file_is_removed_on_destruction)
+      {
+        util::temporary_path const directory;
+
+        boost::filesystem::path path;
+        {
+          interval_spill_file file (directory);
+          file.append (interval_at (0));
+          path = file.path();
+
+          BOOST_REQUIRE (boost::filesystem::exists (path));
+        }
+
+        BOOST_REQUIRE (!boost::filesystem::exists (path));
+      }
+
+      BOOST_AUTO_TEST_CASE (read_returns_intersecting_intervals_in_order)
+      {
+        util::temporary_path const directory;
+        interval_spill_file file (directory);
+
+        //! \note more than one index stride
+        for (long t (0); t < 50000; t += 10)
+        {
+          file.append (interval_at (t));
+        }
+        BOOST_REQUIRE_EQUAL (file.size(), 5000);
+
+        auto const intervals (file.read (20003, 20031));
+
+        BOOST_REQUIRE_EQUAL (intervals.size(), 4);
+        BOOST_REQUIRE_EQUAL (intervals[0].timestamp, 20000);
+        BOOST_REQUIRE_EQUAL (intervals[0].id, "id-20000");
+        BOOST_REQUIRE_EQUAL (intervals[0].name, "name");
+        BOOST_REQUIRE_EQUAL (intervals[0].duration, 5);
+        BOOST_REQUIRE_EQUAL
+          (intervals[0].state, sdpa::daemon::NotificationEvent::STATE_FINISHED);
+        BOOST_REQUIRE_EQUAL (intervals[3].timestamp, 20030);
+
+        BOOST_REQUIRE (file.read (20005, 20010).empty());
+        BOOST_REQUIRE (file.read (60000, 70000).empty());
+        BOOST_REQUIRE_EQUAL (file.read (-10, 100000).size(), 5000);
+      }
+
+      BOOST_AUTO_TEST_CASE (out_of_order_append_throws)
+      {
+        util::temporary_path const directory;
+        interval_spill_file file (directory);
+
+        file.append (interval_at (100));
+
+        BOOST_REQUIRE_THROW (file.append (interval_at (102)), std::logic_error);
+      }
+    }
+  }
+}
@@ -0,0 +1,259 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <pnete/ui/execution_monitor_time_buckets.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+namespace fhg
+{
+  namespace pnete
+  {
+    namespace ui
+    {
+      namespace
+      {
+        constexpr auto const started
+          (sdpa::daemon::NotificationEvent::STATE_STARTED);
+        constexpr auto const finished
+          (sdpa::daemon::NotificationEvent::STATE_FINISHED);
+        constexpr auto const failed
+          (sdpa::daemon::NotificationEvent::STATE_FAILED);
+      }
+
+      BOOST_AUTO_TEST_CASE (invalid_configurations_are_rejected)
+      {
+        BOOST_REQUIRE_THROW (time_bucket_index (0, 4, 10), std::invalid_argument);
+        BOOST_REQUIRE_THROW (time_bucket_index (10, 1, 10), std::invalid_argument);
+        BOOST_REQUIRE_THROW (time_bucket_index (10, 4, 0), std::invalid_argument);
+        BOOST_REQUIRE_THROW
+          (time_bucket_index (10, 4, 10, 0), std::invalid_argument);
+      }
+
+      BOOST_AUTO_TEST_CASE (levels_grow_by_fan_out)
+      {
+        time_bucket_index const index (10, 4, 3);
+
+        BOOST_REQUIRE_EQUAL (index.levels(), 3);
+        BOOST_REQUIRE_EQUAL (index.width (0), 10);
+        BOOST_REQUIRE_EQUAL (index.width (1), 40);
+        BOOST_REQUIRE_EQUAL (index.width (2), 160);
+      }
+
+      BOOST_AUTO_TEST_CASE (level_for_picks_coarsest_level_within_resolution)
+      {
+        time_bucket_index const index (10, 4, 3);
+
+        BOOST_REQUIRE_EQUAL (index.level_for (1), 0);
+        BOOST_REQUIRE_EQUAL (index.level_for (10), 0);
+        BOOST_REQUIRE_EQUAL (index.level_for (39), 0);
+        BOOST_REQUIRE_EQUAL (index.level_for (40), 1);
+        BOOST_REQUIRE_EQUAL (index.level_for (1000), 2);
+      }
+
+      BOOST_AUTO_TEST_CASE (busy_time_is_split_over_buckets)
+      {
+        time_bucket_index index (10, 4, 2);
+        index.add (5, 25, finished);
+
+        auto const spans (index.spans (0, 0, 40));
+
+        //! \note same dominant state, thus merged
+        BOOST_REQUIRE_EQUAL (spans.size(), 1);
+        BOOST_REQUIRE_EQUAL (spans[0].begin, 0);
+        BOOST_REQUIRE_EQUAL (spans[0].end, 30);
+        BOOST_REQUIRE_EQUAL (spans[0].intervals, 1);
+        BOOST_REQUIRE_EQUAL (spans[0].busy[finished], 20);
+        BOOST_REQUIRE_EQUAL (spans[0].busy[failed], 0);
+
+        auto const coarse (index.spans (1, 0, 40));
+        BOOST_REQUIRE_EQUAL (coarse.size(), 1);
+        BOOST_REQUIRE_EQUAL (coarse[0].begin, 0);
+        BOOST_REQUIRE_EQUAL (coarse[0].end, 40);
+        BOOST_REQUIRE_EQUAL (coarse[0].busy[finished], 20);
+      }
+
+      BOOST_AUTO_TEST_CASE (neighbours_are_not_merged_if_not_asked_for)
+      {
+        time_bucket_index index (10, 4, 1);
+        index.add (5, 25, finished);
+
+        auto const spans (index.spans (0, 0, 40, false));
+
+        BOOST_REQUIRE_EQUAL (spans.size(), 3);
+        BOOST_REQUIRE_EQUAL (spans[0].begin, 0);
+        BOOST_REQUIRE_EQUAL (spans[0].end, 10);
+        BOOST_REQUIRE_EQUAL (spans[0].intervals, 1);
+        BOOST_REQUIRE_EQUAL (spans[1].intervals, 0);
+        BOOST_REQUIRE_EQUAL (spans[2].end, 30);
+        BOOST_REQUIRE_EQUAL (spans[2].busy[finished], 5);
+      }
+
+      BOOST_AUTO_TEST_CASE (only_non_empty_buckets_are_stored)
+      {
+        time_bucket_index index (10, 4, 3);
+        index.add (0, 1, finished);
+        index.add (1000000000000L, 1000000000001L, failed);
+
+        for (std::size_t level (0); level < index.levels(); ++level)
+        {
+          BOOST_REQUIRE_EQUAL (index.buckets (level), 2);
+        }
+
+        auto const spans (index.spans (0, index.begin(), index.end()));
+        BOOST_REQUIRE_EQUAL (spans.size(), 2);
+        BOOST_REQUIRE_EQUAL (spans[1].begin, 1000000000000L);
+        BOOST_REQUIRE_EQUAL (spans[1].dominant_state(), failed);
+      }
+
+      BOOST_AUTO_TEST_CASE (older_ranges_are_answered_from_coarser_levels)
+      {
+        time_bucket_index index (10, 4, 3, 4);
+        for (long t (0); t < 1000; t += 10)
+        {
+          index.add (t, t + 10, finished);
+        }
+
+        BOOST_REQUIRE_EQUAL (index.buckets (0), 4);
+        BOOST_REQUIRE_EQUAL (index.buckets (1), 4);
+        BOOST_REQUIRE_EQUAL (index.buckets (2), 7);
+
+        //! \note evicted from the finer levels
+        index.add (5, 6, failed);
+
+        auto const spans (index.spans (0, 0, 1000, false));
+
+        BOOST_REQUIRE_EQUAL (spans.size(), 10);
+        BOOST_REQUIRE_EQUAL (spans.front().begin, 0);
+        BOOST_REQUIRE_EQUAL (spans.front().end, 160);
+        BOOST_REQUIRE_EQUAL (spans.front().busy[failed], 1);
+        BOOST_REQUIRE_EQUAL (spans[5].end, 960);
+        BOOST_REQUIRE_EQUAL (spans[6].begin, 960);
+        BOOST_REQUIRE_EQUAL (spans[6].end, 970);
+        BOOST_REQUIRE_EQUAL (spans.back().end, 1000);
+
+        long busy (0);
+        std::size_t intervals (0);
+        for (auto const& span : spans)
+        {
+          busy += span.busy[finished];
+          intervals += span.intervals;
+        }
+        BOOST_REQUIRE_EQUAL (busy, 1000);
+        BOOST_REQUIRE_EQUAL (intervals, 101);
+        BOOST_REQUIRE_EQUAL (index.intervals_in (0, 1000), 101);
+      }
+
+      BOOST_AUTO_TEST_CASE (long_intervals_respect_the_bucket_limit)
+      {
+        time_bucket_index index (10, 4, 2, 4);
+        index.add (0, 1000, started);
+
+        BOOST_REQUIRE_EQUAL (index.buckets (0), 4);
+        BOOST_REQUIRE_EQUAL (index.buckets (1), 25);
+
+        auto const spans (index.spans (0, 0, 1000, false));
+
+        BOOST_REQUIRE_EQUAL (spans.size(), 24 + 4);
+        BOOST_REQUIRE_EQUAL (spans.back().begin, 990);
+
+        long busy (0);
+        for (auto const& span : spans)
+        {
+          busy += span.busy[started];
+        }
+        BOOST_REQUIRE_EQUAL (busy, 1000);
+        BOOST_REQUIRE_EQUAL (index.intervals_in (0, 1000), 1);
+      }
+
+      BOOST_AUTO_TEST_CASE (spans_report_dominant_state_and_skip_gaps)
+      {
+        time_bucket_index index (10, 4, 1);
+        index.add (0, 7, finished);
+        index.add (7, 10, failed);
+        index.add (30, 31, failed);
+
+        auto const spans (index.spans (0, 0, 100));
+
+        BOOST_REQUIRE_EQUAL (spans.size(), 2);
+        BOOST_REQUIRE_EQUAL (spans[0].dominant_state(), finished);
+        BOOST_REQUIRE_EQUAL (spans[0].intervals, 2);
+        BOOST_REQUIRE_EQUAL (spans[1].begin, 30);
+        BOOST_REQUIRE_EQUAL (spans[1].dominant_state(), failed);
+      }
+
+      BOOST_AUTO_TEST_CASE (spans_are_limited_to_requested_range)
+      {
+        time_bucket_index index (10, 4, 1);
+        for (long t (0); t < 1000; t += 10)
+        {
+          index.add (t, t + 10, t % 20 ? started : finished);
+        }
+
+        auto const spans (index.spans (0, 500, 530));
+
+        BOOST_REQUIRE_EQUAL (spans.size(), 3);
+        BOOST_REQUIRE_EQUAL (spans.front().begin, 500);
+        BOOST_REQUIRE_EQUAL (spans.back().end, 530);
+      }
+
+      BOOST_AUTO_TEST_CASE (zero_length_intervals_are_counted)
+      {
+        time_bucket_index index (10, 4, 1);
+        index.add (3, 3, failed);
+
+        auto const spans (index.spans (0, 0, 10));
+
+        BOOST_REQUIRE_EQUAL (spans.size(), 1);
+        BOOST_REQUIRE_EQUAL (spans[0].dominant_state(), failed);
+        BOOST_REQUIRE_EQUAL (index.intervals_in (0, 10), 1);
+      }
+
+      BOOST_AUTO_TEST_CASE (intervals_in_counts_intervals_beginning_in_range)
+      {
+        time_bucket_index index (10, 4, 6);
+        BOOST_REQUIRE_EQUAL (index.intervals_in (0, 1000000), 0);
+
+        for (long t (0); t < 100000; t += 5)
+        {
+          index.add (t, t + 5, finished);
+        }
+
+        BOOST_REQUIRE_EQUAL (index.intervals_in (0, 100000), 20000);
+        BOOST_REQUIRE_EQUAL (index.intervals_in (-1000, 0), 0);
+        BOOST_REQUIRE_GE (index.intervals_in (0, 50000), 10000);
+        BOOST_REQUIRE_LE (index.intervals_in (0, 50000), 20000);
+      }
+
+      BOOST_AUTO_TEST_CASE (negative_timestamps_are_bucketed_correctly)
+      {
+        time_bucket_index index (10, 4, 1);
+        index.add (-15, -5, finished);
+
+        auto const spans (index.spans (0, -100, 100));
+
+        BOOST_REQUIRE_EQUAL (spans.size(), 1);
+        BOOST_REQUIRE_EQUAL (spans[0].begin, -20);
+        BOOST_REQUIRE_EQUAL (spans[0].end, 0);
+        BOOST_REQUIRE_EQUAL (spans[0].busy[finished], 10);
+        BOOST_REQUIRE_EQUAL (index.begin(), -15);
+        BOOST_REQUIRE_EQUAL (index.end(), -5);
+      }
+    }
+  }
+}
@@ -31,6 +31,8 @@
 #include <util/qt/treeview_with_delete.hpp>
 #include <util-qt/variant.hpp>
 
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
 #include <boost/serialization/export.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 
@@ -304,7 +306,8 @@ namespace fhg
         }
       }
 
-      execution_monitor::execution_monitor()
+      execution_monitor::execution_monitor
+          (boost::optional<worker_model::memory_bound> memory_bound)
         : QSplitter (Qt::Horizontal)
       {
         util::qt::mvc::transform_functions_model* available_transform_functions
@@ -318,7 +321,7 @@ namespace fhg
 
         QAbstractItemModel* next (nullptr);
 
-        base = new worker_model (this);
+        base = new worker_model (this, memory_bound);
         next = base;
 
         util::qt::mvc::flat_to_tree_proxy* transformed_to_tree
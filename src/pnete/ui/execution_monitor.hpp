@@ -18,6 +18,10 @@
 
 #include <logging/message.hpp>
 
+#include <pnete/ui/execution_monitor_worker_model.hpp>
+
+#include <boost/optional.hpp>
+
 #include <QSplitter>
 
 #include <vector>
@@ -28,14 +32,13 @@ namespace fhg
   {
     namespace ui
     {
-      class worker_model;
-
       class execution_monitor : public QSplitter
       {
         Q_OBJECT
 
       public:
-        execution_monitor();
+        execution_monitor
+          (boost::optional<worker_model::memory_bound> = boost::none);
 
         void append_event (logging::message const&);
 
@@ -528,67 +528,111 @@ namespace fhg
           const qreal horizontal_scale
             (qreal (rect.width()) / qreal (visible_range.length()));
 
-          for (worker_model::subrange_getter_type range : subrange_getters)
-          {
-            for (const worker_model::value_type& data : range (from, to))
-            {
-              const qreal left (std::max (from, data.timestamp()));
-              paint_description::block block
-                ( QRectF ( qreal (rect.x())
-                         + (left - from) * horizontal_scale
-                         , rect.top()
-                         , ( ( data.duration()
-                             ? std::min (to, data.timestamp() + *data.duration())
-                             : to
-                             )
-                           - left
-                           ) * horizontal_scale
-                         , descr.height
-                         )
-                , data.id()
-                );
-
-              QVector<paint_description::block>& blocks_in_state
-                (descr.blocks[data.state()]);
-
-              static const qreal merge_threshold (2.0);
-
-              if (merge_away_small_intervals)
+          //! \note msec per pixel: rows with more intervals than
+          //! pixels are painted from aggregated spans
+          const long resolution
+            (std::max (1L, visible_range.length() / std::max (1, rect.width())));
+
+          const auto add_block
+            ( [&] ( worker_model::state_type state
+                  , long begin
+                  , long end
+                  , QString label
+                  )
               {
-                QVector<paint_description::block>::iterator inter
-                  ( std::lower_bound
-                    ( blocks_in_state.begin(), blocks_in_state.end()
-                    , block.rect
-                    , std::bind (&overlaps, std::placeholders::_1, std::placeholders::_2, merge_threshold)
-                    )
+                const qreal left (std::max (from, begin));
+                paint_description::block block
+                  ( QRectF ( qreal (rect.x())
+                           + (left - from) * horizontal_scale
+                           , rect.top()
+                           , (std::min (to, end) - left) * horizontal_scale
+                           , descr.height
+                           )
+                  , label
                   );
 
-                while (inter != blocks_in_state.end())
+                QVector<paint_description::block>& blocks_in_state
+                  (descr.blocks[state]);
+
+                static const qreal merge_threshold (2.0);
+
+                if (merge_away_small_intervals)
                 {
+                  QVector<paint_description::block>::iterator inter
+                    ( std::lower_bound
+                      ( blocks_in_state.begin(), blocks_in_state.end()
+                      , block.rect
+                      , std::bind (&overlaps, std::placeholders::_1, std::placeholders::_2, merge_threshold)
+                      )
+                    );
+
+                  while (inter != blocks_in_state.end())
                   {
-                    temporarily_widen _ (&inter->rect, merge_threshold);
-                    if (!intersects_or_touches (inter->rect, block.rect))
                     {
-                      break;
+                      temporarily_widen _ (&inter->rect, merge_threshold);
+                      if (!intersects_or_touches (inter->rect, block.rect))
+                      {
+                        break;
+                      }
                     }
-                  }
 
-                  block.rect.setRight
-                    (std::max (block.rect.right(), inter->rect.right()));
-                  block.rect.setLeft
-                    (std::min (block.rect.left(), inter->rect.left()));
-                  block.subranges += inter->subranges;
+                    block.rect.setRight
+                      (std::max (block.rect.right(), inter->rect.right()));
+                    block.rect.setLeft
+                      (std::min (block.rect.left(), inter->rect.left()));
+                    block.subranges += inter->subranges;
 
-                  inter = blocks_in_state.erase (inter);
+                    inter = blocks_in_state.erase (inter);
+                  }
+
+                  blocks_in_state.insert (inter, block);
+                }
+                else
+                {
+                  blocks_in_state.push_back (block);
                 }
+              }
+            );
 
-                blocks_in_state.insert (inter, block);
+          for (worker_model::subrange_getter_type range : subrange_getters)
+          {
+            const worker_model::row_slice slice (range (from, to, resolution));
+
+            for (const worker_model::span_type& span : slice.spans)
+            {
+              const QString label (QString ("%1 tasks").arg (span.intervals));
+
+              if (descr.distribute_vertically)
+              {
+                for ( std::size_t state (0)
+                    ; state < time_bucket_index::state_count
+                    ; ++state
+                    )
+                {
+                  if (span.busy[state] > 0)
+                  {
+                    add_block ( static_cast<worker_model::state_type> (state)
+                              , span.begin, span.end, label
+                              );
+                  }
+                }
               }
               else
               {
-                blocks_in_state.push_back (block);
+                add_block (span.dominant_state(), span.begin, span.end, label);
               }
             }
+
+            for (const worker_model::value_type& data : slice.intervals)
+            {
+              add_block ( data.state()
+                        , data.timestamp()
+                        , data.duration()
+                        ? data.timestamp() + *data.duration()
+                        : to
+                        , data.id()
+                        );
+            }
           }
           return descr;
         }
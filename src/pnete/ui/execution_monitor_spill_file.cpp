@@ -0,0 +1,197 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <pnete/ui/execution_monitor_spill_file.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace fhg
+{
+  namespace pnete
+  {
+    namespace ui
+    {
+      namespace
+      {
+        constexpr std::size_t const index_stride (1024);
+
+        template<typename T> void write_pod (std::ostream& os, T const& x)
+        {
+          os.write (reinterpret_cast<char const*> (&x), sizeof (x));
+        }
+        template<typename T> T read_pod (std::istream& is)
+        {
+          T x;
+          is.read (reinterpret_cast<char*> (&x), sizeof (x));
+          return x;
+        }
+
+        void write_string (std::ostream& os, std::string const& s)
+        {
+          write_pod (os, std::uint32_t (s.size()));
+          os.write (s.data(), s.size());
+        }
+        std::string read_string (std::istream& is)
+        {
+          std::string s (read_pod<std::uint32_t> (is), '\0');
+          is.read (&s[0], s.size());
+          return s;
+        }
+
+        std::uint64_t record_size (interval_spill_file::interval const& i)
+        {
+          return sizeof (std::int64_t) + sizeof (std::int64_t)
+            + sizeof (std::int32_t)
+            + sizeof (std::uint32_t) + i.id.size()
+            + sizeof (std::uint32_t) + i.name.size();
+        }
+      }
+
+      interval_spill_file::interval_spill_file
+          (boost::filesystem::path directory)
+        : _path ( directory
+                / boost::filesystem::unique_path
+                    ("gspc-monitor-%%%%-%%%%-%%%%-%%%%.intervals")
+                )
+        , _stream (_path.string(), std::ios::binary | std::ios::trunc)
+        , _offset (0)
+        , _size (0)
+        , _end()
+        , _index()
+      {
+        if (!_stream)
+        {
+          throw std::runtime_error
+            ("could not open spill file " + _path.string());
+        }
+      }
+
+      interval_spill_file::~interval_spill_file()
+      {
+        _stream.close();
+        boost::system::error_code ignored;
+        boost::filesystem::remove (_path, ignored);
+      }
+
+      void interval_spill_file::append (interval const& i)
+      {
+        if (_end && i.timestamp < *_end)
+        {
+          throw std::logic_error
+            ("spill file: intervals have to be appended in order");
+        }
+
+        if (_size % index_stride == 0)
+        {
+          _index.emplace_back (i.timestamp, _offset);
+        }
+
+        write_pod (_stream, std::int64_t (i.timestamp));
+        write_pod (_stream, std::int64_t (i.duration));
+        write_pod (_stream, std::int32_t (i.state));
+        write_string (_stream, i.id);
+        write_string (_stream, i.name);
+
+        if (!_stream)
+        {
+          throw std::runtime_error
+            ("could not write to spill file " + _path.string());
+        }
+
+        _offset += record_size (i);
+        ++_size;
+        _end = i.timestamp + i.duration;
+      }
+
+      std::vector<interval_spill_file::interval> interval_spill_file::read
+        (timestamp_type from, timestamp_type to) const
+      {
+        std::vector<interval> intervals;
+
+        if (_index.empty() || !_end || *_end <= from)
+        {
+          return intervals;
+        }
+
+        _stream.flush();
+
+        //! \note the record at the checkpoint begins not later than
+        //! from, records before it thus end before from
+        auto checkpoint
+          ( std::upper_bound
+              ( _index.begin(), _index.end(), from
+              , [] ( timestamp_type t
+                   , std::pair<timestamp_type, std::uint64_t> const& entry
+                   )
+                {
+                  return t < entry.first;
+                }
+              )
+          );
+        if (checkpoint != _index.begin())
+        {
+          --checkpoint;
+        }
+
+        std::ifstream stream (_path.string(), std::ios::binary);
+        stream.seekg (checkpoint->second);
+
+        for ( std::uint64_t offset (checkpoint->second)
+            ; offset < _offset
+            ; )
+        {
+          interval i;
+          i.timestamp = read_pod<std::int64_t> (stream);
+          i.duration = read_pod<std::int64_t> (stream);
+          i.state = static_cast<state_type> (read_pod<std::int32_t> (stream));
+          i.id = read_string (stream);
+          i.name = read_string (stream);
+
+          if (!stream)
+          {
+            throw std::runtime_error
+              ("could not read from spill file " + _path.string());
+          }
+
+          offset += record_size (i);
+
+          if (i.timestamp >= to)
+          {
+            break;
+          }
+          if (i.timestamp + i.duration > from)
+          {
+            intervals.emplace_back (std::move (i));
+          }
+        }
+
+        return intervals;
+      }
+
+      std::size_t interval_spill_file::size() const
+      {
+        return _size;
+      }
+      boost::filesystem::path const& interval_spill_file::path() const
+      {
+        return _path;
+      }
+    }
+  }
+}
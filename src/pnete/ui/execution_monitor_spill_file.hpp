@@ -0,0 +1,82 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <sdpa/daemon/NotificationEvent.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fhg
+{
+  namespace pnete
+  {
+    namespace ui
+    {
+      //! \note Append-only on-disk store for finished intervals of
+      //! one worker that were evicted from memory. Intervals have to
+      //! be appended in order and must not overlap, which allows to
+      //! find a range via a sparse in-memory index. The file is
+      //! removed on destruction.
+      class interval_spill_file
+      {
+      public:
+        typedef long timestamp_type;
+        typedef sdpa::daemon::NotificationEvent::state_t state_type;
+
+        struct interval
+        {
+          timestamp_type timestamp;
+          timestamp_type duration;
+          state_type state;
+          std::string id;
+          std::string name;
+        };
+
+        interval_spill_file (boost::filesystem::path directory);
+        ~interval_spill_file();
+        interval_spill_file (interval_spill_file const&) = delete;
+        interval_spill_file& operator= (interval_spill_file const&) = delete;
+        interval_spill_file (interval_spill_file&&) = delete;
+        interval_spill_file& operator= (interval_spill_file&&) = delete;
+
+        void append (interval const&);
+
+        //! \note all stored intervals intersecting [from, to)
+        std::vector<interval> read (timestamp_type from, timestamp_type to) const;
+
+        std::size_t size() const;
+        boost::filesystem::path const& path() const;
+
+      private:
+        boost::filesystem::path const _path;
+        mutable std::ofstream _stream;
+        std::uint64_t _offset;
+        std::size_t _size;
+        boost::optional<timestamp_type> _end;
+        //! \note (timestamp, offset) of every index_stride'th record
+        std::vector<std::pair<timestamp_type, std::uint64_t>> _index;
+      };
+    }
+  }
+}
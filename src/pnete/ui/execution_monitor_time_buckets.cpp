@@ -0,0 +1,310 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <pnete/ui/execution_monitor_time_buckets.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace fhg
+{
+  namespace pnete
+  {
+    namespace ui
+    {
+      constexpr std::size_t time_bucket_index::state_count;
+      constexpr time_bucket_index::timestamp_type
+        time_bucket_index::default_finest_width;
+
+      namespace
+      {
+        long floor_div (long x, long d)
+        {
+          return x / d - (x % d != 0 && x < 0);
+        }
+
+        //! \note ask for about this many buckets when only counting
+        constexpr long const counting_buckets (64);
+
+        constexpr long const nothing_evicted
+          (std::numeric_limits<long>::min());
+      }
+
+      time_bucket_index::state_type
+        time_bucket_index::span::dominant_state() const
+      {
+        return static_cast<state_type>
+          (std::max_element (busy.begin(), busy.end()) - busy.begin());
+      }
+
+      time_bucket_index::time_bucket_index ( timestamp_type finest_width
+                                           , std::size_t fan_out
+                                           , std::size_t levels
+                                           , std::size_t buckets_per_level
+                                           )
+        : _levels()
+        , _buckets_per_level (buckets_per_level)
+        , _begin (std::numeric_limits<timestamp_type>::max())
+        , _end (std::numeric_limits<timestamp_type>::min())
+      {
+        if ( finest_width <= 0 || fan_out < 2 || levels == 0
+           || buckets_per_level == 0
+           )
+        {
+          throw std::invalid_argument
+            ( "time_bucket_index: width, fan out, levels and buckets per level"
+              " have to be positive"
+            );
+        }
+
+        timestamp_type width (finest_width);
+        while (levels --> 0)
+        {
+          _levels.push_back ({width, nothing_evicted, {}});
+          width *= fan_out;
+        }
+      }
+
+      void time_bucket_index::add
+        (timestamp_type begin, timestamp_type end, state_type state)
+      {
+        //! \note zero length intervals still have to show up
+        end = std::max (end, begin + 1);
+
+        _begin = std::min (_begin, begin);
+        _end = std::max (_end, end);
+
+        for (std::size_t level_ (0); level_ < _levels.size(); ++level_)
+        {
+          level& l (_levels[level_]);
+          bool const capped (level_ + 1 < _levels.size());
+
+          long const first (floor_div (begin, l.width));
+          long const last (floor_div (end - 1, l.width));
+
+          if (last < l.retained_from)
+          {
+            continue;
+          }
+
+          //! \note a single interval longer than the cap only leaves
+          //! its tail in this level
+          if ( capped
+             && last - std::max (first, l.retained_from)
+              >= long (_buckets_per_level)
+             )
+          {
+            l.retained_from = last - long (_buckets_per_level) + 1;
+            l.buckets.erase
+              (l.buckets.begin(), l.buckets.lower_bound (l.retained_from));
+          }
+
+          if (first >= l.retained_from)
+          {
+            l.buckets[first].intervals += 1;
+          }
+
+          for ( long position (std::max (first, l.retained_from))
+              ; position <= last
+              ; ++position
+              )
+          {
+            timestamp_type const bucket_begin (position * l.width);
+            l.buckets[position].busy[state]
+              += std::min (end, bucket_begin + l.width)
+               - std::max (begin, bucket_begin);
+          }
+
+          while (capped && l.buckets.size() > _buckets_per_level)
+          {
+            l.retained_from = l.buckets.begin()->first + 1;
+            l.buckets.erase (l.buckets.begin());
+          }
+        }
+      }
+
+      std::size_t time_bucket_index::levels() const
+      {
+        return _levels.size();
+      }
+      time_bucket_index::timestamp_type
+        time_bucket_index::width (std::size_t level) const
+      {
+        return _levels.at (level).width;
+      }
+
+      std::size_t time_bucket_index::level_for (timestamp_type resolution) const
+      {
+        std::size_t level (0);
+        while (level + 1 < _levels.size() && _levels[level + 1].width <= resolution)
+        {
+          ++level;
+        }
+        return level;
+      }
+
+      time_bucket_index::timestamp_type
+        time_bucket_index::retained_begin (std::size_t level_) const
+      {
+        level const& l (_levels[level_]);
+
+        if (l.retained_from == nothing_evicted || level_ + 1 == _levels.size())
+        {
+          return std::numeric_limits<timestamp_type>::min();
+        }
+
+        //! \note rounded up to a bucket boundary of the coarser level
+        timestamp_type const coarser (_levels[level_ + 1].width);
+        return -floor_div (-(l.retained_from * l.width), coarser) * coarser;
+      }
+
+      std::size_t time_bucket_index::count_intervals
+        (std::size_t level_, timestamp_type from, timestamp_type to) const
+      {
+        std::size_t intervals (0);
+
+        timestamp_type const retained (retained_begin (level_));
+        if (from < retained)
+        {
+          intervals
+            += count_intervals (level_ + 1, from, std::min (to, retained));
+          from = retained;
+        }
+        if (to <= from)
+        {
+          return intervals;
+        }
+
+        level const& l (_levels[level_]);
+
+        for ( auto position (l.buckets.lower_bound (floor_div (from, l.width)))
+            ; position != l.buckets.upper_bound (floor_div (to - 1, l.width))
+            ; ++position
+            )
+        {
+          intervals += position->second.intervals;
+        }
+
+        return intervals;
+      }
+
+      std::size_t time_bucket_index::intervals_in
+        (timestamp_type from, timestamp_type to) const
+      {
+        if (empty() || to <= from)
+        {
+          return 0;
+        }
+
+        return count_intervals
+          (level_for (std::max (1L, (to - from) / counting_buckets)), from, to);
+      }
+
+      void time_bucket_index::collect_spans ( std::size_t level_
+                                            , timestamp_type from
+                                            , timestamp_type to
+                                            , bool merge_neighbours
+                                            , std::vector<span>& result
+                                            ) const
+      {
+        timestamp_type const retained (retained_begin (level_));
+        if (from < retained)
+        {
+          collect_spans
+            (level_ + 1, from, std::min (to, retained), merge_neighbours, result);
+          from = retained;
+        }
+        if (to <= from)
+        {
+          return;
+        }
+
+        level const& l (_levels[level_]);
+
+        for ( auto position (l.buckets.lower_bound (floor_div (from, l.width)))
+            ; position != l.buckets.upper_bound (floor_div (to - 1, l.width))
+            ; ++position
+            )
+        {
+          span const current { position->first * l.width
+                             , (position->first + 1) * l.width
+                             , position->second.intervals
+                             , position->second.busy
+                             };
+
+          if ( merge_neighbours
+             && !result.empty()
+             && result.back().end == current.begin
+             && result.back().dominant_state() == current.dominant_state()
+             )
+          {
+            result.back().end = current.end;
+            result.back().intervals += current.intervals;
+            for (std::size_t state (0); state < state_count; ++state)
+            {
+              result.back().busy[state] += current.busy[state];
+            }
+          }
+          else
+          {
+            result.emplace_back (current);
+          }
+        }
+      }
+
+      std::vector<time_bucket_index::span> time_bucket_index::spans
+        ( std::size_t level_
+        , timestamp_type from
+        , timestamp_type to
+        , bool merge_neighbours
+        ) const
+      {
+        std::vector<span> result;
+
+        if (level_ >= _levels.size())
+        {
+          throw std::out_of_range ("time_bucket_index: no such level");
+        }
+
+        if (!empty() && from < to)
+        {
+          collect_spans (level_, from, to, merge_neighbours, result);
+        }
+
+        return result;
+      }
+
+      std::size_t time_bucket_index::buckets (std::size_t level_) const
+      {
+        return _levels.at (level_).buckets.size();
+      }
+
+      bool time_bucket_index::empty() const
+      {
+        return _end < _begin;
+      }
+      time_bucket_index::timestamp_type time_bucket_index::begin() const
+      {
+        return _begin;
+      }
+      time_bucket_index::timestamp_type time_bucket_index::end() const
+      {
+        return _end;
+      }
+    }
+  }
+}
@@ -0,0 +1,129 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <sdpa/daemon/NotificationEvent.hpp>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace fhg
+{
+  namespace pnete
+  {
+    namespace ui
+    {
+      //! \note Multi-resolution aggregation of the intervals of one
+      //! worker: level n has buckets of width finest_width *
+      //! fan_out^n, each bucket stores how long the worker was busy
+      //! in every state and how many intervals began in it. Painting
+      //! from the level whose buckets are about one pixel wide costs
+      //! O(pixels) instead of O(intervals).
+      //! \note Only non-empty buckets are stored. All but the
+      //! coarsest level keep at most buckets_per_level of them, the
+      //! most recent ones: older ranges are answered from the finest
+      //! level still holding them.
+      class time_bucket_index
+      {
+      public:
+        typedef long timestamp_type;
+        typedef sdpa::daemon::NotificationEvent::state_t state_type;
+        static constexpr std::size_t state_count
+          = sdpa::daemon::NotificationEvent::STATE_MAX + 1;
+        static constexpr timestamp_type default_finest_width = 1000;
+
+        struct span
+        {
+          timestamp_type begin;
+          timestamp_type end;
+          std::size_t intervals;
+          std::array<timestamp_type, state_count> busy;
+
+          state_type dominant_state() const;
+        };
+
+        time_bucket_index ( timestamp_type finest_width = default_finest_width
+                          , std::size_t fan_out = 4
+                          , std::size_t levels = 10
+                          , std::size_t buckets_per_level = 1 << 16
+                          );
+
+        //! \note [begin, end) has to be a finished interval
+        void add (timestamp_type begin, timestamp_type end, state_type);
+
+        std::size_t levels() const;
+        timestamp_type width (std::size_t level) const;
+        //! \note coarsest level with buckets not wider than
+        //! resolution, the finest level if there is none
+        std::size_t level_for (timestamp_type resolution) const;
+
+        //! \note number of intervals beginning in [from, to),
+        //! rounded out to the buckets of a coarse level
+        std::size_t intervals_in (timestamp_type from, timestamp_type to) const;
+
+        //! \note non-empty buckets of level intersecting [from, to),
+        //! if asked for, neighbours with the same dominant state
+        //! merged
+        std::vector<span> spans ( std::size_t level
+                                , timestamp_type from
+                                , timestamp_type to
+                                , bool merge_neighbours = true
+                                ) const;
+
+        //! \note number of non-empty buckets kept by the level
+        std::size_t buckets (std::size_t level) const;
+
+        //! \note [begin, end) of everything added so far
+        bool empty() const;
+        timestamp_type begin() const;
+        timestamp_type end() const;
+
+      private:
+        struct bucket
+        {
+          std::size_t intervals = 0;
+          std::array<timestamp_type, state_count> busy {{}};
+        };
+        struct level
+        {
+          timestamp_type width;
+          //! \note the buckets before were evicted
+          long retained_from;
+          std::map<long, bucket> buckets;
+        };
+        std::vector<level> _levels;
+        std::size_t _buckets_per_level;
+        timestamp_type _begin;
+        timestamp_type _end;
+
+        //! \note from here on level holds everything, before it the
+        //! next coarser level has to be asked
+        timestamp_type retained_begin (std::size_t level) const;
+        void collect_spans ( std::size_t level
+                           , timestamp_type from
+                           , timestamp_type to
+                           , bool merge_neighbours
+                           , std::vector<span>&
+                           ) const;
+        std::size_t count_intervals
+          (std::size_t level, timestamp_type from, timestamp_type to) const;
+      };
+    }
+  }
+}
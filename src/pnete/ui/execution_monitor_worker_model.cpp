@@ -87,8 +87,10 @@ namespace fhg
         _state = state_;
       }
 
-      worker_model::worker_model (QObject* parent)
+      worker_model::worker_model
+          (QObject* parent, boost::optional<memory_bound> bound)
         : QAbstractItemModel (parent)
+        , _memory_bound (bound)
         , _workers()
         , _worker_containers()
         , _base_time (QDateTime::currentDateTime())
@@ -125,6 +127,71 @@ namespace fhg
         }
       }
 
+      QString const& worker_model::activity_name
+        (sdpa::daemon::NotificationEvent const& event)
+      {
+        auto& names (_activity_names[event.activity_name_id()]);
+
+        for (auto const& name : names)
+        {
+          if (name.first == event.activity_name())
+          {
+            return name.second;
+          }
+        }
+
+        names.emplace_back
+          (event.activity_name(), QString::fromStdString (event.activity_name()));
+
+        return names.back().second;
+      }
+
+      namespace
+      {
+        //! \note to be called on intervals that were running before
+        void index_if_finished
+          ( time_bucket_index& index
+          , worker_model::value_type const& interval
+          )
+        {
+          if (interval.duration())
+          {
+            index.add ( interval.timestamp()
+                      , interval.timestamp() + *interval.duration()
+                      , interval.state()
+                      );
+          }
+        }
+      }
+
+      void worker_model::spill (worker_trace& trace)
+      {
+        if (!trace.spilled)
+        {
+          trace.spilled = std::make_shared<interval_spill_file>
+            (_memory_bound->spill_directory);
+        }
+
+        //! \note keep the recent half, which includes the only
+        //! interval that may still be running
+        auto const evicted
+          (trace.intervals.begin() + trace.intervals.size() / 2);
+
+        for (auto interval (trace.intervals.begin()); interval != evicted; ++interval)
+        {
+          trace.spilled->append
+            ( { interval->timestamp()
+              , interval->duration().get_value_or (0)
+              , interval->state()
+              , interval->id().toStdString()
+              , interval->_name.toStdString()
+              }
+            );
+        }
+
+        trace.intervals.erase (trace.intervals.begin(), evicted);
+      }
+
       void worker_model::handle_events()
       {
         boost::optional<QModelIndex> ul, br;
@@ -161,7 +228,8 @@ namespace fhg
               endInsertRows();
             }
 
-            std::vector<value_type>& container (_worker_containers[worker]);
+            worker_trace& trace (_worker_containers[worker]);
+            std::vector<value_type>& container (trace.intervals);
 
             //! \note We assume that there are no message reorderings,
             //! thus the message always is for the current or a new
@@ -170,6 +238,8 @@ namespace fhg
             //! to inserting a new activity where timestamp <
             //! current.timestamp, which will throw or result in other
             //! weird behaviour.
+            //! \note The check for duplicate ids only covers the
+            //! intervals still in memory.
             if (container.empty() || container.back().id() != activity_id)
             {
               fhg_assert ( std::find_if
@@ -199,6 +269,7 @@ namespace fhg
                 if (!current.duration())
                 {
                   current.state (sdpa::daemon::NotificationEvent::STATE_FAILED, time);
+                  index_if_finished (trace.index, current);
                 }
               }
 
@@ -206,14 +277,27 @@ namespace fhg
                 ( value_type ( time
                              , boost::none
                              , activity_id
-                             , QString::fromStdString (event.activity_name())
+                             , activity_name (event)
                              , event.activity_state()
                              )
                 );
+              index_if_finished (trace.index, container.back());
             }
             else
             {
+              bool const was_running (!container.back().duration());
               container.back().state (event.activity_state(), time);
+              if (was_running)
+              {
+                index_if_finished (trace.index, container.back());
+              }
+            }
+
+            if ( _memory_bound
+               && container.size() > _memory_bound->intervals_in_memory
+               )
+            {
+              spill (trace);
             }
 
             (ul ? br : ul) = index (row, 0);
@@ -244,7 +328,8 @@ namespace fhg
           return !val.duration() || t < (val.timestamp() + *val.duration());
         }
 
-        worker_model::subrange_type find_subrange
+        boost::iterator_range<std::vector<worker_model::value_type>::const_iterator>
+          find_subrange
           ( const std::vector<worker_model::value_type>::const_iterator begin
           , const std::vector<worker_model::value_type>::const_iterator end
           , const worker_model::timestamp_type from
@@ -254,7 +339,7 @@ namespace fhg
           const std::vector<worker_model::value_type>::const_iterator lower
             (std::upper_bound (begin, end, from, is_before));
 
-          return worker_model::subrange_type
+          return boost::make_iterator_range
             ( lower
             , std::lower_bound
               ( lower, end
@@ -270,6 +355,101 @@ namespace fhg
         }
       }
 
+      worker_model::row_slice worker_model::slice
+        ( worker_trace const* trace
+        , timestamp_type from
+        , timestamp_type to
+        , timestamp_type resolution
+        )
+      {
+        row_slice slice;
+
+        resolution = std::max (resolution, 1L);
+        std::size_t const pixels ((to - from) / resolution + 1);
+
+        if (trace->index.intervals_in (from, to) > pixels)
+        {
+          slice.spans = trace->index.spans
+            (trace->index.level_for (resolution), from, to);
+
+          //! \note the running interval is not indexed yet
+          if ( !trace->intervals.empty()
+             && !trace->intervals.back().duration()
+             && trace->intervals.back().timestamp() < to
+             )
+          {
+            slice.intervals.push_back (trace->intervals.back());
+          }
+
+          return slice;
+        }
+
+        if ( trace->spilled
+           && (trace->intervals.empty() || from < trace->intervals.front().timestamp())
+           )
+        {
+          for (interval_spill_file::interval const& spilled : trace->spilled->read (from, to))
+          {
+            value_type interval
+              ( spilled.timestamp
+              , boost::none
+              , QString::fromStdString (spilled.id)
+              , QString::fromStdString (spilled.name)
+              , sdpa::daemon::NotificationEvent::STATE_STARTED
+              );
+            interval.state (spilled.state, spilled.timestamp + spilled.duration);
+            slice.intervals.emplace_back (std::move (interval));
+          }
+        }
+
+        auto const in_memory
+          (find_subrange (trace->intervals.begin(), trace->intervals.end(), from, to));
+        slice.intervals.insert
+          (slice.intervals.end(), in_memory.begin(), in_memory.end());
+
+        return slice;
+      }
+
+      void worker_model::write_aggregated_trace
+        (std::ostream& os, timestamp_type resolution) const
+      {
+        os << "# base time: "
+           << _base_time.toString (Qt::ISODate).toStdString() << '\n'
+           << "# worker\tbegin\tend\tintervals"
+              "\tstarted\tfinished\tfailed\tcanceled\n";
+
+        for (QString const& worker : _workers)
+        {
+          time_bucket_index const& index
+            (_worker_containers.find (worker)->index);
+
+          if (index.empty())
+          {
+            continue;
+          }
+
+          std::string const name (worker.toStdString());
+
+          for ( span_type const& span
+              : index.spans ( index.level_for (resolution)
+                            , index.begin(), index.end()
+                            , false
+                            )
+              )
+          {
+            os << name << '\t' << span.begin << '\t' << span.end
+               << '\t' << span.intervals;
+            for (timestamp_type busy : span.busy)
+            {
+              os << '\t' << busy;
+            }
+            os << '\n';
+          }
+        }
+
+        os.flush();
+      }
+
       QVariant worker_model::data (const QModelIndex& index, int role) const
       {
         if (index.isValid())
@@ -281,17 +461,17 @@ namespace fhg
           else if (role == current_interval_role)
           {
             return QVariant::fromValue<boost::optional<value_type>>
-              (_worker_containers[_workers[index.row()]].back());
+              (_worker_containers[_workers[index.row()]].intervals.back());
           }
           else if (role == range_getter_role)
           {
             return QVariant::fromValue<subrange_getter_type>
               ( std::bind
-                ( &find_subrange
-                , _worker_containers.find (_workers[index.row()])->begin()
-                , _worker_containers.find (_workers[index.row()])->end()
+                ( &worker_model::slice
+                , &*_worker_containers.find (_workers[index.row()])
                 , std::placeholders::_1
                 , std::placeholders::_2
+                , std::placeholders::_3
                 )
               );
           }
@@ -327,6 +507,7 @@ namespace fhg
 
         _workers.clear();
         _worker_containers.clear();
+        _activity_names.clear();
         _base_time = QDateTime::currentDateTime();
 
         endResetModel();
@@ -18,18 +18,28 @@
 
 #include <logging/message.hpp>
 
+#include <pnete/ui/execution_monitor_spill_file.hpp>
+#include <pnete/ui/execution_monitor_time_buckets.hpp>
+
 #include <sdpa/daemon/NotificationEvent.hpp>
 
 #include <boost/asio.hpp>
+#include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 #include <boost/range.hpp>
 
 #include <QAbstractItemModel>
 #include <QDateTime>
+#include <QHash>
 #include <QVector>
 
 #include <functional>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace fhg
@@ -51,7 +61,18 @@ namespace fhg
           range_getter_role
         };
 
-        worker_model (QObject* parent);
+        //! \note Keep at most intervals_in_memory intervals per
+        //! worker in memory, older ones are moved to a file in
+        //! spill_directory and only read back when zoomed in on.
+        struct memory_bound
+        {
+          std::size_t intervals_in_memory;
+          boost::filesystem::path spill_directory;
+        };
+
+        worker_model ( QObject* parent
+                     , boost::optional<memory_bound> = boost::none
+                     );
 
         void append_event (logging::message const&);
 
@@ -100,19 +121,57 @@ namespace fhg
           friend class worker_model;
         };
 
-        typedef boost::iterator_range<std::vector<value_type>::const_iterator>
-          subrange_type;
-        typedef std::function<subrange_type (timestamp_type, timestamp_type)>
+        typedef time_bucket_index::span span_type;
+
+        //! \note Either the individual intervals intersecting the
+        //! requested range or, if there are more than pixels to draw
+        //! them on, aggregated spans plus the still running interval.
+        struct row_slice
+        {
+          std::vector<value_type> intervals;
+          std::vector<span_type> spans;
+        };
+        //! \note (from, to, resolution in msec per pixel)
+        typedef std::function<row_slice (timestamp_type, timestamp_type, timestamp_type)>
           subrange_getter_type;
 
+        //! \note one line per non-empty bucket of every worker, the
+        //! buckets at most resolution msec wide unless they are older
+        //! than what the index keeps at that width
+        void write_aggregated_trace
+          (std::ostream&, timestamp_type resolution) const;
+
       private slots:
         void handle_events();
 
       private:
+        struct worker_trace
+        {
+          std::vector<value_type> intervals;
+          time_bucket_index index;
+          std::shared_ptr<interval_spill_file> spilled;
+        };
+
+        static row_slice slice ( worker_trace const*
+                               , timestamp_type from
+                               , timestamp_type to
+                               , timestamp_type resolution
+                               );
+        void spill (worker_trace&);
+
+        boost::optional<memory_bound> _memory_bound;
+
         QList<QString> _workers;
-        QMap<QString, std::vector<value_type>> _worker_containers;
+        QMap<QString, worker_trace> _worker_containers;
         QDateTime _base_time;
 
+        //! \note the id is a hash of the name, names with the same
+        //! id share a bucket
+        QHash< sdpa::daemon::NotificationEvent::activity_name_id_t
+             , std::list<std::pair<std::string, QString>>
+             > _activity_names;
+        QString const& activity_name (sdpa::daemon::NotificationEvent const&);
+
         std::mutex _event_queue;
         QVector<logging::message> _queued_events;
       };
@@ -36,6 +36,7 @@
 #include <logging/protocol.hpp>
 
 #include <rif/execute_and_get_startup_messages.hpp>
+#include <rif/module_cache.hpp>
 #include <rif/protocol.hpp>
 #include <rif/strategy/meta.hpp>
 
@@ -406,6 +407,21 @@ try
       , fhg::rpc::not_yielding
       );
 
+  fhg::rif::module_cache module_cache;
+
+  fhg::rpc::service_handler<fhg::rif::protocol::fill_module_cache>
+    fill_module_cache_service
+      ( service_dispatcher
+      , [&module_cache] ( boost::filesystem::path const& directory
+                        , std::vector<boost::filesystem::path> const& search_path
+                        , std::vector<std::string> const& modules
+                        )
+        {
+          module_cache.fill (directory, search_path, modules);
+        }
+      , fhg::rpc::not_yielding
+      );
+
   fhg::util::scoped_boost_asio_io_service_with_threads_and_deferred_startup
     io_service (1);
 
@@ -0,0 +1,213 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <rif/module_cache.hpp>
+
+#include <util-generic/join.hpp>
+#include <util-generic/syscall.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+
+#include <openssl/evp.h>
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fhg
+{
+  namespace rif
+  {
+    namespace
+    {
+      boost::filesystem::path resolve
+        ( boost::filesystem::path const& file_name
+        , std::vector<boost::filesystem::path> const& search_path
+        )
+      {
+        for (boost::filesystem::path const& p : search_path)
+        {
+          if (boost::filesystem::exists (p / file_name))
+          {
+            return p / file_name;
+          }
+        }
+
+        throw std::invalid_argument
+          ( ( boost::format ("module cache: %1% not found in %2%")
+            % file_name
+            % fhg::util::join (search_path, ':')
+            ).str()
+          );
+      }
+
+      std::string sha256 (boost::filesystem::path const& file)
+      {
+        std::ifstream stream (file.string(), std::ios::binary);
+
+        if (!stream)
+        {
+          throw std::runtime_error
+            ("module cache: could not open " + file.string());
+        }
+
+        std::unique_ptr<EVP_MD_CTX, void (*) (EVP_MD_CTX*)> const context
+          (EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+
+        if (!context || !EVP_DigestInit_ex (context.get(), EVP_sha256(), nullptr))
+        {
+          throw std::runtime_error ("module cache: could not initialize sha256");
+        }
+
+        std::vector<char> buffer (1 << 20);
+
+        while (stream)
+        {
+          stream.read (buffer.data(), buffer.size());
+
+          if (!EVP_DigestUpdate (context.get(), buffer.data(), stream.gcount()))
+          {
+            throw std::runtime_error ("module cache: could not update sha256");
+          }
+        }
+
+        if (stream.bad())
+        {
+          throw std::runtime_error
+            ("module cache: could not read " + file.string());
+        }
+
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int digest_length (0);
+
+        if (!EVP_DigestFinal_ex (context.get(), digest, &digest_length))
+        {
+          throw std::runtime_error ("module cache: could not finalize sha256");
+        }
+
+        std::string hex;
+
+        for (unsigned int i (0); i < digest_length; ++i)
+        {
+          hex += (boost::format ("%02x") % static_cast<unsigned int> (digest[i])).str();
+        }
+
+        return hex;
+      }
+
+      //! \note concurrent fills, e.g. by two daemons on the same node
+      //! or two requests to the same daemon, never observe partial
+      //! files or links nor write to the same temporary
+      boost::filesystem::path temporary_for (boost::filesystem::path const& p)
+      {
+        return p.parent_path()
+          / ( p.filename().string()
+            + ".tmp." + std::to_string (getpid())
+            + "." + boost::filesystem::unique_path().string()
+            );
+      }
+
+      //! \note the modification time in nanoseconds and the change
+      //! time and inode as well: a rebuild within the same second or
+      //! one that replaces the file is a different key
+      std::string digest_key (boost::filesystem::path const& file)
+      {
+        struct stat buf;
+        fhg::util::syscall::stat (file.string().c_str(), &buf);
+
+        return ( boost::format ("%1%:%2%:%3%:%4%.%5%:%6%.%7%")
+               % file.string()
+               % buf.st_ino
+               % buf.st_size
+               % buf.st_mtim.tv_sec
+               % buf.st_mtim.tv_nsec
+               % buf.st_ctim.tv_sec
+               % buf.st_ctim.tv_nsec
+               ).str();
+      }
+    }
+
+    std::string module_cache::digest (boost::filesystem::path const& file)
+    {
+      std::string const key (digest_key (file));
+
+      {
+        std::lock_guard<std::mutex> const _ (_digests_guard);
+
+        auto const known (_digests.find (key));
+
+        if (known != _digests.end())
+        {
+          return known->second;
+        }
+      }
+
+      std::string const hex (sha256 (file));
+
+      std::lock_guard<std::mutex> const _ (_digests_guard);
+
+      return _digests.emplace (key, hex).first->second;
+    }
+
+    void module_cache::fill
+      ( boost::filesystem::path const& directory
+      , std::vector<boost::filesystem::path> const& search_path
+      , std::vector<std::string> const& modules
+      )
+    {
+      boost::filesystem::create_directories (directory);
+
+      for (std::string const& module : modules)
+      {
+        boost::filesystem::path const file_name ("lib" + module + ".so");
+        boost::filesystem::path const source (resolve (file_name, search_path));
+        std::string const content (digest (source));
+
+        boost::filesystem::path const cached (directory / content / file_name);
+
+        if (!boost::filesystem::exists (cached))
+        {
+          boost::filesystem::create_directories (cached.parent_path());
+
+          boost::filesystem::path const temporary (temporary_for (cached));
+          boost::filesystem::copy_file
+            ( source
+            , temporary
+            , boost::filesystem::copy_option::overwrite_if_exists
+            );
+          boost::filesystem::rename (temporary, cached);
+        }
+
+        boost::filesystem::path const link (directory / file_name);
+        boost::filesystem::path const target (content / file_name);
+
+        boost::system::error_code ec;
+
+        if (boost::filesystem::read_symlink (link, ec) != target || ec)
+        {
+          boost::filesystem::path const temporary (temporary_for (link));
+          boost::filesystem::create_symlink (target, temporary);
+          boost::filesystem::rename (temporary, link);
+        }
+      }
+    }
+  }
+}
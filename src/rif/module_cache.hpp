@@ -0,0 +1,57 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fhg
+{
+  namespace rif
+  {
+    //! A node-local, content addressed copy of module call libraries:
+    //! the content of lib<name>.so is stored as
+    //! <directory>/<sha256 of content>/lib<name>.so and
+    //! <directory>/lib<name>.so is a symbolic link to it. The
+    //! directory thus is a library search path entry that workers can
+    //! dlopen from without touching the shared filesystem. A changed
+    //! module gets a new file instead of overwriting one that might
+    //! be loaded.
+    class module_cache
+    {
+    public:
+      //! \note modules are resolved in \a search_path like the
+      //! loader does, throws if one is not found
+      void fill ( boost::filesystem::path const& directory
+                , std::vector<boost::filesystem::path> const& search_path
+                , std::vector<std::string> const& modules
+                );
+
+    private:
+      //! \note file name, inode, size, modification and change time
+      //! in nanoseconds -> digest, to not read unchanged modules again
+      std::mutex _digests_guard;
+      std::unordered_map<std::string, std::string> _digests;
+
+      std::string digest (boost::filesystem::path const&);
+    };
+  }
+}
@@ -125,6 +125,15 @@ namespace fhg
             )
         );
 
+      //! \see fhg::rif::module_cache
+      FHG_RPC_FUNCTION_DESCRIPTION
+        ( fill_module_cache
+        , void ( boost::filesystem::path directory
+               , std::vector<boost::filesystem::path> search_path
+               , std::vector<std::string> modules
+               )
+        );
+
       struct start_logging_demultiplexer_result
       {
         pid_t pid;
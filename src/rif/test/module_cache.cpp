@@ -0,0 +1,179 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <rif/module_cache.hpp>
+
+#include <util-generic/read_file.hpp>
+#include <util-generic/temporary_path.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/printer/optional.hpp>
+#include <util-generic/wait_and_collect_exceptions.hpp>
+#include <util-generic/write_file.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fhg
+{
+  namespace rif
+  {
+    namespace
+    {
+      struct directories
+      {
+        util::temporary_path const _search_path;
+        util::temporary_path const _cache_parent;
+        boost::filesystem::path const search_path {_search_path};
+        boost::filesystem::path const cache
+          {boost::filesystem::path (_cache_parent) / "cache"};
+      };
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      (module_is_linked_to_a_copy_named_by_its_content, directories)
+    {
+      util::write_file (search_path / "libm.so", "content");
+
+      module_cache().fill (cache, {search_path}, {"m"});
+
+      BOOST_REQUIRE (boost::filesystem::is_symlink (cache / "libm.so"));
+      BOOST_REQUIRE_EQUAL (util::read_file (cache / "libm.so"), "content");
+
+      boost::filesystem::path const target
+        (boost::filesystem::read_symlink (cache / "libm.so"));
+
+      BOOST_REQUIRE_EQUAL (target.filename(), "libm.so");
+      //! \note sha256 of "content"
+      BOOST_REQUIRE_EQUAL
+        ( target.parent_path()
+        , "ed7002b439e9ac845f22357d822bac1444730fbdb6016d3ec9432297b9ec9f73"
+        );
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      (changed_module_gets_a_new_copy_and_keeps_the_old_one, directories)
+    {
+      module_cache cache_daemon;
+
+      util::write_file (search_path / "libm.so", "old");
+      cache_daemon.fill (cache, {search_path}, {"m"});
+      boost::filesystem::path const old_target
+        (cache / boost::filesystem::read_symlink (cache / "libm.so"));
+
+      util::write_file (search_path / "libm.so", "changed");
+      cache_daemon.fill (cache, {search_path}, {"m"});
+
+      BOOST_REQUIRE_EQUAL (util::read_file (cache / "libm.so"), "changed");
+      BOOST_REQUIRE_EQUAL (util::read_file (old_target), "old");
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      (module_rewritten_within_the_same_second_gets_a_new_copy, directories)
+    {
+      module_cache cache_daemon;
+
+      util::write_file (search_path / "libm.so", "old");
+      std::time_t const modified
+        (boost::filesystem::last_write_time (search_path / "libm.so"));
+      cache_daemon.fill (cache, {search_path}, {"m"});
+
+      util::write_file (search_path / "libm.so", "new");
+      boost::filesystem::last_write_time (search_path / "libm.so", modified);
+      cache_daemon.fill (cache, {search_path}, {"m"});
+
+      BOOST_REQUIRE_EQUAL (util::read_file (cache / "libm.so"), "new");
+    }
+
+    BOOST_FIXTURE_TEST_CASE (concurrent_fills_do_not_interfere, directories)
+    {
+      module_cache cache_daemon;
+
+      util::write_file (search_path / "libm.so", "content");
+
+      for (std::size_t round (0); round < 20; ++round)
+      {
+        boost::filesystem::path const round_cache
+          (cache / std::to_string (round));
+
+        std::vector<std::future<void>> fills;
+
+        for (std::size_t fill (0); fill < 8; ++fill)
+        {
+          fills.emplace_back
+            ( std::async
+                ( std::launch::async
+                , [&]
+                  {
+                    cache_daemon.fill (round_cache, {search_path}, {"m"});
+                  }
+                )
+            );
+        }
+
+        util::wait_and_collect_exceptions (fills);
+
+        BOOST_REQUIRE_EQUAL
+          (util::read_file (round_cache / "libm.so"), "content");
+      }
+    }
+
+    BOOST_FIXTURE_TEST_CASE (filling_again_is_idempotent, directories)
+    {
+      module_cache cache_daemon;
+
+      util::write_file (search_path / "libm.so", "content");
+      cache_daemon.fill (cache, {search_path}, {"m"});
+      cache_daemon.fill (cache, {search_path}, {"m"});
+      module_cache().fill (cache, {search_path}, {"m"});
+
+      BOOST_REQUIRE_EQUAL (util::read_file (cache / "libm.so"), "content");
+      BOOST_REQUIRE_EQUAL
+        ( std::distance ( boost::filesystem::directory_iterator (cache)
+                        , boost::filesystem::directory_iterator()
+                        )
+        , 2
+        );
+    }
+
+    BOOST_FIXTURE_TEST_CASE (first_search_path_entry_wins, directories)
+    {
+      util::temporary_path const _second;
+      boost::filesystem::path const second (_second);
+
+      util::write_file (search_path / "libm.so", "first");
+      util::write_file (second / "libm.so", "second");
+
+      module_cache().fill (cache, {search_path, second}, {"m"});
+
+      BOOST_REQUIRE_EQUAL (util::read_file (cache / "libm.so"), "first");
+    }
+
+    BOOST_FIXTURE_TEST_CASE (missing_module_throws, directories)
+    {
+      BOOST_REQUIRE_THROW
+        ( module_cache().fill (cache, {search_path}, {"missing"})
+        , std::invalid_argument
+        );
+    }
+  }
+}
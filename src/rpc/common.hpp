@@ -33,6 +33,22 @@ namespace fhg
 {
   namespace rpc
   {
+    //! \note Functions are identified by their name on first use on
+    //! a connection and by an id negotiated with the service_dispatcher
+    //! afterwards. A request naming the function by id writes an empty
+    //! name followed by the id, which no older service_dispatcher or
+    //! client ever produced, so both request forms can be mixed.
+    using function_id = std::uint32_t;
+
+    namespace detail
+    {
+      //! \note Builtin function of every service_dispatcher: takes a
+      //! function name and returns whether it is known and, if so,
+      //! its function_id.
+      constexpr char const* const resolve_function_id_name
+        = "fhg::rpc::resolve_function_id";
+    }
+
     struct packet_header
     {
       uint64_t message_id;
@@ -84,48 +100,6 @@ namespace fhg
 
   namespace util
   {
-    template<typename Container>
-      struct unique_scoped_map_insert
-    {
-      unique_scoped_map_insert ( Container& container
-                               , typename Container::key_type key
-                               , typename Container::mapped_type value
-                               )
-        : _container (container)
-        , _key (boost::none)
-      {
-        if (!_container.emplace (key, std::move (value)).second)
-        {
-          throw rpc::error::duplicate_function (std::move (key));
-        }
-
-        _key = std::move (key);
-      }
-      unique_scoped_map_insert (unique_scoped_map_insert<Container>&& other)
-        : _container (std::move (other._container))
-        , _key (boost::none)
-      {
-        std::swap (_key, other._key);
-      }
-      ~unique_scoped_map_insert()
-      {
-        if (_key)
-        {
-          _container.erase (*_key);
-        }
-      }
-
-      unique_scoped_map_insert (unique_scoped_map_insert<Container> const&)
-        = delete;
-      unique_scoped_map_insert<Container>& operator=
-        (unique_scoped_map_insert<Container> const&) = delete;
-      unique_scoped_map_insert<Container>& operator=
-        (unique_scoped_map_insert<Container>&&) = delete;
-
-      Container& _container;
-      boost::optional<typename Container::key_type> _key;
-    };
-
     struct vector_sink : boost::iostreams::sink
     {
       vector_sink (std::vector<char>& vector) : _vector (vector) {}
@@ -91,6 +91,13 @@ namespace fhg
           return _io_service;
         }
 
+        //! Upper bound of bytes coalesced into one write. A single
+        //! larger packet is still written as a whole.
+        static constexpr std::size_t max_bytes_per_write = 1 << 20;
+        //! Initial size of the buffer responses are read into. Grows
+        //! to fit the largest response received.
+        static constexpr std::size_t initial_receive_buffer_size = 1 << 16;
+
       private:
         void read_responses (boost::asio::yield_context);
 
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <array>
 #include <iostream>
+#include <iterator>
 
 namespace fhg
 {
@@ -248,27 +249,42 @@ namespace fhg
               boost::upgrade_lock<boost::upgrade_mutex> shared_lock_socket
                 (_guard_socket);
 
+              std::vector<boost::asio::const_buffer> buffers;
+
               while (!_outgoing.empty())
               {
-                outgoing const& packet (_outgoing.front());
+                //! \note Coalesce everything queued so far into one
+                //! scatter-gather write. Packets queued while writing
+                //! are appended to the list without invalidating the
+                //! ones referenced by \c buffers.
+                buffers.clear();
+                std::size_t packets (0);
+                std::size_t bytes (0);
+                for ( auto packet (_outgoing.cbegin())
+                    ; packet != _outgoing.cend()
+                      && (packets == 0 || bytes < max_bytes_per_write)
+                    ; ++packet, ++packets
+                    )
+                {
+                  buffers.emplace_back (&packet->header, sizeof (packet->header));
+                  buffers.emplace_back
+                    (packet->buffer.data(), packet->buffer.size());
+                  bytes += sizeof (packet->header) + packet->buffer.size();
+                }
 
                 boost::system::error_code errc;
 
                 {
                   boost::asio::async_write
                     ( _socket
-                    , std::array<boost::asio::const_buffer, 2>
-                        {{ boost::asio::const_buffer
-                             (&packet.header, sizeof (packet.header))
-                         , boost::asio::const_buffer
-                             (packet.buffer.data(), packet.buffer.size())
-                        }}
+                    , buffers
                     , with_unlocked
                         (yield [errc], lock_outgoing, shared_lock_socket)
                     );
                 }
 
-                _outgoing.pop_front();
+                _outgoing.erase
+                  (_outgoing.begin(), std::next (_outgoing.begin(), packets));
 
                 if (errc)
                 {
@@ -297,25 +313,22 @@ namespace fhg
       {
         try
         {
-          packet_header response_header;
-          std::vector<char> response;
+          //! \note Read as much as is available and handle all
+          //! complete responses in [begin, end) before reading again,
+          //! instead of two reads per response.
+          std::vector<char> received (initial_receive_buffer_size);
+          std::size_t begin (0);
+          std::size_t end (0);
+
           while (true)
           {
             // Acquires mutex. Fine: Mutex is never blocking.
             boost::shared_lock<boost::upgrade_mutex> lock_socket
               (_guard_socket);
 
-            boost::asio::async_read
-              ( _socket
-              , boost::asio::buffer (&response_header, sizeof (response_header))
-              , with_unlocked (yield, lock_socket)
-              );
-
-            response.resize (response_header.buffer_size);
-
-            boost::asio::async_read
-              ( _socket
-              , boost::asio::buffer (response.data(), response.size())
+            end += _socket.async_read_some
+              ( boost::asio::buffer
+                  (received.data() + end, received.size() - end)
               , with_unlocked (yield, lock_socket)
               );
 
@@ -323,25 +336,69 @@ namespace fhg
             std::lock_guard<std::mutex> const lock_set_exception_and_value
               (_guard_set_exception_and_value);
 
-            //! \note was assume_broken'd between unyield and lock,
-            //! which is fine. _set_exception will also be cleaned up.
-            auto const set_value (_set_value.find (response_header.message_id));
-            if (set_value == _set_value.end())
+            packet_header response_header;
+            while (end - begin >= sizeof (response_header))
             {
-              break;
+              std::copy ( received.data() + begin
+                        , received.data() + begin + sizeof (response_header)
+                        , reinterpret_cast<char*> (&response_header)
+                        );
+
+              if ( end - begin - sizeof (response_header)
+                 < response_header.buffer_size
+                 )
+              {
+                break;
+              }
+
+              char const* const response
+                (received.data() + begin + sizeof (response_header));
+              begin += sizeof (response_header) + response_header.buffer_size;
+
+              //! \note was assume_broken'd between unyield and lock,
+              //! which is fine. _set_exception will also be cleaned up.
+              auto const set_value
+                (_set_value.find (response_header.message_id));
+              if (set_value == _set_value.end())
+              {
+                return;
+              }
+
+              boost::iostreams::array_source source
+                (response, response_header.buffer_size);
+              boost::iostreams::stream_buffer<decltype (source)> stream
+                (source);
+              boost::archive::binary_iarchive archive (stream);
+
+              // Callback without yield passed down! Fine: only given by
+              // `remote_function` which passes a Promise's `set_value`,
+              // which is non-blocking.
+              set_value->second (archive);
+              _set_value.erase (set_value);
+              _set_exception.erase (response_header.message_id);
             }
 
-            boost::iostreams::array_source source
-              (response.data(), response.size());
-            boost::iostreams::stream_buffer<decltype (source)> stream (source);
-            boost::archive::binary_iarchive archive (stream);
-
-            // Callback without yield passed down! Fine: only given by
-            // `remote_function` which passes a Promise's `set_value`,
-            // which is non-blocking.
-            set_value->second (archive);
-            _set_value.erase (set_value);
-            _set_exception.erase (response_header.message_id);
+            //! \note Move the incomplete remainder to the front and
+            //! make sure the next packet fits as a whole.
+            std::copy ( received.begin() + begin, received.begin() + end
+                      , received.begin()
+                      );
+            end -= begin;
+            begin = 0;
+
+            if (end >= sizeof (response_header))
+            {
+              std::copy ( received.data()
+                        , received.data() + sizeof (response_header)
+                        , reinterpret_cast<char*> (&response_header)
+                        );
+              received.resize
+                ( std::max<std::size_t>
+                    ( received.size()
+                    , sizeof (response_header) + response_header.buffer_size
+                    )
+                );
+            }
           }
         }
         catch (boost::system::system_error const&)
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <boost/asio/spawn.hpp>
+#include <boost/version.hpp>
 
 #include <functional>
 
@@ -36,15 +36,29 @@ namespace fhg
       // point in time. The remainder of this is
       // boilerplate. Boost.Asio has a *lot* of boilerplate.
 
+      //! \note Boost 1.70 replaced handler_type and async_result
+      //! <Handler> by async_result<CompletionToken, Signature>.
+#if BOOST_VERSION >= 107000
+      template<typename Ret, typename... Args>
+        using coro_async_result_for
+          = boost::asio::async_result<boost::asio::yield_context, Ret (Args...)>;
+      template<typename Ret, typename... Args>
+        using coro_handler_for
+          = typename coro_async_result_for<Ret, Args...>::completion_handler_type;
+#else
       template<typename Ret, typename... Args>
         using coro_handler_for
           = typename boost::asio::handler_type<boost::asio::yield_context, Ret (Args...)>::type;
+      template<typename Ret, typename... Args>
+        using coro_async_result_for
+          = boost::asio::async_result<coro_handler_for<Ret, Args...>>;
+#endif
 
       template<typename Ret, typename... Args>
         struct coro_handler_with_hooks : coro_handler_for<Ret, Args...>
       {
         using coro_handler = coro_handler_for<Ret, Args...>;
-        using coro_async_result = boost::asio::async_result<coro_handler>;
+        using coro_async_result = coro_async_result_for<Ret, Args...>;
 
         std::function<void()> before_yield;
         std::function<void()> before_resume;
@@ -91,6 +105,30 @@ namespace boost
   {
     namespace rpcd = fhg::rpc::detail;
 
+#if BOOST_VERSION >= 107000
+    template<typename Ret, typename... Args>
+      struct async_result<rpcd::yield_context_with_hooks, Ret (Args...)>
+        : rpcd::coro_handler_with_hooks<Ret, Args...>::async_result
+    {
+      using completion_handler_type = rpcd::coro_handler_with_hooks<Ret, Args...>;
+      using rpcd::coro_handler_with_hooks<Ret, Args...>::async_result::async_result;
+    };
+
+    //! \note the handler is executed like the one of a plain
+    //! yield_context, e.g. on its strand
+    template<typename Executor, typename Ret, typename... Args>
+      struct associated_executor
+        <rpcd::coro_handler_with_hooks<Ret, Args...>, Executor>
+      : associated_executor
+          <typename rpcd::coro_handler_with_hooks<Ret, Args...>::coro_handler, Executor>
+    {};
+    template<typename Allocator, typename Ret, typename... Args>
+      struct associated_allocator
+        <rpcd::coro_handler_with_hooks<Ret, Args...>, Allocator>
+      : associated_allocator
+          <typename rpcd::coro_handler_with_hooks<Ret, Args...>::coro_handler, Allocator>
+    {};
+#else
     template<typename Ret, typename... Args>
       struct handler_type<rpcd::yield_context_with_hooks, Ret (Args...)>
     {
@@ -103,5 +141,6 @@ namespace boost
     {
       using rpcd::coro_handler_with_hooks<Ret, Args...>::async_result::async_result;
     };
+#endif
   }
 }
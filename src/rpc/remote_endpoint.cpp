@@ -0,0 +1,157 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <rpc/remote_endpoint.hpp>
+
+#include <boost/iostreams/stream.hpp>
+#include <boost/optional.hpp>
+
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace fhg
+{
+  namespace rpc
+  {
+    struct remote_endpoint::function_ids
+    {
+      struct entry
+      {
+        std::string name;
+        boost::optional<function_id> id;
+        bool negotiating = false;
+      };
+
+      std::mutex guard;
+      bool negotiation_unsupported = false;
+      //! \note Keyed by the address of the name to avoid hashing it
+      //! on every call. The name is kept to detect addresses reused
+      //! by another name, e.g. after unloading a library.
+      std::unordered_map<char const*, entry> entries;
+
+      entry& at (char const* name)
+      {
+        entry& function (entries[name]);
+
+        if (function.name != name)
+        {
+          function = entry();
+          function.name = name;
+        }
+
+        return function;
+      }
+    };
+
+    remote_endpoint::remote_endpoint
+        (util::serialization::exception::serialization_functions functions)
+      : _serialization_functions (error::add_builtin (std::move (functions)))
+      , _function_ids (std::make_shared<function_ids>())
+    {}
+
+    void remote_endpoint::write_function
+      (boost::archive::binary_oarchive& archive, char const* name)
+    {
+      boost::optional<function_id> id;
+      bool negotiate (false);
+
+      {
+        std::lock_guard<std::mutex> const lock (_function_ids->guard);
+
+        if (!_function_ids->negotiation_unsupported)
+        {
+          auto& function (_function_ids->at (name));
+
+          id = function.id;
+          negotiate = !id && !function.negotiating;
+          function.negotiating = function.negotiating || negotiate;
+        }
+      }
+
+      if (id)
+      {
+        archive << std::string();
+        archive << *id;
+
+        return;
+      }
+
+      if (negotiate)
+      {
+        negotiate_function_id (name);
+      }
+
+      archive << std::string (name);
+    }
+
+    void remote_endpoint::negotiate_function_id (char const* name)
+    {
+      std::vector<char> request;
+      {
+        util::vector_sink sink (request);
+        boost::iostreams::stream<decltype (sink)> stream (sink);
+        boost::archive::binary_oarchive archive (stream);
+        archive << std::string (detail::resolve_function_id_name);
+        archive << std::string (name);
+      }
+
+      std::shared_ptr<function_ids> const ids (_function_ids);
+
+      send_and_receive
+        ( std::move (request)
+        , [ids, name] (boost::archive::binary_iarchive& archive)
+          {
+            bool is_exception;
+            archive >> is_exception;
+
+            std::lock_guard<std::mutex> const lock (ids->guard);
+
+            //! \note only older service_dispatchers do not know the
+            //! builtin: stay with names for the whole connection
+            if (is_exception)
+            {
+              ids->negotiation_unsupported = true;
+
+              return;
+            }
+
+            bool known;
+            archive >> known;
+
+            auto& function (ids->at (name));
+
+            function.negotiating = false;
+
+            if (known)
+            {
+              function_id id;
+              archive >> id;
+
+              function.id = id;
+            }
+          }
+        , [ids, name] (std::exception_ptr)
+          {
+            std::lock_guard<std::mutex> const lock (ids->guard);
+
+            ids->at (name).negotiating = false;
+          }
+        );
+    }
+  }
+}
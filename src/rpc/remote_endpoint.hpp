@@ -21,9 +21,13 @@
 #include <util-generic/serialization/exception.hpp>
 
 #include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/asio/io_service.hpp>
 
 #include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace fhg
 {
@@ -31,9 +35,7 @@ namespace fhg
   {
     struct remote_endpoint
     {
-      remote_endpoint (util::serialization::exception::serialization_functions functions)
-        : _serialization_functions (error::add_builtin (std::move (functions)))
-      {}
+      remote_endpoint (util::serialization::exception::serialization_functions);
 
       remote_endpoint (remote_endpoint const&) = default;
       remote_endpoint (remote_endpoint&&) = default;
@@ -53,6 +55,16 @@ namespace fhg
         friend struct remote_function;
       util::serialization::exception::serialization_functions
         _serialization_functions;
+
+      //! Write the identification of the function to call: its
+      //! function_id if already negotiated on this connection, its
+      //! name otherwise. The first call of a function starts
+      //! negotiating its id in the background.
+      void write_function (boost::archive::binary_oarchive&, char const* name);
+      void negotiate_function_id (char const* name);
+
+      struct function_ids;
+      std::shared_ptr<function_ids> _function_ids;
     };
   }
 }
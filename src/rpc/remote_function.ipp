@@ -136,7 +136,7 @@ namespace fhg
         util::vector_sink sink (request);
         boost::iostreams::stream<decltype (sink)> stream (sink);
         boost::archive::binary_oarchive archive (stream);
-        archive << std::string (typeid (Description).name());
+        _endpoint.write_function (archive, typeid (Description).name());
         archive << arguments_tuple_of_t < typename Description::signature
                                         , Args...
                                         > (std::forward<Args> (args)...);
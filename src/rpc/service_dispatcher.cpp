@@ -22,14 +22,68 @@
 #include <boost/iostreams/device/array.hpp>
 
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace fhg
 {
   namespace rpc
   {
+    service_dispatcher::handler_registration::handler_registration
+        (service_dispatcher& dispatcher, std::string name, handler function)
+      : _dispatcher (dispatcher)
+    {
+      auto const id
+        ( _dispatcher._function_ids.emplace
+            (name, static_cast<function_id> (_dispatcher._handlers.size()))
+        );
+
+      if (id.second)
+      {
+        _dispatcher._function_names.emplace_back (name);
+        _dispatcher._handlers.emplace_back();
+      }
+
+      _id = id.first->second;
+
+      if (_dispatcher._handlers[_id])
+      {
+        throw error::duplicate_function (std::move (name));
+      }
+
+      _dispatcher._handlers[_id] = std::move (function);
+    }
+
+    service_dispatcher::handler_registration::~handler_registration()
+    {
+      _dispatcher._handlers[_id] = nullptr;
+    }
+
     service_dispatcher::service_dispatcher
         (util::serialization::exception::serialization_functions functions)
           : _serialization_functions (error::add_builtin (std::move (functions)))
+          , _resolve_function_id
+              ( *this
+              , detail::resolve_function_id_name
+              , [this] ( boost::asio::yield_context
+                       , boost::archive::binary_iarchive& input
+                       , boost::archive::binary_oarchive& output
+                       )
+                {
+                  std::string name;
+                  input >> name;
+
+                  auto const id (_function_ids.find (name));
+
+                  output << false;
+                  output << (id != _function_ids.end());
+
+                  if (id != _function_ids.end())
+                  {
+                    output << id->second;
+                  }
+                }
+              )
     {}
 
     void service_dispatcher::dispatch ( boost::asio::yield_context yield
@@ -42,15 +96,37 @@ namespace fhg
 
       try
       {
-        decltype (_handlers)::const_iterator const handler
-          (_handlers.find (function));
+        function_id id;
+
+        if (function.empty())
+        {
+          input >> id;
+
+          if (!(id < _handlers.size()))
+          {
+            throw error::unknown_function ("#" + std::to_string (id));
+          }
+        }
+        else
+        {
+          auto const known (_function_ids.find (function));
+
+          if (known == _function_ids.end())
+          {
+            throw error::unknown_function (function);
+          }
+
+          id = known->second;
+        }
+
+        handler const& function_handler (_handlers[id]);
 
-        if (handler == _handlers.end())
+        if (!function_handler)
         {
-          throw error::unknown_function (function);
+          throw error::unknown_function (_function_names[id]);
         }
 
-        handler->second (yield, input, output);
+        function_handler (yield, input, output);
       }
       catch (...)
       {
@@ -16,12 +16,15 @@
 
 #pragma once
 
+#include <rpc/common.hpp>
+
 #include <util-generic/serialization/exception.hpp>
 
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/asio/spawn.hpp>
 
+#include <deque>
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -51,16 +54,39 @@ namespace fhg
     private:
       template<typename> friend struct service_handler;
 
-      std::unordered_map
-        < std::string
-        , std::function< void ( boost::asio::yield_context
-                              , boost::archive::binary_iarchive&
-                              , boost::archive::binary_oarchive&
-                              )
-                       >
-        > _handlers;
+      using handler = std::function< void ( boost::asio::yield_context
+                                          , boost::archive::binary_iarchive&
+                                          , boost::archive::binary_oarchive&
+                                          )
+                                   >;
+
+      //! \note A name gets its function_id on first registration and
+      //! keeps it when unregistered and registered again, so clients
+      //! do not need to negotiate again.
+      struct handler_registration
+      {
+        handler_registration (service_dispatcher&, std::string, handler);
+        ~handler_registration();
+
+        handler_registration (handler_registration const&) = delete;
+        handler_registration (handler_registration&&) = delete;
+        handler_registration& operator= (handler_registration const&) = delete;
+        handler_registration& operator= (handler_registration&&) = delete;
+
+      private:
+        service_dispatcher& _dispatcher;
+        function_id _id;
+      };
+
+      std::unordered_map<std::string, function_id> _function_ids;
+      //! \note deque: references stay valid on registration while a
+      //! yielding handler is running
+      std::deque<std::string> _function_names;
+      std::deque<handler> _handlers;
 
       util::serialization::exception::serialization_functions _serialization_functions;
+
+      handler_registration _resolve_function_id;
     };
   }
 }
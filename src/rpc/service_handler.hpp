@@ -49,8 +49,7 @@ namespace fhg
                         );
 
     private:
-      util::unique_scoped_map_insert<decltype (service_dispatcher::_handlers)>
-        _handler_registration;
+      service_dispatcher::handler_registration _handler_registration;
     };
   }
 }
@@ -31,7 +31,7 @@ namespace fhg
       service_handler<Description>::service_handler
           (service_dispatcher& manager, Func&& handler, Yielding)
         : _handler_registration
-            ( manager._handlers
+            ( manager
             , typeid (Description).name()
             , [handler] ( boost::asio::yield_context yield
                         , boost::archive::binary_iarchive& input
@@ -14,6 +14,7 @@
 // You should have received a copy of the GNU General Public License
 // along with this program. If not, see <https://www.gnu.org/licenses/>.
 
+#include <rpc/common.hpp>
 #include <rpc/remote_tcp_endpoint.hpp>
 #include <rpc/remote_function.hpp>
 #include <rpc/service_dispatcher.hpp>
@@ -24,13 +25,16 @@
 #include <util-generic/finally.hpp>
 #include <util-generic/latch.hpp>
 #include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
+#include <util-generic/serialization/std/tuple.hpp>
 #include <util-generic/testing/flatten_nested_exceptions.hpp>
 #include <util-generic/testing/printer/future.hpp>
 #include <util-generic/testing/printer/tuple.hpp>
 #include <util-generic/testing/random.hpp>
 #include <util-generic/testing/require_exception.hpp>
 
+#include <boost/iostreams/stream.hpp>
 #include <boost/serialization/list.hpp>
+#include <boost/serialization/vector.hpp>
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -238,6 +242,53 @@ BOOST_AUTO_TEST_CASE (slow_parallel_pings)
   }
 }
 
+namespace protocol
+{
+  FHG_RPC_FUNCTION_DESCRIPTION (echo_blob, std::vector<char> (std::vector<char>));
+}
+
+BOOST_AUTO_TEST_CASE (parallel_calls_of_mixed_sizes_are_coalesced_correctly)
+{
+  fhg::util::scoped_boost_asio_io_service_with_threads io_service (4);
+
+  fhg::rpc::service_dispatcher service_dispatcher;
+  fhg::rpc::service_handler<protocol::echo_blob> start_service
+    ( service_dispatcher
+    , [] (std::vector<char> blob) { return blob; }
+    );
+  fhg::util::scoped_boost_asio_io_service_with_threads io_service_server (1);
+  fhg::rpc::service_tcp_provider const server
+    {io_service_server, service_dispatcher};
+
+  fhg::rpc::remote_tcp_endpoint client
+    ( io_service
+    , fhg::util::connectable_to_address_string (server.local_endpoint())
+    );
+
+  fhg::rpc::remote_function<protocol::echo_blob> echo (client);
+
+  //! \note sizes below and above both the write coalescing limit and
+  //! the initial receive buffer size
+  std::vector<std::vector<char>> blobs;
+  for (std::size_t i (0); i < 500; ++i)
+  {
+    std::size_t const size
+      (i % 50 == 0 ? (std::size_t (3) << 19) + i : (i * 131) % 4096);
+    blobs.emplace_back (size, static_cast<char> (i));
+  }
+
+  std::vector<std::future<std::vector<char>>> futures;
+  for (auto const& blob : blobs)
+  {
+    futures.emplace_back (echo (blob));
+  }
+
+  for (std::size_t i (0); i < blobs.size(); ++i)
+  {
+    BOOST_REQUIRE (futures.at (i).get() == blobs.at (i));
+  }
+}
+
 BOOST_AUTO_TEST_CASE (deferred_dispatcher)
 {
   fhg::util::scoped_boost_asio_io_service_with_threads io_service (1);
@@ -336,6 +387,85 @@ BOOST_AUTO_TEST_CASE (dispatcher_can_be_extended_after_provider_startup)
   }
 }
 
+BOOST_AUTO_TEST_CASE (repeated_calls_use_negotiated_function_id)
+{
+  fhg::rpc::service_dispatcher service_dispatcher;
+  fhg::rpc::service_handler<protocol::ping> start_service
+    ( service_dispatcher
+    , [] (int i) { return i + 1; }
+    );
+  fhg::util::scoped_boost_asio_io_service_with_threads io_service_server (1);
+  fhg::rpc::service_tcp_provider const server
+    {io_service_server, service_dispatcher};
+
+  fhg::util::scoped_boost_asio_io_service_with_threads io_service_client (1);
+  fhg::rpc::remote_tcp_endpoint client
+    ( io_service_client
+    , fhg::util::connectable_to_address_string (server.local_endpoint())
+    );
+
+  //! \note the first calls are sent by name while the id is being
+  //! negotiated, all later ones by id
+  for (int i (0); i < 100; ++i)
+  {
+    int const s (fhg::util::testing::random<int>{} (1 << 20, 0));
+
+    BOOST_REQUIRE_EQUAL
+      (fhg::rpc::sync_remote_function<protocol::ping> {client} (s), s + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE (calls_identified_by_name_are_accepted)
+{
+  fhg::rpc::service_dispatcher service_dispatcher;
+  fhg::rpc::service_handler<protocol::ping> start_service
+    ( service_dispatcher
+    , [] (int i) { return i + 1; }
+    );
+  fhg::util::scoped_boost_asio_io_service_with_threads io_service_server (1);
+  fhg::rpc::service_tcp_provider const server
+    {io_service_server, service_dispatcher};
+
+  fhg::util::scoped_boost_asio_io_service_with_threads io_service_client (1);
+  fhg::rpc::remote_tcp_endpoint client
+    ( io_service_client
+    , fhg::util::connectable_to_address_string (server.local_endpoint())
+    );
+
+  int const s (fhg::util::testing::random<int>{} (1 << 20, 0));
+
+  //! \note request as sent by clients without function id negotiation
+  std::vector<char> request;
+  {
+    fhg::util::vector_sink sink (request);
+    boost::iostreams::stream<decltype (sink)> stream (sink);
+    boost::archive::binary_oarchive archive (stream);
+    archive << std::string (typeid (protocol::ping).name());
+    archive << std::tuple<int> (s);
+  }
+
+  std::promise<int> pong;
+  client.send_and_receive
+    ( std::move (request)
+    , [&] (boost::archive::binary_iarchive& archive)
+      {
+        bool is_exception;
+        archive >> is_exception;
+        BOOST_REQUIRE (!is_exception);
+
+        int value;
+        archive >> value;
+        pong.set_value (value);
+      }
+    , [&] (std::exception_ptr exception)
+      {
+        pong.set_exception (exception);
+      }
+    );
+
+  BOOST_REQUIRE_EQUAL (pong.get_future().get(), s + 1);
+}
+
 namespace protocol
 {
   FHG_RPC_FUNCTION_DESCRIPTION (wait, void());
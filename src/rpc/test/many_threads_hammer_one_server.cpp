@@ -32,6 +32,11 @@
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
 namespace protocol
 {
   FHG_RPC_FUNCTION_DESCRIPTION (ping, int (int));
@@ -104,6 +109,41 @@ namespace
   }
 }
 
+namespace
+{
+  struct throughput_report
+  {
+    throughput_report ( std::string description
+                      , std::size_t client_count
+                      , std::size_t client_thread_count
+                      )
+      : _description (std::move (description))
+      , _client_count (client_count)
+      , _client_thread_count (client_thread_count)
+      , _start (std::chrono::steady_clock::now())
+    {}
+
+    void finished (std::size_t calls) const
+    {
+      std::chrono::duration<double> const elapsed
+        (std::chrono::steady_clock::now() - _start);
+
+      std::cout << _description
+                << ": clients=" << _client_count
+                << " threads=" << _client_thread_count
+                << " calls=" << calls
+                << " seconds=" << elapsed.count()
+                << " calls/s=" << double (calls) / elapsed.count()
+                << "\n";
+    }
+
+    std::string const _description;
+    std::size_t const _client_count;
+    std::size_t const _client_thread_count;
+    std::chrono::steady_clock::time_point const _start;
+  };
+}
+
 namespace data
 {
   namespace
@@ -159,8 +199,15 @@ BOOST_DATA_TEST_CASE
       ( fhg::util::cxx14::make_unique<fhg::rpc::remote_tcp_endpoint>
           (io_service_clients, endpoint_address, server.local_endpoint().port())
       );
+  }
+
+  throughput_report const report
+    ("local_tcp", client_count, client_thread_count);
+
+  for (std::size_t i (0); i < client_count; ++i)
+  {
     futures.emplace_back
-      (fhg::rpc::remote_function<protocol::ping> {*clients.back()} (i));
+      (fhg::rpc::remote_function<protocol::ping> {*clients.at (i)} (i));
   }
 
   std::vector<std::future<int>> futures2;
@@ -187,6 +234,8 @@ BOOST_DATA_TEST_CASE
   {
     BOOST_REQUIRE_EQUAL (current->at (i).get(), round + i + 1);
   }
+
+  report.finished (client_count * (rounds + 1));
 }
 
 BOOST_DATA_TEST_CASE
@@ -228,8 +277,15 @@ BOOST_DATA_TEST_CASE
       ( fhg::util::cxx14::make_unique<fhg::rpc::remote_socket_endpoint>
           (io_service_clients, server.local_endpoint())
       );
+  }
+
+  throughput_report const report
+    ("local_socket", client_count, client_thread_count);
+
+  for (std::size_t i (0); i < client_count; ++i)
+  {
     futures.emplace_back
-      (fhg::rpc::remote_function<protocol::ping> {*clients.back()} (i));
+      (fhg::rpc::remote_function<protocol::ping> {*clients.at (i)} (i));
   }
 
   std::vector<std::future<int>> futures2;
@@ -256,4 +312,6 @@ BOOST_DATA_TEST_CASE
   {
     BOOST_REQUIRE_EQUAL (current->at (i).get(), round + i + 1);
   }
+
+  report.finished (client_count * (rounds + 1));
 }
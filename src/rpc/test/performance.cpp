@@ -128,6 +128,39 @@ BOOST_DATA_TEST_CASE ( above_1mb_throughput_shall_be_at_least_80_mibs
   require_blob_functions_le (limit, 5);
 }
 
+BOOST_AUTO_TEST_CASE (nop_latency_shall_be_at_most_200_us)
+{
+  fhg::util::scoped_boost_asio_io_service_with_threads io_service {2};
+  fhg::rpc::service_dispatcher service_dispatcher;
+
+  fhg::rpc::service_handler<protocol::nop> nop_service
+    {service_dispatcher, []{}};
+
+  fhg::rpc::service_tcp_provider const server
+    {io_service, service_dispatcher};
+  fhg::rpc::remote_tcp_endpoint endpoint
+    { io_service
+    , fhg::util::connectable_to_address_string (server.local_endpoint())
+    };
+
+  fhg::rpc::sync_remote_function<protocol::nop> nop {endpoint};
+
+  //! \note warm up: let the function id be negotiated so that only
+  //! the steady state is measured
+  for (std::size_t i (0); i < 10; ++i)
+  {
+    nop();
+  }
+
+  auto const latency
+    ( fhg::util::testing::measure_average_time<std::chrono::microseconds>
+        ([&] { nop(); }, 5000)
+    );
+
+  BOOST_TEST_MESSAGE ("nop latency: " << latency.count() << " us");
+  BOOST_REQUIRE_LE (latency, std::chrono::microseconds (200));
+}
+
 #define multiple_clients_with_one_server_setup( server_io_service_threads \
                                               , client_count              \
                                               , client_io_service_threads \
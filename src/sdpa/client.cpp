@@ -16,6 +16,7 @@
 
 #include <sdpa/client.hpp>
 
+#include <sdpa/com/batching.hpp>
 #include <sdpa/events/CancelJobAckEvent.hpp>
 #include <sdpa/events/CancelJobEvent.hpp>
 #include <sdpa/events/Codec.hpp>
@@ -33,22 +34,46 @@
 #include <sdpa/events/SubscribeAckEvent.hpp>
 #include <sdpa/events/SubscribeEvent.hpp>
 #include <sdpa/events/put_token.hpp>
+#include <sdpa/events/set_scheduling_parameters.hpp>
 #include <sdpa/events/workflow_response.hpp>
 
 #include <fhg/util/macros.hpp>
+#include <util-generic/finally.hpp>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
-#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
-#include <thread>
+#include <stdexcept>
 
 namespace sdpa
 {
   namespace client
   {
+    namespace
+    {
+      std::string random_id()
+      {
+        return boost::uuids::to_string (boost::uuids::random_generator()());
+      }
+
+      template<typename T, typename Fun>
+        void set_value_from (std::promise<T>& promise, Fun&& fun)
+      {
+        promise.set_value (fun());
+      }
+      template<typename Fun>
+        void set_value_from (std::promise<void>& promise, Fun&& fun)
+      {
+        fun();
+        promise.set_value();
+      }
+    }
+
     Client::Client ( fhg::com::host_t const& top_level_agent_host
                    , fhg::com::port_t const& top_level_agent_port
                    , std::unique_ptr<boost::asio::io_service> peer_io_service
@@ -86,26 +111,35 @@ namespace sdpa
 
       if (! ec)
       {
-        sdpa::events::SDPAEvent::Ptr const evt
-          (codec.decode (std::string (message.data.begin(), message.data.end())));
-        m_incoming_events.put (evt);
+        sdpa::com::batch::for_each_event
+          ( message.data.data(), message.data.size()
+          , [&] (char const* data, std::size_t size)
+            {
+              dispatch
+                (sdpa::events::SDPAEvent::Ptr (codec.decode (data, size)));
+            }
+          );
       }
       else if ( ec == boost::system::errc::operation_canceled
               || ec == boost::system::errc::network_down
               )
       {
         _stopping = true;
+
+        fail_all (std::make_exception_ptr (boost::system::system_error (ec)));
       }
       else
       {
         if (message.header.src != m_peer.address())
         {
-          sdpa::events::ErrorEvent::Ptr const
-            error(new sdpa::events::ErrorEvent ( sdpa::events::ErrorEvent::SDPA_EUNKNOWN
-                                               , "receiving response failed: " + boost::lexical_cast<std::string>(ec)
-                                               )
-                 );
-          m_incoming_events.put (error);
+          fail_all
+            ( std::make_exception_ptr
+                ( std::runtime_error
+                    ( "receiving response failed: "
+                    + boost::lexical_cast<std::string> (ec)
+                    )
+                )
+            );
         }
       }
 
@@ -123,154 +157,729 @@ namespace sdpa
 
     namespace
     {
-      [[noreturn]] void handle_error_and_unexpected_event
-        (sdpa::events::SDPAEvent::Ptr reply)
+      std::exception_ptr error_from_event (sdpa::events::ErrorEvent const& err)
+      {
+        return std::make_exception_ptr
+          ( std::runtime_error
+              ( "Error: reason := "
+              + err.reason()
+              + " code := "
+              + boost::lexical_cast<std::string>(err.error_code())
+              )
+          );
+      }
+    }
+
+    void Client::dispatch (sdpa::events::SDPAEvent::Ptr const& event)
+    {
+      if ( auto const* submit_ack
+         = dynamic_cast<sdpa::events::SubmitJobAckEvent const*> (event.get())
+         )
+      {
+        reply (submit_ack->job_id(), event);
+      }
+      else if ( auto const* delete_ack
+              = dynamic_cast<sdpa::events::DeleteJobAckEvent const*> (event.get())
+              )
+      {
+        reply (delete_ack->job_id(), event);
+      }
+      else if ( auto const* status
+              = dynamic_cast<sdpa::events::JobStatusReplyEvent const*> (event.get())
+              )
+      {
+        reply (status->job_id(), event);
+      }
+      else if ( auto const* subscribe_ack
+              = dynamic_cast<sdpa::events::SubscribeAckEvent const*> (event.get())
+              )
       {
-        if ( sdpa::events::ErrorEvent* const err
-           = dynamic_cast<sdpa::events::ErrorEvent*> (reply.get())
-           )
         {
-          throw std::runtime_error
-            ( "Error: reason := "
-            + err->reason()
-            + " code := "
-            + boost::lexical_cast<std::string>(err->error_code())
+          std::lock_guard<std::mutex> const _ (_pending_guard);
+          _subscribed.emplace (subscribe_ack->job_id());
+        }
+
+        reply (subscribe_ack->job_id(), event);
+      }
+      else if ( auto const* discovered
+              = dynamic_cast<sdpa::events::DiscoverJobStatesReplyEvent const*>
+                  (event.get())
+              )
+      {
+        reply (discovered->discover_id(), event);
+      }
+      else if ( auto const* put_token_response
+              = dynamic_cast<sdpa::events::put_token_response const*>
+                  (event.get())
+              )
+      {
+        reply (put_token_response->put_token_id(), event);
+      }
+      else if ( auto const* set_scheduling_parameters_response
+              = dynamic_cast
+                  <sdpa::events::set_scheduling_parameters_response const*>
+                    (event.get())
+              )
+      {
+        reply (set_scheduling_parameters_response->request_id(), event);
+      }
+      else if ( auto const* workflow_response_response
+              = dynamic_cast<sdpa::events::workflow_response_response const*>
+                  (event.get())
+              )
+      {
+        reply (workflow_response_response->workflow_response_id(), event);
+      }
+      else if ( auto const* job_finished
+              = dynamic_cast<sdpa::events::JobFinishedEvent const*> (event.get())
+              )
+      {
+        {
+          std::lock_guard<std::mutex> const _ (_pending_guard);
+          _job_results.emplace (job_finished->job_id(), job_finished->result());
+        }
+
+        terminal_state
+          ( job_finished->job_id()
+          , [] { return terminal_state_t {sdpa::status::FINISHED, {}}; }
+          );
+      }
+      else if ( auto const* job_failed
+              = dynamic_cast<sdpa::events::JobFailedEvent const*> (event.get())
+              )
+      {
+        terminal_state
+          ( job_failed->job_id()
+          , [&]
+            {
+              return terminal_state_t
+                {sdpa::status::FAILED, {job_failed->error_message()}};
+            }
+          );
+      }
+      else if ( auto const* cancel_ack
+              = dynamic_cast<sdpa::events::CancelJobAckEvent const*> (event.get())
+              )
+      {
+        //! \note Subscribers are not acknowledged a cancel request
+        //! but notified once the job is canceled: the same event then
+        //! answers both.
+        bool notification;
+        {
+          std::lock_guard<std::mutex> const _ (_pending_guard);
+          notification = _subscribed.count (cancel_ack->job_id());
+        }
+
+        reply (cancel_ack->job_id(), event);
+
+        if (notification)
+        {
+          terminal_state
+            ( cancel_ack->job_id()
+            , [] { return terminal_state_t {sdpa::status::CANCELED, {}}; }
             );
         }
+      }
+      else if ( auto const* error
+              = dynamic_cast<sdpa::events::ErrorEvent const*> (event.get())
+              )
+      {
+        //! \note errors refer to the failed request by its own id or
+        //! by its job: the agent handles requests in order, so it is
+        //! the oldest one for that job
+        if (error->request_id())
+        {
+          fail_oldest (*error->request_id(), error_from_event (*error));
+        }
+        else if (error->job_id())
+        {
+          fail_oldest (*error->job_id(), error_from_event (*error));
+        }
+        else
+        {
+          fail_all (error_from_event (*error));
+        }
+      }
+      else
+      {
+        fail_all
+          ( std::make_exception_ptr
+              ( std::runtime_error
+                  ("Unexpected reply: " + std::string (typeid (*event).name()))
+              )
+          );
+      }
+    }
+
+    void Client::reply ( std::string const& correlation_id
+                       , sdpa::events::SDPAEvent::Ptr const& event
+                       )
+    {
+      std::function<void (sdpa::events::SDPAEvent::Ptr const&)> on_reply;
 
-        throw std::runtime_error
-          ("Unexpected reply: " + std::string (typeid (reply.get()).name()));
+      {
+        std::lock_guard<std::mutex> const _ (_pending_guard);
+
+        auto requests (_pending_requests.find (correlation_id));
+
+        if (requests == _pending_requests.end())
+        {
+          return;
+        }
+
+        auto const request
+          ( std::find_if ( requests->second.begin(), requests->second.end()
+                         , [&] (pending_request const& pending)
+                           {
+                             return pending.reply == typeid (*event);
+                           }
+                         )
+          );
+
+        if (request == requests->second.end())
+        {
+          return;
+        }
+
+        on_reply = std::move (request->on_reply);
+
+        requests->second.erase (request);
+
+        if (requests->second.empty())
+        {
+          _pending_requests.erase (requests);
+        }
       }
+
+      on_reply (event);
     }
 
-    template<typename Expected, typename Sent>
-      Expected Client::send_and_wait_for_reply (Sent event)
+    void Client::fail_oldest
+      (std::string const& correlation_id, std::exception_ptr error)
     {
-      std::lock_guard<std::mutex> const _ (_make_client_thread_safe);
+      std::function<void (std::exception_ptr)> on_error;
 
-      m_incoming_events.INDICATES_A_RACE_clear();
+      {
+        std::lock_guard<std::mutex> const _ (_pending_guard);
 
-      static sdpa::events::Codec const codec {};
-      m_peer.send (_drts_entrypoint_address, codec.encode (&event));
+        auto requests (_pending_requests.find (correlation_id));
+
+        if (requests == _pending_requests.end())
+        {
+          return;
+        }
+
+        on_error = std::move (requests->second.front().on_error);
+
+        requests->second.pop_front();
+
+        if (requests->second.empty())
+        {
+          _pending_requests.erase (requests);
+        }
+      }
+
+      on_error (error);
+    }
+
+    void Client::fail_all (std::exception_ptr error)
+    {
+      decltype (_pending_requests) requests;
+      decltype (_terminal_state_waiters) waiters;
 
-      const sdpa::events::SDPAEvent::Ptr reply (m_incoming_events.get());
-      if (Expected* const e = dynamic_cast<Expected*> (reply.get()))
       {
-        return std::move (*e);
+        std::lock_guard<std::mutex> const _ (_pending_guard);
+
+        std::swap (requests, _pending_requests);
+        std::swap (waiters, _terminal_state_waiters);
+        _subscribed.clear();
       }
 
-      handle_error_and_unexpected_event (reply);
+      for (auto& pending : requests)
+      {
+        for (pending_request& request : pending.second)
+        {
+          request.on_error (error);
+        }
+      }
+      for (auto& job_waiters : waiters)
+      {
+        for (terminal_state_waiter& waiter : job_waiters.second)
+        {
+          waiter.on_error (error);
+        }
+      }
     }
 
-    sdpa::status::code Client::wait_for_terminal_state
-      (job_id_t id, job_info_t& job_info)
+    void Client::terminal_state
+      ( job_id_t const& job_id
+      , std::function<terminal_state_t()> const& make_terminal_state
+      )
     {
-      send_and_wait_for_reply<sdpa::events::SubscribeAckEvent>
-        (sdpa::events::SubscribeEvent (id));
-     sdpa::events::SDPAEvent::Ptr const reply (m_incoming_events.get());
+      std::list<terminal_state_waiter> waiters;
 
-      if ( sdpa::events::JobFinishedEvent* const job_finished
-         = dynamic_cast<sdpa::events::JobFinishedEvent*> (reply.get())
-         )
       {
-        if (job_finished->job_id() != id)
+        std::lock_guard<std::mutex> const _ (_pending_guard);
+
+        _subscribed.erase (job_id);
+
+        auto job_waiters (_terminal_state_waiters.find (job_id));
+
+        if (job_waiters == _terminal_state_waiters.end())
         {
-          throw std::runtime_error ("got status change for different job");
+          return;
         }
 
-        _job_results.emplace (id, job_finished->result());
-        return sdpa::status::FINISHED;
+        std::swap (waiters, job_waiters->second);
+
+        _terminal_state_waiters.erase (job_waiters);
       }
-      else if ( sdpa::events::JobFailedEvent* const job_failed
-              = dynamic_cast<sdpa::events::JobFailedEvent*> (reply.get())
-              )
+
+      terminal_state_t const state (make_terminal_state());
+
+      for (terminal_state_waiter& waiter : waiters)
+      {
+        waiter.on_terminal_state (state);
+      }
+    }
+
+    void Client::send (sdpa::events::SDPAEvent const& event)
+    {
+      static sdpa::events::Codec const codec {};
+      fhg::com::buffer serialized_event (m_peer.buffers().get (0));
+      codec.encode (&event, serialized_event);
+      m_peer.async_send
+        ( _drts_entrypoint_address, std::move (serialized_event)
+        , [this] (boost::system::error_code const& ec)
+          {
+            //! \note the connection is gone, nothing outstanding will
+            //! be answered
+            if (ec)
+            {
+              fail_all
+                (std::make_exception_ptr (boost::system::system_error (ec)));
+            }
+          }
+        );
+    }
+
+    template<typename Expected, typename Result, typename Sent>
+      std::future<Result> Client::request
+        ( std::string const& correlation_id
+        , Sent event
+        , std::function<Result (Expected&)> extract
+        )
+    {
+      auto const promise (std::make_shared<std::promise<Result>>());
+      std::future<Result> future (promise->get_future());
+      std::uint64_t request_id;
+
       {
-        if (job_failed->job_id() != id)
+        std::lock_guard<std::mutex> const _ (_pending_guard);
+
+        request_id = _next_id++;
+
+        _pending_requests[correlation_id].emplace_back
+          ( pending_request
+              { request_id
+              , typeid (Expected)
+              , [promise, extract] (sdpa::events::SDPAEvent::Ptr const& reply)
+                {
+                  try
+                  {
+                    set_value_from
+                      ( *promise
+                      , [&] { return extract (dynamic_cast<Expected&> (*reply)); }
+                      );
+                  }
+                  catch (...)
+                  {
+                    promise->set_exception (std::current_exception());
+                  }
+                }
+              , [promise] (std::exception_ptr error)
+                {
+                  promise->set_exception (error);
+                }
+              }
+          );
+      }
+
+      try
+      {
+        send (event);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> const _ (_pending_guard);
+
+        auto requests (_pending_requests.find (correlation_id));
+
+        if (requests != _pending_requests.end())
         {
-          throw std::runtime_error ("got status change for different job");
+          requests->second.remove_if
+            ( [&] (pending_request const& pending)
+              {
+                return pending.id == request_id;
+              }
+            );
+
+          if (requests->second.empty())
+          {
+            _pending_requests.erase (requests);
+          }
         }
-        job_info.error_message = job_failed->error_message();
-        return sdpa::status::FAILED;
+
+        throw;
       }
-      else if ( sdpa::events::CancelJobAckEvent* const cancel_ack
-              = dynamic_cast<sdpa::events::CancelJobAckEvent*> (reply.get())
-              )
+
+      return future;
+    }
+
+    std::uint64_t Client::when_terminal
+      (job_id_t job_id, terminal_state_waiter waiter)
+    {
+      bool first_waiter;
+      std::uint64_t waiter_id;
+
       {
-        if (cancel_ack->job_id() != id)
+        std::lock_guard<std::mutex> const _ (_pending_guard);
+
+        //! \note the entry stays when its waiters are forgotten, so
+        //! it also marks the subscription as requested
+        first_waiter = !_terminal_state_waiters.count (job_id);
+
+        waiter_id = _next_id++;
+        waiter.id = waiter_id;
+        _terminal_state_waiters[job_id].emplace_back (std::move (waiter));
+
+        //! \note later waiters share the subscription of the first
+        if (first_waiter)
         {
-          throw std::runtime_error ("got status change for different job");
+          _pending_requests[job_id].emplace_back
+            ( pending_request
+                { _next_id++
+                , typeid (sdpa::events::SubscribeAckEvent)
+                , [] (sdpa::events::SDPAEvent::Ptr const&) {}
+                , [this, job_id] (std::exception_ptr error)
+                  {
+                    std::list<terminal_state_waiter> failed;
+
+                    {
+                      std::lock_guard<std::mutex> const _ (_pending_guard);
+                      auto job_waiters (_terminal_state_waiters.find (job_id));
+                      if (job_waiters != _terminal_state_waiters.end())
+                      {
+                        std::swap (failed, job_waiters->second);
+                        _terminal_state_waiters.erase (job_waiters);
+                      }
+                    }
+
+                    for (terminal_state_waiter& waiter : failed)
+                    {
+                      waiter.on_error (error);
+                    }
+                  }
+                }
+            );
         }
-        return sdpa::status::CANCELED;
       }
 
-      handle_error_and_unexpected_event (reply);
+      if (first_waiter)
+      {
+        send (sdpa::events::SubscribeEvent (job_id));
+      }
+
+      return waiter_id;
+    }
+
+    void Client::forget_terminal_state_waiter
+      (job_id_t const& job_id, std::uint64_t waiter_id)
+    {
+      std::lock_guard<std::mutex> const _ (_pending_guard);
+
+      auto job_waiters (_terminal_state_waiters.find (job_id));
+
+      if (job_waiters != _terminal_state_waiters.end())
+      {
+        job_waiters->second.remove_if
+          ( [&] (terminal_state_waiter const& waiter)
+            {
+              return waiter.id == waiter_id;
+            }
+          );
+      }
+    }
+
+    void Client::on_terminal_state
+      ( job_id_t job_id
+      , std::function<void (terminal_state_t const&)> on_terminal_state
+      , std::function<void (std::exception_ptr)> on_error
+      )
+    {
+      when_terminal
+        ( job_id
+        , terminal_state_waiter
+            {0, std::move (on_terminal_state), std::move (on_error)}
+        );
+    }
+
+    std::future<terminal_state_t>
+      Client::wait_for_terminal_state_async (job_id_t job_id)
+    {
+      auto const promise (std::make_shared<std::promise<terminal_state_t>>());
+      std::future<terminal_state_t> future (promise->get_future());
+
+      when_terminal
+        ( job_id
+        , terminal_state_waiter
+            { 0
+            , [promise] (terminal_state_t const& state)
+              {
+                promise->set_value (state);
+              }
+            , [promise] (std::exception_ptr error)
+              {
+                promise->set_exception (error);
+              }
+            }
+        );
+
+      return future;
+    }
+
+    sdpa::status::code Client::wait_for_terminal_state
+      (job_id_t id, job_info_t& job_info)
+    {
+      terminal_state_t const state (wait_for_terminal_state_async (id).get());
+
+      job_info = state.job_info;
+
+      return state.status;
+    }
+
+    job_id_t Client::wait_for_any_terminal_state
+      (std::vector<job_id_t> const& job_ids)
+    {
+      if (job_ids.empty())
+      {
+        throw std::invalid_argument
+          ("wait_for_any_terminal_state: no jobs given");
+      }
+
+      struct first_terminated
+      {
+        std::mutex guard;
+        std::condition_variable done;
+        boost::optional<job_id_t> job_id;
+        std::exception_ptr error;
+      };
+
+      auto const first (std::make_shared<first_terminated>());
+      std::vector<std::pair<job_id_t, std::uint64_t>> waiters;
+
+      //! \note the waiters for the jobs still running would otherwise
+      //! stay registered until those terminate
+      FHG_UTIL_FINALLY
+        ( [&]
+          {
+            for (auto const& waiter : waiters)
+            {
+              forget_terminal_state_waiter (waiter.first, waiter.second);
+            }
+          }
+        );
+
+      for (job_id_t const& job_id : job_ids)
+      {
+        waiters.emplace_back
+          ( job_id
+          , when_terminal
+              ( job_id
+              , terminal_state_waiter
+                  { 0
+                  , [first, job_id] (terminal_state_t const&)
+                    {
+                      std::lock_guard<std::mutex> const _ (first->guard);
+                      if (!first->job_id && !first->error)
+                      {
+                        first->job_id = job_id;
+                        first->done.notify_all();
+                      }
+                    }
+                  , [first] (std::exception_ptr error)
+                    {
+                      std::lock_guard<std::mutex> const _ (first->guard);
+                      if (!first->job_id && !first->error)
+                      {
+                        first->error = error;
+                        first->done.notify_all();
+                      }
+                    }
+                  }
+              )
+          );
+      }
+
+      std::unique_lock<std::mutex> lock (first->guard);
+      first->done.wait (lock, [&] { return first->job_id || first->error; });
+
+      if (first->error)
+      {
+        std::rethrow_exception (first->error);
+      }
+
+      return *first->job_id;
+    }
+
+    std::future<sdpa::job_id_t> Client::submit_job_async
+      ( we::type::activity_t activity
+      , boost::optional<scheduling_parameters> parameters
+      )
+    {
+      //! \note chosen here to correlate the acknowledgement
+      sdpa::job_id_t const job_id (random_id());
+
+      return request<sdpa::events::SubmitJobAckEvent, sdpa::job_id_t>
+        ( job_id
+        , sdpa::events::SubmitJobEvent
+            (job_id, std::move (activity), boost::none, {}, parameters)
+        , [] (sdpa::events::SubmitJobAckEvent& ack)
+          {
+            return ack.job_id();
+          }
+        );
     }
 
     sdpa::job_id_t Client::submitJob (we::type::activity_t activity)
     {
-      return send_and_wait_for_reply<sdpa::events::SubmitJobAckEvent>
-        (sdpa::events::SubmitJobEvent (boost::none, std::move (activity), boost::none)).job_id();
+      return submit_job_async (std::move (activity)).get();
+    }
+
+    sdpa::job_id_t Client::submitJob
+      (we::type::activity_t activity, scheduling_parameters parameters)
+    {
+      return submit_job_async (std::move (activity), parameters).get();
+    }
+
+    std::future<void> Client::cancel_job_async (job_id_t job_id)
+    {
+      return request<sdpa::events::CancelJobAckEvent, void>
+        ( job_id
+        , sdpa::events::CancelJobEvent (job_id)
+        , [] (sdpa::events::CancelJobAckEvent&) {}
+        );
     }
 
     void Client::cancelJob(const job_id_t &jid)
     {
-      send_and_wait_for_reply<sdpa::events::CancelJobAckEvent>
-        (sdpa::events::CancelJobEvent (jid));
+      cancel_job_async (jid).get();
     }
 
     sdpa::discovery_info_t Client::discoverJobStates(const we::layer::id_type& discover_id, const job_id_t &job_id)
     {
-      return send_and_wait_for_reply<sdpa::events::DiscoverJobStatesReplyEvent>
-        (sdpa::events::DiscoverJobStatesEvent (job_id, discover_id)).discover_result();
+      return request< sdpa::events::DiscoverJobStatesReplyEvent
+                    , sdpa::discovery_info_t
+                    >
+        ( discover_id
+        , sdpa::events::DiscoverJobStatesEvent (job_id, discover_id)
+        , [] (sdpa::events::DiscoverJobStatesReplyEvent& reply)
+          {
+            return reply.discover_result();
+          }
+        ).get();
     }
 
-    void Client::put_token
+    std::future<void> Client::put_token_async
       (job_id_t job_id, std::string place_name, pnet::type::value::value_type value)
     {
-      std::string const put_token_id
-        (boost::uuids::to_string (boost::uuids::random_generator()()));
+      return put_tokens_async (job_id, place_name, {value});
+    }
 
-      sdpa::events::put_token_response const response
-        ( send_and_wait_for_reply<sdpa::events::put_token_response>
-            ( sdpa::events::put_token ( job_id
-                                      , put_token_id
-                                      , place_name
-                                      , value
-                                      )
-            )
+    std::future<void> Client::put_tokens_async
+      ( job_id_t job_id
+      , std::string place_name
+      , std::list<pnet::type::value::value_type> values
+      )
+    {
+      std::string const put_token_id (random_id());
+
+      return request<sdpa::events::put_token_response, void>
+        ( put_token_id
+        , sdpa::events::put_token ( job_id
+                                  , put_token_id
+                                  , place_name
+                                  , std::move (values)
+                                  )
+        , [] (sdpa::events::put_token_response& response)
+          {
+            response.get();
+          }
         );
+    }
 
-      if (response.put_token_id() != put_token_id)
-      {
-        throw std::logic_error ("received put_token_response for different put_token");
-      }
+    void Client::put_token
+      (job_id_t job_id, std::string place_name, pnet::type::value::value_type value)
+    {
+      put_token_async (job_id, place_name, value).get();
+    }
 
-      return response.get();
+    void Client::put_tokens
+      ( job_id_t job_id
+      , std::string place_name
+      , std::list<pnet::type::value::value_type> values
+      )
+    {
+      put_tokens_async (job_id, place_name, std::move (values)).get();
     }
 
-    pnet::type::value::value_type Client::workflow_response
-      (job_id_t job_id, std::string place_name, pnet::type::value::value_type value)
+    std::future<void> Client::set_scheduling_parameters_async
+      (job_id_t job_id, scheduling_parameters parameters)
     {
-      std::string const workflow_response_id
-        (boost::uuids::to_string (boost::uuids::random_generator()()));
-
-      sdpa::events::workflow_response_response const response
-        ( send_and_wait_for_reply<sdpa::events::workflow_response_response>
-            ( sdpa::events::workflow_response ( job_id
-                                              , workflow_response_id
-                                              , place_name
-                                              , value
-                                              )
-            )
+      std::string const request_id (random_id());
+
+      return request<sdpa::events::set_scheduling_parameters_response, void>
+        ( request_id
+        , sdpa::events::set_scheduling_parameters
+            (job_id, request_id, parameters)
+        , [] (sdpa::events::set_scheduling_parameters_response& response)
+          {
+            response.get();
+          }
         );
+    }
 
-      if (response.workflow_response_id() != workflow_response_id)
-      {
-        throw std::logic_error
-          ("received workflow_response_response for different workflow_response");
-      }
+    void Client::set_scheduling_parameters
+      (job_id_t job_id, scheduling_parameters parameters)
+    {
+      set_scheduling_parameters_async (job_id, parameters).get();
+    }
 
-      return response.get();
+    std::future<pnet::type::value::value_type> Client::workflow_response_async
+      (job_id_t job_id, std::string place_name, pnet::type::value::value_type value)
+    {
+      std::string const workflow_response_id (random_id());
+
+      return request< sdpa::events::workflow_response_response
+                    , pnet::type::value::value_type
+                    >
+        ( workflow_response_id
+        , sdpa::events::workflow_response ( job_id
+                                          , workflow_response_id
+                                          , place_name
+                                          , value
+                                          )
+        , [] (sdpa::events::workflow_response_response& response)
+          {
+            return response.get();
+          }
+        );
+    }
+
+    pnet::type::value::value_type Client::workflow_response
+      (job_id_t job_id, std::string place_name, pnet::type::value::value_type value)
+    {
+      return workflow_response_async (job_id, place_name, value).get();
     }
 
     sdpa::status::code Client::queryJob(const job_id_t &jid)
@@ -281,26 +890,45 @@ namespace sdpa
 
     sdpa::status::code Client::queryJob(const job_id_t &jid, job_info_t &info)
     {
-      const sdpa::events::JobStatusReplyEvent reply
-        ( send_and_wait_for_reply<sdpa::events::JobStatusReplyEvent>
-          (sdpa::events::QueryJobStatusEvent (jid))
+      terminal_state_t const reply
+        ( request<sdpa::events::JobStatusReplyEvent, terminal_state_t>
+            ( jid
+            , sdpa::events::QueryJobStatusEvent (jid)
+            , [] (sdpa::events::JobStatusReplyEvent& status)
+              {
+                return terminal_state_t
+                  {status.status(), {status.error_message()}};
+              }
+            ).get()
         );
 
-      info.error_message = reply.error_message();
+      info = reply.job_info;
 
-      return reply.status();
+      return reply.status;
     }
 
-    void Client::deleteJob(const job_id_t &jid)
+    std::future<void> Client::delete_job_async (job_id_t job_id)
     {
-      send_and_wait_for_reply<sdpa::events::DeleteJobAckEvent>
-        (sdpa::events::DeleteJobEvent (jid));
+      return request<sdpa::events::DeleteJobAckEvent, void>
+        ( job_id
+        , sdpa::events::DeleteJobEvent (job_id)
+        , [this, job_id] (sdpa::events::DeleteJobAckEvent&)
+          {
+            std::lock_guard<std::mutex> const _ (_pending_guard);
+            _job_results.erase (job_id);
+          }
+        );
+    }
 
-      _job_results.erase (jid);
+    void Client::deleteJob(const job_id_t &jid)
+    {
+      delete_job_async (jid).get();
     }
 
     we::type::activity_t Client::result (sdpa::job_id_t const& job) const
     {
+      std::lock_guard<std::mutex> const _ (_pending_guard);
+
       if (!_job_results.count (job))
       {
         throw std::runtime_error ("couldn't find any resulted stored for the job " + job);
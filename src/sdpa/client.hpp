@@ -17,6 +17,7 @@
 #pragma once
 
 #include <sdpa/events/SDPAEvent.hpp>
+#include <sdpa/scheduling_parameters.hpp>
 #include <sdpa/types.hpp>
 
 #include <we/layer.hpp>
@@ -25,15 +26,22 @@
 
 #include <fhgcom/peer.hpp>
 
-#include <fhg/util/thread/queue.hpp>
-
 #include <boost/noncopyable.hpp>
 #include <boost/optional.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace sdpa
 {
@@ -44,6 +52,15 @@ namespace sdpa
       std::string error_message;
     };
 
+    struct terminal_state_t
+    {
+      sdpa::status::code status;
+      job_info_t job_info;
+    };
+
+    //! \note Requests are correlated with their replies by job id or
+    //! by the request id sent along, so any number of them may be
+    //! outstanding at the same time, from any number of threads.
     class Client : boost::noncopyable
     {
     public:
@@ -55,6 +72,7 @@ namespace sdpa
       ~Client();
 
       job_id_t submitJob(we::type::activity_t);
+      job_id_t submitJob (we::type::activity_t, scheduling_parameters);
       void cancelJob(const job_id_t &);
       status::code queryJob(const job_id_t &);
       status::code queryJob(const job_id_t &, job_info_t &);
@@ -62,20 +80,94 @@ namespace sdpa
       sdpa::discovery_info_t discoverJobStates(const we::layer::id_type& discover_id, const job_id_t &job_id);
       void put_token
         (job_id_t, std::string place_name, pnet::type::value::value_type);
+      void put_tokens
+        ( job_id_t
+        , std::string place_name
+        , std::list<pnet::type::value::value_type>
+        );
       pnet::type::value::value_type workflow_response
         (job_id_t, std::string place_name, pnet::type::value::value_type);
+      void set_scheduling_parameters (job_id_t, scheduling_parameters);
 
       sdpa::status::code wait_for_terminal_state (job_id_t, job_info_t&);
 
+      std::future<job_id_t> submit_job_async
+        ( we::type::activity_t
+        , boost::optional<scheduling_parameters> = boost::none
+        );
+      std::future<void> cancel_job_async (job_id_t);
+      std::future<void> delete_job_async (job_id_t);
+      std::future<void> put_token_async
+        (job_id_t, std::string place_name, pnet::type::value::value_type);
+      //! \note all values travel in one event and are acknowledged once
+      std::future<void> put_tokens_async
+        ( job_id_t
+        , std::string place_name
+        , std::list<pnet::type::value::value_type>
+        );
+      std::future<pnet::type::value::value_type> workflow_response_async
+        (job_id_t, std::string place_name, pnet::type::value::value_type);
+      //! \note for top level jobs only, takes effect for the jobs
+      //! not yet started
+      std::future<void> set_scheduling_parameters_async
+        (job_id_t, scheduling_parameters);
+      std::future<terminal_state_t> wait_for_terminal_state_async (job_id_t);
+      void on_terminal_state
+        ( job_id_t
+        , std::function<void (terminal_state_t const&)>
+        , std::function<void (std::exception_ptr)> on_error
+        );
+
+      //! \note returns the first of the given jobs to be in a
+      //! terminal state, independent of what that state is
+      job_id_t wait_for_any_terminal_state (std::vector<job_id_t> const&);
+
       we::type::activity_t result (sdpa::job_id_t const&) const;
 
     private:
-      std::mutex _make_client_thread_safe;
-
-      fhg::thread::queue<sdpa::events::SDPAEvent::Ptr> m_incoming_events;
-
-      template<typename Expected, typename Sent>
-        Expected send_and_wait_for_reply (Sent event);
+      struct pending_request
+      {
+        std::uint64_t id;
+        std::type_index reply;
+        std::function<void (sdpa::events::SDPAEvent::Ptr const&)> on_reply;
+        std::function<void (std::exception_ptr)> on_error;
+      };
+      struct terminal_state_waiter
+      {
+        std::uint64_t id;
+        std::function<void (terminal_state_t const&)> on_terminal_state;
+        std::function<void (std::exception_ptr)> on_error;
+      };
+
+      mutable std::mutex _pending_guard;
+      //! \note by job id or request id, in the order of sending
+      std::unordered_map<std::string, std::list<pending_request>>
+        _pending_requests;
+      std::unordered_map<job_id_t, std::list<terminal_state_waiter>>
+        _terminal_state_waiters;
+      //! \note jobs the top level agent acknowledged a subscription
+      //! for and did not yet notify about their terminal state
+      std::unordered_set<job_id_t> _subscribed;
+      std::unordered_map<sdpa::job_id_t, we::type::activity_t> _job_results;
+      std::uint64_t _next_id {0};
+
+      template<typename Expected, typename Result, typename Sent>
+        std::future<Result> request
+          ( std::string const& correlation_id
+          , Sent event
+          , std::function<Result (Expected&)> extract
+          );
+      void send (sdpa::events::SDPAEvent const&);
+
+      std::uint64_t when_terminal (job_id_t, terminal_state_waiter);
+      void forget_terminal_state_waiter (job_id_t const&, std::uint64_t);
+
+      void reply (std::string const&, sdpa::events::SDPAEvent::Ptr const&);
+      void fail_oldest (std::string const&, std::exception_ptr);
+      void fail_all (std::exception_ptr);
+      void terminal_state
+        (job_id_t const&, std::function<terminal_state_t()> const&);
+      void dispatch (sdpa::events::SDPAEvent::Ptr const&);
 
       void handle_recv ( boost::system::error_code const& ec
                        , boost::optional<fhg::com::p2p::address_t>
@@ -85,7 +177,6 @@ namespace sdpa
       bool _stopping;
       fhg::com::peer_t m_peer;
       fhg::com::p2p::address_t _drts_entrypoint_address;
-      std::unordered_map<sdpa::job_id_t, we::type::activity_t> _job_results;
     };
   }
 }
@@ -18,10 +18,12 @@
 
 #include <sdpa/events/ErrorEvent.hpp>
 
+#include <util-generic/cxx14/make_unique.hpp>
 #include <util-generic/print_exception.hpp>
 #include <util-generic/this_bound_mem_fn.hpp>
 
 #include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
 
 #include <algorithm>
 #include <utility>
@@ -36,11 +38,29 @@ namespace sdpa
         , fhg::com::host_t const& host
         , fhg::com::port_t const& port
         , fhg::com::Certificates const& certificates
+        , std::size_t io_threads
+        , boost::optional<batching> event_batching
+        , fhg::metrics::labels const& metric_labels
         )
-      : _codec()
+      : _codec (metric_labels)
       , _event_handler (event_handler)
       , m_shutting_down (false)
-      , _peer (std::move (peer_io_service), host, port, certificates)
+      , _peer ( std::move (peer_io_service)
+              , host
+              , port
+              , certificates
+              , io_threads
+              )
+      , _batching (event_batching)
+      , _batches_guard()
+      , _batches()
+      , _batch_generation (0)
+      , _batch_timers
+          ( _batching
+          ? fhg::util::cxx14::make_unique
+              <fhg::util::scoped_boost_asio_io_service_with_threads> (1)
+          : nullptr
+          )
     {
       _peer.async_recv
         (fhg::util::bind_this (this, &NetworkStrategy::handle_recv));
@@ -49,6 +69,14 @@ namespace sdpa
     NetworkStrategy::~NetworkStrategy()
     {
       m_shutting_down = true;
+
+      std::lock_guard<std::mutex> const lock (_batches_guard);
+
+      for (auto& batch : _batches)
+      {
+        perform (batch.first, std::move (batch.second.events));
+      }
+      _batches.clear();
     }
 
     fhg::com::p2p::address_t NetworkStrategy::connect_to
@@ -70,11 +98,14 @@ namespace sdpa
     {
       if (!ec)
       {
-        events::SDPAEvent::Ptr const evt
-          ( _codec.decode
-              (std::string (message.data.begin(), message.data.end()))
+        batch::for_each_event
+          ( message.data.data(), message.data.size()
+          , [&] (char const* data, std::size_t size)
+            {
+              events::SDPAEvent::Ptr const evt (_codec.decode (data, size));
+              _event_handler (source.get(), evt);
+            }
           );
-        _event_handler (source.get(), evt);
 
         _peer.async_recv
           (fhg::util::bind_this (this, &NetworkStrategy::handle_recv));
@@ -99,13 +130,13 @@ namespace sdpa
     }
 
     void NetworkStrategy::perform
-      (fhg::com::p2p::address_t const& address, std::string const& event)
+      (fhg::com::p2p::address_t const& address, fhg::com::buffer event)
     {
       try
       {
         _peer.async_send
           ( address
-          , event
+          , std::move (event)
           , [address, this] (boost::system::error_code const& ec)
             {
               if (ec)
@@ -130,5 +161,90 @@ namespace sdpa
           );
       }
     }
+
+    void NetworkStrategy::perform_batched
+      ( fhg::com::p2p::address_t const& address
+      , events::SDPAEvent const* event
+      )
+    {
+      std::lock_guard<std::mutex> const lock (_batches_guard);
+
+      auto batch (_batches.find (address));
+
+      if (batch == _batches.end())
+      {
+        batch = _batches.emplace
+          ( address
+          , pending_batch { _peer.buffers().get (0)
+                          , ++_batch_generation
+                          , fhg::util::cxx14::make_unique
+                              <boost::asio::steady_timer> (*_batch_timers)
+                          }
+          ).first;
+
+        batch::start (batch->second.events);
+
+        auto const generation (batch->second.generation);
+        batch->second.flush_timer->expires_from_now (_batching->window);
+        batch->second.flush_timer->async_wait
+          ( [this, address, generation] (boost::system::error_code const& ec)
+            {
+              if (!ec)
+              {
+                flush_batch (address, generation);
+              }
+            }
+          );
+      }
+
+      try
+      {
+        batch::append
+          ( batch->second.events
+          , [&] (fhg::com::buffer& events) { _codec.encode (event, events); }
+          );
+      }
+      catch (batch::event_too_large const&)
+      {
+        //! \note send what was batched before first to keep the order
+        fhg::com::buffer events (std::move (batch->second.events));
+        _batches.erase (batch);
+        perform (address, std::move (events));
+
+        fhg::com::buffer unbatched (_peer.buffers().get (0));
+        _codec.encode (event, unbatched);
+        perform (address, std::move (unbatched));
+
+        return;
+      }
+
+      if (batch->second.events.size() >= _batching->max_bytes)
+      {
+        fhg::com::buffer events (std::move (batch->second.events));
+        _batches.erase (batch);
+
+        perform (address, std::move (events));
+      }
+    }
+
+    void NetworkStrategy::flush_batch
+      (fhg::com::p2p::address_t const& address, std::uint64_t generation)
+    {
+      std::lock_guard<std::mutex> const lock (_batches_guard);
+
+      auto const batch (_batches.find (address));
+
+      //! \note The batch may have been sent for exceeding the size
+      //! limit already, with a newer one started since.
+      if (batch == _batches.end() || batch->second.generation != generation)
+      {
+        return;
+      }
+
+      fhg::com::buffer events (std::move (batch->second.events));
+      _batches.erase (batch);
+
+      perform (address, std::move (events));
+    }
   }
 }
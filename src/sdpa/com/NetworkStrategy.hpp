@@ -16,18 +16,28 @@
 
 #pragma once
 
+#include <sdpa/com/batching.hpp>
 #include <sdpa/events/Codec.hpp>
 #include <sdpa/events/SDPAEvent.hpp>
 
+#include <metrics/registry.hpp>
+
 #include <fhgcom/peer.hpp>
 
+#include <util-generic/scoped_boost_asio_io_service_with_threads.hpp>
+
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/optional.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace sdpa
 {
@@ -47,6 +57,9 @@ namespace sdpa
                       , fhg::com::host_t const& host
                       , fhg::com::port_t const& port
                       , fhg::com::Certificates const& certificates
+                      , std::size_t io_threads = 1
+                      , boost::optional<batching> event_batching = boost::none
+                      , fhg::metrics::labels const& metric_labels = {}
                       );
       ~NetworkStrategy();
 
@@ -66,14 +79,33 @@ namespace sdpa
                        );
 
       void perform ( fhg::com::p2p::address_t const& address
-                   , std::string const& serialized_event
+                   , fhg::com::buffer serialized_event
                    );
+      void perform_batched
+        (fhg::com::p2p::address_t const&, events::SDPAEvent const*);
+      void flush_batch (fhg::com::p2p::address_t const&, std::uint64_t);
 
       EventHandler _event_handler;
 
       bool m_shutting_down;
 
       fhg::com::peer_t _peer;
+
+      struct pending_batch
+      {
+        fhg::com::buffer events;
+        std::uint64_t generation;
+        std::unique_ptr<boost::asio::steady_timer> flush_timer;
+      };
+
+      boost::optional<batching> _batching;
+      //! \note Held while handing a batch to the peer, so that
+      //! batches to one destination are sent in order.
+      std::mutex _batches_guard;
+      std::unordered_map<fhg::com::p2p::address_t, pending_batch> _batches;
+      std::uint64_t _batch_generation;
+      std::unique_ptr<fhg::util::scoped_boost_asio_io_service_with_threads>
+        _batch_timers;
     };
   }
 }
@@ -24,8 +24,17 @@ namespace sdpa
       void NetworkStrategy::perform
         (fhg::com::p2p::address_t const& address, Args&&... args)
     {
-      return perform
-        (address, _codec.encode<Event> (std::forward<Args> (args)...));
+      Event const event (std::forward<Args> (args)...);
+
+      if (_batching)
+      {
+        return perform_batched (address, &event);
+      }
+
+      fhg::com::buffer serialized_event (_peer.buffers().get (0));
+      _codec.encode (&event, serialized_event);
+
+      return perform (address, std::move (serialized_event));
     }
   }
 }
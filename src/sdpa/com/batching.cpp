@@ -0,0 +1,83 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/com/batching.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace sdpa
+{
+  namespace com
+  {
+    namespace batch
+    {
+      namespace
+      {
+        constexpr char const marker {'\0'};
+      }
+
+      event_too_large::event_too_large (std::size_t size)
+        : std::length_error
+            ( "event of " + std::to_string (size)
+            + " bytes exceeds the size limit of a batched event"
+            )
+      {}
+
+      void start (fhg::com::buffer& batch)
+      {
+        batch.resize (0);
+        batch.append (&marker, sizeof (marker));
+      }
+
+      void for_each_event
+        ( char const* data
+        , std::size_t size
+        , std::function<void (char const*, std::size_t)> const& callback
+        )
+      {
+        if (size == 0 || *data != marker)
+        {
+          return callback (data, size);
+        }
+
+        char const* position (data + sizeof (marker));
+        char const* const end (data + size);
+
+        while (position != end)
+        {
+          std::uint32_t event_size;
+
+          if (std::size_t (end - position) < sizeof (event_size))
+          {
+            throw std::runtime_error ("truncated event batch: missing size");
+          }
+
+          std::memcpy (&event_size, position, sizeof (event_size));
+          position += sizeof (event_size);
+
+          if (std::size_t (end - position) < event_size)
+          {
+            throw std::runtime_error ("truncated event batch: missing event");
+          }
+
+          callback (position, event_size);
+          position += event_size;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,86 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <fhgcom/buffer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace sdpa
+{
+  namespace com
+  {
+    //! \note Events performed to the same destination within window
+    //! of the first one are sent as a single message. The message is
+    //! sent early once the serialized events exceed max_bytes.
+    struct batching
+    {
+      std::chrono::microseconds window;
+      std::size_t max_bytes;
+    };
+
+    namespace batch
+    {
+      //! \note A batch starts with a marker byte no serialized event
+      //! starts with, followed by the events, each prefixed by its
+      //! size. Messages without the marker are a single event, so
+      //! receivers accept both.
+      void start (fhg::com::buffer&);
+
+      //! \note encode (buffer&) shall append one serialized event.
+      //! Throws event_too_large and leaves the batch unchanged if
+      //! the event does not fit the size prefix.
+      struct event_too_large : std::length_error
+      {
+        event_too_large (std::size_t size);
+      };
+      template<typename Encode>
+        void append (fhg::com::buffer& batch, Encode&& encode)
+      {
+        std::size_t const size_offset (batch.size());
+        batch.resize (size_offset + sizeof (std::uint32_t));
+
+        encode (batch);
+
+        std::size_t const size
+          (batch.size() - size_offset - sizeof (std::uint32_t));
+        if (size > std::numeric_limits<std::uint32_t>::max())
+        {
+          batch.resize (size_offset);
+          throw event_too_large (size);
+        }
+
+        std::uint32_t const size32 (size);
+        std::memcpy (batch.data() + size_offset, &size32, sizeof (size32));
+      }
+
+      //! \note Calls the callback for every event in order, or once
+      //! with the whole message if it is not a batch.
+      void for_each_event
+        ( char const* data
+        , std::size_t size
+        , std::function<void (char const*, std::size_t)> const&
+        );
+    }
+  }
+}
@@ -27,6 +27,7 @@
 #include <sdpa/events/SubscribeAckEvent.hpp>
 #include <sdpa/events/delayed_function_call.hpp>
 #include <sdpa/events/put_token.hpp>
+#include <sdpa/events/set_scheduling_parameters.hpp>
 #include <sdpa/events/workflow_response.hpp>
 #include <sdpa/id_generator.hpp>
 
@@ -39,14 +40,23 @@
 #include <util-generic/join.hpp>
 #include <util-generic/print_exception.hpp>
 
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/serialization/optional.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
 #include <boost/tokenizer.hpp>
 
 #include <algorithm>
 #include <chrono>
 #include <functional>
+#include <list>
 #include <sstream>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace sdpa
 {
@@ -54,6 +64,11 @@ namespace sdpa
   {
     namespace
     {
+      //! \note fewer runtimes are too noisy to replace the static
+      //! computational cost
+      constexpr std::size_t const minimum_runtimes_for_computational_cost (5);
+      constexpr std::size_t const runtime_statistics_snapshot_interval (100);
+
       std::vector<std::string> require_proper_url (std::string url)
       {
         const boost::tokenizer<boost::char_separator<char>> tok
@@ -78,6 +93,60 @@ namespace sdpa
         const std::vector<std::string> vec (require_proper_url (url));
         return fhg::com::port_t (vec.size() == 2 ? vec[1] : "0");
       }
+
+      //! \note lets clients with many outstanding requests correlate
+      //! an error with the request that caused it
+      boost::optional<job_id_t> client_request_job_id
+        (events::SDPAEvent const* event)
+      {
+        if (auto const* submit = dynamic_cast<events::SubmitJobEvent const*> (event))
+        {
+          return submit->job_id();
+        }
+        if (auto const* cancel = dynamic_cast<events::CancelJobEvent const*> (event))
+        {
+          return cancel->job_id();
+        }
+        if (auto const* del = dynamic_cast<events::DeleteJobEvent const*> (event))
+        {
+          return del->job_id();
+        }
+        if (auto const* query = dynamic_cast<events::QueryJobStatusEvent const*> (event))
+        {
+          return query->job_id();
+        }
+        if (auto const* subscribe = dynamic_cast<events::SubscribeEvent const*> (event))
+        {
+          return subscribe->job_id();
+        }
+
+        return boost::none;
+      }
+
+      //! \note requests correlated by an id of their own rather than
+      //! by job id, where a job id would not identify the request
+      boost::optional<std::string> client_request_id
+        (events::SDPAEvent const* event)
+      {
+        if (auto const* put = dynamic_cast<events::put_token const*> (event))
+        {
+          return put->put_token_id();
+        }
+        if (auto const* response = dynamic_cast<events::workflow_response const*> (event))
+        {
+          return response->workflow_response_id();
+        }
+        if (auto const* discover = dynamic_cast<events::DiscoverJobStatesEvent const*> (event))
+        {
+          return discover->discover_id();
+        }
+        if (auto const* parameters = dynamic_cast<events::set_scheduling_parameters const*> (event))
+        {
+          return parameters->request_id();
+        }
+
+        return boost::none;
+      }
     }
 
     Agent::Agent
@@ -88,6 +157,13 @@ namespace sdpa
         , master_info_t masters
         , bool create_wfe
         , fhg::com::Certificates const& certificates
+        , boost::optional<boost::filesystem::path> runtime_statistics_snapshot
+        , bool schedule_by_runtime_statistics
+        , std::size_t network_threads
+        , boost::optional<com::batching> network_batching
+        , bool prefer_workers_caching_global_memory
+        , boost::optional<double> speculative_backup_runtime_multiple
+        , boost::optional<we::snapshot_settings> workflow_snapshots
         )
       : _name (name)
       , _master_info (std::move (masters))
@@ -102,7 +178,57 @@ namespace sdpa
                        return findJob (job_id)->requirements_and_preferences();
                      }
                    , _worker_manager
+                   , [this] (job_id_t const& job_id)
+                     {
+                       return top_level_job (job_id);
+                     }
+                   , [this] ( job_id_t const& job_id
+                            , Implementation const& implementation
+                            , WorkerSet const& workers
+                            )
+                     {
+                       return expected_runtime
+                         (job_id, implementation, workers);
+                     }
+                   , {{"agent", _name}}
                    )
+      , _runtime_statistics()
+      , _runtime_statistics_snapshot (std::move (runtime_statistics_snapshot))
+      , _runtimes_recorded (0)
+      , _schedule_by_runtime_statistics (schedule_by_runtime_statistics)
+      , _job_starts_guard()
+      , _job_starts()
+      , _prefer_workers_caching_global_memory
+          (prefer_workers_caching_global_memory)
+      , _global_memory_locality()
+      , _speculative_backups
+          ( speculative_backup_runtime_multiple
+          ? fhg::util::cxx14::make_unique<scheduler::speculative_backups>
+              (*speculative_backup_runtime_multiple)
+          : nullptr
+          )
+      , _speculative_backups_launched
+          ( fhg::metrics::process_registry().counter_for
+              ( "gspc_agent_speculative_backups_launched_total"
+              , "number of backup copies launched for straggling jobs"
+              , {{"agent", _name}}
+              )
+          )
+      , _speculative_backups_won
+          ( fhg::metrics::process_registry().counter_for
+              ( "gspc_agent_speculative_backups_won_total"
+              , "number of backup copies that finished before their original"
+              , {{"agent", _name}}
+              )
+          )
+      , _workflow_snapshots
+          ( workflow_snapshots && create_wfe
+          ? fhg::util::cxx14::make_unique<we::snapshot_directory>
+              (workflow_snapshots->directory)
+          : nullptr
+          )
+      , _resumed_children_guard()
+      , _resumed_children()
       , _cancel_mutex()
       , _scheduling_requested_guard()
       , _scheduling_requested_condition()
@@ -111,19 +237,46 @@ namespace sdpa
         (boost::make_optional (create_wfe, std::mt19937 (std::random_device()())))
       , mtx_subscriber_()
       , mtx_cpb_()
-      , _log_emitter()
+      //! \note gantt events are emitted from the event handler thread,
+      //! which should not wait for the monitors receiving them
+      , _log_emitter (fhg::logging::asynchronous_emission{})
       , _registration_timeout (std::chrono::seconds (1))
+      , _event_queue_size
+          ( fhg::metrics::process_registry().gauge_for
+              ( "gspc_agent_event_queue_size"
+              , "number of events waiting to be handled"
+              , {{"agent", _name}}
+              )
+          )
+      , _events_handled
+          ( fhg::metrics::process_registry().counter_for
+              ( "gspc_agent_events_handled_total"
+              , "number of events handled"
+              , {{"agent", _name}}
+              )
+          )
+      , _event_handling_duration
+          ( fhg::metrics::process_registry().histogram_for
+              ( "gspc_agent_event_handling_seconds"
+              , "time to handle an event"
+              , {{"agent", _name}}
+              )
+          )
       , _event_queue()
       , _network_strategy ( [this] ( fhg::com::p2p::address_t const& source
                                    , events::SDPAEvent::Ptr const& e
                                    )
                           {
+                            _event_queue_size.increment();
                             _event_queue.put (source, e);
                           }
                           , std::move (peer_io_service)
                           , host_from_url (url)
                           , port_from_url (url)
                           , certificates
+                          , network_threads
+                          , network_batching
+                          , {{"agent", _name}}
                           )
       , ptr_workflow_engine_
           ( create_wfe
@@ -139,6 +292,8 @@ namespace sdpa
               , std::bind (&Agent::workflow_response_response, this, std::placeholders::_1, std::placeholders::_2)
               , std::bind (&Agent::gen_id, this)
               , *_random_extraction_engine
+              , workflow_snapshots
+              , {{"agent", _name}}
               )
           : nullptr
           )
@@ -161,12 +316,226 @@ namespace sdpa
       , _event_handler_thread (&Agent::handle_events, this)
       , _interrupt_event_queue (_event_queue)
     {
+      if ( _runtime_statistics_snapshot
+         && boost::filesystem::exists (*_runtime_statistics_snapshot)
+         )
+      {
+        _runtime_statistics.load (*_runtime_statistics_snapshot);
+      }
+
+      if (_workflow_snapshots)
+      {
+        std::list<we::net_snapshot> snapshots (_workflow_snapshots->load());
+
+        //! \note Nets without annotation were submitted by the
+        //! workflow engine itself and are submitted again from the
+        //! snapshot of their parent. Their directories are removed
+        //! before that happens.
+        for ( auto snapshot (snapshots.begin())
+            ; snapshot != snapshots.end()
+            ;
+            )
+        {
+          if (snapshot->annotation)
+          {
+            ++snapshot;
+          }
+          else
+          {
+            _workflow_snapshots->remove (snapshot->id);
+            snapshot = snapshots.erase (snapshot);
+          }
+        }
+
+        for (we::net_snapshot& snapshot : snapshots)
+        {
+          resume_workflow (std::move (snapshot));
+        }
+      }
+
       for (master_network_info& master : _master_info)
       {
         requestRegistration (master);
       }
     }
 
+    Agent::~Agent()
+    {
+      if (_runtime_statistics_snapshot)
+      {
+        save_runtime_statistics();
+      }
+    }
+
+    void Agent::save_runtime_statistics()
+    {
+      try
+      {
+        _runtime_statistics.save (*_runtime_statistics_snapshot);
+      }
+      catch (...)
+      {
+        _log_emitter.emit ( "Failed to save runtime statistics to "
+                          + _runtime_statistics_snapshot->string() + ": "
+                          + fhg::util::current_exception_printer (": ").string()
+                          , fhg::logging::legacy::category_level_error
+                          );
+      }
+    }
+
+    namespace
+    {
+      //! \note stored as annotation of the snapshot of a top level
+      //! workflow, a master is identified by its host and port
+      struct snapshotted_job_source
+      {
+        boost::optional<std::pair<std::string, std::string>> master;
+        scheduling_parameters parameters;
+
+        template<typename Archive>
+          void serialize (Archive& ar, unsigned int)
+        {
+          ar & master;
+          ar & parameters;
+        }
+      };
+    }
+
+    void Agent::annotate_workflow_snapshot
+      ( job_id_t const& job_id
+      , job_source const& source
+      , scheduling_parameters const& parameters
+      )
+    {
+      snapshotted_job_source const snapshotted
+        { fhg::util::visit
+            <boost::optional<std::pair<std::string, std::string>>>
+            ( source
+            , [] (job_source_master const& master)
+              {
+                return std::make_pair
+                  (std::string (master._->host), std::string (master._->port));
+              }
+            , [] (job_source_client const&)
+              {
+                return boost::none;
+              }
+            , [] (job_source_wfe const&) -> boost::none_t
+              {
+                throw std::logic_error
+                  ("annotate_workflow_snapshot: not a top level job");
+              }
+            )
+        , parameters
+        };
+
+      try
+      {
+        std::ostringstream annotation;
+        {
+          boost::archive::text_oarchive archive (annotation);
+          archive << snapshotted;
+        }
+        _workflow_snapshots->write_annotation (job_id, annotation.str());
+      }
+      catch (...)
+      {
+        _log_emitter.emit ( "Failed to annotate the snapshot of " + job_id
+                          + ", it will not be resumed: "
+                          + fhg::util::current_exception_printer (": ").string()
+                          , fhg::logging::legacy::category_level_error
+                          );
+      }
+    }
+
+    void Agent::resume_workflow (we::net_snapshot snapshot)
+    {
+      snapshotted_job_source snapshotted;
+      {
+        std::istringstream annotation (*snapshot.annotation);
+        boost::archive::text_iarchive archive (annotation);
+        archive >> snapshotted;
+      }
+
+      job_source source {job_source_client{}};
+      if (snapshotted.master)
+      {
+        auto const master
+          ( std::find_if
+              ( _master_info.begin(), _master_info.end()
+              , [&] (master_network_info const& info)
+                {
+                  return std::make_pair
+                      (std::string (info.host), std::string (info.port))
+                    == *snapshotted.master;
+                }
+              )
+          );
+
+        if (master != _master_info.end())
+        {
+          source = job_source_master {master};
+        }
+        else
+        {
+          _log_emitter.emit ( "master " + snapshotted.master->first + ":"
+                            + snapshotted.master->second + " of workflow "
+                            + snapshot.id + " is gone, resuming it as"
+                              " submitted by a client"
+                            , fhg::logging::legacy::category_level_warn
+                            );
+        }
+      }
+
+      _scheduler.set_scheduling_parameters (snapshot.id, snapshotted.parameters);
+
+      {
+        std::lock_guard<std::mutex> const _ (_resumed_children_guard);
+        for (auto const& child : snapshot.outstanding_children)
+        {
+          _resumed_children.emplace (child.first);
+        }
+      }
+
+      Job* const job
+        ( addJobWithNoPreferences
+            ( snapshot.id
+            , we::type::activity_t (snapshot.net).unwrap()
+            , source
+            , job_handler_wfe()
+            )
+        );
+
+      _log_emitter.emit ( "resuming workflow " + snapshot.id + " with "
+                        + std::to_string (snapshot.outstanding_children.size())
+                        + " outstanding children"
+                        , fhg::logging::legacy::category_level_info
+                        );
+
+      workflowEngine()->resume (std::move (snapshot));
+      job->Dispatch();
+
+      emit_gantt (job->id(), job->activity(), NotificationEvent::STATE_STARTED);
+    }
+
+    bool Agent::is_stale_result_of_resumed_child
+      (fhg::com::p2p::address_t const& source, job_id_t const& job_id)
+    {
+      {
+        std::lock_guard<std::mutex> const _ (_resumed_children_guard);
+        if (!_resumed_children.count (job_id))
+        {
+          return false;
+        }
+      }
+
+      auto const worker (_worker_manager.worker_by_address (source));
+
+      return !findJob (job_id)
+        || !worker
+        || !_scheduler.is_reserved_on (job_id, worker.get()->second);
+    }
+
     Agent::cleanup_job_map_on_dtor_helper::cleanup_job_map_on_dtor_helper
         (job_map_t& m)
       : _ (m)
@@ -190,6 +559,49 @@ namespace sdpa
       return _network_strategy.local_endpoint();
     }
 
+    scheduler::runtime_statistics const& Agent::runtime_statistics() const
+    {
+      return _runtime_statistics;
+    }
+
+    void Agent::record_runtime
+      (job_id_t const& job_id, worker_id_t const& worker)
+    {
+      auto const finished (std::chrono::steady_clock::now());
+
+      std::pair<std::chrono::steady_clock::time_point, Implementation> start;
+      {
+        std::lock_guard<std::mutex> const _ (_job_starts_guard);
+
+        auto const job_start (_job_starts.find (job_id));
+        if (job_start == _job_starts.end())
+        {
+          return;
+        }
+
+        start = job_start->second;
+      }
+
+      Job const* const job (findJob (job_id));
+      if (!job)
+      {
+        return;
+      }
+
+      _runtime_statistics.record
+        ( {job->activity().name(), start.second, _worker_manager.worker_class (worker)}
+        , std::chrono::duration<double> (finished - start.first).count()
+        );
+
+      //! \note not only on shutdown, to survive a crash
+      if ( _runtime_statistics_snapshot
+         && ++_runtimes_recorded % runtime_statistics_snapshot_interval == 0
+         )
+      {
+        save_runtime_statistics();
+      }
+    }
+
     void Agent::serveJob
       ( WorkerSet const& workers
       , Implementation const& implementation
@@ -199,8 +611,22 @@ namespace sdpa
       Job const* const ptrJob = findJob (jobId);
       if (ptrJob)
       {
+        {
+          std::lock_guard<std::mutex> const _ (_job_starts_guard);
+          _job_starts[jobId]
+            = std::make_pair (std::chrono::steady_clock::now(), implementation);
+        }
+
         for (auto const& worker : workers)
         {
+          if (_prefer_workers_caching_global_memory)
+          {
+            _global_memory_locality.record
+              ( worker
+              , ptrJob->requirements_and_preferences().global_memory_gets()
+              );
+          }
+
           child_proxy
             ( this
             , _worker_manager.address_by_worker (worker).get()->second
@@ -226,12 +652,50 @@ namespace sdpa
                                , job_handler handler
                                )
     {
+      auto requirements_and_preferences
+        (activity.requirements_and_preferences (_virtual_memory_api.get()));
+
+      if (_schedule_by_runtime_statistics)
+      {
+        std::string const transition (activity.name());
+
+        //! \note Once enough runtimes were observed, the expected
+        //! runtime in seconds is the computational cost, so that wrong
+        //! static estimates are corrected between transitions, too.
+        //! Until then the static estimate is used.
+        requirements_and_preferences.estimate_computational_cost_by
+          ( [this, transition]
+              ( std::set<std::string> const& worker_class
+              , Implementation const& implementation
+              )
+            {
+              return _runtime_statistics.expected_runtime
+                ( {transition, implementation, worker_class}
+                , minimum_runtimes_for_computational_cost
+                );
+            }
+          );
+      }
+
+      if ( _prefer_workers_caching_global_memory
+         && !requirements_and_preferences.global_memory_gets().empty()
+         )
+      {
+        auto const gets (requirements_and_preferences.global_memory_gets());
+
+        requirements_and_preferences.discount_transfer_cost_by
+          ( [this, gets] (worker_id_t const& worker)
+            {
+              return _global_memory_locality.cached_fraction (worker, gets);
+            }
+          );
+      }
+
       return addJob ( job_id
                     , std::move (activity)
                     , std::move (source)
                     , std::move (handler)
-                    , activity.requirements_and_preferences
-                        (_virtual_memory_api.get())
+                    , std::move (requirements_and_preferences)
                     );
     }
 
@@ -300,6 +764,8 @@ namespace sdpa
 
     void Agent::deleteJob (const sdpa::job_id_t& job_id)
     {
+      _scheduler.forget_top_level_job (job_id);
+
       std::lock_guard<std::mutex> const _ (_job_map_mutex);
 
       const job_map_t::const_iterator it (job_map_.find( job_id ));
@@ -310,6 +776,71 @@ namespace sdpa
 
       delete it->second;
       job_map_.erase (it);
+
+      {
+        std::lock_guard<std::mutex> const resumed (_resumed_children_guard);
+        _resumed_children.erase (job_id);
+      }
+
+      if (_speculative_backups)
+      {
+        _speculative_backups->forget (job_id);
+      }
+
+      std::lock_guard<std::mutex> const lock_job_starts (_job_starts_guard);
+      _job_starts.erase (job_id);
+    }
+
+    job_id_t Agent::top_level_job (job_id_t const& job_id) const
+    {
+      job_id_t top_level (job_id);
+
+      if (hasWorkflowEngine())
+      {
+        //! \note children know their parent only while running, which
+        //! they are from submission until their result is handled
+        while (auto const parent = workflowEngine()->parent (top_level))
+        {
+          top_level = *parent;
+        }
+      }
+
+      return top_level;
+    }
+
+    double Agent::expected_runtime
+      ( job_id_t const& job_id
+      , Implementation const& implementation
+      , WorkerSet const& workers
+      ) const
+    {
+      Job const* const job (findJob (job_id));
+
+      if (!job)
+      {
+        return CoallocationScheduler::runtime_quantum;
+      }
+
+      boost::optional<double> slowest;
+
+      for (worker_id_t const& worker : workers)
+      {
+        auto const runtime
+          ( _runtime_statistics.expected_runtime
+              ( { job->activity().name()
+                , implementation
+                , _worker_manager.worker_class (worker)
+                }
+              )
+          );
+
+        if (runtime)
+        {
+          slowest = std::max (slowest.get_value_or (0.0), *runtime);
+        }
+      }
+
+      return slowest.get_value_or (CoallocationScheduler::runtime_quantum);
     }
 
     void Agent::handleDeleteJobEvent
@@ -462,6 +993,12 @@ namespace sdpa
 
       const job_id_t job_id (e.job_id() ? *e.job_id() : job_id_t (gen_id()));
 
+      if (e.scheduling_parameters())
+      {
+        _scheduler.set_scheduling_parameters
+          (job_id, *e.scheduling_parameters());
+      }
+
       auto const maybe_master (master_by_address (source));
       Job* const pJob ( addJobWithNoPreferences
                           ( job_id
@@ -481,6 +1018,15 @@ namespace sdpa
       // if it comes from outside and the agent has an WFE, submit it to it
       if (boost::get<job_handler_wfe> (&pJob->handler()))
       {
+        if (_workflow_snapshots)
+        {
+          annotate_workflow_snapshot
+            ( job_id
+            , pJob->source()
+            , e.scheduling_parameters().get_value_or (scheduling_parameters())
+            );
+        }
+
         if (workflow_engine_submit (job_id, pJob))
         {
           emit_gantt (job_id, pJob->activity(), NotificationEvent::STATE_STARTED);
@@ -521,6 +1067,10 @@ namespace sdpa
         , event->hostname(), source
         );
 
+      //! \note a newly started worker has an empty cache
+      _global_memory_locality.reset
+        (event->name(), event->global_memory_cache_size());
+
       request_scheduling();
 
       // send to the masters my new set of capabilities
@@ -592,6 +1142,13 @@ namespace sdpa
             }
 
             std::lock_guard<std::mutex> const _ (_cancel_mutex);
+
+            std::list<job_id_t> const superseded_copies
+              ( _speculative_backups
+              ? _speculative_backups->superseded_jobs()
+              : std::list<job_id_t>()
+              );
+
             _scheduler.reschedule_worker_jobs_and_maybe_remove_worker
               ( as_worker.get()->second
               , [this] (job_id_t const& job)
@@ -607,6 +1164,16 @@ namespace sdpa
               , (error.error_code() == events::ErrorEvent::SDPA_EBACKLOGFULL)
               );
 
+            //! \note superseded copies that lost their worker are not
+            //! run again
+            for (job_id_t const& copy : superseded_copies)
+            {
+              if (findJob (copy))
+              {
+                drop_speculative_copy (copy);
+              }
+            }
+
             request_scheduling();
           }
           else
@@ -688,6 +1255,14 @@ namespace sdpa
 
       pJob->CancelJob();
 
+      if (_speculative_backups)
+      {
+        if (auto const backup = _speculative_backups->running_backup_of (job_id))
+        {
+          drop_speculative_copy (*backup);
+        }
+      }
+
       const std::unordered_set<worker_id_t>
         workers_to_cancel (_worker_manager.workers_to_send_cancel (job_id));
 
@@ -776,6 +1351,17 @@ namespace sdpa
         return;
       }
 
+      //! \note the other copy has won already
+      if (_speculative_backups && _speculative_backups->superseded (job->id()))
+      {
+        _scheduler.releaseReservation (job->id());
+        request_scheduling();
+
+        deleteJob (job->id());
+
+        return;
+      }
+
       //! \note rescheduled: never tell workflow engine or modify state!
       if ( _scheduler.reservation_canceled (job->id())
         && (job->getStatus() != sdpa::status::CANCELING)
@@ -788,6 +1374,43 @@ namespace sdpa
         return;
       }
 
+      boost::optional<job_id_t> const original
+        ( _speculative_backups
+        ? _speculative_backups->original_of (job->id())
+        : boost::none
+        );
+
+      //! \note a failed backup leaves the original running alone, a
+      //! finished one delivers its result as the original's
+      if (original)
+      {
+        if ( std::none_of ( results->individual_results.begin()
+                          , results->individual_results.end()
+                          , [] (std::pair<worker_id_t const, terminal_state> const& result)
+                            {
+                              return boost::get<JobFSM_::s_failed> (&result.second);
+                            }
+                          )
+           )
+        {
+          job_finished
+            ( require_job (*original, "backup of unknown job " + *original)
+            , results->last_success.result
+            );
+          _speculative_backups_won.increment();
+
+          std::lock_guard<std::mutex> const _ (_cancel_mutex);
+          drop_speculative_copy (*original);
+        }
+
+        _scheduler.releaseReservation (job->id());
+        request_scheduling();
+
+        deleteJob (job->id());
+
+        return;
+      }
+
       //! \todo instead of ignoring sub-failures and merging error
       //! messages, just pass on results to the user
       if (job->getStatus() == sdpa::status::CANCELING)
@@ -817,6 +1440,15 @@ namespace sdpa
         }
       }
 
+      if (_speculative_backups)
+      {
+        if (auto const backup = _speculative_backups->running_backup_of (job->id()))
+        {
+          std::lock_guard<std::mutex> const _ (_cancel_mutex);
+          drop_speculative_copy (*backup);
+        }
+      }
+
       _scheduler.releaseReservation (job->id());
       request_scheduling();
 
@@ -831,14 +1463,22 @@ namespace sdpa
       , events::JobFinishedEvent const* event
       )
     {
+      if (is_stale_result_of_resumed_child (source, event->job_id()))
+      {
+        child_proxy (this, source).job_finished_ack (event->job_id());
+        return;
+      }
+
       Job* const job
         (require_job (event->job_id(), "job_finished for unknown job"));
 
+      worker_id_t const worker
+        (_worker_manager.worker_by_address (source).get()->second);
+
+      record_runtime (job->id(), worker);
+
       _scheduler.store_result
-        ( _worker_manager.worker_by_address (source).get()->second
-        , job->id()
-        , JobFSM_::s_finished (event->result())
-        );
+        (worker, job->id(), JobFSM_::s_finished (event->result()));
 
       handle_job_termination (job);
 
@@ -850,6 +1490,12 @@ namespace sdpa
       , events::JobFailedEvent const* event
       )
     {
+      if (is_stale_result_of_resumed_child (source, event->job_id()))
+      {
+        child_proxy (this, source).job_failed_ack (event->job_id());
+        return;
+      }
+
       Job* const job
         (require_job (event->job_id(), "job_failed for unknown job"));
 
@@ -1065,8 +1711,13 @@ namespace sdpa
       {
         const std::pair<fhg::com::p2p::address_t, events::SDPAEvent::Ptr> event
           (_event_queue.get());
+        _event_queue_size.decrement();
+
         try
         {
+          fhg::metrics::scoped_timer const handling_timer
+            (_event_handling_duration);
+
           event.second->handleBy (event.first, this);
         }
         catch (...)
@@ -1075,8 +1726,12 @@ namespace sdpa
             ( event.first
             , events::ErrorEvent::SDPA_EUNKNOWN
             , fhg::util::current_exception_printer (": ").string()
+            , client_request_job_id (event.second.get())
+            , client_request_id (event.second.get())
             );
         }
+
+        _events_handled.increment();
       }
     }
     catch (decltype (_event_queue)::interrupted const&)
@@ -1085,6 +1740,7 @@ namespace sdpa
 
     void Agent::delay (std::function<void()> fun)
     {
+      _event_queue_size.increment();
       _event_queue.put
         ( fhg::com::p2p::address_t()
         , events::SDPAEvent::Ptr (new events::delayed_function_call (fun))
@@ -1226,6 +1882,9 @@ namespace sdpa
       if(ptrJob->getStatus() == sdpa:: status::CANCELING)
         return;
 
+      if (_speculative_backups && _speculative_backups->superseded (ptrJob->id()))
+        return;
+
       WorkerManager::worker_connections_t::right_map::iterator const worker
         ( fhg::util::boost::get_or_throw<std::runtime_error>
             ( _worker_manager.worker_by_address (source)
@@ -1479,7 +2138,7 @@ namespace sdpa
                 .put_token ( job_id
                            , event->put_token_id()
                            , event->place_name()
-                           , event->value()
+                           , event->values()
                            );
             }
           }
@@ -1487,11 +2146,11 @@ namespace sdpa
           {
             _put_token_source.emplace (event->put_token_id(), source);
 
-            workflowEngine()->put_token ( job_id
-                                        , event->put_token_id()
-                                        , event->place_name()
-                                        , event->value()
-                                        );
+            workflowEngine()->put_tokens ( job_id
+                                         , event->put_token_id()
+                                         , event->place_name()
+                                         , event->values()
+                                         );
           }
         );
     }
@@ -1501,6 +2160,49 @@ namespace sdpa
         (event->put_token_id(), std::current_exception());
     }
 
+    void Agent::handle_set_scheduling_parameters
+      ( fhg::com::p2p::address_t const& source
+      , const events::set_scheduling_parameters* event
+      )
+    try
+    {
+      Job const* const job (findJob (event->job_id()));
+
+      if (!job || sdpa::status::is_terminal (job->getStatus()))
+      {
+        throw std::runtime_error
+          ( "unable to set scheduling parameters: " + event->job_id()
+          + " unknown or terminated"
+          );
+      }
+
+      if (boost::get<job_source_wfe> (&job->source()))
+      {
+        throw std::invalid_argument
+          ( "unable to set scheduling parameters: " + event->job_id()
+          + " is not a top level job"
+          );
+      }
+
+      _scheduler.set_scheduling_parameters
+        (event->job_id(), event->parameters());
+      request_scheduling();
+
+      if (_workflow_snapshots && boost::get<job_handler_wfe> (&job->handler()))
+      {
+        annotate_workflow_snapshot
+          (event->job_id(), job->source(), event->parameters());
+      }
+
+      parent_proxy (this, source).set_scheduling_parameters_response
+        (event->request_id(), boost::none);
+    }
+    catch (...)
+    {
+      parent_proxy (this, source).set_scheduling_parameters_response
+        (event->request_id(), std::current_exception());
+    }
+
     void Agent::handle_put_token_response
       ( fhg::com::p2p::address_t const&
       , events::put_token_response const* event
@@ -1614,14 +2316,25 @@ namespace sdpa
       {
         {
           std::unique_lock<std::mutex> lock (_scheduling_requested_guard);
-          _scheduling_requested_condition.wait
-            ( lock
-            , [this]
+          auto const requested
+            ( [this]
               {
                 return _scheduling_requested || _scheduling_interrupted;
               }
             );
 
+          //! \note stragglers become stragglers by time passing
+          //! only, not by any event
+          if (_speculative_backups)
+          {
+            _scheduling_requested_condition.wait_for
+              (lock, std::chrono::seconds (1), requested);
+          }
+          else
+          {
+            _scheduling_requested_condition.wait (lock, requested);
+          }
+
           if (_scheduling_interrupted)
           {
             break;
@@ -1642,6 +2355,138 @@ namespace sdpa
                      , std::placeholders::_3
                      )
           );
+
+        if (_speculative_backups)
+        {
+          launch_speculative_backups();
+        }
+      }
+    }
+
+    void Agent::launch_speculative_backups()
+    {
+      unsigned long idle_workers (_worker_manager.num_free_workers());
+
+      if (!idle_workers)
+      {
+        return;
+      }
+
+      using job_start = std::pair
+        < job_id_t
+        , std::pair<std::chrono::steady_clock::time_point, Implementation>
+        >;
+      std::vector<job_start> starts;
+      {
+        std::lock_guard<std::mutex> const _ (_job_starts_guard);
+        starts.assign (_job_starts.begin(), _job_starts.end());
+      }
+
+      auto const now (std::chrono::steady_clock::now());
+      bool launched (false);
+
+      for (auto const& start : starts)
+      {
+        if (!idle_workers)
+        {
+          break;
+        }
+
+        job_id_t const& original (start.first);
+
+        if ( _speculative_backups->speculated (original)
+          || _speculative_backups->original_of (original)
+          || _speculative_backups->superseded (original)
+           )
+        {
+          continue;
+        }
+
+        //! \note copies of jobs of other sources can not be told
+        //! apart by their master, coallocated jobs are not duplicated
+        Job const* const job (findJob (original));
+        if ( !job
+          || job->getStatus() != sdpa::status::RUNNING
+          || !boost::get<job_source_wfe> (&job->source())
+          || !boost::get<job_handler_worker> (&job->handler())
+          || !job->activity().side_effect_free()
+          || job->requirements_and_preferences().numWorkers() != 1
+           )
+        {
+          continue;
+        }
+
+        auto const workers (_worker_manager.findSubmOrAckWorkers (original));
+        if (workers.empty())
+        {
+          continue;
+        }
+
+        auto const observed
+          ( _runtime_statistics.query
+              ({job->activity().name(), start.second.second, {}})
+          );
+        if ( !observed
+          || !_speculative_backups->is_straggler
+               ( *observed
+               , std::chrono::duration<double>
+                   (now - start.second.first).count()
+               )
+           )
+        {
+          continue;
+        }
+
+        auto requirements_and_preferences (job->requirements_and_preferences());
+        requirements_and_preferences.exclude_workers (workers);
+
+        job_id_t const backup (gen_id());
+        addJob ( backup
+               , job->activity()
+               , job_source_wfe()
+               , job_handler_worker()
+               , std::move (requirements_and_preferences)
+               );
+        _speculative_backups->launched (original, backup);
+        _scheduler.enqueueJob (backup);
+        _speculative_backups_launched.increment();
+
+        --idle_workers;
+        launched = true;
+      }
+
+      if (launched)
+      {
+        request_scheduling();
+      }
+    }
+
+    void Agent::drop_speculative_copy (job_id_t const& job_id)
+    {
+      bool const cancel_already_requested
+        (_speculative_backups->superseded (job_id));
+
+      _speculative_backups->supersede (job_id);
+
+      std::unordered_set<worker_id_t> const workers_to_cancel
+        (_worker_manager.workers_to_send_cancel (job_id));
+
+      if (workers_to_cancel.empty())
+      {
+        _scheduler.delete_job (job_id);
+        _scheduler.releaseReservation (job_id);
+        _scheduler.delete_pending_job (job_id);
+
+        deleteJob (job_id);
+      }
+      else if (!cancel_already_requested)
+      {
+        for (worker_id_t const& worker : workers_to_cancel)
+        {
+          child_proxy ( this
+                      , _worker_manager.address_by_worker (worker).get()->second
+                      ).cancel_job (job_id);
+        }
       }
     }
 
@@ -1702,11 +2547,11 @@ namespace sdpa
       ( job_id_t job_id
       , std::string put_token_id
       , std::string place_name
-      , pnet::type::value::value_type value
+      , std::list<pnet::type::value::value_type> values
       ) const
     {
       _that->sendEventToOther<events::put_token>
-        (_address, job_id, put_token_id, place_name, value);
+        (_address, job_id, put_token_id, place_name, values);
     }
 
     void Agent::child_proxy::workflow_response
@@ -1744,7 +2589,7 @@ namespace sdpa
     {
       _that->sendEventToOther<events::WorkerRegistrationEvent>
         ( _address
-        , _that->name(), capabilities, 0, true, fhg::util::hostname()
+        , _that->name(), capabilities, 0, true, fhg::util::hostname(), 0
         );
     }
 
@@ -1816,6 +2661,13 @@ namespace sdpa
         (_address, put_token_id, error);
     }
 
+    void Agent::parent_proxy::set_scheduling_parameters_response
+      (std::string request_id, boost::optional<std::exception_ptr> error) const
+    {
+      _that->sendEventToOther<events::set_scheduling_parameters_response>
+        (_address, request_id, error);
+    }
+
     void Agent::parent_proxy::workflow_response_response
       ( std::string workflow_response_id
       , boost::variant<std::exception_ptr, pnet::type::value::value_type> content
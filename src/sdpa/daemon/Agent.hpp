@@ -20,6 +20,9 @@
 #include <sdpa/com/NetworkStrategy.hpp>
 #include <sdpa/daemon/NotificationEvent.hpp>
 #include <sdpa/daemon/scheduler/CoallocationScheduler.hpp>
+#include <sdpa/daemon/scheduler/global_memory_locality.hpp>
+#include <sdpa/daemon/scheduler/runtime_statistics.hpp>
+#include <sdpa/daemon/scheduler/speculative_backups.hpp>
 #include <sdpa/events/CancelJobAckEvent.hpp>
 #include <sdpa/events/DeleteJobAckEvent.hpp>
 #include <sdpa/events/DeleteJobEvent.hpp>
@@ -43,7 +46,10 @@
 
 #include <logging/stream_emitter.hpp>
 
+#include <metrics/registry.hpp>
+
 #include <we/layer.hpp>
+#include <we/snapshot.hpp>
 #include <we/type/activity.hpp>
 #include <we/type/net.hpp>
 #include <we/type/schedule_data.hpp>
@@ -56,18 +62,25 @@
 
 #include <boost/bimap.hpp>
 #include <boost/bimap/unordered_multiset_of.hpp>
+#include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread/scoped_thread.hpp>
 #include <boost/utility.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <forward_list>
 #include <memory>
+#include <list>
 #include <mutex>
 #include <queue>
 #include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace sdpa {
   namespace daemon {
@@ -82,14 +95,28 @@ namespace sdpa {
                    , master_info_t masters
                    , bool create_wfe
                    , fhg::com::Certificates const& certificates
+                   , boost::optional<boost::filesystem::path>
+                       runtime_statistics_snapshot = boost::none
+                   , bool schedule_by_runtime_statistics = false
+                   , std::size_t network_threads = 1
+                   , boost::optional<com::batching> network_batching
+                       = boost::none
+                   , bool prefer_workers_caching_global_memory = false
+                   , boost::optional<double>
+                       speculative_backup_runtime_multiple = boost::none
+                   , boost::optional<we::snapshot_settings>
+                       workflow_snapshots = boost::none
                    );
-      virtual ~Agent() = default;
+      virtual ~Agent();
 
       const std::string& name() const;
       boost::asio::ip::tcp::endpoint peer_local_endpoint() const;
       fhg::logging::endpoint logger_registration_endpoint() const;
       fhg::logging::stream_emitter& log_emitter();
 
+      //! runtimes of the jobs finished by the workers of this agent
+      scheduler::runtime_statistics const& runtime_statistics() const;
+
     public:
       // WE interface
       void submit( const we::layer::id_type & id, we::type::activity_t);
@@ -206,6 +233,10 @@ namespace sdpa {
         ( fhg::com::p2p::address_t const&
         , const events::put_token_response*
         ) override;
+      virtual void handle_set_scheduling_parameters
+        ( fhg::com::p2p::address_t const&
+        , const events::set_scheduling_parameters*
+        ) override;
       virtual void handle_workflow_response
         ( fhg::com::p2p::address_t const&
         , const events::workflow_response*
@@ -281,6 +312,16 @@ namespace sdpa {
       Job* require_job (job_id_t const&, std::string const& error) const;
       void deleteJob(const sdpa::job_id_t& job_id);
 
+      //! \note the job submitted by a client or master that the
+      //! given job was created for, the job itself if it was
+      job_id_t top_level_job (job_id_t const&) const;
+
+      //! \note in seconds, by the runtime statistics of the slowest
+      //! of the workers, CoallocationScheduler::runtime_quantum if
+      //! none were recorded yet
+      double expected_runtime
+        (job_id_t const&, Implementation const&, WorkerSet const&) const;
+
       void cancel_worker_handled_job (we::layer::id_type const&);
       void delayed_discover (we::layer::id_type discover_id, we::layer::id_type);
 
@@ -322,6 +363,55 @@ namespace sdpa {
       WorkerManager _worker_manager;
       CoallocationScheduler _scheduler;
 
+      scheduler::runtime_statistics _runtime_statistics;
+      //! \note loaded on construction, saved every
+      //! runtime_statistics_snapshot_interval recorded runtimes and on
+      //! destruction
+      boost::optional<boost::filesystem::path> _runtime_statistics_snapshot;
+      std::atomic<std::size_t> _runtimes_recorded;
+      void save_runtime_statistics();
+      bool _schedule_by_runtime_statistics;
+      std::mutex _job_starts_guard;
+      std::unordered_map
+        < job_id_t
+        , std::pair<std::chrono::steady_clock::time_point, Implementation>
+        > _job_starts;
+      //! \note for finished jobs only, see runtime_statistics
+      void record_runtime (job_id_t const&, worker_id_t const&);
+
+      //! \note workers are expected to hold the global memory ranges
+      //! read by the jobs they were most recently sent
+      bool _prefer_workers_caching_global_memory;
+      scheduler::global_memory_locality _global_memory_locality;
+
+      //! \note opt-in: side effect free jobs running much longer than
+      //! their transition did before get a backup copy on another
+      //! worker, the copy finishing first wins
+      std::unique_ptr<scheduler::speculative_backups> _speculative_backups;
+      fhg::metrics::counter& _speculative_backups_launched;
+      fhg::metrics::counter& _speculative_backups_won;
+      void launch_speculative_backups();
+      //! \note cancels the copy or, if it is on no worker (anymore),
+      //! deletes it, requires _cancel_mutex to be held
+      void drop_speculative_copy (job_id_t const&);
+
+      //! \note opt-in: the workflows of a previous run are resumed
+      //! from their snapshots, the outstanding children are submitted
+      //! again with their previous ids
+      std::unique_ptr<we::snapshot_directory> _workflow_snapshots;
+      void resume_workflow (we::net_snapshot);
+      //! \note the source and scheduling parameters of a top level
+      //! job, to recreate it as it was submitted when resuming
+      void annotate_workflow_snapshot
+        (job_id_t const&, job_source const&, scheduling_parameters const&);
+      //! \note results of the previous run may still arrive for the
+      //! resumed children and are dropped unless from the worker the
+      //! child is reserved on now, until the child is deleted
+      bool is_stale_result_of_resumed_child
+        (fhg::com::p2p::address_t const&, job_id_t const&);
+      std::mutex _resumed_children_guard;
+      std::unordered_set<job_id_t> _resumed_children;
+
       std::mutex _cancel_mutex;
       std::mutex _scheduling_requested_guard;
       std::condition_variable _scheduling_requested_condition;
@@ -344,6 +434,10 @@ namespace sdpa {
 
       void do_registration_after_sleep (master_network_info&);
 
+      fhg::metrics::gauge& _event_queue_size;
+      fhg::metrics::counter& _events_handled;
+      fhg::metrics::histogram& _event_handling_duration;
+
       fhg::util::interruptible_threadsafe_queue
         < std::pair< fhg::com::p2p::address_t
                    , boost::shared_ptr<events::SDPAEvent>
@@ -394,7 +488,7 @@ namespace sdpa {
         void put_token ( job_id_t
                        , std::string put_token_id
                        , std::string place_name
-                       , pnet::type::value::value_type
+                       , std::list<pnet::type::value::value_type>
                        ) const;
 
         void workflow_response ( job_id_t
@@ -438,6 +532,10 @@ namespace sdpa {
         void put_token_response ( std::string put_token_id
                                 , boost::optional<std::exception_ptr>
                                 ) const;
+        void set_scheduling_parameters_response
+          ( std::string request_id
+          , boost::optional<std::exception_ptr>
+          ) const;
         void workflow_response_response
           ( std::string workflow_response_id
           , boost::variant<std::exception_ptr, pnet::type::value::value_type>
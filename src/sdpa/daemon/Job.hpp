@@ -88,6 +88,7 @@ namespace sdpa
          _row< s_running   , e_reschedule     , s_pending   >,
         //   +-------------+------------------+-------------+
         _irow< s_finished  , e_finished     /*, ignore */   >,
+        _irow< s_finished  , e_reschedule   /*, ignore */   >,
         //   +-------------+------------------+-------------+
         _irow< s_failed    , e_failed       /*, ignore */   >,
         //   +-------------+------------------+-------------+
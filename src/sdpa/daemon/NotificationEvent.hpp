@@ -19,16 +19,23 @@
 #include <we/type/net.hpp> // recursive wrapper of transition_t fails otherwise.
 #include <we/type/activity.hpp>
 
-#include <boost/archive/text_oarchive.hpp>
-#include <boost/archive/text_iarchive.hpp>
-
-#include <sstream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <stdexcept>
 #include <string>
 
 namespace sdpa
 {
   namespace daemon
   {
+    //! \note Encoded as a fixed layout binary blob
+    //!   magic[3] version:u8 state:u8 activity_name_id:u64
+    //!   activity_id:str activity_name:str components:u32 (str)*
+    //! with all integers little endian and str being u32 length
+    //! followed by the bytes. Consumers shall check the version and
+    //! refuse anything else.
     class NotificationEvent
     {
     public:
@@ -41,6 +48,10 @@ namespace sdpa
       , STATE_MAX = STATE_CANCELED
       };
 
+      using activity_name_id_t = std::uint64_t;
+
+      static constexpr std::uint8_t encoding_version = 1;
+
       NotificationEvent ( const std::list<std::string>& components
                         , const std::string& activity_id
                         , const state_t& activity_state
@@ -49,39 +60,194 @@ namespace sdpa
         : _components (components)
         , _activity_id (activity_id)
         , _activity_name (activity.name())
+        , _activity_name_id (intern (_activity_name))
         , _activity_state (activity_state)
       {}
 
       NotificationEvent (const std::string encoded)
       {
-        std::istringstream stream (encoded);
-        boost::archive::text_iarchive archive (stream);
-        archive & _components;
-        archive & _activity_id;
-        archive & _activity_name;
-        archive & _activity_state;
+        decoder decode (encoded);
+
+        decode.header();
+        _activity_state = decode.state();
+        _activity_name_id = decode.integral<activity_name_id_t>();
+        _activity_id = decode.string();
+        _activity_name = decode.string();
+        for (auto n (decode.integral<std::uint32_t>()); n > 0; --n)
+        {
+          _components.emplace_back (decode.string());
+        }
+        decode.end();
       }
       std::string encoded() const
       {
-        std::ostringstream stream;
-        boost::archive::text_oarchive archive (stream);
-        archive & _components;
-        archive & _activity_id;
-        archive & _activity_name;
-        archive & _activity_state;
-        return stream.str();
+        std::size_t size (magic_size + 1 + 1 + 8 + 4);
+        size += 4 + _activity_id.size();
+        size += 4 + _activity_name.size();
+        for (auto const& component : _components)
+        {
+          size += 4 + component.size();
+        }
+
+        std::string encoded;
+        encoded.reserve (size);
+
+        encoded.append (magic(), magic_size);
+        encoded.push_back (static_cast<char> (encoding_version));
+        encoded.push_back (static_cast<char> (_activity_state));
+        append_integral (encoded, _activity_name_id);
+        append_string (encoded, _activity_id);
+        append_string (encoded, _activity_name);
+        append_integral
+          (encoded, static_cast<std::uint32_t> (_components.size()));
+        for (auto const& component : _components)
+        {
+          append_string (encoded, component);
+        }
+
+        return encoded;
+      }
+
+      //! Peek at the activity name id without decoding the event,
+      //! e.g. to look up an already known activity name.
+      static activity_name_id_t activity_name_id (std::string const& encoded)
+      {
+        decoder decode (encoded);
+        decode.header();
+        decode.state();
+        return decode.integral<activity_name_id_t>();
+      }
+
+      //! \note Stable across processes (FNV-1a), so that consumers
+      //! can cache names by id independent of the emitting process.
+      static activity_name_id_t intern (std::string const& name)
+      {
+        activity_name_id_t hash (0xcbf29ce484222325ull);
+        for (unsigned char c : name)
+        {
+          hash ^= c;
+          hash *= 0x100000001b3ull;
+        }
+        return hash;
       }
 
       const std::list<std::string>& components() const { return _components; }
       const std::string &activity_id() const { return _activity_id; }
       const std::string &activity_name() const { return _activity_name; }
+      activity_name_id_t activity_name_id() const { return _activity_name_id; }
       const state_t &activity_state() const { return _activity_state; }
 
     private:
+      static char const* magic() { return "GNE"; }
+      static constexpr std::size_t magic_size = 3;
+
       std::list<std::string> _components;
       std::string _activity_id;
       std::string _activity_name;
+      activity_name_id_t _activity_name_id;
       state_t _activity_state;
+
+      template<typename Integral>
+        static void append_integral (std::string& encoded, Integral value)
+      {
+        for (std::size_t byte (0); byte < sizeof (Integral); ++byte)
+        {
+          encoded.push_back (static_cast<char> ((value >> (8 * byte)) & 0xff));
+        }
+      }
+      static void append_string (std::string& encoded, std::string const& s)
+      {
+        append_integral (encoded, static_cast<std::uint32_t> (s.size()));
+        encoded.append (s);
+      }
+
+      class decoder
+      {
+      public:
+        decoder (std::string const& encoded)
+          : _pos (encoded.data())
+          , _end (encoded.data() + encoded.size())
+        {}
+
+        void header()
+        {
+          require (magic_size + 1);
+
+          if (!std::equal (magic(), magic() + magic_size, _pos))
+          {
+            throw std::runtime_error
+              ("NotificationEvent: not a binary notification event");
+          }
+          _pos += magic_size;
+
+          auto const version (static_cast<std::uint8_t> (*_pos++));
+          if (version != encoding_version)
+          {
+            throw std::runtime_error
+              ( "NotificationEvent: unsupported encoding version "
+              + std::to_string (version) + ", expected "
+              + std::to_string (encoding_version)
+              );
+          }
+        }
+
+        state_t state()
+        {
+          require (1);
+          auto const state (static_cast<std::uint8_t> (*_pos++));
+          if (state > STATE_MAX)
+          {
+            throw std::runtime_error
+              ( "NotificationEvent: invalid state "
+              + std::to_string (state)
+              );
+          }
+          return static_cast<state_t> (state);
+        }
+
+        template<typename Integral>
+          Integral integral()
+        {
+          require (sizeof (Integral));
+          Integral value (0);
+          for (std::size_t byte (0); byte < sizeof (Integral); ++byte)
+          {
+            value |= static_cast<Integral>
+              (static_cast<unsigned char> (*_pos++)) << (8 * byte);
+          }
+          return value;
+        }
+
+        std::string string()
+        {
+          auto const size (integral<std::uint32_t>());
+          require (size);
+          std::string s (_pos, _pos + size);
+          _pos += size;
+          return s;
+        }
+
+        void end() const
+        {
+          if (_pos != _end)
+          {
+            throw std::runtime_error
+              ("NotificationEvent: trailing bytes after event");
+          }
+        }
+
+      private:
+        char const* _pos;
+        char const* const _end;
+
+        void require (std::size_t bytes) const
+        {
+          if (static_cast<std::size_t> (_end - _pos) < bytes)
+          {
+            throw std::runtime_error ("NotificationEvent: truncated event");
+          }
+        }
+      };
     };
 
     constexpr char const* const gantt_log_category = "gantt-job-events";
@@ -37,6 +37,7 @@ namespace sdpa
       , _children_allowed (children_allowed)
       , _hostname (hostname)
       , _last_time_idle (fhg::util::now())
+      , _expected_time_idle (_last_time_idle)
       , reserved_ (false)
       , backlog_full_ (false)
     {
@@ -63,16 +64,24 @@ namespace sdpa
 
     void Worker::assign (const job_id_t& jobId, double cost)
     {
-      pending_.insert (jobId);
+      if (pending_.emplace (jobId, cost).second)
+      {
+        _pending_by_cost.emplace (cost, jobId);
+      }
       _cost_assigned_jobs += cost;
     }
 
-    void Worker::submit (const job_id_t& jobId)
+    void Worker::submit (const job_id_t& jobId, double expected_runtime)
     {
-      if (!pending_.erase (jobId))
+      auto const pending (pending_.find (jobId));
+      if (pending == pending_.end())
       {
         throw std::runtime_error ("subnmit: no pending job with the id " + jobId + " was found!");
       }
+      _expected_time_idle
+        = std::max (_expected_time_idle, fhg::util::now()) + expected_runtime;
+      _pending_by_cost.erase ({pending->second, jobId});
+      pending_.erase (pending);
       submitted_.insert (jobId);
       if (!_children_allowed)
       {
@@ -98,18 +107,25 @@ namespace sdpa
       {
         reserved_ = false;
       }
+      if (!has_running_jobs())
+      {
+        _expected_time_idle = _last_time_idle;
+      }
 
       _cost_assigned_jobs -= cost;
     }
 
     void Worker::delete_pending_job (const job_id_t job_id, double cost)
     {
-      if (0 == pending_.erase (job_id))
+      auto const pending (pending_.find (job_id));
+      if (pending == pending_.end())
       {
         throw std::runtime_error ( "Could not remove the pending job "
                                  + job_id
                                  );
       }
+      _pending_by_cost.erase ({pending->second, job_id});
+      pending_.erase (pending);
 
       _cost_assigned_jobs -= cost;
     }
@@ -181,5 +197,15 @@ namespace sdpa
             || (pending_.size() > 1)
              );
     }
+
+    job_id_t const& Worker::most_expensive_pending_job() const
+    {
+      if (_pending_by_cost.empty())
+      {
+        throw std::logic_error ("most_expensive_pending_job: no pending jobs");
+      }
+
+      return _pending_by_cost.begin()->second;
+    }
   }
 }
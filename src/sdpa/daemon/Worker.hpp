@@ -17,7 +17,11 @@
 #pragma once
 
 #include <list>
+#include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <sdpa/capability.hpp>
 #include <sdpa/daemon/Job.hpp>
 #include <sdpa/events/SDPAEvent.hpp>
@@ -31,6 +35,20 @@ namespace sdpa
 {
   namespace daemon
   {
+    //! Orders (cost, id) pairs by descending cost, equal costs by
+    //! ascending id.
+    template<typename Id>
+      struct most_expensive_first
+    {
+      bool operator() ( std::pair<double, Id> const& lhs
+                      , std::pair<double, Id> const& rhs
+                      ) const
+      {
+        return std::tie (rhs.first, lhs.second)
+          < std::tie (lhs.first, rhs.second);
+      }
+    };
+
     class Worker {
     private:
       friend class WorkerManager;
@@ -42,7 +60,8 @@ namespace sdpa
                       );
 
       void assign (const job_id_t&, double);
-      void submit(const job_id_t&);
+      //! \note expected_runtime: in seconds
+      void submit (const job_id_t&, double expected_runtime);
 
       void acknowledge(const job_id_t&);
       bool is_terminal() const;
@@ -68,6 +87,7 @@ namespace sdpa
       double _cost_assigned_jobs;
 
       bool stealing_allowed() const;
+      job_id_t const& most_expensive_pending_job() const;
 
       capabilities_set_t _capabilities;
       fhg::util::refcounted_set<std::string> capability_names_;
@@ -75,8 +95,16 @@ namespace sdpa
       bool const _children_allowed;
       std::string const _hostname;
       double _last_time_idle;
-
-      std::set<job_id_t> pending_;
+      //! \note estimated by the expected runtimes of the jobs
+      //! submitted, not by their cost
+      double _expected_time_idle;
+
+      std::unordered_map<job_id_t, double> pending_; //! the jobs assigned to this worker but not yet submitted, with their cost
+      std::set < std::pair<double, job_id_t>
+               , most_expensive_first<job_id_t>
+               > _pending_by_cost;
+      //! the key of the worker in the victims of its equivalence class
+      boost::optional<double> _stealing_cost;
       std::set<job_id_t> submitted_; //! the queue of jobs assigned to this worker (sent but not acknowledged)
       std::set<job_id_t> acknowledged_; //! the queue of jobs assigned to this worker (successfully submitted)
 
@@ -19,6 +19,7 @@
 #include <sdpa/types.hpp>
 
 #include <fhg/assert.hpp>
+#include <fhg/util/now.hpp>
 
 #include <util-generic/make_optional.hpp>
 
@@ -219,6 +220,7 @@ namespace sdpa
         ._stealing_allowed_classes.emplace (result.first->second.capability_names_);
 
       _num_free_workers++;
+      _stealing_may_succeed = true;
     }
 
 
@@ -365,6 +367,11 @@ namespace sdpa
           continue;
         }
 
+        double const computational_cost
+          ( requirements_and_preferences.computational_cost
+              (worker_class.first, matching_degree_and_implementation.second)
+          );
+
         for (auto& worker_id : worker_class.second._worker_ids)
         {
           auto const& worker (worker_map_.at (worker_id));
@@ -380,9 +387,13 @@ namespace sdpa
           if (worker.backlog_full())
             { continue; }
 
+          if (requirements_and_preferences.excludes (worker_id))
+            { continue; }
+
           double const total_cost
-            ( requirements_and_preferences.transfer_cost()(worker._hostname)
-            + requirements_and_preferences.computational_cost()
+            ( requirements_and_preferences.transfer_cost
+                (worker_id, worker._hostname)
+            + computational_cost
             + worker_map_.at (worker_id).cost_assigned_jobs()
             );
 
@@ -409,6 +420,7 @@ namespace sdpa
         ( job_id_t const& job_id
         , WorkerSet const& workers
         , Implementation const& implementation
+        , double expected_runtime
         , std::function<void ( WorkerSet const&
                              , Implementation const&
                              , const job_id_t&
@@ -432,7 +444,7 @@ namespace sdpa
       {
         for (auto const& worker: workers)
         {
-          submit_job_to_worker (job_id, worker);
+          submit_job_to_worker (job_id, worker, expected_runtime);
         }
 
         serve_job (workers, implementation, job_id);
@@ -489,14 +501,24 @@ namespace sdpa
 
       worker_class._idle_workers.erase (worker->first);
 
-      worker_class.allow_classes_matching_preferences_stealing
-        (worker_equiv_classes_, preferences);
+      if ( worker_class.allow_classes_matching_preferences_stealing
+             (worker_equiv_classes_, preferences)
+         )
+      {
+        _stealing_may_succeed = true;
+      }
+
+      update_stealing_victim (worker);
     }
 
-    void WorkerManager::submit_job_to_worker (const job_id_t& job_id, const worker_id_t& worker_id)
+    void WorkerManager::submit_job_to_worker
+      ( const job_id_t& job_id
+      , const worker_id_t& worker_id
+      , double expected_runtime
+      )
     {
       auto worker (worker_map_.find (worker_id));
-      worker->second.submit (job_id);
+      worker->second.submit (job_id, expected_runtime);
       auto& equivalence_class
         (worker_equiv_classes_.at (worker->second.capability_names_));
 
@@ -505,6 +527,8 @@ namespace sdpa
 
       equivalence_class._idle_workers.erase (worker->first);
 
+      update_stealing_victim (worker);
+
       // Update the counter only if the worker is terminal,
       // i.e. it has no slaves. Submission to slave agents is always allowed.
       if (worker->second.is_terminal())
@@ -558,8 +582,11 @@ namespace sdpa
            )
         {
           equivalence_class._idle_workers.emplace (worker->first);
+          _stealing_may_succeed = true;
         }
 
+        update_stealing_victim (worker);
+
         // Update the counter only if the worker is terminal,
         // i.e. it has no slaves. Submission to slave agents is always allowed.
         if (worker->second.is_terminal())
@@ -575,6 +602,34 @@ namespace sdpa
       return worker_map_.at (worker)._capabilities;
     }
 
+    std::set<std::string> WorkerManager::worker_class
+      (worker_id_t const& worker) const
+    {
+      std::lock_guard<std::mutex> const _(mtx_);
+      return worker_map_.at (worker).capability_names_;
+    }
+
+    std::unordered_map<worker_id_t, std::pair<std::set<std::string>, std::string>>
+      WorkerManager::classes_and_hosts (std::set<worker_id_t> const& workers) const
+    {
+      std::lock_guard<std::mutex> const _(mtx_);
+
+      std::unordered_map<worker_id_t, std::pair<std::set<std::string>, std::string>>
+        classes_and_hosts;
+
+      for (worker_id_t const& worker : workers)
+      {
+        auto const& description (worker_map_.at (worker));
+
+        classes_and_hosts.emplace
+          ( worker
+          , std::make_pair (description.capability_names_, description._hostname)
+          );
+      }
+
+      return classes_and_hosts;
+    }
+
     void WorkerManager::change_equivalence_class ( worker_iterator worker
                                                  , std::set<std::string> const& old_cpbs
                                                  )
@@ -596,6 +651,38 @@ namespace sdpa
           (worker_equiv_classes_[worker->second.capability_names_]);
         equivalence_class.add_worker_entry (worker);
       }
+
+      _stealing_may_succeed = true;
+    }
+
+    void WorkerManager::update_stealing_victim (worker_iterator worker)
+    {
+      auto& victims
+        (worker_equiv_classes_.at (worker->second.capability_names_)._victims);
+
+      boost::optional<double> const cost
+        ( FHG_UTIL_MAKE_OPTIONAL ( worker->second.stealing_allowed()
+                                 , worker->second.cost_assigned_jobs()
+                                 )
+        );
+
+      if (cost == worker->second._stealing_cost)
+      {
+        return;
+      }
+
+      if (worker->second._stealing_cost)
+      {
+        victims.erase ({*worker->second._stealing_cost, worker->first});
+      }
+
+      if (cost)
+      {
+        victims.emplace (*cost, worker->first);
+        _stealing_may_succeed = true;
+      }
+
+      worker->second._stealing_cost = cost;
     }
 
     bool WorkerManager::add_worker_capabilities ( const worker_id_t& worker_id
@@ -715,6 +802,12 @@ namespace sdpa
                        + worker->second.acknowledged_.size()
                        );
       _idle_workers.emplace (worker->first);
+
+      if (worker->second.stealing_allowed())
+      {
+        worker->second._stealing_cost = worker->second.cost_assigned_jobs();
+        _victims.emplace (*worker->second._stealing_cost, worker->first);
+      }
     }
 
     void WorkerManager::WorkerEquivalenceClass::remove_worker_entry
@@ -726,16 +819,24 @@ namespace sdpa
                        + worker->second.acknowledged_.size()
                        );
       _idle_workers.erase (worker->first);
+
+      if (worker->second._stealing_cost)
+      {
+        _victims.erase ({*worker->second._stealing_cost, worker->first});
+        worker->second._stealing_cost = boost::none;
+      }
     }
 
-    void WorkerManager::WorkerEquivalenceClass::allow_classes_matching_preferences_stealing
+    bool WorkerManager::WorkerEquivalenceClass::allow_classes_matching_preferences_stealing
       ( std::map<std::set<std::string>, WorkerEquivalenceClass> const& worker_classes
       , Preferences const& preferences
       )
     {
+      bool allowed_additional_class (false);
+
       if (preferences.empty())
       {
-        return;
+        return allowed_additional_class;
       }
 
       for (auto const& worker_class : worker_classes)
@@ -747,15 +848,29 @@ namespace sdpa
                         )
            )
         {
-          _stealing_allowed_classes.emplace (worker_class.first);
+          allowed_additional_class
+            = _stealing_allowed_classes.emplace (worker_class.first).second
+            || allowed_additional_class;
         }
       }
+
+      return allowed_additional_class;
     }
 
     void WorkerManager::steal_work
       (std::function<scheduler::Reservation* (job_id_t const&)> reservation)
     {
       std::lock_guard<std::mutex> const _(mtx_);
+
+      if (!_stealing_may_succeed)
+      {
+        return;
+      }
+
+      //! \note reset before stealing: a successful steal changes the
+      //! victims, so the next round tries the remaining thieves again
+      _stealing_may_succeed = false;
+
       for (WorkerEquivalenceClass& weqc : worker_equiv_classes_
                                         | boost::adaptors::map_values
           )
@@ -774,21 +889,6 @@ namespace sdpa
         return;
       }
 
-      std::unordered_set<worker_id_t> thieves;
-
-      auto const& worker_classes (worker_manager.worker_equiv_classes_);
-      for (auto const& cls : _stealing_allowed_classes)
-      {
-        thieves.insert ( worker_classes.at (cls)._idle_workers.begin()
-                       , worker_classes.at (cls)._idle_workers.end()
-                       );
-      }
-
-      if (thieves.empty())
-      {
-        return;
-      }
-
       std::function<double (job_id_t const& job_id)> const cost
         { [&reservation] (job_id_t const& job_id)
           {
@@ -796,90 +896,59 @@ namespace sdpa
           }
         };
 
-      std::function<bool (worker_iterator const&, worker_iterator const&)> const
-        comp { [] (worker_iterator const& lhs, worker_iterator const& rhs)
-               {
-                 return lhs->second.cost_assigned_jobs()
-                   < rhs->second.cost_assigned_jobs();
-               }
-             };
-
-      std::priority_queue < worker_iterator
-                          , std::vector<worker_iterator>
-                          , decltype (comp)
-                          > to_steal_from (comp);
-
-      for (worker_id_t const& w : _worker_ids)
-      {
-        auto const& it (worker_manager.worker_map_.find (w));
-        fhg_assert (it != worker_manager.worker_map_.end());
-        Worker const& worker (it->second);
-
-        if (worker.stealing_allowed())
-        {
-          to_steal_from.emplace (it);
-        }
-      }
-
-      while (!(thieves.empty() || to_steal_from.empty()))
+      auto const& worker_classes (worker_manager.worker_equiv_classes_);
+      for (auto const& cls : _stealing_allowed_classes)
       {
-        worker_iterator const richest (to_steal_from.top());
-        worker_iterator const& thief
-          (worker_manager.worker_map_.find (*thieves.begin()));
-        Worker& richest_worker (richest->second);
+        auto const& idle_workers (worker_classes.at (cls)._idle_workers);
 
-        auto it_job (std::max_element ( richest_worker.pending_.begin()
-                                      , richest_worker.pending_.end()
-                                      , [&reservation] ( job_id_t const& r
-                                                       , job_id_t const& l
-                                                       )
-                                        {
-                                          return reservation (r)->cost()
-                                            < reservation (l)->cost();
-                                        }
-                                      )
-                    );
-
-        fhg_assert (it_job != richest_worker.pending_.end());
-
-        Preferences const preferences (reservation (*it_job)->preferences());
-
-        auto const preference
-          (std::find_if ( preferences.begin()
-                        , preferences.end()
-                        , [&] (std::string const& pref)
-                          {
-                            return thief->second.hasCapability (pref);
-                          }
-                        )
-          );
-
-        if (preferences.empty() || preference != preferences.end())
+        //! \note A successful thief is erased from idle_workers, which
+        //! only invalidates iterators to itself, so advance first.
+        for ( auto next_thief (idle_workers.begin())
+            ; next_thief != idle_workers.end() && !_victims.empty()
+            ;
+            )
         {
-          reservation (*it_job)->replace_worker
-            ( richest->first
-            , thief->first
-            , FHG_UTIL_MAKE_OPTIONAL (!preferences.empty(), *preference)
-            , [&thief] (const std::string& cpb)
-              {
-                return thief->second.hasCapability (cpb);
-              }
+          worker_iterator const thief
+            (worker_manager.worker_map_.find (*next_thief++));
+          fhg_assert (thief != worker_manager.worker_map_.end());
+
+          worker_iterator const richest
+            (worker_manager.worker_map_.find (_victims.begin()->second));
+          fhg_assert (richest != worker_manager.worker_map_.end());
+
+          job_id_t const job (richest->second.most_expensive_pending_job());
+
+          Preferences const preferences (reservation (job)->preferences());
+
+          auto const preference
+            (std::find_if ( preferences.begin()
+                          , preferences.end()
+                          , [&] (std::string const& pref)
+                            {
+                              return thief->second.hasCapability (pref);
+                            }
+                          )
             );
 
-          worker_manager.assign_job_to_worker
-            (*it_job, thief, cost (*it_job), preferences);
-          worker_manager.delete_job_from_worker
-            (*it_job, richest, cost (*it_job));
-
-          to_steal_from.pop();
-
-          if (richest_worker.stealing_allowed())
+          if (preferences.empty() || preference != preferences.end())
           {
-            to_steal_from.emplace (richest);
+            reservation (job)->replace_worker
+              ( richest->first
+              , thief->first
+              , FHG_UTIL_MAKE_OPTIONAL (!preferences.empty(), *preference)
+              , [&thief] (const std::string& cpb)
+                {
+                  return thief->second.hasCapability (cpb);
+                }
+              );
+
+            //! \note both update the victims of the involved classes
+            worker_manager.assign_job_to_worker
+              (job, thief, cost (job), preferences);
+            worker_manager.delete_job_from_worker
+              (job, richest, cost (job));
           }
         }
-
-        thieves.erase (thieves.begin());
       }
     }
 
@@ -894,10 +963,10 @@ namespace sdpa
 
       Worker const& worker (worker_map_.at (worker_id));
 
-      std::unordered_set<sdpa::job_id_t> jobs_to_reschedule
-        ( worker.pending_.begin()
-        , worker.pending_.end()
-        );
+      std::unordered_set<sdpa::job_id_t> jobs_to_reschedule;
+      boost::copy ( worker.pending_ | boost::adaptors::map_keys
+                  , std::inserter (jobs_to_reschedule, jobs_to_reschedule.begin())
+                  );
 
       std::unordered_set<sdpa::job_id_t> jobs_to_cancel;
       std::set_union ( worker.submitted_.begin()
@@ -943,6 +1012,27 @@ namespace sdpa
       return jobs_to_reschedule;
     }
 
+    double WorkerManager::expected_time_all_idle
+      (WorkerSet const& workers) const
+    {
+      std::lock_guard<std::mutex> const _ (mtx_);
+
+      double expected_time (fhg::util::now());
+
+      for (worker_id_t const& worker_id : workers)
+      {
+        auto const worker (worker_map_.find (worker_id));
+
+        if (worker != worker_map_.end() && worker->second.has_running_jobs())
+        {
+          expected_time = std::max
+            (expected_time, worker->second._expected_time_idle);
+        }
+      }
+
+      return expected_time;
+    }
+
     unsigned long WorkerManager::num_free_workers() const
     {
       std::lock_guard<std::mutex> const _ (mtx_);
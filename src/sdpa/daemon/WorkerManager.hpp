@@ -100,7 +100,8 @@ namespace sdpa
         void steal_work
           (std::function<scheduler::Reservation* (job_id_t const&)>, WorkerManager&);
 
-        void allow_classes_matching_preferences_stealing
+        //! returns whether stealing from an additional class is allowed
+        bool allow_classes_matching_preferences_stealing
           ( std::map<std::set<std::string>, WorkerEquivalenceClass> const& worker_classes
           , Preferences const& preferences
           );
@@ -111,6 +112,10 @@ namespace sdpa
         std::unordered_set<worker_id_t> _worker_ids;
         std::unordered_set<worker_id_t> _idle_workers;
         std::set<std::set<std::string>> _stealing_allowed_classes;
+        //! workers allowed to be stolen from, by cost of assigned jobs
+        std::set < std::pair<double, worker_id_t>
+                 , most_expensive_first<worker_id_t>
+                 > _victims;
       };
 
     public:
@@ -139,11 +144,19 @@ namespace sdpa
 
       void steal_work (std::function<scheduler::Reservation* (job_id_t const&)> reservation);
 
+      //! \returns when all of the given workers are expected to be
+      //! idle, estimated by the expected runtimes of the jobs
+      //! submitted to them, at the earliest now
+      double expected_time_all_idle (WorkerSet const&) const;
+
+      //! \note expected_runtime: in seconds, see
+      //! expected_time_all_idle()
       std::pair<bool, unsigned long>
         submit_and_serve_if_can_start_job_INDICATES_A_RACE
           ( job_id_t const&
           , WorkerSet const&
           , Implementation const&
+          , double expected_runtime
           , std::function<void ( WorkerSet const&
                                , Implementation const&
                                , const job_id_t&
@@ -162,6 +175,12 @@ namespace sdpa
     void acknowledge_job_sent_to_worker (const job_id_t&, const worker_id_t&);
     void delete_job_from_worker (const job_id_t &job_id, const worker_id_t&, double);
     const capabilities_set_t& worker_capabilities (const worker_id_t&) const;
+    //! the names of the capabilities of the worker
+    std::set<std::string> worker_class (const worker_id_t&) const;
+    //! the class and the host of each of the workers, all taken
+    //! under a single lock
+    std::unordered_map<worker_id_t, std::pair<std::set<std::string>, std::string>>
+      classes_and_hosts (std::set<worker_id_t> const&) const;
     bool add_worker_capabilities (const worker_id_t&, const capabilities_set_t&);
     bool remove_worker_capabilities (const worker_id_t&, const capabilities_set_t&);
     void set_worker_backlog_full (const worker_id_t&, bool);
@@ -186,8 +205,10 @@ namespace sdpa
         (const job_id_t&, worker_iterator, double cost, Preferences const&);
       void delete_job_from_worker
         (const job_id_t &job_id, const worker_iterator worker, double cost);
-      void submit_job_to_worker (const job_id_t&, const worker_id_t&);
+      void submit_job_to_worker
+        (const job_id_t&, const worker_id_t&, double expected_runtime);
       void change_equivalence_class (worker_iterator, std::set<std::string> const&);
+      void update_stealing_victim (worker_iterator);
 
       std::pair<boost::optional<double>, boost::optional<std::string>>
         match_requirements_and_preferences
@@ -201,6 +222,11 @@ namespace sdpa
 
       mutable std::mutex mtx_;
       unsigned long _num_free_workers {0};
+      //! \note Set by the transitions which may enable stealing (a
+      //! worker became idle or can be stolen from, stealing between
+      //! more classes was allowed), reset by steal_work(), so that
+      //! scheduling rounds without such transitions skip stealing.
+      bool _stealing_may_succeed {false};
     };
   }
 }
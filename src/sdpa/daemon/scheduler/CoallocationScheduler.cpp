@@ -16,10 +16,13 @@
 
 #include <sdpa/daemon/scheduler/CoallocationScheduler.hpp>
 
+#include <fhg/util/now.hpp>
+
 #include <util-generic/cxx14/make_unique.hpp>
 
 #include <boost/range/algorithm.hpp>
 
+#include <algorithm>
 #include <climits>
 #include <functional>
 #include <queue>
@@ -28,14 +31,61 @@ namespace sdpa
 {
   namespace daemon
   {
+    constexpr double const CoallocationScheduler::runtime_quantum;
+
     CoallocationScheduler::CoallocationScheduler
       ( std::function<Requirements_and_preferences (const sdpa::job_id_t&)> requirements_and_preferences
       , WorkerManager& worker_manager
+      , scheduler::fair_share::top_level_job_of top_level_job
+      , expected_runtime_of expected_runtime
+      , fhg::metrics::labels const& metric_labels
       )
       : _requirements_and_preferences (requirements_and_preferences)
       , _worker_manager (worker_manager)
+      , _top_level_job (std::move (top_level_job))
+      , _expected_runtime (std::move (expected_runtime))
+      , _jobs_to_schedule
+          ( fhg::metrics::process_registry().gauge_for
+              ( "gspc_scheduler_jobs_to_schedule"
+              , "number of jobs waiting for a reservation"
+              , metric_labels
+              )
+          )
+      , _pending_jobs_size
+          ( fhg::metrics::process_registry().gauge_for
+              ( "gspc_scheduler_pending_jobs"
+              , "number of jobs with a reservation waiting for their workers"
+              , metric_labels
+              )
+          )
+      , _scheduling_round_duration
+          ( fhg::metrics::process_registry().histogram_for
+              ( "gspc_scheduler_round_seconds"
+              , "time to assign the jobs to schedule to workers"
+              , metric_labels
+              )
+          )
+      , _reservations
+          ( fhg::metrics::process_registry().counter_for
+              ( "gspc_scheduler_reservations_total"
+              , "number of reservations made"
+              , metric_labels
+              )
+          )
+      , _backfilled_jobs
+          ( fhg::metrics::process_registry().counter_for
+              ( "gspc_scheduler_backfilled_jobs_total"
+              , "number of jobs started on workers reserved for a coallocated job"
+              , metric_labels
+              )
+          )
     {}
 
+    CoallocationScheduler::~CoallocationScheduler()
+    {
+      _pending_jobs_size.decrement (_pending_jobs.size());
+    }
+
     bool CoallocationScheduler::delete_job (sdpa::job_id_t const& job)
     {
       return _jobs_to_schedule.erase (job);
@@ -46,37 +96,58 @@ namespace sdpa
       _jobs_to_schedule.push (jobId);
     }
 
+    void CoallocationScheduler::set_scheduling_parameters
+      (job_id_t const& top_level_job, scheduling_parameters parameters)
+    {
+      _fair_share.set (top_level_job, parameters);
+    }
+
+    void CoallocationScheduler::forget_top_level_job
+      (job_id_t const& top_level_job)
+    {
+      _fair_share.forget (top_level_job);
+    }
+
     void CoallocationScheduler::delete_pending_job (sdpa::job_id_t const& job)
     {
-      _pending_jobs.erase (job);
+      _pending_jobs_size.decrement (_pending_jobs.erase (job));
     }
 
     double CoallocationScheduler::compute_reservation_cost
-      ( const job_id_t& job_id
+      ( const Requirements_and_preferences& requirements_and_preferences
       , const std::set<worker_id_t>& workers
-      , const double computational_cost
+      , const Implementation& implementation
       ) const
     {
-      return std::accumulate
-        ( workers.begin()
-        , workers.end()
-        , 0.0
-        , [this, &job_id] ( const double total
-                          , worker_id_t const& worker
-                          )
-          {
-            return total
-              + _requirements_and_preferences (job_id).transfer_cost()
-                  (_worker_manager.host_INDICATES_A_RACE (worker));
-          }
-        ) + computational_cost;
+      //! \note all workers of a job wait for the slowest one
+      double computational_cost (0.0);
+      double transfer_cost (0.0);
+
+      for ( auto const& class_and_host
+          : _worker_manager.classes_and_hosts (workers)
+          )
+      {
+        computational_cost = std::max
+          ( computational_cost
+          , requirements_and_preferences.computational_cost
+              (class_and_host.second.first, implementation)
+          );
+        transfer_cost += requirements_and_preferences.transfer_cost
+          (class_and_host.first, class_and_host.second.second);
+      }
+
+      return transfer_cost + computational_cost;
     }
 
     void CoallocationScheduler::assignJobsToWorkers()
     {
       std::lock_guard<std::recursive_mutex> const _ (mtx_alloc_table_);
 
-      std::list<job_id_t> jobs_to_schedule (_jobs_to_schedule.get_and_clear());
+      fhg::metrics::scoped_timer const round_timer
+        (_scheduling_round_duration);
+
+      std::list<job_id_t> jobs_to_schedule
+        (_fair_share.order (_jobs_to_schedule.get_and_clear(), _top_level_job));
       std::list<sdpa::job_id_t> nonmatching_jobs_queue;
 
       while (!jobs_to_schedule.empty())
@@ -109,9 +180,9 @@ namespace sdpa
 
           double cost
             (compute_reservation_cost
-              ( jobId
+              ( requirements_and_preferences
               , matching_workers_and_implementation.first
-              , requirements_and_preferences.computational_cost()
+              , matching_workers_and_implementation.second
               )
             );
 
@@ -139,7 +210,11 @@ namespace sdpa
                   )
               );
 
-            _pending_jobs.emplace (jobId);
+            if (_pending_jobs.push_back (jobId))
+            {
+              _pending_jobs_size.increment();
+            }
+            _reservations.increment();
           }
           catch (std::out_of_range const&)
           {
@@ -224,31 +299,87 @@ namespace sdpa
       long num_free_workers_left
         (_worker_manager.num_free_workers());
 
-      for ( auto it (_pending_jobs.begin())
-          ; num_free_workers_left > 0  && it != _pending_jobs.end()
-          ;
+      if (num_free_workers_left <= 0)
+      {
+        return jobs_started;
+      }
+
+      //! \note free workers go to the jobs of the top level jobs
+      //! with the highest priority and the smallest share used
+      std::list<job_id_t> const pending_jobs
+        (_fair_share.order (_pending_jobs.jobs(), _top_level_job));
+
+      //! \note the first coallocated job that can not start yet has
+      //! its workers reserved and the time all of them are expected
+      //! to be idle: later jobs may use them only if they are
+      //! expected to finish by then (backfilling), so that the
+      //! coallocated job is not starved by smaller ones
+      boost::optional<std::pair<WorkerSet, double>> reserved_for_coallocation;
+
+      for ( auto it (pending_jobs.begin())
+          ; num_free_workers_left > 0  && it != pending_jobs.end()
+          ; ++it
           )
       {
         auto const job_id (*it);
 
         std::lock_guard<std::recursive_mutex> const _ (mtx_alloc_table_);
-        auto const assigned_workers (allocation_table_.at (job_id)->workers());
+        scheduler::Reservation const& reservation
+          (*allocation_table_.at (job_id));
+        auto const assigned_workers (reservation.workers());
+
+        bool const backfilling
+          ( reserved_for_coallocation
+          && std::any_of ( assigned_workers.begin()
+                         , assigned_workers.end()
+                         , [&] (worker_id_t const& worker)
+                           {
+                             return reserved_for_coallocation->first.count
+                               (worker);
+                           }
+                         )
+          );
+
+        double const expected_runtime
+          ( _expected_runtime
+              (job_id, reservation.implementation(), assigned_workers)
+          );
+
+        if ( backfilling
+           && fhg::util::now() + expected_runtime
+            > reserved_for_coallocation->second
+           )
+        {
+          continue;
+        }
+
         std::tie (started, num_free_workers_left) =
           _worker_manager.submit_and_serve_if_can_start_job_INDICATES_A_RACE
             ( job_id
-            , allocation_table_.at (job_id)->workers()
-            , allocation_table_.at (job_id)->implementation()
+            , assigned_workers
+            , reservation.implementation()
+            , expected_runtime
             , serve_job
             );
 
         if (started)
         {
           jobs_started.insert (job_id);
-          it = _pending_jobs.erase (it);
+          _pending_jobs.erase (job_id);
+          _pending_jobs_size.decrement();
+          _fair_share.charge (_top_level_job (job_id));
+
+          if (backfilling)
+          {
+            _backfilled_jobs.increment();
+          }
         }
-        else
+        else if (!reserved_for_coallocation && assigned_workers.size() > 1)
         {
-          it++;
+          reserved_for_coallocation = std::make_pair
+            ( assigned_workers
+            , _worker_manager.expected_time_all_idle (assigned_workers)
+            );
         }
       }
 
@@ -288,6 +419,15 @@ namespace sdpa
       return allocation_table_.at (job)->is_canceled();
     }
 
+    bool CoallocationScheduler::is_reserved_on
+      (job_id_t const& job, worker_id_t const& worker) const
+    {
+      std::lock_guard<std::recursive_mutex> const _ (mtx_alloc_table_);
+      auto const it (allocation_table_.find (job));
+      return it != allocation_table_.end()
+        && it->second->workers().count (worker);
+    }
+
     void CoallocationScheduler::store_result ( worker_id_t const& worker_id
                                              , job_id_t const& job_id
                                              , terminal_state result
@@ -319,17 +459,30 @@ namespace sdpa
       return it->second->get_aggregated_results_if_all_terminated();
     }
 
+    CoallocationScheduler::locked_job_id_list::locked_job_id_list
+        (fhg::metrics::gauge& size)
+      : size_ (size)
+    {}
+
+    CoallocationScheduler::locked_job_id_list::~locked_job_id_list()
+    {
+      size_.decrement (container_.size());
+    }
+
     void CoallocationScheduler::locked_job_id_list::push (job_id_t const& item)
     {
       std::lock_guard<std::mutex> const _ (mtx_);
       container_.emplace_back (item);
+      size_.increment();
     }
 
     template <typename Range>
     void CoallocationScheduler::locked_job_id_list::push (Range const& range)
     {
       std::lock_guard<std::mutex> const _ (mtx_);
-      container_.insert (container_.end(), std::begin (range), std::end (range));
+      auto const pushed
+        (container_.insert (container_.end(), std::begin (range), std::end (range)));
+      size_.increment (std::distance (pushed, container_.end()));
     }
 
     size_t CoallocationScheduler::locked_job_id_list::erase (const job_id_t& item)
@@ -349,6 +502,7 @@ namespace sdpa
           ++iter;
         }
       }
+      size_.decrement (count);
       return count;
     }
 
@@ -358,7 +512,46 @@ namespace sdpa
 
       std::list<job_id_t> ret;
       std::swap (ret, container_);
+      size_.decrement (ret.size());
       return ret;
     }
+
+    bool CoallocationScheduler::pending_job_list::push_back
+      (job_id_t const& job)
+    {
+      if (_positions.count (job))
+      {
+        return false;
+      }
+
+      _positions.emplace (job, _jobs.emplace (_jobs.end(), job));
+      return true;
+    }
+
+    std::size_t CoallocationScheduler::pending_job_list::erase
+      (job_id_t const& job)
+    {
+      auto const position (_positions.find (job));
+
+      if (position == _positions.end())
+      {
+        return 0;
+      }
+
+      _jobs.erase (position->second);
+      _positions.erase (position);
+      return 1;
+    }
+
+    std::size_t CoallocationScheduler::pending_job_list::size() const
+    {
+      return _jobs.size();
+    }
+
+    std::list<job_id_t> const&
+      CoallocationScheduler::pending_job_list::jobs() const
+    {
+      return _jobs;
+    }
   }
 }
@@ -19,8 +19,12 @@
 #include <sdpa/daemon/Job.hpp>
 #include <sdpa/daemon/WorkerManager.hpp>
 #include <sdpa/daemon/scheduler/Reservation.hpp>
+#include <sdpa/daemon/scheduler/fair_share.hpp>
+#include <sdpa/scheduling_parameters.hpp>
 #include <sdpa/types.hpp>
 
+#include <metrics/registry.hpp>
+
 #include <boost/optional.hpp>
 #include <boost/range/adaptor/map.hpp>
 
@@ -35,10 +39,36 @@ namespace sdpa
     class CoallocationScheduler : boost::noncopyable
     {
     public:
+      //! seconds the job is expected to run with the implementation
+      //! on the workers
+      //! \note not the cost of the reservation: that is unitless and
+      //! includes the transfer cost
+      using expected_runtime_of = std::function
+        <double (job_id_t const&, Implementation const&, WorkerSet const&)>;
+
+      //! \note the runtime assumed for every job without a better
+      //! estimate
+      static constexpr double const runtime_quantum = 1.0;
+
+      //! \note top_level_job: the top level job whose scheduling
+      //! parameters a job is scheduled with, by default every job is
+      //! a top level job on its own
+      //! \note expected_runtime: to estimate when workers become
+      //! idle, by default every job runs for runtime_quantum
       CoallocationScheduler
         ( std::function<Requirements_and_preferences (const sdpa::job_id_t&)>
         , WorkerManager&
+        , scheduler::fair_share::top_level_job_of top_level_job
+            = [] (job_id_t const& job) { return job; }
+        , expected_runtime_of expected_runtime
+            = [] (job_id_t const&, Implementation const&, WorkerSet const&)
+              {
+                return runtime_quantum;
+              }
+          //! added to the labels of all metrics, e.g. the agent
+        , fhg::metrics::labels const& metric_labels = {}
         );
+      ~CoallocationScheduler();
 
       // -- used by daemon
       bool delete_job (const sdpa::job_id_t&);
@@ -52,6 +82,11 @@ namespace sdpa
       void enqueueJob (const sdpa::job_id_t&);
       void request_scheduling();
 
+      //! \note may be changed while the top level job is running
+      void set_scheduling_parameters
+        (job_id_t const& top_level_job, scheduling_parameters);
+      void forget_top_level_job (job_id_t const&);
+
       // used by daemon and self and test
       void releaseReservation (const sdpa::job_id_t&);
       void assignJobsToWorkers();
@@ -73,11 +108,14 @@ namespace sdpa
         );
 
       bool reservation_canceled (job_id_t const&) const;
+      //! \note whether the job currently has a reservation that
+      //! includes the worker
+      bool is_reserved_on (job_id_t const&, worker_id_t const&) const;
     private:
       double compute_reservation_cost
-        ( const job_id_t&
+        ( const Requirements_and_preferences&
         , const std::set<worker_id_t>&
-        , const double computational_cost
+        , const Implementation&
         ) const;
 
       std::function<Requirements_and_preferences (const sdpa::job_id_t&)>
@@ -85,9 +123,16 @@ namespace sdpa
 
       WorkerManager& _worker_manager;
 
+      scheduler::fair_share::top_level_job_of _top_level_job;
+      scheduler::fair_share _fair_share;
+      expected_runtime_of _expected_runtime;
+
       class locked_job_id_list
       {
       public:
+        explicit locked_job_id_list (fhg::metrics::gauge& size);
+        ~locked_job_id_list();
+
         inline void push (job_id_t const& item);
         template <typename Range>
         inline void push (Range const& items);
@@ -98,6 +143,7 @@ namespace sdpa
       private:
         mutable std::mutex mtx_;
         std::list<job_id_t> container_;
+        fhg::metrics::gauge& size_;
       } _jobs_to_schedule;
 
       //! \note to be able to call releaseReservation instead of
@@ -107,7 +153,26 @@ namespace sdpa
         = std::unordered_map<job_id_t, std::unique_ptr<scheduler::Reservation>>;
       allocation_table_t allocation_table_;
 
-      std::unordered_set<job_id_t> _pending_jobs;
+      //! \note in the order the reservations were made
+      class pending_job_list
+      {
+      public:
+        //! \returns whether the job was not yet in the list
+        bool push_back (job_id_t const&);
+        std::size_t erase (job_id_t const&);
+        std::size_t size() const;
+        std::list<job_id_t> const& jobs() const;
+
+      private:
+        std::list<job_id_t> _jobs;
+        std::unordered_map<job_id_t, std::list<job_id_t>::iterator>
+          _positions;
+      } _pending_jobs;
+
+      fhg::metrics::gauge& _pending_jobs_size;
+      fhg::metrics::histogram& _scheduling_round_duration;
+      fhg::metrics::counter& _reservations;
+      fhg::metrics::counter& _backfilled_jobs;
 
       friend class access_allocation_table_TESTING_ONLY;
     };
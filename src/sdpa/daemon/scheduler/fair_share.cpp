@@ -0,0 +1,160 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/daemon/scheduler/fair_share.hpp>
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace sdpa
+{
+  namespace daemon
+  {
+    namespace scheduler
+    {
+      void fair_share::set
+        (job_id_t const& top_level_job, scheduling_parameters parameters)
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        auto const known (_shares.find (top_level_job));
+
+        if (known == _shares.end())
+        {
+          _shares.emplace
+            (top_level_job, share {parameters, _virtual_time});
+        }
+        else
+        {
+          known->second.parameters = parameters;
+        }
+      }
+
+      void fair_share::forget (job_id_t const& top_level_job)
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        _shares.erase (top_level_job);
+      }
+
+      fair_share::share fair_share::share_of
+        (job_id_t const& top_level_job) const
+      {
+        auto const known (_shares.find (top_level_job));
+
+        if (known == _shares.end())
+        {
+          return {scheduling_parameters(), _virtual_time};
+        }
+
+        return { known->second.parameters
+               , std::max (known->second.pass, _virtual_time)
+               };
+      }
+
+      std::list<job_id_t> fair_share::order
+        (std::list<job_id_t> jobs, top_level_job_of const& top_level_job) const
+      {
+        //! \note in the order of the first job of each top level job
+        std::vector<std::pair<job_id_t, std::list<job_id_t>>> queues;
+        std::unordered_map<job_id_t, std::size_t> queue_index;
+
+        for (job_id_t& job : jobs)
+        {
+          job_id_t top_level (top_level_job (job));
+
+          auto const index
+            (queue_index.emplace (top_level, queues.size()));
+
+          if (index.second)
+          {
+            queues.emplace_back (std::move (top_level), std::list<job_id_t>());
+          }
+
+          queues[index.first->second].second.emplace_back (std::move (job));
+        }
+
+        if (queues.size() < 2)
+        {
+          return queues.empty() ? std::list<job_id_t>()
+                                : std::move (queues.front().second);
+        }
+
+        std::vector<share> shares;
+
+        {
+          std::lock_guard<std::mutex> const _ (_guard);
+
+          for (auto const& queue : queues)
+          {
+            shares.emplace_back (share_of (queue.first));
+          }
+        }
+
+        //! \note -priority, pass, index: the first is the next to go
+        std::set<std::tuple<int, double, std::size_t>> next;
+
+        for (std::size_t index (0); index < queues.size(); ++index)
+        {
+          next.emplace
+            (-shares[index].parameters.priority, shares[index].pass, index);
+        }
+
+        std::list<job_id_t> ordered;
+
+        while (!next.empty())
+        {
+          auto const first (*next.begin());
+          next.erase (next.begin());
+
+          std::size_t const index (std::get<2> (first));
+          std::list<job_id_t>& queue (queues[index].second);
+
+          ordered.splice (ordered.end(), queue, queue.begin());
+
+          if (!queue.empty())
+          {
+            next.emplace
+              ( std::get<0> (first)
+              , std::get<1> (first) + 1.0 / shares[index].parameters.weight
+              , index
+              );
+          }
+        }
+
+        return ordered;
+      }
+
+      void fair_share::charge (job_id_t const& top_level_job)
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        auto& charged
+          ( _shares.emplace
+              (top_level_job, share {scheduling_parameters(), _virtual_time})
+            .first->second
+          );
+
+        charged.pass = std::max (charged.pass, _virtual_time);
+        _virtual_time = charged.pass;
+        charged.pass += 1.0 / charged.parameters.weight;
+      }
+    }
+  }
+}
@@ -0,0 +1,75 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <sdpa/scheduling_parameters.hpp>
+#include <sdpa/types.hpp>
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace sdpa
+{
+  namespace daemon
+  {
+    namespace scheduler
+    {
+      //! Orders the jobs of concurrently running top level jobs by
+      //! stride scheduling: every top level job has a pass that is
+      //! advanced by 1/weight for every job started, the top level
+      //! job with the highest priority and the lowest pass goes
+      //! next. Thread safe.
+      //! \note top level jobs not known get the default parameters
+      class fair_share
+      {
+      public:
+        using top_level_job_of
+          = std::function<job_id_t (job_id_t const&)>;
+
+        //! \note may be called while jobs are running, the pass
+        //! already reached is kept
+        void set (job_id_t const& top_level_job, scheduling_parameters);
+        void forget (job_id_t const& top_level_job);
+
+        //! \returns the given jobs in the order they shall be tried,
+        //! jobs of the same top level job keep their relative order
+        std::list<job_id_t> order
+          (std::list<job_id_t> jobs, top_level_job_of const&) const;
+
+        //! \note to be called for every job started
+        void charge (job_id_t const& top_level_job);
+
+      private:
+        struct share
+        {
+          scheduling_parameters parameters;
+          double pass;
+        };
+
+        mutable std::mutex _guard;
+        std::unordered_map<job_id_t, share> _shares;
+        //! \note the pass of the share charged last: shares that were
+        //! idle meanwhile or are new do not get the time back
+        double _virtual_time = 0.0;
+
+        share share_of (job_id_t const&) const;
+      };
+    }
+  }
+}
@@ -0,0 +1,155 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <sdpa/daemon/scheduler/global_memory_locality.hpp>
+
+#include <stdexcept>
+
+namespace sdpa
+{
+  namespace daemon
+  {
+    namespace scheduler
+    {
+      namespace
+      {
+        std::tuple<std::string, unsigned long, unsigned long> key_of
+          (we::global::range const& range)
+        {
+          return std::make_tuple
+            (range.handle().name(), range.offset(), range.size());
+        }
+      }
+
+      global_memory_locality::global_memory_locality
+          (std::size_t ranges_per_worker)
+        : _ranges_per_worker (ranges_per_worker)
+      {
+        if (_ranges_per_worker == 0)
+        {
+          throw std::invalid_argument
+            ("global_memory_locality: ranges per worker have to be positive");
+        }
+      }
+
+      void global_memory_locality::record
+        ( worker_id_t const& worker
+        , std::list<we::global::range> const& global_ranges
+        )
+      {
+        if (global_ranges.empty())
+        {
+          return;
+        }
+
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        auto const known (_ranges.find (worker));
+
+        if (known == _ranges.end())
+        {
+          return;
+        }
+
+        ranges& worker_ranges (known->second);
+
+        for (we::global::range const& range : global_ranges)
+        {
+          //! \note not cached by the worker either
+          if (range.size() > worker_ranges.capacity)
+          {
+            continue;
+          }
+
+          key const range_key (key_of (range));
+
+          auto const position (worker_ranges.positions.find (range_key));
+
+          if (position != worker_ranges.positions.end())
+          {
+            worker_ranges.recently_recorded.splice
+              ( worker_ranges.recently_recorded.begin()
+              , worker_ranges.recently_recorded
+              , position->second
+              );
+
+            continue;
+          }
+
+          worker_ranges.recently_recorded.emplace_front (range_key);
+          worker_ranges.positions.emplace
+            (range_key, worker_ranges.recently_recorded.begin());
+          worker_ranges.size += range.size();
+
+          while ( worker_ranges.recently_recorded.size() > _ranges_per_worker
+                || worker_ranges.size > worker_ranges.capacity
+                )
+          {
+            key const& evicted (worker_ranges.recently_recorded.back());
+
+            worker_ranges.size -= std::get<2> (evicted);
+            worker_ranges.positions.erase (evicted);
+            worker_ranges.recently_recorded.pop_back();
+          }
+        }
+      }
+
+      double global_memory_locality::cached_fraction
+        ( worker_id_t const& worker
+        , std::list<we::global::range> const& global_ranges
+        ) const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        auto const worker_ranges (_ranges.find (worker));
+
+        if (worker_ranges == _ranges.end())
+        {
+          return 0.0;
+        }
+
+        double total (0.0);
+        double cached (0.0);
+
+        for (we::global::range const& range : global_ranges)
+        {
+          total += range.size();
+
+          if (worker_ranges->second.positions.count (key_of (range)))
+          {
+            cached += range.size();
+          }
+        }
+
+        return total > 0.0 ? cached / total : 0.0;
+      }
+
+      void global_memory_locality::reset
+        (worker_id_t const& worker, unsigned long capacity)
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        _ranges.erase (worker);
+
+        if (capacity > 0)
+        {
+          _ranges.emplace (worker, ranges {capacity, 0, {}, {}});
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,83 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <sdpa/types.hpp>
+
+#include <we/type/range.hpp>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+namespace sdpa
+{
+  namespace daemon
+  {
+    namespace scheduler
+    {
+      //! The global memory ranges the workers were most recently sent
+      //! jobs reading them, i.e. are likely to hold in their cache of
+      //! global memory. Thread safe.
+      //! \note only an estimate: the workers evict on their own. Only
+      //! workers with a cache get ranges recorded, and only as many
+      //! bytes as fit into it.
+      class global_memory_locality
+      {
+      public:
+        //! \note ranges_per_worker: number of most recent ranges
+        //! remembered per worker
+        global_memory_locality (std::size_t ranges_per_worker = 1024);
+
+        //! \note ignored for workers without a cache
+        void record (worker_id_t const&, std::list<we::global::range> const&);
+
+        //! \returns the part of the bytes of the given ranges that
+        //! were recorded for the worker, in [0, 1]
+        double cached_fraction
+          (worker_id_t const&, std::list<we::global::range> const&) const;
+
+        //! \note when the worker (re-)registers: its cache is empty,
+        //! capacity in bytes, 0 if it has none
+        void reset (worker_id_t const&, unsigned long capacity);
+
+      private:
+        //! handle, offset, size
+        using key = std::tuple<std::string, unsigned long, unsigned long>;
+
+        struct ranges
+        {
+          unsigned long capacity;
+          unsigned long size;
+          //! \note front: most recently recorded
+          std::list<key> recently_recorded;
+          std::map<key, std::list<key>::iterator> positions;
+        };
+
+        std::size_t _ranges_per_worker;
+
+        mutable std::mutex _guard;
+        std::unordered_map<worker_id_t, ranges> _ranges;
+      };
+    }
+  }
+}
@@ -0,0 +1,234 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/daemon/scheduler/runtime_statistics.hpp>
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/utility.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace sdpa
+{
+  namespace daemon
+  {
+    namespace scheduler
+    {
+      namespace
+      {
+        //! \note nearest rank on sorted samples
+        double quantile (std::vector<double> const& sorted, double q)
+        {
+          auto const rank
+            (static_cast<std::size_t> (std::ceil (q * sorted.size())));
+
+          return sorted.at (std::max<std::size_t> (rank, 1) - 1);
+        }
+      }
+
+      bool runtime_statistics::key::operator< (key const& other) const
+      {
+        return std::tie (transition, implementation, worker_class)
+          < std::tie (other.transition, other.implementation, other.worker_class);
+      }
+
+      runtime_statistics::runtime_statistics
+          (double smoothing, std::size_t window)
+        : _smoothing (smoothing)
+        , _window (window)
+      {
+        if (!(0.0 < _smoothing && _smoothing <= 1.0))
+        {
+          throw std::invalid_argument
+            ("runtime_statistics: smoothing has to be in (0, 1]");
+        }
+
+        if (_window == 0)
+        {
+          throw std::invalid_argument
+            ("runtime_statistics: window has to be positive");
+        }
+      }
+
+      void runtime_statistics::record (runtimes& runtimes, double seconds)
+      {
+        runtimes.ewma = runtimes.count == 0 ? seconds
+          : _smoothing * seconds + (1.0 - _smoothing) * runtimes.ewma;
+        ++runtimes.count;
+
+        runtimes.recent.emplace_back (seconds);
+        while (runtimes.recent.size() > _window)
+        {
+          runtimes.recent.pop_front();
+        }
+      }
+
+      void runtime_statistics::record (key const& key, double seconds)
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        record (_runtimes[key], seconds);
+
+        if (!key.worker_class.empty())
+        {
+          record (_runtimes[{key.transition, key.implementation, {}}], seconds);
+        }
+      }
+
+      boost::optional<double> runtime_statistics::expected_runtime
+        (key const& key, std::size_t minimum_samples) const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        return expected_runtime_locked (key, minimum_samples);
+      }
+
+      boost::optional<double> runtime_statistics::expected_runtime_locked
+        (key const& key, std::size_t minimum_samples) const
+      {
+        for ( auto const& candidate
+            : {key, runtime_statistics::key {key.transition, key.implementation, {}}}
+            )
+        {
+          auto const runtimes (_runtimes.find (candidate));
+
+          if ( runtimes != _runtimes.end()
+             && runtimes->second.count >= minimum_samples
+             )
+          {
+            return runtimes->second.ewma;
+          }
+        }
+
+        return boost::none;
+      }
+
+      runtime_statistics::summary runtime_statistics::summarize
+        (runtimes const& runtimes) const
+      {
+        std::vector<double> sorted
+          (runtimes.recent.begin(), runtimes.recent.end());
+        std::sort (sorted.begin(), sorted.end());
+
+        return { runtimes.count
+               , runtimes.ewma
+               , quantile (sorted, 0.5)
+               , quantile (sorted, 0.9)
+               , quantile (sorted, 0.99)
+               , sorted.back()
+               };
+      }
+
+      boost::optional<runtime_statistics::summary> runtime_statistics::query
+        (key const& key) const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        auto const runtimes (_runtimes.find (key));
+
+        if (runtimes == _runtimes.end())
+        {
+          return boost::none;
+        }
+
+        return summarize (runtimes->second);
+      }
+
+      std::map<runtime_statistics::key, runtime_statistics::summary>
+        runtime_statistics::summaries() const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        std::map<key, summary> summaries;
+
+        for (auto const& runtimes : _runtimes)
+        {
+          summaries.emplace (runtimes.first, summarize (runtimes.second));
+        }
+
+        return summaries;
+      }
+
+      void runtime_statistics::save (boost::filesystem::path const& path) const
+      {
+        boost::filesystem::path const temporary (path.string() + ".tmp");
+
+        {
+          boost::filesystem::ofstream stream (temporary);
+
+          if (!stream)
+          {
+            throw std::runtime_error
+              ("could not open " + temporary.string() + " for writing");
+          }
+
+          boost::archive::text_oarchive archive (stream);
+
+          std::lock_guard<std::mutex> const _ (_guard);
+          archive << _runtimes;
+        }
+
+        boost::filesystem::rename (temporary, path);
+      }
+
+      void runtime_statistics::load (boost::filesystem::path const& path)
+      {
+        boost::filesystem::ifstream stream (path);
+
+        if (!stream)
+        {
+          throw std::runtime_error
+            ("could not open " + path.string() + " for reading");
+        }
+
+        boost::archive::text_iarchive archive (stream);
+
+        std::map<key, runtimes> loaded;
+        archive >> loaded;
+
+        for (auto& runtimes : loaded)
+        {
+          while (runtimes.second.recent.size() > _window)
+          {
+            runtimes.second.recent.pop_front();
+          }
+        }
+
+        std::lock_guard<std::mutex> const _ (_guard);
+        _runtimes = std::move (loaded);
+      }
+
+      std::ostream& operator<<
+        (std::ostream& os, runtime_statistics::summary const& summary)
+      {
+        return os << "count " << summary.count
+                  << ", ewma " << summary.ewma << "s"
+                  << ", median " << summary.median << "s"
+                  << ", p90 " << summary.p90 << "s"
+                  << ", p99 " << summary.p99 << "s"
+                  << ", max " << summary.max << "s";
+      }
+    }
+  }
+}
@@ -0,0 +1,136 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <sdpa/daemon/Job.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <boost/serialization/deque.hpp>
+#include <boost/serialization/optional.hpp>
+#include <boost/serialization/set.hpp>
+#include <boost/serialization/string.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+
+namespace sdpa
+{
+  namespace daemon
+  {
+    namespace scheduler
+    {
+      //! Streaming statistics of the observed runtimes of finished
+      //! jobs, per transition, implementation and class of worker
+      //! (its set of capabilities). Thread safe.
+      //! \note only successful jobs are recorded: failed jobs often
+      //! abort early and canceled ones are cut short, so neither
+      //! tells how long the job takes on that class of worker
+      class runtime_statistics
+      {
+      public:
+        struct key
+        {
+          std::string transition;
+          Implementation implementation;
+          //! \note empty: on any class of worker
+          std::set<std::string> worker_class;
+
+          bool operator< (key const&) const;
+
+          template<typename Archive>
+            void serialize (Archive& ar, unsigned int)
+          {
+            ar & transition;
+            ar & implementation;
+            ar & worker_class;
+          }
+        };
+
+        struct summary
+        {
+          std::size_t count;
+          double ewma;
+          double median;
+          double p90;
+          double p99;
+          double max;
+        };
+
+        //! \note smoothing: weight of the newest runtime in the
+        //! exponentially weighted moving average, window: number of
+        //! most recent runtimes the quantiles are computed from
+        runtime_statistics (double smoothing = 0.2, std::size_t window = 256);
+
+        //! records for the given key and for the key on any class of
+        //! worker
+        void record (key const&, double seconds);
+
+        //! the moving average for the key or, if less than
+        //! minimum_samples were recorded for that class of worker yet,
+        //! on any class of worker
+        boost::optional<double> expected_runtime
+          (key const&, std::size_t minimum_samples = 1) const;
+
+        boost::optional<summary> query (key const&) const;
+        std::map<key, summary> summaries() const;
+
+        //! \note replaces the snapshot atomically
+        void save (boost::filesystem::path const&) const;
+        //! \note replaces all statistics, throws if the snapshot can
+        //! not be read
+        void load (boost::filesystem::path const&);
+
+      private:
+        struct runtimes
+        {
+          std::size_t count = 0;
+          double ewma = 0.0;
+          std::deque<double> recent;
+
+          template<typename Archive>
+            void serialize (Archive& ar, unsigned int)
+          {
+            ar & count;
+            ar & ewma;
+            ar & recent;
+          }
+        };
+
+        void record (runtimes&, double seconds);
+        summary summarize (runtimes const&) const;
+
+        double _smoothing;
+        std::size_t _window;
+
+        mutable std::mutex _guard;
+        std::map<key, runtimes> _runtimes;
+
+        boost::optional<double> expected_runtime_locked
+          (key const&, std::size_t minimum_samples) const;
+      };
+
+      std::ostream& operator<<
+        (std::ostream&, runtime_statistics::summary const&);
+    }
+  }
+}
@@ -0,0 +1,124 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/daemon/scheduler/speculative_backups.hpp>
+
+#include <stdexcept>
+
+namespace sdpa
+{
+  namespace daemon
+  {
+    namespace scheduler
+    {
+      speculative_backups::speculative_backups
+          (double runtime_multiple, std::size_t minimum_observations)
+        : _runtime_multiple (runtime_multiple)
+        , _minimum_observations (minimum_observations)
+      {
+        if (!(_runtime_multiple > 0.0))
+        {
+          throw std::invalid_argument
+            ("speculative_backups: runtime multiple has to be positive");
+        }
+      }
+
+      bool speculative_backups::is_straggler
+        ( runtime_statistics::summary const& observed
+        , double running_seconds
+        ) const
+      {
+        return observed.count >= _minimum_observations
+          && running_seconds > _runtime_multiple * observed.p90;
+      }
+
+      void speculative_backups::launched
+        (job_id_t const& original, job_id_t const& backup)
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        if (!_backups.emplace (original, backup).second)
+        {
+          throw std::logic_error ("second backup for job " + original);
+        }
+        _originals.emplace (backup, original);
+      }
+
+      bool speculative_backups::speculated (job_id_t const& original) const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        return _backups.count (original);
+      }
+
+      boost::optional<job_id_t> speculative_backups::running_backup_of
+        (job_id_t const& original) const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        auto const backup (_backups.find (original));
+
+        return boost::make_optional
+          ( backup != _backups.end() && _originals.count (backup->second)
+          , backup != _backups.end() ? backup->second : job_id_t()
+          );
+      }
+
+      boost::optional<job_id_t> speculative_backups::original_of
+        (job_id_t const& backup) const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        auto const original (_originals.find (backup));
+
+        return boost::make_optional
+          ( original != _originals.end()
+          , original != _originals.end() ? original->second : job_id_t()
+          );
+      }
+
+      void speculative_backups::supersede (job_id_t const& job)
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        _superseded.emplace (job);
+      }
+
+      bool speculative_backups::superseded (job_id_t const& job) const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        return _superseded.count (job);
+      }
+
+      std::list<job_id_t> speculative_backups::superseded_jobs() const
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        return {_superseded.begin(), _superseded.end()};
+      }
+
+      void speculative_backups::forget (job_id_t const& job)
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+
+        _backups.erase (job);
+        _originals.erase (job);
+        _superseded.erase (job);
+      }
+    }
+  }
+}
@@ -0,0 +1,81 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <sdpa/daemon/scheduler/runtime_statistics.hpp>
+#include <sdpa/types.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace sdpa
+{
+  namespace daemon
+  {
+    namespace scheduler
+    {
+      //! Decides which running jobs are stragglers and keeps track of
+      //! the backup copies launched for them: an original and its
+      //! backup run concurrently, the first one to finish decides the
+      //! result and the other one is superseded. Thread safe.
+      //! \note every original gets at most one backup
+      class speculative_backups
+      {
+      public:
+        //! \note a job is a straggler if it runs longer than
+        //! runtime_multiple times the 90th percentile of the runtimes
+        //! observed for its transition, once at least
+        //! minimum_observations runtimes were observed
+        speculative_backups
+          (double runtime_multiple, std::size_t minimum_observations = 10);
+
+        bool is_straggler
+          (runtime_statistics::summary const&, double running_seconds) const;
+
+        void launched (job_id_t const& original, job_id_t const& backup);
+
+        //! \note stays true after the backup is forgotten
+        bool speculated (job_id_t const& original) const;
+        boost::optional<job_id_t> running_backup_of
+          (job_id_t const& original) const;
+        boost::optional<job_id_t> original_of (job_id_t const& backup) const;
+
+        //! \note the result of a superseded job is not to be reported
+        void supersede (job_id_t const&);
+        bool superseded (job_id_t const&) const;
+        std::list<job_id_t> superseded_jobs() const;
+
+        //! \note to be called when the job is deleted
+        void forget (job_id_t const&);
+
+      private:
+        double _runtime_multiple;
+        std::size_t _minimum_observations;
+
+        mutable std::mutex _guard;
+        std::unordered_map<job_id_t, job_id_t> _backups;
+        std::unordered_map<job_id_t, job_id_t> _originals;
+        std::unordered_set<job_id_t> _superseded;
+      };
+    }
+  }
+}
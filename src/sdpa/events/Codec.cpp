@@ -39,11 +39,16 @@
 #include <sdpa/events/SubscribeEvent.hpp>
 #include <sdpa/events/WorkerRegistrationEvent.hpp>
 #include <sdpa/events/put_token.hpp>
+#include <sdpa/events/set_scheduling_parameters.hpp>
 #include <sdpa/events/worker_registration_response.hpp>
 #include <sdpa/events/workflow_response.hpp>
 
+#include <metrics/registry.hpp>
+
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
 
 #include <sstream>
 
@@ -86,6 +91,8 @@ namespace sdpa
         REGISTER (WorkerRegistrationEvent, MgmtEvent);
         REGISTER (put_token, JobEvent);
         REGISTER (put_token_response, MgmtEvent);
+        REGISTER (set_scheduling_parameters, JobEvent);
+        REGISTER (set_scheduling_parameters_response, MgmtEvent);
         REGISTER (workflow_response, JobEvent);
         REGISTER (workflow_response_response, MgmtEvent);
         REGISTER (BacklogNoLongerFullEvent, MgmtEvent);
@@ -95,19 +102,82 @@ namespace sdpa
       }
     }
 
+    Codec::Codec (fhg::metrics::labels const& metric_labels)
+      : _encode_duration
+          ( fhg::metrics::process_registry().histogram_for
+              ( "gspc_sdpa_event_encode_seconds"
+              , "time to serialize an event"
+              , metric_labels
+              )
+          )
+      , _decode_duration
+          ( fhg::metrics::process_registry().histogram_for
+              ( "gspc_sdpa_event_decode_seconds"
+              , "time to deserialize an event"
+              , metric_labels
+              )
+          )
+      , _encoded_bytes
+          ( fhg::metrics::process_registry().counter_for
+              ( "gspc_sdpa_event_encoded_bytes_total"
+              , "size of serialized events"
+              , metric_labels
+              )
+          )
+      , _decoded_bytes
+          ( fhg::metrics::process_registry().counter_for
+              ( "gspc_sdpa_event_decoded_bytes_total"
+              , "size of deserialized events"
+              , metric_labels
+              )
+          )
+    {}
+
     std::string Codec::encode (sdpa::events::SDPAEvent const* e) const
     {
+      fhg::metrics::scoped_timer const encode_timer (_encode_duration);
+
       std::ostringstream sstr;
       boost::archive::text_oarchive ar (sstr);
       initialize_archive (ar);
       ar << e;
-      return sstr.str();
+
+      std::string encoded (sstr.str());
+      _encoded_bytes.increment (encoded.size());
+      return encoded;
     }
 
     sdpa::events::SDPAEvent* Codec::decode (std::string const& s) const
     {
-      std::istringstream sstr (s);
-      boost::archive::text_iarchive ar (sstr);
+      return decode (s.data(), s.size());
+    }
+
+    void Codec::encode
+      (sdpa::events::SDPAEvent const* e, fhg::com::buffer& buffer) const
+    {
+      fhg::metrics::scoped_timer const encode_timer (_encode_duration);
+
+      std::size_t const size_before (buffer.size());
+
+      {
+        boost::iostreams::stream<fhg::com::buffer_sink> stream (buffer);
+        boost::archive::text_oarchive ar (stream);
+        initialize_archive (ar);
+        ar << e;
+      }
+
+      _encoded_bytes.increment (buffer.size() - size_before);
+    }
+
+    sdpa::events::SDPAEvent* Codec::decode
+      (char const* data, std::size_t size) const
+    {
+      fhg::metrics::scoped_timer const decode_timer (_decode_duration);
+      _decoded_bytes.increment (size);
+
+      boost::iostreams::stream<boost::iostreams::array_source> stream
+        (data, size);
+      boost::archive::text_iarchive ar (stream);
       initialize_archive (ar);
       SDPAEvent* e (nullptr);
       ar >> e;
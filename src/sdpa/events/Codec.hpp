@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <fhgcom/buffer.hpp>
+
+#include <metrics/registry.hpp>
+
+#include <cstddef>
 #include <string>
 
 namespace sdpa
@@ -27,11 +32,25 @@ namespace sdpa
     class Codec
     {
     public:
+      //! \a metric_labels are added to the labels of the metrics of
+      //! the codec, e.g. the agent
+      Codec (fhg::metrics::labels const& metric_labels = {});
+
       template<typename Event, typename... Args>
         std::string encode (Args&&... args) const;
 
       std::string encode (sdpa::events::SDPAEvent const* e) const;
       sdpa::events::SDPAEvent* decode (std::string const& s) const;
+
+      //! \note Serializes straight into the given buffer, appending.
+      void encode (sdpa::events::SDPAEvent const* e, fhg::com::buffer&) const;
+      sdpa::events::SDPAEvent* decode (char const* data, std::size_t size) const;
+
+    private:
+      fhg::metrics::histogram& _encode_duration;
+      fhg::metrics::histogram& _decode_duration;
+      fhg::metrics::counter& _encoded_bytes;
+      fhg::metrics::counter& _decoded_bytes;
     };
   }
 }
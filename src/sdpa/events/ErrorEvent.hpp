@@ -41,11 +41,15 @@ namespace sdpa
         , const std::string& a_reason
         //! \todo This should not be in _every_ ErrorEvent!
         , const boost::optional<sdpa::job_id_t>& jobId = boost::none
+        //! \note the id of the client request that failed if it is
+        //! correlated by an id of its own, e.g. a put_token_id
+        , const boost::optional<std::string>& request_id = boost::none
         )
           : MgmtEvent()
           , error_code_ (a_error_code)
           , reason_ (a_reason)
           , job_id_ (jobId)
+          , request_id_ (request_id)
       {}
 
       const std::string&reason() const
@@ -60,6 +64,10 @@ namespace sdpa
       {
         return job_id_;
       }
+      const boost::optional<std::string>& request_id() const
+      {
+        return request_id_;
+      }
 
       virtual void handleBy
         (fhg::com::p2p::address_t const& source, EventHandler* handler) override
@@ -71,6 +79,7 @@ namespace sdpa
       error_code_t error_code_;
       std::string reason_;
       boost::optional<sdpa::job_id_t> job_id_;
+      boost::optional<std::string> request_id_;
     };
 
     SAVE_CONSTRUCT_DATA_DEF (ErrorEvent, e)
@@ -79,6 +88,7 @@ namespace sdpa
       SAVE_TO_ARCHIVE (e->error_code());
       SAVE_TO_ARCHIVE (e->reason());
       SAVE_TO_ARCHIVE (e->job_id());
+      SAVE_TO_ARCHIVE (e->request_id());
     }
 
     LOAD_CONSTRUCT_DATA_DEF (ErrorEvent, e)
@@ -87,8 +97,9 @@ namespace sdpa
       LOAD_FROM_ARCHIVE (ErrorEvent::error_code_t, error_code);
       LOAD_FROM_ARCHIVE (std::string, reason);
       LOAD_FROM_ARCHIVE (boost::optional<sdpa::job_id_t>, job_id);
+      LOAD_FROM_ARCHIVE (boost::optional<std::string>, request_id);
 
-      ::new (e) ErrorEvent (error_code, reason, job_id);
+      ::new (e) ErrorEvent (error_code, reason, job_id, request_id);
     }
   }
 }
@@ -47,6 +47,8 @@ namespace sdpa
     class SubscribeAckEvent;
     class put_token;
     class put_token_response;
+    class set_scheduling_parameters;
+    class set_scheduling_parameters_response;
     class BacklogNoLongerFullEvent;
     class workflow_response;
     class workflow_response_response;
@@ -100,6 +102,10 @@ namespace sdpa
       { throw std::runtime_error ("UNHANDLED EVENT: put_token"); }
       virtual void handle_put_token_response (fhg::com::p2p::address_t const&, const put_token_response*)
       { throw std::runtime_error ("UNHANDLED EVENT: put_token_response"); }
+      virtual void handle_set_scheduling_parameters (fhg::com::p2p::address_t const&, const set_scheduling_parameters*)
+      { throw std::runtime_error ("UNHANDLED EVENT: set_scheduling_parameters"); }
+      virtual void handle_set_scheduling_parameters_response (fhg::com::p2p::address_t const&, const set_scheduling_parameters_response*)
+      { throw std::runtime_error ("UNHANDLED EVENT: set_scheduling_parameters_response"); }
       virtual void handleBacklogNoLongerFullEvent (fhg::com::p2p::address_t const&, const BacklogNoLongerFullEvent*)
          { throw std::runtime_error ("UNHANDLED EVENT: BacklogNoLongerFullEvent"); }
       virtual void handle_workflow_response (fhg::com::p2p::address_t const&, const workflow_response*)
@@ -18,6 +18,7 @@
 
 #include <sdpa/events/SDPAEvent.hpp>
 #include <sdpa/events/EventHandler.hpp>
+#include <sdpa/scheduling_parameters.hpp>
 #include <sdpa/types.hpp>
 
 #include <we/type/activity.hpp>
@@ -37,12 +38,15 @@ namespace sdpa
         , we::type::activity_t activity
         , boost::optional<std::string> const& implementation
         , std::set<worker_id_t> const& workers = {}
+        , boost::optional<sdpa::scheduling_parameters> const&
+            scheduling_parameters = boost::none
         )
           : SDPAEvent()
           , _job_id (a_job_id)
           , _activity (std::move (activity))
           , _implementation (implementation)
           , _workers (workers)
+          , _scheduling_parameters (scheduling_parameters)
       {}
 
       const boost::optional<sdpa::job_id_t>& job_id() const
@@ -61,6 +65,13 @@ namespace sdpa
       {
         return _workers;
       }
+      //! \note none: the default parameters or, for children, the
+      //! ones of the top level job
+      boost::optional<sdpa::scheduling_parameters> const&
+        scheduling_parameters() const
+      {
+        return _scheduling_parameters;
+      }
 
       virtual void handleBy
         (fhg::com::p2p::address_t const& source, EventHandler* handler) override
@@ -73,6 +84,7 @@ namespace sdpa
       we::type::activity_t _activity;
       boost::optional<std::string> _implementation;
       std::set<worker_id_t> _workers;
+      boost::optional<sdpa::scheduling_parameters> _scheduling_parameters;
     };
 
     SAVE_CONSTRUCT_DATA_DEF (SubmitJobEvent, e)
@@ -82,6 +94,7 @@ namespace sdpa
       SAVE_TO_ARCHIVE (e->activity());
       SAVE_TO_ARCHIVE (e->implementation());
       SAVE_TO_ARCHIVE (e->workers());
+      SAVE_TO_ARCHIVE (e->scheduling_parameters());
     }
 
     LOAD_CONSTRUCT_DATA_DEF (SubmitJobEvent, e)
@@ -91,8 +104,16 @@ namespace sdpa
       LOAD_FROM_ARCHIVE (we::type::activity_t, activity);
       LOAD_FROM_ARCHIVE (boost::optional<std::string>, implementation);
       LOAD_FROM_ARCHIVE (std::set<sdpa::worker_id_t>, workers);
+      LOAD_FROM_ARCHIVE
+        (boost::optional<sdpa::scheduling_parameters>, scheduling_parameters);
 
-      ::new (e) SubmitJobEvent (job_id, std::move (activity), implementation, workers);
+      ::new (e) SubmitJobEvent
+        ( job_id
+        , std::move (activity)
+        , implementation
+        , workers
+        , scheduling_parameters
+        );
     }
   }
 }
@@ -36,6 +36,7 @@ namespace sdpa
         , const unsigned long allocated_shared_memory_size
         , bool children_allowed
         , const std::string& hostname
+        , const unsigned long global_memory_cache_size
         )
           : MgmtEvent()
           , _name (name)
@@ -43,6 +44,7 @@ namespace sdpa
           , allocated_shared_memory_size_ (allocated_shared_memory_size)
           , children_allowed_(children_allowed)
           , hostname_(hostname)
+          , global_memory_cache_size_ (global_memory_cache_size)
       {}
 
       std::string const& name() const
@@ -69,6 +71,12 @@ namespace sdpa
         return allocated_shared_memory_size_;
       }
 
+      //! \note 0 if the worker does not cache global memory
+      const unsigned long& global_memory_cache_size() const
+      {
+        return global_memory_cache_size_;
+      }
+
       virtual void handleBy
         (fhg::com::p2p::address_t const& source, EventHandler* handler) override
       {
@@ -81,6 +89,7 @@ namespace sdpa
       unsigned long allocated_shared_memory_size_;
       bool children_allowed_;
       std::string hostname_;
+      unsigned long global_memory_cache_size_;
     };
 
     SAVE_CONSTRUCT_DATA_DEF (WorkerRegistrationEvent, e)
@@ -91,6 +100,7 @@ namespace sdpa
       SAVE_TO_ARCHIVE (e->allocated_shared_memory_size());
       SAVE_TO_ARCHIVE (e->children_allowed());
       SAVE_TO_ARCHIVE (e->hostname());
+      SAVE_TO_ARCHIVE (e->global_memory_cache_size());
     }
 
     LOAD_CONSTRUCT_DATA_DEF (WorkerRegistrationEvent, e)
@@ -101,12 +111,14 @@ namespace sdpa
       LOAD_FROM_ARCHIVE (unsigned long, allocated_shared_memory_size);
       LOAD_FROM_ARCHIVE (bool, children_allowed);
       LOAD_FROM_ARCHIVE (std::string, hostname);
+      LOAD_FROM_ARCHIVE (unsigned long, global_memory_cache_size);
 
       ::new (e) WorkerRegistrationEvent ( name
                                         , cpbset
                                         , allocated_shared_memory_size
                                         , children_allowed
                                         , hostname
+                                        , global_memory_cache_size
                                         );
     }
   }
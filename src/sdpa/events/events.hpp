@@ -38,4 +38,5 @@
 #include <sdpa/events/SubscribeEvent.hpp>
 #include <sdpa/events/SubscribeAckEvent.hpp>
 #include <sdpa/events/put_token.hpp>
+#include <sdpa/events/set_scheduling_parameters.hpp>
 #include <sdpa/events/BacklogNoLongerFullEvent.hpp>
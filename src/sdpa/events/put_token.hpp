@@ -25,8 +25,10 @@
 #include <util-generic/serialization/exception.hpp>
 
 #include <boost/optional.hpp>
+#include <boost/serialization/list.hpp>
 
 #include <exception>
+#include <list>
 #include <string>
 
 namespace sdpa
@@ -39,12 +41,12 @@ namespace sdpa
       put_token ( job_id_t job_id
                 , std::string put_token_id
                 , std::string place_name
-                , pnet::type::value::value_type value
+                , std::list<pnet::type::value::value_type> values
                 )
         : JobEvent (job_id)
         , _put_token_id (put_token_id)
         , _place_name (place_name)
-        , _value (value)
+        , _values (std::move (values))
       {}
 
       std::string const& put_token_id() const
@@ -55,9 +57,9 @@ namespace sdpa
       {
         return _place_name;
       }
-      pnet::type::value::value_type const& value() const
+      std::list<pnet::type::value::value_type> const& values() const
       {
-        return _value;
+        return _values;
       }
 
       virtual void handleBy
@@ -69,7 +71,7 @@ namespace sdpa
     private:
       std::string _put_token_id;
       std::string _place_name;
-      pnet::type::value::value_type _value;
+      std::list<pnet::type::value::value_type> _values;
     };
 
     SAVE_CONSTRUCT_DATA_DEF (put_token, e)
@@ -77,7 +79,7 @@ namespace sdpa
       SAVE_JOBEVENT_CONSTRUCT_DATA (e);
       SAVE_TO_ARCHIVE (e->put_token_id());
       SAVE_TO_ARCHIVE (e->place_name());
-      SAVE_TO_ARCHIVE (e->value());
+      SAVE_TO_ARCHIVE (e->values());
     }
 
     LOAD_CONSTRUCT_DATA_DEF (put_token, e)
@@ -85,12 +87,12 @@ namespace sdpa
       LOAD_JOBEVENT_CONSTRUCT_DATA (job_id);
       LOAD_FROM_ARCHIVE (std::string, put_token_id);
       LOAD_FROM_ARCHIVE (std::string, place_name);
-      LOAD_FROM_ARCHIVE (pnet::type::value::value_type, value);
+      LOAD_FROM_ARCHIVE (std::list<pnet::type::value::value_type>, values);
 
       ::new (e) put_token ( job_id
                           , put_token_id
                           , place_name
-                          , value
+                          , values
                           );
     }
 
@@ -0,0 +1,157 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <sdpa/events/JobEvent.hpp>
+#include <sdpa/events/MgmtEvent.hpp>
+#include <sdpa/events/Serialization.hpp>
+#include <sdpa/scheduling_parameters.hpp>
+
+#include <util-generic/serialization/exception.hpp>
+
+#include <boost/optional.hpp>
+
+#include <exception>
+#include <string>
+
+namespace sdpa
+{
+  namespace events
+  {
+    class set_scheduling_parameters : public JobEvent
+    {
+    public:
+      set_scheduling_parameters ( job_id_t job_id
+                                , std::string request_id
+                                , scheduling_parameters parameters
+                                )
+        : JobEvent (job_id)
+        , _request_id (request_id)
+        , _parameters (parameters)
+      {}
+
+      std::string const& request_id() const
+      {
+        return _request_id;
+      }
+      scheduling_parameters const& parameters() const
+      {
+        return _parameters;
+      }
+
+      virtual void handleBy
+        (fhg::com::p2p::address_t const& source, EventHandler* handler) override
+      {
+        handler->handle_set_scheduling_parameters (source, this);
+      }
+
+    private:
+      std::string _request_id;
+      scheduling_parameters _parameters;
+    };
+
+    SAVE_CONSTRUCT_DATA_DEF (set_scheduling_parameters, e)
+    {
+      SAVE_JOBEVENT_CONSTRUCT_DATA (e);
+      SAVE_TO_ARCHIVE (e->request_id());
+      SAVE_TO_ARCHIVE (e->parameters());
+    }
+
+    LOAD_CONSTRUCT_DATA_DEF (set_scheduling_parameters, e)
+    {
+      LOAD_JOBEVENT_CONSTRUCT_DATA (job_id);
+      LOAD_FROM_ARCHIVE (std::string, request_id);
+      LOAD_FROM_ARCHIVE (scheduling_parameters, parameters);
+
+      ::new (e) set_scheduling_parameters (job_id, request_id, parameters);
+    }
+
+    class set_scheduling_parameters_response : public MgmtEvent
+    {
+    public:
+      set_scheduling_parameters_response
+          ( std::string request_id
+          , boost::optional<std::exception_ptr> error
+          )
+        : MgmtEvent()
+        , _request_id (request_id)
+        , _error (std::move (error))
+      {}
+
+      std::string const& request_id() const
+      {
+        return _request_id;
+      }
+
+      void get() const
+      {
+        if (_error)
+        {
+          std::rethrow_exception (*_error);
+        }
+      }
+
+      virtual void handleBy
+        (fhg::com::p2p::address_t const& source, EventHandler* handler) override
+      {
+        handler->handle_set_scheduling_parameters_response (source, this);
+      }
+
+      //! \note for serialization only
+      boost::optional<std::exception_ptr> const& exception() const
+      {
+        return _error;
+      }
+
+    private:
+      std::string _request_id;
+      boost::optional<std::exception_ptr> _error;
+    };
+
+    SAVE_CONSTRUCT_DATA_DEF (set_scheduling_parameters_response, e)
+    {
+      SAVE_MGMTEVENT_CONSTRUCT_DATA (e);
+      SAVE_TO_ARCHIVE (e->request_id());
+
+      boost::optional<std::string> exception (boost::none);
+      if (!!e->exception())
+      {
+        exception = fhg::util::serialization::exception::serialize
+          (e->exception().get());
+      }
+      SAVE_TO_ARCHIVE (exception);
+    }
+
+    LOAD_CONSTRUCT_DATA_DEF (set_scheduling_parameters_response, e)
+    {
+      LOAD_MGMTEVENT_CONSTRUCT_DATA();
+      LOAD_FROM_ARCHIVE (std::string, request_id);
+      LOAD_FROM_ARCHIVE (boost::optional<std::string>, exception);
+      if (!exception)
+      {
+        ::new (e) set_scheduling_parameters_response (request_id, boost::none);
+      }
+      else
+      {
+        ::new (e) set_scheduling_parameters_response
+          ( request_id
+          , fhg::util::serialization::exception::deserialize (exception.get())
+          );
+      }
+    }
+  }
+}
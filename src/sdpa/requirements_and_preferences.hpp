@@ -16,13 +16,17 @@
 
 #pragma once
 
+#include <we/type/range.hpp>
 #include <we/type/requirement.hpp>
 #include <we/type/schedule_data.hpp>
 #include <we/type/transition.hpp>
 
+#include <boost/optional.hpp>
+
 #include <functional>
 #include <iterator>
 #include <list>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
@@ -33,6 +37,19 @@ const std::function<double (std::string const&)>
 
 using Preferences = std::list<we::type::preference_t>;
 
+//! computational cost on a worker with the given capabilities using
+//! the given implementation, none if unknown
+using computational_cost_estimate = std::function
+  < boost::optional<double> ( std::set<std::string> const&
+                            , boost::optional<std::string> const&
+                            )
+  >;
+
+//! fraction of the global memory to transfer that the given worker
+//! already holds, in [0, 1]
+using cached_global_memory_estimate
+  = std::function<double (std::string const& worker)>;
+
 class Requirements_and_preferences
 {
 public:
@@ -45,12 +62,14 @@ public:
       , double estimated_computational_cost
       , unsigned long shared_memory_amount_required
       , Preferences preferences
+      , std::list<we::global::range> global_memory_gets = {}
       )
     : _requirements (requirements)
     , _scheduleData (schedule_data)
     , _transfer_cost (transfer_cost)
     , _estimated_computational_cost (estimated_computational_cost)
     , _shared_memory_amount_required (shared_memory_amount_required)
+    , _global_memory_gets (std::move (global_memory_gets))
   {
     if ( std::unordered_set<std::string>
            (std::begin (preferences), std::end (preferences)).size()
@@ -66,14 +85,64 @@ public:
   unsigned long numWorkers() const {return _scheduleData.num_worker().get_value_or(1);}
   const std::list<we::type::requirement_t>& requirements() const {return _requirements;}
   const std::function<double (std::string const&)> transfer_cost() const {return _transfer_cost;}
+  double transfer_cost
+    (std::string const& worker, std::string const& hostname) const
+  {
+    double const cost (_transfer_cost (hostname));
+
+    return _cached_global_memory_estimate
+      ? cost * (1.0 - _cached_global_memory_estimate (worker))
+      : cost;
+  }
+  //! \note scales the transfer cost down by the part of the global
+  //! memory that is expected to be cached on the worker
+  void discount_transfer_cost_by (cached_global_memory_estimate estimate)
+  {
+    _cached_global_memory_estimate = std::move (estimate);
+  }
+  std::list<we::global::range> const& global_memory_gets() const
+  {
+    return _global_memory_gets;
+  }
   double computational_cost() const {return _estimated_computational_cost;}
+  double computational_cost
+    ( std::set<std::string> const& worker_capabilities
+    , boost::optional<std::string> const& implementation
+    ) const
+  {
+    boost::optional<double> const estimate
+      ( _computational_cost_estimate
+      ? _computational_cost_estimate (worker_capabilities, implementation)
+      : boost::none
+      );
+
+    return estimate.get_value_or (_estimated_computational_cost);
+  }
+  //! \note the static estimate is used where the given one returns none
+  void estimate_computational_cost_by (computational_cost_estimate estimate)
+  {
+    _computational_cost_estimate = std::move (estimate);
+  }
   unsigned long shared_memory_amount_required() const {return _shared_memory_amount_required;}
   Preferences preferences() const { return _preferences; }
+  //! \note e.g. the workers already running another copy of the job
+  void exclude_workers (std::unordered_set<std::string> workers)
+  {
+    _excluded_workers = std::move (workers);
+  }
+  bool excludes (std::string const& worker) const
+  {
+    return _excluded_workers.count (worker);
+  }
 private:
   std::list<we::type::requirement_t> _requirements;
   we::type::schedule_data _scheduleData;
   std::function<double (std::string const&)> _transfer_cost;
+  cached_global_memory_estimate _cached_global_memory_estimate;
   double _estimated_computational_cost;
+  computational_cost_estimate _computational_cost_estimate;
   unsigned long _shared_memory_amount_required;
   Preferences _preferences;
+  std::list<we::global::range> _global_memory_gets;
+  std::unordered_set<std::string> _excluded_workers;
 };
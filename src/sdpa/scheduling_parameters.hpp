@@ -0,0 +1,49 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdexcept>
+
+namespace sdpa
+{
+  //! How the jobs of a top level job compete with those of other top
+  //! level jobs: jobs of a higher priority are started first, jobs of
+  //! equal priority share the workers in proportion to their weight.
+  struct scheduling_parameters
+  {
+    scheduling_parameters (int priority_ = 0, double weight_ = 1.0)
+      : priority (priority_)
+      , weight (weight_)
+    {
+      if (!(weight > 0.0))
+      {
+        throw std::invalid_argument
+          ("scheduling_parameters: weight has to be positive");
+      }
+    }
+
+    int priority;
+    double weight;
+
+    template<typename Archive>
+      void serialize (Archive& ar, unsigned int)
+    {
+      ar & priority;
+      ar & weight;
+    }
+  };
+}
@@ -0,0 +1,155 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include <sdpa/daemon/NotificationEvent.hpp>
+
+#include <we/type/activity.hpp>
+#include <we/type/transition.hpp>
+
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/printer/list.hpp>
+#include <util-generic/testing/random.hpp>
+#include <util-generic/testing/require_exception.hpp>
+
+#include <list>
+#include <string>
+
+namespace
+{
+  we::type::activity_t activity_with_name (std::string const& name)
+  {
+    return we::type::activity_t
+      ( we::type::transition_t ( name
+                               , we::type::expression_t()
+                               , boost::none
+                               , we::type::property::type()
+                               , we::priority_type()
+                               )
+      );
+  }
+
+  sdpa::daemon::NotificationEvent::state_t random_state()
+  {
+    return static_cast<sdpa::daemon::NotificationEvent::state_t>
+      ( fhg::util::testing::random<int>{}
+          (sdpa::daemon::NotificationEvent::STATE_MAX, 0)
+      );
+  }
+}
+
+BOOST_AUTO_TEST_CASE (encoded_notification_event_can_be_decoded)
+{
+  fhg::util::testing::random<std::string> random_string;
+
+  std::list<std::string> const components
+    {random_string(), random_string(), random_string()};
+  std::string const activity_id (random_string());
+  std::string const activity_name (random_string());
+  auto const state (random_state());
+
+  sdpa::daemon::NotificationEvent const event
+    (components, activity_id, state, activity_with_name (activity_name));
+
+  std::string const encoded (event.encoded());
+  sdpa::daemon::NotificationEvent const decoded (encoded);
+
+  BOOST_REQUIRE_EQUAL (decoded.components(), components);
+  BOOST_REQUIRE_EQUAL (decoded.activity_id(), activity_id);
+  BOOST_REQUIRE_EQUAL (decoded.activity_name(), activity_name);
+  BOOST_REQUIRE_EQUAL (decoded.activity_state(), state);
+  BOOST_REQUIRE_EQUAL (decoded.activity_name_id(), event.activity_name_id());
+  BOOST_REQUIRE_EQUAL
+    ( sdpa::daemon::NotificationEvent::activity_name_id (encoded)
+    , event.activity_name_id()
+    );
+}
+
+BOOST_AUTO_TEST_CASE (activity_name_id_only_depends_on_name)
+{
+  fhg::util::testing::random<std::string> random_string;
+
+  std::string const activity_name (random_string());
+
+  sdpa::daemon::NotificationEvent const a
+    ( {random_string()}, random_string(), random_state()
+    , activity_with_name (activity_name)
+    );
+  sdpa::daemon::NotificationEvent const b
+    ( {random_string()}, random_string(), random_state()
+    , activity_with_name (activity_name)
+    );
+
+  BOOST_REQUIRE_EQUAL (a.activity_name_id(), b.activity_name_id());
+  BOOST_REQUIRE_EQUAL
+    ( a.activity_name_id()
+    , sdpa::daemon::NotificationEvent::intern (activity_name)
+    );
+}
+
+BOOST_AUTO_TEST_CASE (decoding_an_unknown_version_throws)
+{
+  std::string encoded
+    ( sdpa::daemon::NotificationEvent
+        ( {"worker"}, "id", sdpa::daemon::NotificationEvent::STATE_STARTED
+        , activity_with_name ("name")
+        ).encoded()
+    );
+  encoded[3] = static_cast<char>
+    (sdpa::daemon::NotificationEvent::encoding_version + 1);
+
+  fhg::util::testing::require_exception
+    ( [&] { sdpa::daemon::NotificationEvent const event (encoded); }
+    , std::runtime_error
+        ( "NotificationEvent: unsupported encoding version "
+        + std::to_string (sdpa::daemon::NotificationEvent::encoding_version + 1)
+        + ", expected "
+        + std::to_string (sdpa::daemon::NotificationEvent::encoding_version)
+        )
+    );
+}
+
+BOOST_AUTO_TEST_CASE (decoding_a_text_archive_throws)
+{
+  fhg::util::testing::require_exception
+    ( []
+      {
+        sdpa::daemon::NotificationEvent const event
+          ("22 serialization::archive 17 0 0 1 0 6 worker");
+      }
+    , std::runtime_error ("NotificationEvent: not a binary notification event")
+    );
+}
+
+BOOST_AUTO_TEST_CASE (decoding_a_truncated_event_throws)
+{
+  std::string const encoded
+    ( sdpa::daemon::NotificationEvent
+        ( {"worker"}, "id", sdpa::daemon::NotificationEvent::STATE_STARTED
+        , activity_with_name ("name")
+        ).encoded()
+    );
+
+  fhg::util::testing::require_exception
+    ( [&]
+      {
+        sdpa::daemon::NotificationEvent const event
+          (encoded.substr (0, encoded.size() - 1));
+      }
+    , std::runtime_error ("NotificationEvent: truncated event")
+    );
+}
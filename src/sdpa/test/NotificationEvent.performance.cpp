@@ -0,0 +1,118 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include <sdpa/daemon/NotificationEvent.hpp>
+
+#include <we/type/activity.hpp>
+#include <we/type/transition.hpp>
+
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/measure_average_time.hpp>
+#include <util-generic/testing/printer/chrono.hpp>
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/serialization/list.hpp>
+#include <boost/serialization/string.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+
+namespace
+{
+  //! \note the encoding used before the binary one, as reference
+  std::string text_archive_round_trip
+    (sdpa::daemon::NotificationEvent const& event)
+  {
+    std::ostringstream ostream;
+    {
+      boost::archive::text_oarchive archive (ostream);
+      auto components (event.components());
+      auto activity_id (event.activity_id());
+      auto activity_name (event.activity_name());
+      auto activity_state (event.activity_state());
+      archive & components;
+      archive & activity_id;
+      archive & activity_name;
+      archive & activity_state;
+    }
+
+    std::istringstream istream (ostream.str());
+    boost::archive::text_iarchive archive (istream);
+    std::list<std::string> components;
+    std::string activity_id;
+    std::string activity_name;
+    sdpa::daemon::NotificationEvent::state_t activity_state;
+    archive & components;
+    archive & activity_id;
+    archive & activity_name;
+    archive & activity_state;
+
+    return activity_name;
+  }
+}
+
+BOOST_AUTO_TEST_CASE (binary_encoding_round_trip_is_faster_than_text_archive)
+{
+  we::type::activity_t const activity
+    ( we::type::transition_t ( "some_module_call_transition"
+                             , we::type::expression_t()
+                             , boost::none
+                             , we::type::property::type()
+                             , we::priority_type()
+                             )
+    );
+  sdpa::daemon::NotificationEvent const event
+    ( {"calc-ip-127-0-0-1 12345 50501-1"}
+    , "job-1234567890-abcdef"
+    , sdpa::daemon::NotificationEvent::STATE_FINISHED
+    , activity
+    );
+
+  std::size_t const count (100000);
+
+  auto const binary
+    ( fhg::util::testing::measure_average_time<std::chrono::nanoseconds>
+        ( [&]
+          {
+            sdpa::daemon::NotificationEvent const decoded (event.encoded());
+            BOOST_REQUIRE_EQUAL
+              (decoded.activity_name(), event.activity_name());
+          }
+        , count
+        )
+    );
+  auto const text
+    ( fhg::util::testing::measure_average_time<std::chrono::nanoseconds>
+        ( [&]
+          {
+            BOOST_REQUIRE_EQUAL
+              (text_archive_round_trip (event), event.activity_name());
+          }
+        , count
+        )
+    );
+
+  std::cout << "binary round trip: " << binary.count() << " ns\n"
+            << "text archive round trip: " << text.count() << " ns\n";
+
+  BOOST_REQUIRE_LT (binary, text);
+}
@@ -17,6 +17,8 @@
 #include <boost/test/unit_test.hpp>
 
 #include <sdpa/com/NetworkStrategy.hpp>
+#include <sdpa/com/batching.hpp>
+#include <sdpa/events/CancelJobEvent.hpp>
 #include <sdpa/events/ErrorEvent.hpp>
 
 #include <test/certificates_data.hpp>
@@ -25,15 +27,21 @@
 #include <util-generic/cxx14/make_unique.hpp>
 #include <util-generic/testing/flatten_nested_exceptions.hpp>
 #include <util-generic/testing/printer/optional.hpp>
+#include <util-generic/testing/printer/vector.hpp>
+#include <util-generic/testing/require_exception.hpp>
 
 #include <boost/asio/io_service.hpp>
 #include <boost/test/data/monomorphic.hpp>
 #include <boost/test/data/test_case.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <iostream>
 #include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -105,3 +113,131 @@ BOOST_DATA_TEST_CASE (test_strategy, certificates_data, certificates)
 
   counter.wait();
 }
+
+namespace
+{
+  std::vector<std::string> events_in (fhg::com::buffer const& message)
+  {
+    std::vector<std::string> events;
+    sdpa::com::batch::for_each_event
+      ( message.data(), message.size()
+      , [&] (char const* data, std::size_t size)
+        {
+          events.emplace_back (data, data + size);
+        }
+      );
+    return events;
+  }
+
+  void append (fhg::com::buffer& batch, std::string const& event)
+  {
+    sdpa::com::batch::append
+      ( batch
+      , [&] (fhg::com::buffer& buffer)
+        {
+          buffer.append (event.data(), event.size());
+        }
+      );
+  }
+}
+
+BOOST_AUTO_TEST_CASE (batch_yields_appended_events_in_order)
+{
+  std::vector<std::string> const events {"first", "", "third"};
+
+  fhg::com::buffer batch;
+  sdpa::com::batch::start (batch);
+  for (auto const& event : events)
+  {
+    append (batch, event);
+  }
+
+  BOOST_REQUIRE_EQUAL (events_in (batch), events);
+}
+
+BOOST_AUTO_TEST_CASE (message_that_is_no_batch_is_a_single_event)
+{
+  std::string const event ("serialized event");
+
+  fhg::com::buffer message;
+  message.append (event.data(), event.size());
+
+  BOOST_REQUIRE_EQUAL (events_in (message), std::vector<std::string> {event});
+}
+
+BOOST_AUTO_TEST_CASE (truncated_batch_throws)
+{
+  fhg::com::buffer batch;
+  sdpa::com::batch::start (batch);
+  append (batch, "event");
+  batch.resize (batch.size() - 1);
+
+  fhg::util::testing::require_exception
+    ( [&] { events_in (batch); }
+    , std::runtime_error ("truncated event batch: missing event")
+    );
+}
+
+BOOST_DATA_TEST_CASE
+  (batched_events_arrive_in_order, certificates_data, certificates)
+{
+  std::size_t const count (1000);
+
+  std::mutex received_guard;
+  std::condition_variable received_all;
+  std::vector<sdpa::job_id_t> received;
+
+  sdpa::com::NetworkStrategy receiver
+    ( [&] ( fhg::com::p2p::address_t const&
+          , boost::shared_ptr<sdpa::events::SDPAEvent> const& event
+          )
+      {
+        std::lock_guard<std::mutex> const lock (received_guard);
+        received.emplace_back
+          ( dynamic_cast<sdpa::events::CancelJobEvent const&> (*event)
+          . job_id()
+          );
+        received_all.notify_all();
+      }
+    , fhg::util::cxx14::make_unique<boost::asio::io_service>()
+    , fhg::com::host_t ("localhost")
+    , fhg::com::port_t ("0")
+    , certificates
+    );
+
+  sdpa::com::NetworkStrategy sender
+    ( [] ( fhg::com::p2p::address_t const&
+         , boost::shared_ptr<sdpa::events::SDPAEvent> const&
+         )
+      {
+        throw std::logic_error ("sender shall not receive events");
+      }
+    , fhg::util::cxx14::make_unique<boost::asio::io_service>()
+    , fhg::com::host_t ("localhost")
+    , fhg::com::port_t ("0")
+    , certificates
+    , 1
+    , sdpa::com::batching {std::chrono::milliseconds (1), 1 << 10}
+    );
+
+  auto const address
+    ( sender.connect_to
+        ( fhg::com::host_t ( fhg::util::connectable_to_address_string
+                               (receiver.local_endpoint().address())
+                           )
+        , fhg::com::port_t (std::to_string (receiver.local_endpoint().port()))
+        )
+    );
+
+  std::vector<sdpa::job_id_t> sent;
+  for (std::size_t i (0); i < count; ++i)
+  {
+    sent.emplace_back (std::to_string (i));
+    sender.perform<sdpa::events::CancelJobEvent> (address, sent.back());
+  }
+
+  std::unique_lock<std::mutex> lock (received_guard);
+  received_all.wait (lock, [&] { return received.size() >= count; });
+
+  BOOST_REQUIRE_EQUAL (received, sent);
+}
@@ -151,6 +151,22 @@ struct fixture_scheduler_and_requirements_and_preferences
                   , std::placeholders::_1
                   )
       , _worker_manager
+      , [this] (sdpa::job_id_t const& job)
+        {
+          auto const top_level_job (_top_level_jobs.find (job));
+          return top_level_job == _top_level_jobs.end() ? job
+            : top_level_job->second;
+        }
+      , [this] ( sdpa::job_id_t const& job
+               , sdpa::daemon::Implementation const&
+               , sdpa::daemon::WorkerSet const&
+               )
+        {
+          auto const expected_runtime (_expected_runtimes.find (job));
+          return expected_runtime == _expected_runtimes.end()
+            ? sdpa::daemon::CoallocationScheduler::runtime_quantum
+            : expected_runtime->second;
+        }
       )
     , _access_allocation_table (_scheduler)
   {}
@@ -195,6 +211,53 @@ struct fixture_scheduler_and_requirements_and_preferences
 
   std::map<sdpa::job_id_t, Requirements_and_preferences> _requirements_and_preferences;
 
+  std::map<sdpa::job_id_t, double> _expected_runtimes;
+  sdpa::job_id_t add_and_enqueue_job_with_runtime
+    (Requirements_and_preferences reqs_and_prefs, double expected_runtime)
+  {
+    auto const job_id (job_ids());
+    _expected_runtimes.emplace (job_id, expected_runtime);
+    _requirements_and_preferences.emplace (job_id, std::move (reqs_and_prefs));
+    _scheduler.enqueueJob (job_id);
+    return job_id;
+  }
+
+  std::map<sdpa::job_id_t, sdpa::job_id_t> _top_level_jobs;
+  sdpa::job_id_t add_and_enqueue_child_job
+    ( sdpa::job_id_t const& top_level_job
+    , Requirements_and_preferences reqs_and_prefs
+    )
+  {
+    auto const job_id (job_ids());
+    _top_level_jobs.emplace (job_id, top_level_job);
+    _requirements_and_preferences.emplace (job_id, std::move (reqs_and_prefs));
+    _scheduler.enqueueJob (job_id);
+    return job_id;
+  }
+
+  //! \note one job at a time on a single worker: \returns the number
+  //! of jobs started before the given one
+  std::size_t run_jobs_one_by_one_until_started (sdpa::job_id_t const& job)
+  {
+    std::size_t started_before (0);
+
+    for (;;)
+    {
+      _scheduler.assignJobsToWorkers();
+
+      auto const started (_scheduler.start_pending_jobs (serve_job));
+      BOOST_REQUIRE_EQUAL (started.size(), 1);
+
+      if (started.count (job))
+      {
+        return started_before;
+      }
+
+      ++started_before;
+      _scheduler.releaseReservation (*started.begin());
+    }
+  }
+
   unsigned long count_assigned_jobs
     ( std::map<sdpa::job_id_t, std::set<sdpa::worker_id_t>> assignment
     , const sdpa::worker_id_t& worker_id
@@ -1400,6 +1463,323 @@ BOOST_FIXTURE_TEST_CASE ( assign_to_the_same_worker_if_the_total_cost_is_lower
   BOOST_REQUIRE_EQUAL (assignment.at (job_id_1), expected_assignment);
 }
 
+BOOST_FIXTURE_TEST_CASE ( assign_to_the_worker_caching_the_global_memory
+                        , fixture_scheduler_and_requirements_and_preferences
+                        )
+{
+  std::string const name_worker_0 {utils::random_peer_name()};
+  std::string const name_worker_1 {utils::random_peer_name()};
+  std::string const name_node_0 {utils::random_peer_name()};
+  std::string const name_node_1 {utils::random_peer_name()};
+
+  _worker_manager.addWorker ( name_worker_0
+                            , {}
+                            , 100
+                            , false
+                            , name_node_0
+                            , fhg::util::testing::random_string()
+                            );
+
+  _worker_manager.addWorker ( name_worker_1
+                            , {}
+                            , 100
+                            , false
+                            , name_node_1
+                            , fhg::util::testing::random_string()
+                            );
+
+  std::function<double (std::string const&)> const
+    test_transfer_cost ( [&name_node_0, &name_node_1](const std::string& host) -> double
+                         {
+                           if (host == name_node_0)
+                             return 10.0;
+                           if (host == name_node_1)
+                             return 100.0;
+                           throw std::runtime_error ("Unexpected host argument in test transfer cost function");
+                         }
+                       );
+
+  Requirements_and_preferences requirements_and_preferences
+    ({}, we::type::schedule_data(), test_transfer_cost, 1.0, 100, {});
+
+  requirements_and_preferences.discount_transfer_cost_by
+    ( [&name_worker_1] (std::string const& worker)
+      {
+        return worker == name_worker_1 ? 1.0 : 0.0;
+      }
+    );
+
+  auto const job_id (add_and_enqueue_job (requirements_and_preferences));
+
+  _scheduler.assignJobsToWorkers();
+  auto const assignment (get_current_assignment());
+
+  BOOST_REQUIRE (assignment.count (job_id));
+  BOOST_REQUIRE_EQUAL
+    (assignment.at (job_id), std::set<sdpa::worker_id_t> {name_worker_1});
+}
+
+BOOST_FIXTURE_TEST_CASE
+  ( excluded_workers_are_not_assigned_even_if_cheaper
+  , fixture_scheduler_and_requirements_and_preferences
+  )
+{
+  std::string const name_excluded {utils::random_peer_name()};
+  std::string const name_other {utils::random_peer_name()};
+
+  add_worker (_worker_manager, name_excluded);
+  add_worker (_worker_manager, name_other);
+
+  Requirements_and_preferences requirements_and_preferences
+    ( {}
+    , we::type::schedule_data()
+    , null_transfer_cost
+    , 1.0
+    , 0
+    , {}
+    );
+  requirements_and_preferences.discount_transfer_cost_by
+    ( [&name_excluded] (std::string const& worker)
+      {
+        return worker == name_excluded ? 1.0 : 0.0;
+      }
+    );
+  requirements_and_preferences.exclude_workers ({name_excluded});
+
+  auto const job_id (add_and_enqueue_job (requirements_and_preferences));
+
+  _scheduler.assignJobsToWorkers();
+  auto const assignment (get_current_assignment());
+
+  BOOST_REQUIRE (assignment.count (job_id));
+  BOOST_REQUIRE_EQUAL
+    (assignment.at (job_id), std::set<sdpa::worker_id_t> {name_other});
+}
+
+BOOST_FIXTURE_TEST_CASE
+  ( only_excluded_workers_leave_the_job_unassigned
+  , fixture_scheduler_and_requirements_and_preferences
+  )
+{
+  std::string const name_excluded {utils::random_peer_name()};
+
+  add_worker (_worker_manager, name_excluded);
+
+  auto requirements_and_preferences (no_requirements_and_preferences());
+  requirements_and_preferences.exclude_workers ({name_excluded});
+
+  auto const job_id (add_and_enqueue_job (requirements_and_preferences));
+
+  _scheduler.assignJobsToWorkers();
+
+  BOOST_REQUIRE (!get_current_assignment().count (job_id));
+}
+
+BOOST_FIXTURE_TEST_CASE
+  ( small_job_submitted_behind_a_large_one_does_not_wait_for_it
+  , fixture_scheduler_and_requirements_and_preferences
+  )
+{
+  add_worker (_worker_manager, "worker");
+
+  sdpa::job_id_t const large (job_ids());
+  for (std::size_t i (0); i < 1000; ++i)
+  {
+    add_and_enqueue_child_job (large, no_requirements_and_preferences());
+  }
+
+  _scheduler.assignJobsToWorkers();
+  auto const started_large (_scheduler.start_pending_jobs (serve_job));
+  BOOST_REQUIRE_EQUAL (started_large.size(), 1);
+  _scheduler.releaseReservation (*started_large.begin());
+
+  auto const small
+    (add_and_enqueue_child_job (job_ids(), no_requirements_and_preferences()));
+
+  auto const latency (run_jobs_one_by_one_until_started (small));
+
+  BOOST_TEST_MESSAGE
+    ("jobs started before the small one: " << latency);
+  BOOST_REQUIRE_LE (latency, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE
+  ( raising_the_priority_of_a_running_job_lets_its_jobs_go_first
+  , fixture_scheduler_and_requirements_and_preferences
+  )
+{
+  add_worker (_worker_manager, "worker");
+
+  sdpa::job_id_t const large (job_ids());
+  sdpa::job_id_t const small (job_ids());
+
+  for (std::size_t i (0); i < 100; ++i)
+  {
+    add_and_enqueue_child_job (large, no_requirements_and_preferences());
+  }
+
+  _scheduler.assignJobsToWorkers();
+  auto const started_large (_scheduler.start_pending_jobs (serve_job));
+  BOOST_REQUIRE_EQUAL (started_large.size(), 1);
+  _scheduler.releaseReservation (*started_large.begin());
+
+  for (std::size_t i (0); i < 10; ++i)
+  {
+    add_and_enqueue_child_job (small, no_requirements_and_preferences());
+  }
+
+  _scheduler.set_scheduling_parameters
+    (small, sdpa::scheduling_parameters (1));
+
+  for (std::size_t i (0); i < 10; ++i)
+  {
+    _scheduler.assignJobsToWorkers();
+
+    auto const started (_scheduler.start_pending_jobs (serve_job));
+    BOOST_REQUIRE_EQUAL (started.size(), 1);
+    BOOST_REQUIRE_EQUAL (_top_level_jobs.at (*started.begin()), small);
+    _scheduler.releaseReservation (*started.begin());
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE
+  ( top_level_jobs_share_the_workers_in_proportion_to_their_weight
+  , fixture_scheduler_and_requirements_and_preferences
+  )
+{
+  add_worker (_worker_manager, "worker");
+
+  sdpa::job_id_t const heavy (job_ids());
+  sdpa::job_id_t const light (job_ids());
+
+  _scheduler.set_scheduling_parameters
+    (heavy, sdpa::scheduling_parameters (0, 3.0));
+
+  for (std::size_t i (0); i < 100; ++i)
+  {
+    add_and_enqueue_child_job (heavy, no_requirements_and_preferences());
+    add_and_enqueue_child_job (light, no_requirements_and_preferences());
+  }
+
+  std::map<sdpa::job_id_t, std::size_t> started_per_top_level_job;
+
+  for (std::size_t i (0); i < 40; ++i)
+  {
+    _scheduler.assignJobsToWorkers();
+
+    auto const started (_scheduler.start_pending_jobs (serve_job));
+    BOOST_REQUIRE_EQUAL (started.size(), 1);
+
+    ++started_per_top_level_job[_top_level_jobs.at (*started.begin())];
+    _scheduler.releaseReservation (*started.begin());
+  }
+
+  BOOST_REQUIRE_EQUAL (started_per_top_level_job[heavy], 30u);
+  BOOST_REQUIRE_EQUAL (started_per_top_level_job[light], 10u);
+}
+
+namespace
+{
+  Requirements_and_preferences require_with_cost
+    (std::string capability, double cost)
+  {
+    return { {we::type::requirement_t (capability, true)}
+           , we::type::schedule_data()
+           , null_transfer_cost
+           , cost
+           , 0
+           , {}
+           };
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE
+  ( coallocated_job_is_not_starved_by_long_jobs_on_its_workers
+  , fixture_scheduler_and_requirements_and_preferences
+  )
+{
+  add_worker (_worker_manager, "worker_0", {sdpa::Capability ("A", "worker_0")});
+  add_worker (_worker_manager, "worker_1", {sdpa::Capability ("B", "worker_1")});
+
+  auto const running (add_and_enqueue_job_with_runtime (require ("A"), 100.0));
+  _scheduler.assignJobsToWorkers();
+  BOOST_REQUIRE_EQUAL ( _scheduler.start_pending_jobs (serve_job)
+                      , set_jobs_t ({running})
+                      );
+
+  auto const coallocated (add_and_enqueue_job (require (2)));
+  add_and_enqueue_job_with_runtime (require ("B"), 100.0);
+  _scheduler.assignJobsToWorkers();
+
+  BOOST_REQUIRE (_scheduler.start_pending_jobs (serve_job).empty());
+
+  _scheduler.releaseReservation (running);
+
+  BOOST_REQUIRE_EQUAL ( _scheduler.start_pending_jobs (serve_job)
+                      , set_jobs_t ({coallocated})
+                      );
+}
+
+BOOST_FIXTURE_TEST_CASE
+  ( short_jobs_are_backfilled_on_the_workers_of_a_waiting_coallocated_job
+  , fixture_scheduler_and_requirements_and_preferences
+  )
+{
+  add_worker (_worker_manager, "worker_0", {sdpa::Capability ("A", "worker_0")});
+  add_worker (_worker_manager, "worker_1", {sdpa::Capability ("B", "worker_1")});
+
+  auto const running (add_and_enqueue_job_with_runtime (require ("A"), 100.0));
+  _scheduler.assignJobsToWorkers();
+  BOOST_REQUIRE_EQUAL ( _scheduler.start_pending_jobs (serve_job)
+                      , set_jobs_t ({running})
+                      );
+
+  auto const coallocated (add_and_enqueue_job (require (2)));
+  auto const short_job
+    (add_and_enqueue_job_with_runtime (require ("B"), 1.0));
+  _scheduler.assignJobsToWorkers();
+
+  BOOST_REQUIRE_EQUAL ( _scheduler.start_pending_jobs (serve_job)
+                      , set_jobs_t ({short_job})
+                      );
+
+  _scheduler.releaseReservation (short_job);
+
+  BOOST_REQUIRE (_scheduler.start_pending_jobs (serve_job).empty());
+
+  _scheduler.releaseReservation (running);
+
+  BOOST_REQUIRE_EQUAL ( _scheduler.start_pending_jobs (serve_job)
+                      , set_jobs_t ({coallocated})
+                      );
+}
+
+BOOST_FIXTURE_TEST_CASE
+  ( backfilling_goes_by_the_expected_runtime_not_by_the_cost
+  , fixture_scheduler_and_requirements_and_preferences
+  )
+{
+  add_worker (_worker_manager, "worker_0", {sdpa::Capability ("A", "worker_0")});
+  add_worker (_worker_manager, "worker_1", {sdpa::Capability ("B", "worker_1")});
+
+  auto const running
+    (add_and_enqueue_job_with_runtime (require_with_cost ("A", 0.001), 100.0));
+  _scheduler.assignJobsToWorkers();
+  BOOST_REQUIRE_EQUAL ( _scheduler.start_pending_jobs (serve_job)
+                      , set_jobs_t ({running})
+                      );
+
+  add_and_enqueue_job (require (2));
+  add_and_enqueue_job_with_runtime (require_with_cost ("B", 0.001), 1000.0);
+  auto const short_but_costly
+    (add_and_enqueue_job_with_runtime (require_with_cost ("B", 1000.0), 1.0));
+  _scheduler.assignJobsToWorkers();
+
+  BOOST_REQUIRE_EQUAL ( _scheduler.start_pending_jobs (serve_job)
+                      , set_jobs_t ({short_but_costly})
+                      );
+}
+
 BOOST_FIXTURE_TEST_CASE ( work_stealing
                         , fixture_scheduler_and_requirements_and_preferences
                         )
@@ -1946,6 +2326,7 @@ BOOST_FIXTURE_TEST_CASE
     ( *worker_jobs.cbegin()
     , {worker_with_1_job}
     , boost::none
+    , 1.0
     , [] ( sdpa::daemon::WorkerSet const&
          , sdpa::daemon::Implementation const&
          , sdpa::job_id_t const&
@@ -2007,6 +2388,7 @@ BOOST_FIXTURE_TEST_CASE
     ( *worker_jobs.cbegin()
     , {worker_with_1_job}
     , boost::none
+    , 1.0
     , [] ( sdpa::daemon::WorkerSet const&
          , sdpa::daemon::Implementation
          , sdpa::job_id_t const&
@@ -2086,6 +2468,7 @@ BOOST_FIXTURE_TEST_CASE
       ( *worker_jobs.cbegin()
       , {worker}
       , boost::none
+      , 1.0
       , [] ( sdpa::daemon::WorkerSet const&
            , sdpa::daemon::Implementation const&
            , sdpa::job_id_t const&
@@ -0,0 +1,164 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/daemon/WorkerManager.hpp>
+#include <sdpa/daemon/scheduler/CoallocationScheduler.hpp>
+#include <sdpa/test/sdpa/utils.hpp>
+#include <sdpa/types.hpp>
+
+#include <we/type/requirement.hpp>
+#include <we/type/schedule_data.hpp>
+
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/measure_average_time.hpp>
+#include <util-generic/testing/random.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+  Requirements_and_preferences require (std::string const& capability)
+  {
+    return { {we::type::requirement_t (capability, true)}
+           , we::type::schedule_data()
+           , null_transfer_cost
+           , 1.0
+           , 0
+           , {}
+           };
+  }
+
+  struct fixture_busy_workers
+  {
+    fixture_busy_workers()
+      : _capability (fhg::util::testing::random_identifier())
+      , _scheduler
+          ( [this] (sdpa::job_id_t const& id)
+            {
+              return _requirements_and_preferences.at (id);
+            }
+          , _worker_manager
+          )
+    {}
+
+    void add_worker()
+    {
+      auto const worker (utils::random_peer_name());
+
+      _worker_manager.addWorker
+        ( worker
+        , {sdpa::capability_t (_capability, worker)}
+        , 0
+        , false
+        , fhg::util::testing::random_string()
+        , fhg::util::testing::random_string()
+        );
+    }
+
+    //! every worker has one running and one pending job, i.e. can be
+    //! stolen from
+    void add_busy_workers (unsigned int n)
+    {
+      for (unsigned int i (0); i < n; ++i)
+      {
+        add_worker();
+      }
+
+      for (unsigned int i (0); i < 2 * n; ++i)
+      {
+        sdpa::job_id_t const job (_job_ids());
+        _requirements_and_preferences.emplace (job, require (_capability));
+        _scheduler.enqueueJob (job);
+      }
+
+      _scheduler.assignJobsToWorkers();
+      _scheduler.start_pending_jobs
+        ( [] ( sdpa::daemon::WorkerSet const&
+             , sdpa::daemon::Implementation const&
+             , sdpa::job_id_t const&
+             )
+          {}
+        );
+    }
+
+    void request_scheduling()
+    {
+      _scheduler.assignJobsToWorkers();
+      _scheduler.steal_work();
+    }
+
+    std::string const _capability;
+    fhg::util::testing::unique_random<sdpa::job_id_t> _job_ids;
+    std::map<sdpa::job_id_t, Requirements_and_preferences>
+      _requirements_and_preferences;
+    sdpa::daemon::WorkerManager _worker_manager;
+    sdpa::daemon::CoallocationScheduler _scheduler;
+  };
+
+  template<typename Duration>
+    double per_second (Duration duration)
+  {
+    return 1.0 / std::chrono::duration<double> (duration).count();
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE
+  (rounds_without_transitions_do_not_depend_on_worker_count, fixture_busy_workers)
+{
+  add_busy_workers (5000);
+
+  double const rounds_per_second
+    ( per_second
+        ( fhg::util::testing::measure_average_time<std::chrono::nanoseconds>
+            ([&] { request_scheduling(); }, 100000)
+        )
+    );
+
+  BOOST_TEST_MESSAGE
+    ("rounds without transitions: " << rounds_per_second << " rounds/s");
+  BOOST_REQUIRE_GE (rounds_per_second, 100000.0);
+}
+
+BOOST_FIXTURE_TEST_CASE
+  (rounds_with_a_new_idle_worker_steal_in_logarithmic_time, fixture_busy_workers)
+{
+  add_busy_workers (5000);
+
+  //! \note each round one worker joins and steals one job
+  double const rounds_per_second
+    ( per_second
+        ( fhg::util::testing::measure_average_time<std::chrono::nanoseconds>
+            ( [&]
+              {
+                add_worker();
+                request_scheduling();
+              }
+            , 2000
+            )
+        )
+    );
+
+  BOOST_TEST_MESSAGE
+    ("rounds with a new idle worker: " << rounds_per_second << " rounds/s");
+  BOOST_REQUIRE_GE (rounds_per_second, 10000.0);
+}
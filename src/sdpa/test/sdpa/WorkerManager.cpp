@@ -172,6 +172,7 @@ BOOST_AUTO_TEST_CASE (find_submitted_or_acknowledged_worker)
     ( job_id
     , {worker_ids[0]}
     , boost::none
+    , 1.0
     , [] ( sdpa::daemon::WorkerSet const&
          , sdpa::daemon::Implementation const&
          , sdpa::job_id_t const&
@@ -227,6 +228,7 @@ BOOST_AUTO_TEST_CASE (find_submitted_or_acknowledged_coallocated_workers)
     ( job_id
     , workers
     , boost::none
+    , 1.0
     , [] ( sdpa::daemon::WorkerSet const&
          , sdpa::daemon::Implementation const&
          , sdpa::job_id_t const&
@@ -320,6 +322,7 @@ BOOST_AUTO_TEST_CASE (issue_675_reference_to_popped_queue_element)
               ( job_id
               , {worker_id}
               , boost::none
+              , 1.0
               , [] ( sdpa::daemon::WorkerSet const&
                    , sdpa::daemon::Implementation const&
                    , sdpa::job_id_t const&
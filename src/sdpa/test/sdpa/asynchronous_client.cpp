@@ -0,0 +1,291 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/client.hpp>
+#include <sdpa/events/ErrorEvent.hpp>
+#include <sdpa/events/put_token.hpp>
+#include <sdpa/events/workflow_response.hpp>
+#include <sdpa/test/sdpa/utils.hpp>
+#include <sdpa/types.hpp>
+
+#include <we/type/value/boost/test/printer.hpp>
+
+#include <test/certificates_data.hpp>
+
+#include <fhg/util/thread/queue.hpp>
+#include <util-generic/cxx14/make_unique.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/printer/optional.hpp>
+#include <util-generic/testing/random.hpp>
+
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <boost/asio/io_service.hpp>
+
+#include <future>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BOOST_DATA_TEST_CASE
+  (many_submissions_are_outstanding_at_once, certificates_data, certificates)
+{
+  const utils::agent agent (certificates);
+
+  fhg::thread::queue<std::string> jobs_submitted;
+  utils::fake_drts_worker_waiting_for_finished_ack worker
+    ( [&jobs_submitted] (std::string name) { jobs_submitted.put (name); }
+    , agent
+    , certificates
+    );
+
+  utils::client client (agent, certificates);
+
+  std::size_t const job_count (50);
+
+  std::vector<std::future<sdpa::job_id_t>> submissions;
+  for (std::size_t i (0); i < job_count; ++i)
+  {
+    submissions.emplace_back
+      (client._.submit_job_async (utils::module_call (std::to_string (i))));
+  }
+
+  std::set<sdpa::job_id_t> job_ids;
+  std::vector<std::future<sdpa::client::terminal_state_t>> terminal_states;
+  for (auto& submission : submissions)
+  {
+    auto const job_id (submission.get());
+    job_ids.emplace (job_id);
+    terminal_states.emplace_back
+      (client._.wait_for_terminal_state_async (job_id));
+  }
+
+  BOOST_REQUIRE_EQUAL (job_ids.size(), job_count);
+
+  for (std::size_t i (0); i < job_count; ++i)
+  {
+    worker.finish_and_wait_for_ack (jobs_submitted.get());
+  }
+
+  for (auto& terminal_state : terminal_states)
+  {
+    BOOST_REQUIRE_EQUAL (terminal_state.get().status, sdpa::status::FINISHED);
+  }
+}
+
+BOOST_DATA_TEST_CASE
+  (wait_any_returns_the_job_that_terminated, certificates_data, certificates)
+{
+  const utils::agent agent (certificates);
+
+  fhg::thread::queue<std::string> jobs_submitted;
+  utils::fake_drts_worker_waiting_for_finished_ack worker
+    ( [&jobs_submitted] (std::string name) { jobs_submitted.put (name); }
+    , agent
+    , certificates
+    );
+
+  utils::client client (agent, certificates);
+
+  std::map<std::string, sdpa::job_id_t> job_ids;
+  for (std::string const name : {"first", "second"})
+  {
+    job_ids.emplace (name, client.submit_job (utils::module_call (name)));
+  }
+
+  //! \note the worker gets only one job at a time: the other one
+  //! stays running until it is finished as well
+  std::string const finished (jobs_submitted.get());
+  worker.finish_and_wait_for_ack (finished);
+
+  BOOST_REQUIRE_EQUAL
+    ( client._.wait_for_any_terminal_state
+        ({job_ids.at ("first"), job_ids.at ("second")})
+    , job_ids.at (finished)
+    );
+
+  worker.finish_and_wait_for_ack (jobs_submitted.get());
+
+  for (auto const& job_id : job_ids)
+  {
+    BOOST_REQUIRE_EQUAL
+      ( client.wait_for_terminal_state_and_cleanup (job_id.second)
+      , sdpa::status::FINISHED
+      );
+  }
+}
+
+BOOST_DATA_TEST_CASE
+  (failing_request_does_not_affect_others, certificates_data, certificates)
+{
+  const utils::agent agent (certificates);
+
+  utils::client client (agent, certificates);
+
+  auto const job_id (client.submit_job (utils::module_call()));
+
+  auto terminal_state (client._.wait_for_terminal_state_async (job_id));
+  auto cancel_unknown_job
+    ( client._.cancel_job_async
+        (fhg::util::testing::random_string_without_zero())
+    );
+  auto cancel (client._.cancel_job_async (job_id));
+
+  BOOST_REQUIRE_THROW (cancel_unknown_job.get(), std::runtime_error);
+  cancel.get();
+  BOOST_REQUIRE_EQUAL (terminal_state.get().status, sdpa::status::CANCELED);
+}
+
+namespace
+{
+  //! \note answers requests for the place "fail" with an error for
+  //! the request instead of a response, as the agent does when
+  //! handling the request throws
+  class fake_agent_failing_requests final
+    : public utils::basic_drts_component_no_logic
+  {
+  public:
+    fake_agent_failing_requests (fhg::com::Certificates const& certificates)
+      : utils::basic_drts_component_no_logic (certificates)
+    {}
+
+    virtual void handle_put_token
+      ( fhg::com::p2p::address_t const& source
+      , sdpa::events::put_token const* event
+      ) override
+    {
+      if (event->place_name() == "fail")
+      {
+        _network.perform<sdpa::events::ErrorEvent>
+          ( source
+          , sdpa::events::ErrorEvent::SDPA_EUNKNOWN
+          , "put_token failed"
+          , event->job_id()
+          , event->put_token_id()
+          );
+      }
+      else
+      {
+        _network.perform<sdpa::events::put_token_response>
+          (source, event->put_token_id(), boost::none);
+      }
+    }
+
+    virtual void handle_workflow_response
+      ( fhg::com::p2p::address_t const& source
+      , sdpa::events::workflow_response const* event
+      ) override
+    {
+      if (event->place_name() == "fail")
+      {
+        _network.perform<sdpa::events::ErrorEvent>
+          ( source
+          , sdpa::events::ErrorEvent::SDPA_EUNKNOWN
+          , "workflow_response failed"
+          , event->job_id()
+          , event->workflow_response_id()
+          );
+      }
+      else
+      {
+        _network.perform<sdpa::events::workflow_response_response>
+          (source, event->workflow_response_id(), event->value());
+      }
+    }
+
+    virtual void handleErrorEvent
+      ( fhg::com::p2p::address_t const&
+      , sdpa::events::ErrorEvent const* event
+      ) override
+    {
+      //! \note the client disconnecting
+      if (event->error_code() != sdpa::events::ErrorEvent::SDPA_ENODE_SHUTDOWN)
+      {
+        throw std::runtime_error ("UNHANDLED EVENT: ErrorEvent");
+      }
+    }
+
+  private:
+    basic_drts_component_no_logic::event_thread _ = {*this};
+  };
+
+  struct client_of_fake_agent
+  {
+    client_of_fake_agent
+        ( fake_agent_failing_requests const& agent
+        , fhg::com::Certificates const& certificates
+        )
+      : _ ( agent.host()
+          , agent.port()
+          , fhg::util::cxx14::make_unique<boost::asio::io_service>()
+          , certificates
+          )
+    {}
+
+    sdpa::client::Client _;
+  };
+}
+
+BOOST_DATA_TEST_CASE
+  ( failing_put_token_does_not_affect_other_put_tokens
+  , certificates_data
+  , certificates
+  )
+{
+  fake_agent_failing_requests const agent (certificates);
+  client_of_fake_agent client (agent, certificates);
+
+  auto const job_id (fhg::util::testing::random_string_without_zero());
+
+  auto put_before (client._.put_token_async (job_id, "succeed", 0UL));
+  auto put_failing (client._.put_token_async (job_id, "fail", 1UL));
+  auto put_after (client._.put_token_async (job_id, "succeed", 2UL));
+
+  BOOST_REQUIRE_THROW (put_failing.get(), std::runtime_error);
+  put_before.get();
+  put_after.get();
+}
+
+BOOST_DATA_TEST_CASE
+  ( failing_workflow_response_does_not_affect_other_workflow_responses
+  , certificates_data
+  , certificates
+  )
+{
+  fake_agent_failing_requests const agent (certificates);
+  client_of_fake_agent client (agent, certificates);
+
+  auto const job_id (fhg::util::testing::random_string_without_zero());
+
+  auto response_before
+    (client._.workflow_response_async (job_id, "succeed", 0UL));
+  auto response_failing
+    (client._.workflow_response_async (job_id, "fail", 1UL));
+  auto put (client._.put_token_async (job_id, "succeed", 2UL));
+  auto response_after
+    (client._.workflow_response_async (job_id, "succeed", 3UL));
+
+  BOOST_REQUIRE_THROW (response_failing.get(), std::runtime_error);
+  BOOST_REQUIRE_EQUAL
+    (response_before.get(), pnet::type::value::value_type (0UL));
+  put.get();
+  BOOST_REQUIRE_EQUAL
+    (response_after.get(), pnet::type::value::value_type (3UL));
+}
@@ -0,0 +1,170 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/daemon/scheduler/fair_share.hpp>
+
+#include <util-generic/testing/printer/list.hpp>
+#include <util-generic/testing/require_exception.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <list>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+  using sdpa::daemon::scheduler::fair_share;
+
+  //! \note jobs are named "<top level job>.<n>"
+  std::string top_level_job (std::string const& job)
+  {
+    return job.substr (0, job.find ('.'));
+  }
+
+  std::list<std::string> jobs (std::string top_level, std::size_t count)
+  {
+    std::list<std::string> jobs;
+    for (std::size_t n (0); n < count; ++n)
+    {
+      jobs.emplace_back (top_level + "." + std::to_string (n));
+    }
+    return jobs;
+  }
+
+  std::list<std::string> concat
+    (std::list<std::string> lhs, std::list<std::string> rhs)
+  {
+    lhs.splice (lhs.end(), rhs);
+    return lhs;
+  }
+
+  std::list<std::string> top_level_jobs (std::list<std::string> jobs)
+  {
+    std::transform (jobs.begin(), jobs.end(), jobs.begin(), &top_level_job);
+    return jobs;
+  }
+}
+
+BOOST_AUTO_TEST_CASE (jobs_of_a_single_top_level_job_keep_their_order)
+{
+  fair_share const share;
+
+  BOOST_REQUIRE_EQUAL
+    (share.order (jobs ("a", 5), &top_level_job), jobs ("a", 5));
+}
+
+BOOST_AUTO_TEST_CASE (top_level_jobs_of_equal_weight_alternate)
+{
+  fair_share const share;
+
+  BOOST_REQUIRE_EQUAL
+    ( share.order (concat (jobs ("a", 3), jobs ("b", 3)), &top_level_job)
+    , (std::list<std::string> {"a.0", "b.0", "a.1", "b.1", "a.2", "b.2"})
+    );
+}
+
+BOOST_AUTO_TEST_CASE (higher_priority_goes_first)
+{
+  fair_share share;
+  share.set ("b", sdpa::scheduling_parameters (1));
+
+  BOOST_REQUIRE_EQUAL
+    ( top_level_jobs
+        (share.order (concat (jobs ("a", 2), jobs ("b", 2)), &top_level_job))
+    , (std::list<std::string> {"b", "b", "a", "a"})
+    );
+}
+
+BOOST_AUTO_TEST_CASE (top_level_jobs_share_in_proportion_to_their_weight)
+{
+  fair_share share;
+  share.set ("a", sdpa::scheduling_parameters (0, 4.0));
+
+  BOOST_REQUIRE_EQUAL
+    ( top_level_jobs
+        (share.order (concat (jobs ("a", 6), jobs ("b", 2)), &top_level_job))
+    , (std::list<std::string> {"a", "b", "a", "a", "a", "a", "b", "a"})
+    );
+}
+
+BOOST_AUTO_TEST_CASE (started_jobs_are_charged_to_their_top_level_job)
+{
+  fair_share share;
+
+  share.charge ("a");
+  share.charge ("a");
+
+  BOOST_REQUIRE_EQUAL
+    ( top_level_jobs
+        (share.order (concat (jobs ("a", 2), jobs ("b", 3)), &top_level_job))
+    , (std::list<std::string> {"b", "a", "b", "a", "b"})
+    );
+}
+
+BOOST_AUTO_TEST_CASE (new_top_level_jobs_do_not_get_the_past_back)
+{
+  fair_share share;
+
+  for (int i (0); i < 100; ++i)
+  {
+    share.charge ("a");
+  }
+
+  BOOST_REQUIRE_EQUAL
+    ( top_level_jobs
+        (share.order (concat (jobs ("a", 2), jobs ("b", 2)), &top_level_job))
+    , (std::list<std::string> {"b", "a", "b", "a"})
+    );
+}
+
+BOOST_AUTO_TEST_CASE (changing_the_parameters_keeps_the_pass)
+{
+  fair_share share;
+
+  share.charge ("a");
+  share.charge ("b");
+  share.set ("b", sdpa::scheduling_parameters (0, 2.0));
+
+  BOOST_REQUIRE_EQUAL
+    ( top_level_jobs
+        (share.order (concat (jobs ("a", 2), jobs ("b", 3)), &top_level_job))
+    , (std::list<std::string> {"a", "b", "b", "a", "b"})
+    );
+}
+
+BOOST_AUTO_TEST_CASE (forgotten_top_level_jobs_get_the_default_parameters)
+{
+  fair_share share;
+  share.set ("b", sdpa::scheduling_parameters (1));
+  share.forget ("b");
+
+  BOOST_REQUIRE_EQUAL
+    ( top_level_jobs
+        (share.order (concat (jobs ("a", 2), jobs ("b", 2)), &top_level_job))
+    , (std::list<std::string> {"a", "b", "a", "b"})
+    );
+}
+
+BOOST_AUTO_TEST_CASE (weight_has_to_be_positive)
+{
+  fhg::util::testing::require_exception
+    ( [] { sdpa::scheduling_parameters (0, 0.0); }
+    , std::invalid_argument
+        ("scheduling_parameters: weight has to be positive")
+    );
+}
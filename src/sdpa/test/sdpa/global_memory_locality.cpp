@@ -0,0 +1,148 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <sdpa/daemon/scheduler/global_memory_locality.hpp>
+
+#include <we/type/value.hpp>
+#include <we/type/value/poke.hpp>
+
+#include <util-generic/testing/require_exception.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <list>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+  using sdpa::daemon::scheduler::global_memory_locality;
+
+  we::global::range global_range
+    (std::string handle, unsigned long offset, unsigned long size)
+  {
+    pnet::type::value::value_type range;
+    pnet::type::value::poke
+      (std::list<std::string> {"handle", "name"}, range, handle);
+    pnet::type::value::poke ("offset", range, offset);
+    pnet::type::value::poke ("size", range, size);
+    return range;
+  }
+}
+
+BOOST_AUTO_TEST_CASE (nothing_is_cached_on_unknown_workers)
+{
+  global_memory_locality const locality;
+
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("1", 0, 10)}), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE (fraction_is_weighted_by_the_size_of_the_ranges)
+{
+  global_memory_locality locality;
+
+  locality.reset ("w", 100);
+  locality.reset ("other", 100);
+  locality.record ("w", {global_range ("1", 0, 30)});
+
+  BOOST_REQUIRE_EQUAL
+    ( locality.cached_fraction
+        ("w", {global_range ("1", 0, 30), global_range ("1", 30, 10)})
+    , 0.75
+    );
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("other", {global_range ("1", 0, 30)}), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE (only_the_most_recent_ranges_are_remembered)
+{
+  global_memory_locality locality (2);
+
+  locality.reset ("w", 100);
+  locality.record ("w", {global_range ("1", 0, 10)});
+  locality.record ("w", {global_range ("2", 0, 10)});
+  locality.record ("w", {global_range ("1", 0, 10)});
+  locality.record ("w", {global_range ("3", 0, 10)});
+
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("1", 0, 10)}), 1.0);
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("2", 0, 10)}), 0.0);
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("3", 0, 10)}), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE (only_as_many_bytes_as_fit_the_cache_are_remembered)
+{
+  global_memory_locality locality;
+
+  locality.reset ("w", 25);
+
+  locality.record ("w", {global_range ("1", 0, 10)});
+  locality.record ("w", {global_range ("2", 0, 10)});
+  locality.record ("w", {global_range ("3", 0, 10)});
+  locality.record ("w", {global_range ("4", 0, 30)});
+
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("1", 0, 10)}), 0.0);
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("2", 0, 10)}), 1.0);
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("3", 0, 10)}), 1.0);
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("4", 0, 30)}), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE (nothing_is_recorded_for_workers_without_a_cache)
+{
+  global_memory_locality locality;
+
+  locality.record ("unregistered", {global_range ("1", 0, 10)});
+  locality.reset ("without_cache", 0);
+  locality.record ("without_cache", {global_range ("1", 0, 10)});
+
+  BOOST_REQUIRE_EQUAL
+    ( locality.cached_fraction ("unregistered", {global_range ("1", 0, 10)})
+    , 0.0
+    );
+  BOOST_REQUIRE_EQUAL
+    ( locality.cached_fraction ("without_cache", {global_range ("1", 0, 10)})
+    , 0.0
+    );
+}
+
+BOOST_AUTO_TEST_CASE (reregistered_worker_holds_nothing)
+{
+  global_memory_locality locality;
+
+  locality.reset ("w", 100);
+  locality.record ("w", {global_range ("1", 0, 10)});
+  locality.reset ("w", 100);
+
+  BOOST_REQUIRE_EQUAL
+    (locality.cached_fraction ("w", {global_range ("1", 0, 10)}), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE (ranges_per_worker_have_to_be_positive)
+{
+  fhg::util::testing::require_exception
+    ( [] { global_memory_locality (0); }
+    , std::invalid_argument
+        ("global_memory_locality: ranges per worker have to be positive")
+    );
+}
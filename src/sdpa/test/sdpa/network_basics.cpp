@@ -119,6 +119,7 @@ namespace
       , fhg::util::testing::random<unsigned long>{}()
       , fhg::util::testing::random<bool>{}()
       , fhg::util::testing::random<std::string>{}()
+      , fhg::util::testing::random<unsigned long>{}()
       );
   }
 
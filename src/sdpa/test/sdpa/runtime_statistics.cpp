@@ -0,0 +1,144 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/daemon/scheduler/runtime_statistics.hpp>
+
+#include <util-generic/temporary_path.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/require_exception.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/optional/optional_io.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+namespace
+{
+  using sdpa::daemon::scheduler::runtime_statistics;
+
+  runtime_statistics::key const on_a {"t", std::string ("impl"), {"A"}};
+  runtime_statistics::key const on_b {"t", std::string ("impl"), {"B"}};
+  runtime_statistics::key const on_any {"t", std::string ("impl"), {}};
+}
+
+BOOST_AUTO_TEST_CASE (nothing_is_expected_for_unknown_keys)
+{
+  runtime_statistics const statistics;
+
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a), boost::none);
+  BOOST_REQUIRE (!statistics.query (on_a));
+}
+
+BOOST_AUTO_TEST_CASE (moving_average_weights_the_newest_runtime)
+{
+  runtime_statistics statistics (0.5);
+
+  statistics.record (on_a, 4.0);
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a), 4.0);
+
+  statistics.record (on_a, 2.0);
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a), 3.0);
+
+  statistics.record (on_a, 1.0);
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a), 2.0);
+}
+
+BOOST_AUTO_TEST_CASE (quantiles_are_computed_over_the_window)
+{
+  runtime_statistics statistics (0.2, 100);
+
+  for (int i (200); i > 0; --i)
+  {
+    statistics.record (on_a, i);
+  }
+
+  auto const summary (statistics.query (on_a).get());
+
+  BOOST_REQUIRE_EQUAL (summary.count, 200);
+  BOOST_REQUIRE_EQUAL (summary.median, 50.0);
+  BOOST_REQUIRE_EQUAL (summary.p90, 90.0);
+  BOOST_REQUIRE_EQUAL (summary.p99, 99.0);
+  BOOST_REQUIRE_EQUAL (summary.max, 100.0);
+}
+
+BOOST_AUTO_TEST_CASE (unknown_worker_class_falls_back_to_any_class)
+{
+  runtime_statistics statistics (1.0);
+
+  statistics.record (on_a, 3.0);
+
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_b), 3.0);
+  BOOST_REQUIRE_EQUAL (statistics.query (on_any).get().count, 1);
+
+  statistics.record (on_b, 5.0);
+
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a), 3.0);
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_b), 5.0);
+  BOOST_REQUIRE_EQUAL (statistics.query (on_any).get().count, 2);
+}
+
+BOOST_AUTO_TEST_CASE (classes_of_workers_with_too_few_samples_fall_back)
+{
+  runtime_statistics statistics (1.0);
+
+  statistics.record (on_a, 2.0);
+
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a, 2), boost::none);
+
+  statistics.record (on_b, 8.0);
+
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a), 2.0);
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a, 2), 8.0);
+  BOOST_REQUIRE_EQUAL (statistics.expected_runtime (on_a, 3), boost::none);
+}
+
+BOOST_AUTO_TEST_CASE (snapshot_restores_statistics)
+{
+  fhg::util::temporary_path const directory;
+  boost::filesystem::path const snapshot
+    (boost::filesystem::path (directory) / "runtime_statistics");
+
+  runtime_statistics saved;
+  saved.record (on_a, 1.0);
+  saved.record (on_a, 2.0);
+  saved.record (on_b, 7.0);
+  saved.save (snapshot);
+
+  runtime_statistics loaded;
+  loaded.load (snapshot);
+
+  BOOST_REQUIRE_EQUAL (loaded.summaries().size(), saved.summaries().size());
+  BOOST_REQUIRE_EQUAL
+    (loaded.expected_runtime (on_a), saved.expected_runtime (on_a));
+  BOOST_REQUIRE_EQUAL
+    (loaded.expected_runtime (on_b), saved.expected_runtime (on_b));
+  BOOST_REQUIRE_EQUAL
+    (loaded.query (on_any).get().max, saved.query (on_any).get().max);
+}
+
+BOOST_AUTO_TEST_CASE (loading_a_corrupt_snapshot_throws)
+{
+  fhg::util::temporary_path const directory;
+  boost::filesystem::path const snapshot
+    (boost::filesystem::path (directory) / "runtime_statistics");
+
+  boost::filesystem::ofstream (snapshot) << "not a snapshot";
+
+  runtime_statistics statistics;
+
+  BOOST_REQUIRE_THROW (statistics.load (snapshot), std::exception);
+}
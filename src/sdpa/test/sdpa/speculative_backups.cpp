@@ -0,0 +1,144 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/daemon/scheduler/speculative_backups.hpp>
+
+#include <util-generic/testing/printer/list.hpp>
+#include <util-generic/testing/printer/optional.hpp>
+#include <util-generic/testing/require_exception.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <list>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+  using sdpa::daemon::scheduler::runtime_statistics;
+  using sdpa::daemon::scheduler::speculative_backups;
+
+  runtime_statistics::summary observed (std::size_t count, double p90)
+  {
+    return {count, p90, p90, p90, p90, p90};
+  }
+}
+
+BOOST_AUTO_TEST_CASE (runtime_multiple_has_to_be_positive)
+{
+  fhg::util::testing::require_exception
+    ( [] { speculative_backups (0.0); }
+    , std::invalid_argument
+        ("speculative_backups: runtime multiple has to be positive")
+    );
+  fhg::util::testing::require_exception
+    ( [] { speculative_backups (-1.0); }
+    , std::invalid_argument
+        ("speculative_backups: runtime multiple has to be positive")
+    );
+}
+
+BOOST_AUTO_TEST_CASE (straggler_runs_longer_than_the_multiple_of_the_p90)
+{
+  speculative_backups const backups (2.0, 1);
+
+  BOOST_REQUIRE (!backups.is_straggler (observed (1, 10.0), 10.0));
+  BOOST_REQUIRE (!backups.is_straggler (observed (1, 10.0), 20.0));
+  BOOST_REQUIRE (backups.is_straggler (observed (1, 10.0), 20.5));
+}
+
+BOOST_AUTO_TEST_CASE (no_straggler_before_enough_runtimes_were_observed)
+{
+  speculative_backups const backups (2.0, 10);
+
+  BOOST_REQUIRE (!backups.is_straggler (observed (9, 1.0), 100.0));
+  BOOST_REQUIRE (backups.is_straggler (observed (10, 1.0), 100.0));
+}
+
+BOOST_AUTO_TEST_CASE (backup_and_original_know_each_other)
+{
+  speculative_backups backups (2.0);
+
+  BOOST_REQUIRE (!backups.speculated ("original"));
+  BOOST_REQUIRE_EQUAL
+    (backups.running_backup_of ("original"), boost::none);
+
+  backups.launched ("original", "backup");
+
+  BOOST_REQUIRE (backups.speculated ("original"));
+  BOOST_REQUIRE (!backups.speculated ("backup"));
+  BOOST_REQUIRE_EQUAL
+    ( backups.running_backup_of ("original")
+    , boost::optional<std::string> ("backup")
+    );
+  BOOST_REQUIRE_EQUAL
+    ( backups.original_of ("backup")
+    , boost::optional<std::string> ("original")
+    );
+  BOOST_REQUIRE_EQUAL (backups.original_of ("original"), boost::none);
+}
+
+BOOST_AUTO_TEST_CASE (a_job_gets_at_most_one_backup)
+{
+  speculative_backups backups (2.0);
+
+  backups.launched ("original", "backup");
+
+  fhg::util::testing::require_exception
+    ( [&] { backups.launched ("original", "another backup"); }
+    , std::logic_error ("second backup for job original")
+    );
+}
+
+BOOST_AUTO_TEST_CASE (original_stays_speculated_after_its_backup_is_forgotten)
+{
+  speculative_backups backups (2.0);
+
+  backups.launched ("original", "backup");
+  backups.forget ("backup");
+
+  BOOST_REQUIRE (backups.speculated ("original"));
+  BOOST_REQUIRE_EQUAL
+    (backups.running_backup_of ("original"), boost::none);
+  BOOST_REQUIRE_EQUAL (backups.original_of ("backup"), boost::none);
+
+  backups.forget ("original");
+
+  BOOST_REQUIRE (!backups.speculated ("original"));
+}
+
+BOOST_AUTO_TEST_CASE (superseded_until_forgotten)
+{
+  speculative_backups backups (2.0);
+
+  backups.launched ("original", "backup");
+
+  BOOST_REQUIRE (!backups.superseded ("original"));
+  BOOST_REQUIRE (backups.superseded_jobs().empty());
+
+  backups.supersede ("original");
+  backups.supersede ("original");
+
+  BOOST_REQUIRE (backups.superseded ("original"));
+  BOOST_REQUIRE (!backups.superseded ("backup"));
+  BOOST_REQUIRE_EQUAL
+    (backups.superseded_jobs(), std::list<std::string> {"original"});
+
+  backups.forget ("original");
+
+  BOOST_REQUIRE (!backups.superseded ("original"));
+  BOOST_REQUIRE (backups.superseded_jobs().empty());
+}
@@ -0,0 +1,393 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <sdpa/daemon/scheduler/runtime_statistics.hpp>
+#include <sdpa/events/CancelJobAckEvent.hpp>
+#include <sdpa/events/CancelJobEvent.hpp>
+#include <sdpa/events/JobFailedEvent.hpp>
+#include <sdpa/events/JobFinishedEvent.hpp>
+#include <sdpa/events/SubmitJobAckEvent.hpp>
+#include <sdpa/events/SubmitJobEvent.hpp>
+#include <sdpa/test/sdpa/utils.hpp>
+#include <sdpa/types.hpp>
+
+#include <test/certificates_data.hpp>
+
+#include <metrics/registry.hpp>
+
+#include <util-generic/cxx14/make_unique.hpp>
+#include <util-generic/temporary_path.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/printer/optional.hpp>
+#include <util-generic/testing/printer/set.hpp>
+#include <util-generic/testing/random.hpp>
+#include <util-generic/threadsafe_queue.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace
+{
+  //! \note the copies of a side effect free job are told apart by
+  //! their job id only, the submissions tell which worker got which
+  using submission = std::pair<std::string, sdpa::job_id_t>;
+
+  class fake_drts_worker_running_copies final
+    : public utils::no_thread::basic_drts_worker
+  {
+  public:
+    fake_drts_worker_running_copies
+        ( fhg::util::threadsafe_queue<submission>& submissions
+        , fhg::util::threadsafe_queue<sdpa::job_id_t>& cancels
+        , utils::agent const& master
+        , fhg::com::Certificates const& certificates
+        )
+      : utils::no_thread::basic_drts_worker (master, certificates)
+      , _submissions (submissions)
+      , _cancels (cancels)
+    {}
+
+    virtual void handleSubmitJobEvent
+      ( fhg::com::p2p::address_t const& source
+      , sdpa::events::SubmitJobEvent const* event
+      ) override
+    {
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+        _jobs.emplace (*event->job_id(), std::make_pair (source, event->activity()));
+      }
+
+      _network.perform<sdpa::events::SubmitJobAckEvent>
+        (source, *event->job_id());
+
+      _submissions.put (name(), *event->job_id());
+    }
+
+    virtual void handleCancelJobEvent
+      ( fhg::com::p2p::address_t const&
+      , sdpa::events::CancelJobEvent const* event
+      ) override
+    {
+      {
+        std::lock_guard<std::mutex> const _ (_guard);
+        ++_cancel_requests;
+      }
+
+      _cancels.put (event->job_id());
+    }
+
+    virtual void handleJobFinishedAckEvent
+      ( fhg::com::p2p::address_t const&
+      , sdpa::events::JobFinishedAckEvent const*
+      ) override
+    {}
+
+    virtual void handleJobFailedAckEvent
+      ( fhg::com::p2p::address_t const&
+      , sdpa::events::JobFailedAckEvent const*
+      ) override
+    {}
+
+    //! \note with the activity it was submitted with as result, so
+    //! that the workflow engine can inject it
+    void finish (sdpa::job_id_t const& job_id)
+    {
+      auto const job (take (job_id));
+
+      _network.perform<sdpa::events::JobFinishedEvent>
+        (job.first, job_id, job.second);
+    }
+
+    void fail (sdpa::job_id_t const& job_id)
+    {
+      _network.perform<sdpa::events::JobFailedEvent>
+        (take (job_id).first, job_id, "copy failed");
+    }
+
+    void acknowledge_cancel (sdpa::job_id_t const& job_id)
+    {
+      _network.perform<sdpa::events::CancelJobAckEvent>
+        (take (job_id).first, job_id);
+    }
+
+    std::size_t cancel_requests() const
+    {
+      std::lock_guard<std::mutex> const _ (_guard);
+      return _cancel_requests;
+    }
+
+  private:
+    std::pair<fhg::com::p2p::address_t, we::type::activity_t> take
+      (sdpa::job_id_t const& job_id)
+    {
+      std::lock_guard<std::mutex> const _ (_guard);
+
+      auto job (_jobs.at (job_id));
+      _jobs.erase (job_id);
+      return job;
+    }
+
+    fhg::util::threadsafe_queue<submission>& _submissions;
+    fhg::util::threadsafe_queue<sdpa::job_id_t>& _cancels;
+
+    mutable std::mutex _guard;
+    std::map< sdpa::job_id_t
+            , std::pair<fhg::com::p2p::address_t, we::type::activity_t>
+            > _jobs;
+    std::size_t _cancel_requests {0};
+
+    basic_drts_component::event_thread_and_worker_join _ = {*this};
+  };
+
+  we::type::activity_t side_effect_free_module_call (std::string name)
+  {
+    we::type::property::type properties;
+    properties.set ({"fhg", "drts", "side_effect_free"}, true);
+
+    we::type::transition_t transition
+      ( name
+      , we::type::module_call_t
+          ( fhg::util::testing::random_string()
+          , fhg::util::testing::random_string()
+          , std::unordered_map<std::string, we::type::memory_buffer_info_t>()
+          , std::list<we::type::memory_transfer>()
+          , std::list<we::type::memory_transfer>()
+          , true
+          , true
+          )
+      , boost::none
+      , properties
+      , we::priority_type()
+      );
+    auto const port_name (fhg::util::testing::random_identifier());
+    transition.add_port ( we::type::port_t ( port_name
+                                           , we::type::PORT_IN
+                                           , std::string ("string")
+                                           , we::type::property::type()
+                                           )
+                        );
+
+    we::type::activity_t activity (transition);
+    activity.add_input (port_name, fhg::util::testing::random_identifier());
+    return activity;
+  }
+
+  //! \note every earlier run of the transition took a millisecond,
+  //! so that every running copy is a straggler at once
+  boost::filesystem::path fast_earlier_runs
+    (boost::filesystem::path const& directory, std::string const& transition)
+  {
+    sdpa::daemon::scheduler::runtime_statistics statistics;
+
+    for (int i (0); i < 10; ++i)
+    {
+      statistics.record ({transition, boost::none, {}}, 0.001);
+    }
+
+    boost::filesystem::path const snapshot (directory / "runtime_statistics");
+    statistics.save (snapshot);
+    return snapshot;
+  }
+
+  //! An agent with two workers, running a side effect free job that
+  //! got a backup copy: the original is the first submission, the
+  //! backup the second one, to the other worker.
+  struct straggling_job
+  {
+    straggling_job (fhg::com::Certificates const& certificates)
+      : transition (fhg::util::testing::random_identifier())
+      , agent ( certificates
+              , fast_earlier_runs (directory, transition)
+              , 1.0
+              )
+      , worker_0 ( fhg::util::cxx14::make_unique<fake_drts_worker_running_copies>
+                     (submissions, cancels, agent, certificates)
+                 )
+      , worker_1 ( fhg::util::cxx14::make_unique<fake_drts_worker_running_copies>
+                     (submissions, cancels, agent, certificates)
+                 )
+      , client (agent, certificates)
+      , job_id (client.submit_job (side_effect_free_module_call (transition)))
+      , original (submissions.get())
+      , backup (submissions.get())
+    {
+      BOOST_REQUIRE_NE (original.first, backup.first);
+      BOOST_REQUIRE_EQUAL (launched_backups(), 1);
+    }
+
+    std::unique_ptr<fake_drts_worker_running_copies>& worker_running
+      (submission const& copy)
+    {
+      return worker_0 && copy.first == worker_0->name() ? worker_0 : worker_1;
+    }
+
+    std::uint64_t launched_backups() const
+    {
+      return fhg::metrics::process_registry().counter_for
+        ( "gspc_agent_speculative_backups_launched_total"
+        , "number of backup copies launched for straggling jobs"
+        , {{"agent", agent.name()}}
+        ).value();
+    }
+    std::uint64_t backups_won() const
+    {
+      return fhg::metrics::process_registry().counter_for
+        ( "gspc_agent_speculative_backups_won_total"
+        , "number of backup copies that finished before their original"
+        , {{"agent", agent.name()}}
+        ).value();
+    }
+
+    fhg::util::temporary_path const directory;
+    std::string const transition;
+    utils::agent const agent;
+    fhg::util::threadsafe_queue<submission> submissions;
+    fhg::util::threadsafe_queue<sdpa::job_id_t> cancels;
+    std::unique_ptr<fake_drts_worker_running_copies> worker_0;
+    std::unique_ptr<fake_drts_worker_running_copies> worker_1;
+    utils::client client;
+    sdpa::job_id_t const job_id;
+    submission const original;
+    submission const backup;
+  };
+}
+
+BOOST_DATA_TEST_CASE
+  ( finished_backup_delivers_the_result_once_and_cancels_the_original
+  , certificates_data
+  , certificates
+  )
+{
+  straggling_job job (certificates);
+
+  job.worker_running (job.backup)->finish (job.backup.second);
+
+  BOOST_REQUIRE_EQUAL (job.cancels.get(), job.original.second);
+
+  //! \note the original finishing anyway is ignored
+  job.worker_running (job.original)->finish (job.original.second);
+
+  BOOST_REQUIRE_EQUAL
+    (job.client.wait_for_terminal_state (job.job_id), sdpa::status::FINISHED);
+  BOOST_REQUIRE_EQUAL (job.backups_won(), 1);
+  BOOST_REQUIRE_EQUAL (job.worker_running (job.backup)->cancel_requests(), 0);
+}
+
+BOOST_DATA_TEST_CASE
+  ( finished_original_cancels_the_backup
+  , certificates_data
+  , certificates
+  )
+{
+  straggling_job job (certificates);
+
+  job.worker_running (job.original)->finish (job.original.second);
+
+  BOOST_REQUIRE_EQUAL (job.cancels.get(), job.backup.second);
+
+  job.worker_running (job.backup)->acknowledge_cancel (job.backup.second);
+
+  BOOST_REQUIRE_EQUAL
+    (job.client.wait_for_terminal_state (job.job_id), sdpa::status::FINISHED);
+  BOOST_REQUIRE_EQUAL (job.backups_won(), 0);
+  BOOST_REQUIRE_EQUAL (job.worker_running (job.original)->cancel_requests(), 0);
+}
+
+BOOST_DATA_TEST_CASE
+  ( failed_backup_leaves_the_original_running
+  , certificates_data
+  , certificates
+  )
+{
+  straggling_job job (certificates);
+
+  job.worker_running (job.backup)->fail (job.backup.second);
+  job.worker_running (job.original)->finish (job.original.second);
+
+  BOOST_REQUIRE_EQUAL
+    (job.client.wait_for_terminal_state (job.job_id), sdpa::status::FINISHED);
+  BOOST_REQUIRE_EQUAL (job.backups_won(), 0);
+  BOOST_REQUIRE_EQUAL (job.launched_backups(), 1);
+  BOOST_REQUIRE_EQUAL (job.worker_running (job.original)->cancel_requests(), 0);
+}
+
+BOOST_DATA_TEST_CASE
+  ( superseded_copy_that_loses_its_worker_is_not_run_again
+  , certificates_data
+  , certificates
+  )
+{
+  straggling_job job (certificates);
+
+  job.worker_running (job.backup)->finish (job.backup.second);
+
+  BOOST_REQUIRE_EQUAL (job.cancels.get(), job.original.second);
+
+  job.worker_running (job.original).reset();
+
+  BOOST_REQUIRE_EQUAL
+    (job.client.wait_for_terminal_state (job.job_id), sdpa::status::FINISHED);
+
+  //! \note the next submission is the one of the next job, not the
+  //! superseded original again
+  auto const next_job_id
+    (job.client.submit_job (utils::module_call (job.transition)));
+  auto const next (job.submissions.get());
+
+  BOOST_REQUIRE_NE (next.second, job.original.second);
+
+  job.worker_running (next)->finish (next.second);
+
+  BOOST_REQUIRE_EQUAL
+    (job.client.wait_for_terminal_state (next_job_id), sdpa::status::FINISHED);
+}
+
+BOOST_DATA_TEST_CASE
+  ( canceling_the_original_cancels_its_running_backup
+  , certificates_data
+  , certificates
+  )
+{
+  straggling_job job (certificates);
+
+  job.client.cancel_job (job.job_id);
+
+  std::set<sdpa::job_id_t> canceled;
+  canceled.emplace (job.cancels.get());
+  canceled.emplace (job.cancels.get());
+
+  BOOST_REQUIRE_EQUAL
+    ( canceled
+    , std::set<sdpa::job_id_t> ({job.original.second, job.backup.second})
+    );
+
+  job.worker_running (job.backup)->acknowledge_cancel (job.backup.second);
+  job.worker_running (job.original)->acknowledge_cancel (job.original.second);
+
+  BOOST_REQUIRE_EQUAL
+    (job.client.wait_for_terminal_state (job.job_id), sdpa::status::CANCELED);
+  BOOST_REQUIRE_EQUAL (job.backups_won(), 0);
+}
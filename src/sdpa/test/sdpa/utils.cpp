@@ -326,6 +326,25 @@ namespace utils
         )
   {}
 
+  agent::agent ( fhg::com::Certificates const& certificates
+               , boost::filesystem::path const& runtime_statistics_snapshot
+               , double speculative_backup_runtime_multiple
+               )
+    : _ ( random_peer_name(), "127.0.0.1"
+        , fhg::util::cxx14::make_unique<boost::asio::io_service>()
+        , boost::none
+        , sdpa::master_info_t()
+        , true
+        , certificates
+        , runtime_statistics_snapshot
+        , false
+        , 1
+        , boost::none
+        , false
+        , speculative_backup_runtime_multiple
+        )
+  {}
+
   std::string agent::name() const
   {
     return _.name();
@@ -438,6 +457,7 @@ namespace utils
       , fhg::util::testing::random<unsigned long>{}()
       , accept_workers
       , fhg::util::testing::random_string()
+      , 0
       );
   }
 
@@ -458,6 +478,7 @@ namespace utils
       , fhg::util::testing::random<unsigned long>{}()
       , accept_workers
       , fhg::util::testing::random_string()
+      , 0
       );
   }
 
@@ -480,6 +501,7 @@ namespace utils
       , fhg::util::testing::random<unsigned long>{}()
       , accept_workers
       , fhg::util::testing::random_string()
+      , 0
       );
   }
 
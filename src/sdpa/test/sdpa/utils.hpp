@@ -29,6 +29,7 @@
 
 #include <we/type/activity.hpp>
 
+#include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/thread/scoped_thread.hpp>
@@ -95,6 +96,13 @@ namespace utils
           , fhg::com::Certificates const&
           );
 
+    //! \note launches speculative backups of straggling jobs, judged
+    //! by the runtime statistics loaded from the snapshot
+    agent ( fhg::com::Certificates const&
+          , boost::filesystem::path const& runtime_statistics_snapshot
+          , double speculative_backup_runtime_multiple
+          );
+
     agent() = delete;
     agent (agent const&) = delete;
     agent (agent&) = delete;
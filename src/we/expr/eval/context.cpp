@@ -40,6 +40,15 @@ namespace expr
     void context::bind_and_discard_ref ( const std::list<std::string>& key_vec
                                        , const pnet::type::value::value_type& value
                                        )
+    {
+      bind_and_discard_ref (key_vec, {}, value);
+    }
+
+    void context::bind_and_discard_ref
+      ( const std::list<std::string>& key_vec
+      , const pnet::type::value::field_positions& positions
+      , const pnet::type::value::value_type& value
+      )
     {
       if (key_vec.empty())
       {
@@ -59,6 +68,7 @@ namespace expr
 
       pnet::type::value::poke ( key_pos
                               , key_vec.end()
+                              , positions
                               , _container[key]
                               , value
                               );
@@ -66,6 +76,14 @@ namespace expr
 
     const pnet::type::value::value_type&
       context::value (const std::list<std::string>& key_vec) const
+    {
+      return value (key_vec, {});
+    }
+
+    const pnet::type::value::value_type&
+      context::value ( const std::list<std::string>& key_vec
+                     , const pnet::type::value::field_positions& positions
+                     ) const
     {
       if (key_vec.empty())
       {
@@ -81,7 +99,7 @@ namespace expr
         if (pos != _ref_container.end())
         {
           boost::optional<const pnet::type::value::value_type&>
-            v (pnet::type::value::peek (key_pos, key_vec.end(), *pos->second));
+            v (pnet::type::value::peek (key_pos, key_vec.end(), positions, *pos->second));
 
           if (v)
           {
@@ -96,7 +114,7 @@ namespace expr
         if (pos != _container.end())
         {
           boost::optional<const pnet::type::value::value_type&>
-            v (pnet::type::value::peek (key_pos, key_vec.end(), pos->second));
+            v (pnet::type::value::peek (key_pos, key_vec.end(), positions, pos->second));
 
           if (v)
           {
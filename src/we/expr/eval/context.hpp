@@ -17,6 +17,7 @@
 #pragma once
 
 #include <we/type/value.hpp>
+#include <we/type/value/field_positions.hpp>
 
 #include <iosfwd>
 #include <list>
@@ -50,8 +51,16 @@ namespace expr
       void bind_and_discard_ref ( const std::list<std::string>&
                                 , const pnet::type::value::value_type&
                                 );
+      void bind_and_discard_ref ( const std::list<std::string>&
+                                , const pnet::type::value::field_positions&
+                                , const pnet::type::value::value_type&
+                                );
 
       const pnet::type::value::value_type& value (const std::list<std::string>&) const;
+      const pnet::type::value::value_type& value
+        ( const std::list<std::string>&
+        , const pnet::type::value::field_positions&
+        ) const;
     };
   }
 }
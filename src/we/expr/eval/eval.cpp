@@ -52,6 +52,11 @@ namespace expr
           return c.value (key);
         }
 
+        pnet::type::value::value_type operator() (const expr::parse::node::ResolvedKey& key) const
+        {
+          return c.value (key.key, key.positions);
+        }
+
         pnet::type::value::value_type operator () (const expr::parse::node::unary_t& u) const
         {
           pnet::type::value::value_type c0 (boost::apply_visitor (*this, u.child));
@@ -65,10 +70,20 @@ namespace expr
             {
               pnet::type::value::value_type c1 (boost::apply_visitor (*this, b.r));
 
-              c.bind_and_discard_ref
-                ( boost::get<std::list<std::string>>(b.l)
-                , c1
-                );
+              if ( auto const* resolved
+                     = boost::get<expr::parse::node::ResolvedKey> (&b.l)
+                 )
+              {
+                c.bind_and_discard_ref
+                  (resolved->key, resolved->positions, c1);
+              }
+              else
+              {
+                c.bind_and_discard_ref
+                  ( boost::get<std::list<std::string>>(b.l)
+                  , c1
+                  );
+              }
 
               return c1;
             }
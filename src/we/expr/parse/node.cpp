@@ -24,7 +24,9 @@
 
 #include <boost/format.hpp>
 
+#include <iterator>
 #include <stdexcept>
+#include <utility>
 
 namespace expr
 {
@@ -89,6 +91,11 @@ namespace expr
             s << "${" << show_key_vec (key) << "}";
           }
 
+          void operator () (const ResolvedKey& key) const
+          {
+            (*this) (key.key);
+          }
+
           void operator () (const unary_t & u) const
           {
             s << u.token << "(" << u.child << ")";
@@ -158,6 +165,32 @@ namespace expr
         return boost::apply_visitor (visitor_get_value(), node);
       }
 
+      namespace
+      {
+        class visitor_get_key : public boost::static_visitor<const Key&>
+        {
+        public:
+          const Key& operator () (const Key& key) const
+          {
+            return key;
+          }
+          const Key& operator () (const ResolvedKey& key) const
+          {
+            return key.key;
+          }
+          template<typename T>
+          const Key& operator () (const T &) const
+          {
+            throw exception::eval::type_error ("key: node is not a key");
+          }
+        };
+      }
+
+      const Key& key (const type& node)
+      {
+        return boost::apply_visitor (visitor_get_key(), node);
+      }
+
       namespace
       {
         class visitor_is_value : public boost::static_visitor<bool>
@@ -165,6 +198,7 @@ namespace expr
         public:
           bool operator () (const pnet::type::value::value_type &) const { return true; }
           bool operator () (const Key&) const { return false; }
+          bool operator () (const ResolvedKey&) const { return false; }
           bool operator () (const unary_t &) const { return false; }
           bool operator () (const binary_t &) const { return false; }
           bool operator () (const ternary_t &) const { return false; }
@@ -183,6 +217,7 @@ namespace expr
         public:
           bool operator () (const pnet::type::value::value_type &) const { return false; }
           bool operator () (const Key&) const { return true; }
+          bool operator () (const ResolvedKey&) const { return true; }
           bool operator () (const unary_t &) const { return false; }
           bool operator () (const binary_t &) const { return false; }
           bool operator () (const ternary_t &) const { return false; }
@@ -216,6 +251,11 @@ namespace expr
               }
           }
 
+          void operator () (ResolvedKey& v) const
+          {
+            (*this) (v.key);
+          }
+
           void operator () (unary_t & u) const
           {
             boost::apply_visitor (*this, u.child);
@@ -264,6 +304,10 @@ namespace expr
 
             _roots.emplace (key.front());
           }
+          void operator() (ResolvedKey const& key) const
+          {
+            (*this) (key.key);
+          }
 
           void operator() (unary_t const& u) const
           {
@@ -292,6 +336,83 @@ namespace expr
       {
         boost::apply_visitor (visitor_collect_key_roots (roots), node);
       }
+
+      namespace
+      {
+        class visitor_resolve_field_positions
+          : public boost::static_visitor<void>
+        {
+        public:
+          visitor_resolve_field_positions
+              (type& node, SignatureOfRoot const& signature_of)
+            : _node (node)
+            , _signature_of (signature_of)
+          {}
+
+          void operator() (pnet::type::value::value_type&) const
+          {
+            return;
+          }
+
+          void operator() (Key& key) const
+          {
+            auto const signature
+              (key.empty() ? boost::none : _signature_of (key.front()));
+
+            if (!signature)
+            {
+              return;
+            }
+
+            auto positions
+              ( pnet::type::value::resolve_field_positions
+                  (std::next (key.begin()), key.end(), *signature)
+              );
+
+            if (!positions.empty())
+            {
+              Key resolved (std::move (key));
+              _node = ResolvedKey {std::move (resolved), std::move (positions)};
+            }
+          }
+
+          void operator() (ResolvedKey& key) const
+          {
+            Key unresolved (std::move (key.key));
+            _node = std::move (unresolved);
+            (*this) (boost::get<Key> (_node));
+          }
+
+          void operator() (unary_t& u) const
+          {
+            resolve_field_positions (u.child, _signature_of);
+          }
+
+          void operator() (binary_t& b) const
+          {
+            resolve_field_positions (b.l, _signature_of);
+            resolve_field_positions (b.r, _signature_of);
+          }
+
+          void operator() (ternary_t& t) const
+          {
+            resolve_field_positions (t.child0, _signature_of);
+            resolve_field_positions (t.child1, _signature_of);
+            resolve_field_positions (t.child2, _signature_of);
+          }
+
+        private:
+          type& _node;
+          SignatureOfRoot const& _signature_of;
+        };
+      }
+
+      void resolve_field_positions
+        (type& node, SignatureOfRoot const& signature_of)
+      {
+        boost::apply_visitor
+          (visitor_resolve_field_positions (node, signature_of), node);
+      }
     }
   }
 }
@@ -20,9 +20,13 @@
 #include <we/expr/token/tokenizer.hpp>
 
 #include <we/type/value.hpp>
+#include <we/type/value/field_positions.hpp>
 
+#include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <functional>
+
 #include <list>
 #include <string>
 #include <unordered_set>
@@ -40,8 +44,17 @@ namespace expr
       using Key = std::list<std::string>;
       using KeyRoots = std::unordered_set<std::string>;
 
+      //! \note a Key with the positions of its fields resolved against
+      //! the signature of its root, see parser::resolve_field_positions()
+      struct ResolvedKey
+      {
+        Key key;
+        pnet::type::value::field_positions positions;
+      };
+
       typedef boost::variant < pnet::type::value::value_type
                              , Key
+                             , ResolvedKey
                              , boost::recursive_wrapper<unary_t>
                              , boost::recursive_wrapper<binary_t>
                              , boost::recursive_wrapper<ternary_t>
@@ -49,11 +62,19 @@ namespace expr
 
       std::ostream & operator << (std::ostream &, const type&);
       const pnet::type::value::value_type& get (const type&);
+      //! \note of a Key or a ResolvedKey
+      const Key& key (const type&);
       bool is_value (const type&);
       bool is_ref (const type&);
       void rename (type&, const std::string& from, const std::string& to);
       void collect_key_roots (type const&, KeyRoots&);
 
+      using SignatureOfRoot = std::function
+        < boost::optional<pnet::type::signature::signature_type const&>
+            (std::string const&)
+        >;
+      void resolve_field_positions (type&, SignatureOfRoot const&);
+
       struct unary_t
       {
         token::type token;
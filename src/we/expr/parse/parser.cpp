@@ -92,6 +92,15 @@ namespace expr
                     );
     }
 
+    void parser::resolve_field_positions
+      (node::SignatureOfRoot const& signature_of)
+    {
+      for (nd_t& node : nd_stack)
+      {
+        node::resolve_field_positions (node, signature_of);
+      }
+    }
+
     node::KeyRoots parser::key_roots() const
     {
       node::KeyRoots roots;
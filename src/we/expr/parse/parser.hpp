@@ -92,6 +92,13 @@ namespace expr
 
       void rename (const std::string& from, const std::string& to);
 
+      //! \note Resolves, for all keys with a root of known signature,
+      //! e.g. the ports of a transition, where their fields are stored,
+      //! see pnet::type::value::field_position. Evaluation then looks
+      //! there first and fields assigned to are inserted in signature
+      //! order. Resolves keys that were resolved before again.
+      void resolve_field_positions (node::SignatureOfRoot const&);
+
       node::KeyRoots key_roots() const;
 
       std::string string() const;
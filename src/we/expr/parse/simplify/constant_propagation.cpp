@@ -85,6 +85,11 @@ namespace expr
             }
           }
 
+          node::type operator() (const node::ResolvedKey& key) const
+          {
+            return (*this) (key.key);
+          }
+
           node::type operator() (node::unary_t& u) const
           {
             u.child = boost::apply_visitor (*this, u.child);
@@ -97,7 +102,7 @@ namespace expr
             {
               b.r = boost::apply_visitor (*this, b.r);
 
-              key_type lhs (boost::get<key_type> (b.l));
+              key_type lhs (node::key (b.l));
               remove_parents_and_children_left (lhs, _propagation_map);
               //! \todo also propagate constant trees or fold them?
               if (const pnet::type::value::value_type* rhs = boost::get<pnet::type::value::value_type> (&b.r))
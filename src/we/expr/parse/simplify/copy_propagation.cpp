@@ -111,6 +111,11 @@ namespace expr
             return k;
           }
 
+          node::type operator() (const node::ResolvedKey& key) const
+          {
+            return (*this) (key.key);
+          }
+
           node::type operator() (node::unary_t& u) const
           {
             u.child = boost::apply_visitor (*this, u.child);
@@ -123,7 +128,7 @@ namespace expr
             {
               b.r = boost::apply_visitor (*this, b.r);
 
-              key_type lhs (boost::get<key_type> (b.l));
+              key_type lhs (node::key (b.l));
               remove_parents_and_children_both (lhs, _propagation_map);
               if (const key_type* rhs = boost::get<key_type> (&b.r))
               {
@@ -53,6 +53,11 @@ namespace expr
             return key;
           }
 
+          node::type operator() (const node::ResolvedKey& key) const
+          {
+            return (*this) (key.key);
+          }
+
           node::type operator() (node::unary_t& u) const
           {
             u.child = boost::apply_visitor (*this, u.child);
@@ -97,7 +102,7 @@ namespace expr
           {
             if (token::is_define (b.token))
             {
-              key_type lhs (boost::get<key_type> (b.l));
+              key_type lhs (node::key (b.l));
               bool lhs_referenced (variable_or_member_referenced (lhs));
 
               _referenced_names.erase (lhs);
@@ -19,7 +19,9 @@
 #include <we/exception.hpp>
 #include <we/expr/eval/context.hpp>
 #include <we/expr/parse/parser.hpp>
+#include <we/type/signature.hpp>
 #include <we/type/value/boost/test/printer.hpp>
+#include <we/type/value/poke.hpp>
 #include <we/type/value/show.hpp>
 #include <we/type/value/read.hpp>
 
@@ -27,6 +29,8 @@
 #include <util-generic/testing/random.hpp>
 #include <util-generic/testing/require_exception.hpp>
 
+#include <boost/optional.hpp>
+
 #include <functional>
 #include <limits>
 #include <random>
@@ -168,6 +172,115 @@ BOOST_AUTO_TEST_CASE (renamed_at_depth_greater_zero)
     (parser.string(), expr::parse::parser ("sin (${A})").string());
 }
 
+namespace
+{
+  pnet::type::signature::signature_type signature_of_p()
+  {
+    using pnet::type::signature::field_type;
+    using pnet::type::signature::structure_type;
+
+    return pnet::type::signature::structured_type
+      ( "s"
+      , structure_type
+        { field_type (std::make_pair (std::string ("a"), std::string ("long")))
+        , field_type (std::make_pair (std::string ("b"), std::string ("long")))
+        , field_type
+          ( std::make_pair
+            ( std::string ("c")
+            , structure_type
+              { field_type
+                  (std::make_pair (std::string ("x"), std::string ("long")))
+              , field_type
+                  (std::make_pair (std::string ("y"), std::string ("long")))
+              }
+            )
+          )
+        }
+      );
+  }
+
+  expr::parse::parser resolved (std::string const& expression)
+  {
+    pnet::type::signature::signature_type const signature (signature_of_p());
+
+    expr::parse::parser parser (expression);
+    parser.resolve_field_positions
+      ( [&signature] (std::string const& root)
+          -> boost::optional<pnet::type::signature::signature_type const&>
+        {
+          if (root == "p")
+          {
+            return signature;
+          }
+
+          return boost::none;
+        }
+      );
+
+    return parser;
+  }
+}
+
+BOOST_AUTO_TEST_CASE (resolving_field_positions_keeps_the_expression)
+{
+  std::string const expression ("${p.c.y} := ${p.a} + ${q.a}");
+
+  BOOST_REQUIRE_EQUAL
+    (resolved (expression).string(), expr::parse::parser (expression).string());
+}
+
+BOOST_AUTO_TEST_CASE (resolved_fields_are_assigned_in_signature_order)
+{
+  std::string const expression
+    ("${p.c.y} := 4L; ${p.b} := 2L; ${p.c.x} := 3L; ${p.a} := 1L");
+
+  pnet::type::value::value_type in_signature_order;
+  pnet::type::value::poke ("a", in_signature_order, 1L);
+  pnet::type::value::poke ("b", in_signature_order, 2L);
+  pnet::type::value::poke ("c.x", in_signature_order, 3L);
+  pnet::type::value::poke ("c.y", in_signature_order, 4L);
+
+  {
+    expr::eval::context context;
+    resolved (expression).eval_all (context);
+
+    BOOST_REQUIRE_EQUAL (context.value ({"p"}), in_signature_order);
+  }
+
+  {
+    expr::eval::context context;
+    expr::parse::parser (expression).eval_all (context);
+
+    BOOST_REQUIRE_NE (context.value ({"p"}), in_signature_order);
+  }
+}
+
+BOOST_AUTO_TEST_CASE (resolved_fields_are_found_in_values_of_other_order)
+{
+  pnet::type::value::value_type reversed;
+  pnet::type::value::poke ("c.y", reversed, 4L);
+  pnet::type::value::poke ("c.x", reversed, 3L);
+  pnet::type::value::poke ("b", reversed, 2L);
+
+  expr::eval::context context;
+  context.bind_ref ("p", reversed);
+
+  BOOST_REQUIRE_EQUAL
+    ( resolved ("${p.b} + ${p.c.x} * ${p.c.y}").eval_all (context)
+    , pnet::type::value::value_type (14L)
+    );
+
+  resolved ("${p.a} := 1L").eval_all (context);
+
+  pnet::type::value::value_type expected;
+  pnet::type::value::poke ("a", expected, 1L);
+  pnet::type::value::poke ("c.y", expected, 4L);
+  pnet::type::value::poke ("c.x", expected, 3L);
+  pnet::type::value::poke ("b", expected, 2L);
+
+  BOOST_REQUIRE_EQUAL (context.value ({"p"}), expected);
+}
+
 BOOST_AUTO_TEST_CASE (token_or_boolean_table)
 {
   require_evaluating_to ("true || true", true);
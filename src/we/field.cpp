@@ -38,4 +38,25 @@ namespace pnet
 
     return *field;
   }
+
+  const type::value::value_type& field
+    ( std::size_t position
+    , const std::string& f
+    , const type::value::value_type& v
+    , const type::signature::signature_type& signature
+    )
+  {
+    const type::value::structured_type* const fields
+      (boost::get<type::value::structured_type> (&v));
+
+    if ( fields
+       && position < fields->size()
+       && (*fields)[position].first == f
+       )
+    {
+      return (*fields)[position].second;
+    }
+
+    return field (f, v, signature);
+  }
 }
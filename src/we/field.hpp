@@ -20,6 +20,7 @@
 #include <we/type/signature.hpp>
 #include <we/type/value.hpp>
 
+#include <cstddef>
 #include <list>
 #include <string>
 
@@ -30,24 +31,52 @@ namespace pnet
                                        , const type::signature::signature_type&
                                        );
 
+  //! \note looks at the given position first and falls back to the
+  //! lookup by name if the field is not stored there
+  const type::value::value_type& field ( std::size_t position
+                                       , const std::string&
+                                       , const type::value::value_type&
+                                       , const type::signature::signature_type&
+                                       );
+
+  namespace detail
+  {
+    template<typename T>
+      const T& value_as ( const type::value::value_type& value
+                        , const std::string& f
+                        , const type::signature::signature_type& signature
+                        )
+    {
+      const T* x (boost::get<T> (&value));
+
+      if (!x)
+      {
+        throw exception::type_mismatch ( signature
+                                       , value
+                                       , std::list<std::string> (1, f)
+                                       );
+      }
+
+      return *x;
+    }
+  }
+
   template<typename T>
     const T& field_as ( const std::string& f
                       , const type::value::value_type& v
                       , const type::signature::signature_type& signature
                       )
   {
-    const type::value::value_type& value (field (f, v, signature));
-
-    const T* x (boost::get<T> (&value));
-
-    if (!x)
-    {
-      throw exception::type_mismatch ( signature
-                                     , value
-                                     , std::list<std::string> (1, f)
-                                     );
-    }
+    return detail::value_as<T> (field (f, v, signature), f, signature);
+  }
 
-    return *x;
+  template<typename T>
+    const T& field_as ( std::size_t position
+                      , const std::string& f
+                      , const type::value::value_type& v
+                      , const type::signature::signature_type& signature
+                      )
+  {
+    return detail::value_as<T> (field (position, f, v, signature), f, signature);
   }
 }
@@ -42,6 +42,8 @@ namespace we
         , std::function<void (std::string workflow_response_id, boost::variant<std::exception_ptr, pnet::type::value::value_type>)> rts_workflow_response
         , std::function<id_type()> rts_id_generator
         , std::mt19937& random_extraction_engine
+        , boost::optional<snapshot_settings> snapshots
+        , fhg::metrics::labels const& metric_labels
         )
       : _rts_submit (rts_submit)
       , _rts_cancel (rts_cancel)
@@ -53,9 +55,53 @@ namespace we
       , _rts_token_put (rts_token_put)
       , _rts_workflow_response (rts_workflow_response)
       , _rts_id_generator (rts_id_generator)
+      , _nets_to_extract_from (metric_labels)
       , _random_extraction_engine (random_extraction_engine)
+      , _extraction_duration
+          ( fhg::metrics::process_registry().histogram_for
+              ( "gspc_we_extraction_seconds"
+              , "time to extract the next activity from a net"
+              , metric_labels
+              )
+          )
+      , _extracted_activities
+          ( fhg::metrics::process_registry().counter_for
+              ( "gspc_we_extracted_activities_total"
+              , "number of activities extracted from nets"
+              , metric_labels
+              )
+          )
+      , _snapshot_copy_duration
+          ( fhg::metrics::process_registry().histogram_for
+              ( "gspc_we_snapshot_copy_seconds"
+              , "time a net is held back from extraction to copy it or take"
+                " its changes for a snapshot"
+              , metric_labels
+              )
+          )
+      , _snapshot_settings (std::move (snapshots))
+      , _snapshots
+          ( _snapshot_settings
+          ? fhg::util::cxx14::make_unique<snapshot_directory>
+              (_snapshot_settings->directory)
+          : nullptr
+          )
       , _extract_from_nets_thread (&layer::extract_from_nets, this)
       , _stop_extracting ([this] { _nets_to_extract_from.interrupt(); })
+      , _snapshot_thread
+          ( _snapshots
+          ? fhg::util::cxx14::make_unique<boost::strict_scoped_thread<>>
+              (&layer::write_snapshots, this)
+          : nullptr
+          )
+      , _stop_snapshotting
+          ( [this]
+            {
+              std::lock_guard<std::mutex> const _ (_snapshot_state_guard);
+              _snapshotting_interrupted = true;
+              _snapshotting_interrupted_condition.notify_all();
+            }
+          )
     {}
 
     void layer::submit (id_type id, type::activity_t act)
@@ -69,6 +115,53 @@ namespace we
         );
     }
 
+    void layer::resume (net_snapshot snapshot)
+    {
+      activity_data_type activity_data
+        ( snapshot.id
+        , fhg::util::cxx14::make_unique<type::activity_t>
+            (std::move (snapshot.net))
+        );
+
+      if (_snapshots)
+      {
+        activity_data._activity->record_marking_changes();
+
+        std::lock_guard<std::mutex> const _ (_snapshot_state_guard);
+        _snapshotted_structures.emplace (snapshot.id);
+        auto& snapshotted (_snapshotted_children[snapshot.id]);
+        for (auto const& child : snapshot.outstanding_children)
+        {
+          snapshotted.emplace (child.first);
+        }
+      }
+
+      std::list<std::pair<id_type, type::activity_t>> children;
+      for (auto const& child : snapshot.outstanding_children)
+      {
+        _running_jobs.started
+          (snapshot.id, child.first, child.second.eureka_id());
+        children.emplace_back (child.first, child.second);
+      }
+
+      activity_data._outstanding_children
+        = std::move (snapshot.outstanding_children);
+      //! \note just was loaded from the snapshot
+      activity_data._changed_since_snapshot = false;
+
+      _nets_to_extract_from.put (std::move (activity_data), true);
+
+      for (auto& child : children)
+      {
+        _rts_submit (child.first, std::move (child.second));
+      }
+    }
+
+    boost::optional<layer::id_type> layer::parent (id_type child)
+    {
+      return _running_jobs.parent (child);
+    }
+
     void layer::finished (id_type id, type::activity_t result)
     {
       boost::optional<id_type> const parent (_running_jobs.parent (id));
@@ -169,6 +262,7 @@ namespace we
           , [this, child] (activity_data_type& activity_data)
           {
             id_type const parent_id (activity_data._id);
+            activity_data._outstanding_children.erase (child);
             _running_jobs.terminated (parent_id, child);
           }
           );
@@ -261,6 +355,25 @@ namespace we
         );
     }
 
+    void layer::put_tokens ( id_type id
+                           , std::string put_token_id
+                           , std::string place_name
+                           , std::list<pnet::type::value::value_type> values
+                           )
+    {
+      _nets_to_extract_from.apply
+        ( id
+        , [this, put_token_id, place_name, values]
+          (activity_data_type& activity_data)
+        {
+          activity_data._activity->put_tokens (place_name, values);
+
+          _rts_token_put (put_token_id, boost::none);
+        }
+        , std::bind (_rts_token_put, put_token_id, std::placeholders::_1)
+        );
+    }
+
   void layer::request_workflow_response
     ( id_type id
     , std::string workflow_response_id
@@ -343,6 +456,10 @@ namespace we
         activity_data_type activity_data (_nets_to_extract_from.get());
         auto const id (activity_data._id);
 
+        //! \note extraction fires expressions even if nothing is
+        //! extracted
+        activity_data._changed_since_snapshot = true;
+
         bool was_active (false);
 
         //! \todo How to cancel if the net is inside
@@ -352,6 +469,9 @@ namespace we
         boost::optional<type::activity_t> activity;
         try
         {
+          fhg::metrics::scoped_timer const extraction_timer
+            (_extraction_duration);
+
           fhg::util::nest_exceptions<std::runtime_error>
             ( [&]
               {
@@ -404,11 +524,17 @@ namespace we
 
         if (activity)
         {
+          _extracted_activities.increment();
+
           const id_type child_id (_rts_id_generator());
           _running_jobs.started ( activity_data._id
                                 , child_id
                                 , activity->eureka_id()
                                 );
+          if (_snapshots)
+          {
+            activity_data._outstanding_children.emplace (child_id, *activity);
+          }
           _rts_submit (child_id, std::move (*activity));
           was_active = true;
         }
@@ -452,18 +578,21 @@ namespace we
     void layer::rts_finished_and_forget (id_type id, type::activity_t activity)
     {
       _nets_to_extract_from.forget (id);
+      snapshot_forget (id);
       cancel_outstanding_responses (id, "workflow finished");
       _rts_finished (id, std::move (activity));
     }
     void layer::rts_failed_and_forget (id_type id, std::string message)
     {
       _nets_to_extract_from.forget (id);
+      snapshot_forget (id);
       cancel_outstanding_responses (id, message);
       _rts_failed (id, message);
     }
     void layer::rts_canceled_and_forget (id_type id)
     {
       _nets_to_extract_from.forget (id);
+      snapshot_forget (id);
       cancel_outstanding_responses (id, "workflow was canceled");
       _rts_canceled (id);
     }
@@ -492,6 +621,8 @@ namespace we
   void layer::async_remove_queue::RemovalFunction::operator()
     (activity_data_type& activity_data) &&
   {
+    activity_data._changed_since_snapshot = true;
+
     fhg::util::visit<void>
       ( _function
       , [&] (std::function<void (activity_data_type&)>& fun)
@@ -521,6 +652,7 @@ namespace we
                   );
               }
             );
+          activity_data._outstanding_children.erase (to_finish._id);
           to_finish._that->_running_jobs.terminated
             ( to_finish._parent
             , to_finish._id
@@ -545,6 +677,36 @@ namespace we
       , _id (std::move (id))
   {}
 
+    namespace
+    {
+      fhg::metrics::gauge& nets_to_extract_from
+        (fhg::metrics::labels labels, std::string const& state)
+      {
+        labels.emplace ("state", state);
+
+        return fhg::metrics::process_registry().gauge_for
+          ( "gspc_we_nets_to_extract_from"
+          , "number of nets waiting for extraction"
+          , labels
+          );
+      }
+    }
+
+    layer::async_remove_queue::async_remove_queue
+        (fhg::metrics::labels const& metric_labels)
+      : _container (nets_to_extract_from (metric_labels, "active"))
+      , _container_inactive (nets_to_extract_from (metric_labels, "inactive"))
+    {}
+
+    layer::async_remove_queue::list_with_id_lookup::list_with_id_lookup
+        (fhg::metrics::gauge& size)
+      : _size (size)
+    {}
+    layer::async_remove_queue::list_with_id_lookup::~list_with_id_lookup()
+    {
+      _size.decrement (_container.size());
+    }
+
     layer::activity_data_type
       layer::async_remove_queue::list_with_id_lookup::get_front()
     {
@@ -552,6 +714,7 @@ namespace we
 
       _container.pop_front();
       _position_in_container.erase (activity_data._id);
+      _size.decrement();
 
       return activity_data;
     }
@@ -564,6 +727,7 @@ namespace we
         ( activity_data_id
         , _container.insert (_container.end(), std::move (activity_data))
         );
+      _size.increment();
     }
     layer::async_remove_queue::list_with_id_lookup::iterator
       layer::async_remove_queue::list_with_id_lookup::find (id_type id)
@@ -579,11 +743,20 @@ namespace we
     {
       _container.erase (pos->second);
       _position_in_container.erase (pos);
+      _size.decrement();
     }
     bool layer::async_remove_queue::list_with_id_lookup::empty() const
     {
       return _container.empty();
     }
+    void layer::async_remove_queue::list_with_id_lookup::append_ids
+      (std::vector<id_type>& ids) const
+    {
+      for (activity_data_type const& activity_data : _container)
+      {
+        ids.emplace_back (activity_data._id);
+      }
+    }
 
 
     // async_remove_queue
@@ -781,6 +954,62 @@ namespace we
       }
     }
 
+    std::vector<layer::id_type> layer::async_remove_queue::ids() const
+    {
+      std::lock_guard<std::recursive_mutex> const _ (_container_mutex);
+
+      std::vector<id_type> ids;
+      _container.append_ids (ids);
+      _container_inactive.append_ids (ids);
+      return ids;
+    }
+
+    bool layer::async_remove_queue::take_and_put_back
+      (id_type id, std::function<void (activity_data_type&)> fun)
+    {
+      boost::optional<activity_data_type> activity_data;
+      bool active (false);
+
+      {
+        std::lock_guard<std::recursive_mutex> const _ (_container_mutex);
+
+        list_with_id_lookup::iterator const pos_container
+          (_container.find (id));
+        list_with_id_lookup::iterator const pos_container_inactive
+          (_container_inactive.find (id));
+
+        if (pos_container != _container.end())
+        {
+          activity_data.emplace (std::move (*pos_container->second));
+          _container.erase (pos_container);
+          active = true;
+        }
+        else if (pos_container_inactive != _container_inactive.end())
+        {
+          activity_data.emplace (std::move (*pos_container_inactive->second));
+          _container_inactive.erase (pos_container_inactive);
+        }
+        else
+        {
+          return false;
+        }
+      }
+
+      try
+      {
+        fun (*activity_data);
+      }
+      catch (...)
+      {
+        put (std::move (*activity_data), active);
+        throw;
+      }
+
+      put (std::move (*activity_data), active);
+
+      return true;
+    }
+
     void layer::async_remove_queue::interrupt()
     {
       std::lock_guard<std::recursive_mutex> const _ (_container_mutex);
@@ -789,6 +1018,168 @@ namespace we
       _condition_not_empty_or_interrupted.notify_all();
     }
 
+    // snapshots
+
+    void layer::snapshot_forget (id_type id)
+    {
+      if (_snapshots)
+      {
+        std::lock_guard<std::mutex> const _ (_snapshot_state_guard);
+        _terminated_since_snapshot.emplace (id);
+      }
+    }
+
+    void layer::write_snapshots()
+    {
+      std::unique_lock<std::mutex> lock (_snapshot_state_guard);
+
+      while ( !_snapshotting_interrupted_condition.wait_for
+                ( lock
+                , _snapshot_settings->interval
+                , [this] { return _snapshotting_interrupted; }
+                )
+            )
+      {
+        lock.unlock();
+        write_snapshot_round();
+        lock.lock();
+      }
+    }
+
+    void layer::write_snapshot_round()
+    {
+      //! \note Nets currently being extracted from are skipped and
+      //! stay changed for the next round. Taking a net only defers
+      //! the events for it while it is copied, it is written while
+      //! extraction continues. The whole net is copied only for its
+      //! first snapshot and after a failed write, afterwards the net
+      //! records the tokens put and deleted and is held back only for
+      //! taking these changes and the children extracted since the
+      //! last round, see gspc_we_snapshot_copy_seconds.
+      for (id_type const& id : _nets_to_extract_from.ids())
+      {
+        boost::optional<type::activity_t> structure;
+        boost::optional<type::net_marking_changes> changes;
+        std::vector<id_type> outstanding_children;
+        std::unordered_map<id_type, type::activity_t> new_children;
+
+        _nets_to_extract_from.take_and_put_back
+          ( id
+          , [&] (activity_data_type& activity_data)
+            {
+              std::lock_guard<std::mutex> const _ (_snapshot_state_guard);
+
+              if ( !activity_data._changed_since_snapshot
+                 && !_snapshot_failed.count (id)
+                 )
+              {
+                return;
+              }
+
+              fhg::metrics::scoped_timer const copy_timer
+                (_snapshot_copy_duration);
+
+              activity_data._changed_since_snapshot = false;
+              if (!_snapshotted_structures.count (id))
+              {
+                structure.emplace (*activity_data._activity);
+                activity_data._activity->record_marking_changes();
+              }
+              else
+              {
+                changes = activity_data._activity->take_marking_changes();
+              }
+
+              auto const& snapshotted (_snapshotted_children[id]);
+              for (auto const& child : activity_data._outstanding_children)
+              {
+                outstanding_children.emplace_back (child.first);
+                if (!snapshotted.count (child.first))
+                {
+                  new_children.emplace (child.first, child.second);
+                }
+              }
+            }
+          );
+
+        if (!structure && !changes)
+        {
+          continue;
+        }
+
+        //! \note there is nobody to report to: retry in the next
+        //! round even if the net does not change. The changes taken
+        //! are lost with a failed write, so the retry starts anew
+        //! with a copy of the whole net.
+        try
+        {
+          if (structure)
+          {
+            _snapshots->write_structure (id, *structure);
+          }
+          for (auto const& child : new_children)
+          {
+            _snapshots->write_child (id, child.first, child.second);
+          }
+          if (structure)
+          {
+            _snapshots->write_marking (id, outstanding_children);
+          }
+          else
+          {
+            _snapshots->append_marking_changes
+              (id, *changes, outstanding_children);
+          }
+
+          std::lock_guard<std::mutex> const _ (_snapshot_state_guard);
+          _snapshotted_structures.emplace (id);
+          _snapshotted_children[id] = std::unordered_set<id_type>
+            (outstanding_children.begin(), outstanding_children.end());
+          _snapshot_failed.erase (id);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> const _ (_snapshot_state_guard);
+          _snapshotted_structures.erase (id);
+          _snapshot_failed.emplace (id);
+        }
+
+        //! \note the net might have terminated while being written
+        remove_snapshots_of_terminated_nets();
+      }
+
+      remove_snapshots_of_terminated_nets();
+    }
+
+    void layer::remove_snapshots_of_terminated_nets()
+    {
+      std::unordered_set<id_type> terminated;
+
+      {
+        std::lock_guard<std::mutex> const _ (_snapshot_state_guard);
+        std::swap (terminated, _terminated_since_snapshot);
+        for (id_type const& id : terminated)
+        {
+          _snapshotted_children.erase (id);
+          _snapshotted_structures.erase (id);
+          _snapshot_failed.erase (id);
+        }
+      }
+
+      for (id_type const& id : terminated)
+      {
+        try
+        {
+          _snapshots->remove (id);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> const _ (_snapshot_state_guard);
+          _terminated_since_snapshot.emplace (id);
+        }
+      }
+    }
+
     // activity_data_type
 
     void layer::activity_data_type::child_finished
@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <metrics/registry.hpp>
+
 #include <util-generic/finally.hpp>
 
 #include <we/plugin/Plugins.hpp>
+#include <we/snapshot.hpp>
 #include <we/type/activity.hpp>
 #include <we/type/id.hpp>
 #include <we/type/net.hpp>
@@ -36,8 +39,10 @@
 #include <boost/optional.hpp>
 #include <boost/thread/scoped_thread.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <random>
 #include <unordered_map>
@@ -45,6 +50,7 @@
 #include <list>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace we
 {
@@ -73,11 +79,20 @@ namespace we
             , std::function<void (std::string workflow_response_id, boost::variant<std::exception_ptr, pnet::type::value::value_type>)> rts_workflow_response
             , std::function<id_type()> rts_id_generator
             , std::mt19937& random_extraction_engine
+              // periodically write snapshots of all nets
+            , boost::optional<snapshot_settings> = boost::none
+              // added to the labels of all metrics, e.g. the agent
+            , fhg::metrics::labels const& metric_labels = {}
             );
 
       // initial from exec_layer -> top level
       void submit (id_type, type::activity_t);
 
+      // initial from exec_layer -> top level, continue a net from a
+      // snapshot: the outstanding children are submitted again with
+      // their previous ids
+      void resume (net_snapshot);
+
       // initial from exec_layer -> top level
       void cancel (id_type);
 
@@ -104,6 +119,17 @@ namespace we
                      , std::string place_name
                      , pnet::type::value::value_type
                      );
+      // initial from exec_layer -> top level, unique put_token_id, all
+      // values are put in one step and acknowledged once
+      void put_tokens ( id_type
+                      , std::string put_token_id
+                      , std::string place_name
+                      , std::list<pnet::type::value::value_type>
+                      );
+
+      // the job a child was submitted for, none for top level jobs
+      // and children no longer running
+      boost::optional<id_type> parent (id_type child);
 
       // initial from exec_layer -> top level, unique workflow_response_id
       void request_workflow_response ( id_type
@@ -163,10 +189,17 @@ namespace we
 
         id_type _id;
         std::unique_ptr<type::activity_t> _activity;
+
+        //! \note copies of the children extracted and not yet
+        //! terminated, only kept when writing snapshots
+        std::unordered_map<id_type, type::activity_t> _outstanding_children;
+        bool _changed_since_snapshot {true};
       };
 
       struct async_remove_queue
       {
+        explicit async_remove_queue (fhg::metrics::labels const&);
+
         struct RemovalFunction
         {
           void operator() (activity_data_type&) &&;
@@ -213,6 +246,14 @@ namespace we
 
         void forget (id_type);
 
+        //! \note the ids of all nets not currently being extracted from
+        std::vector<id_type> ids() const;
+        //! \note Takes the net out of the queue while fun runs without
+        //! holding the lock, events for it are deferred as when being
+        //! extracted from. False if the net is not in the queue.
+        bool take_and_put_back
+          (id_type, std::function<void (activity_data_type&)>);
+
         struct interrupted{};
         void interrupt();
 
@@ -224,15 +265,24 @@ namespace we
                                     > position_in_container_type;
           typedef position_in_container_type::iterator iterator;
 
+          list_with_id_lookup (fhg::metrics::gauge& size);
+          ~list_with_id_lookup();
+          list_with_id_lookup (list_with_id_lookup const&) = delete;
+          list_with_id_lookup& operator= (list_with_id_lookup const&) = delete;
+          list_with_id_lookup (list_with_id_lookup&&) = delete;
+          list_with_id_lookup& operator= (list_with_id_lookup&&) = delete;
+
           activity_data_type get_front();
           void push_back (activity_data_type);
           iterator find (id_type);
           iterator end();
           void erase (iterator);
           bool empty() const;
+          void append_ids (std::vector<id_type>&) const;
         private:
           std::list<activity_data_type> _container;
           position_in_container_type _position_in_container;
+          fhg::metrics::gauge& _size;
         };
 
         mutable std::recursive_mutex _container_mutex;
@@ -256,6 +306,12 @@ namespace we
       std::mt19937& _random_extraction_engine;
       void extract_from_nets();
 
+      fhg::metrics::histogram& _extraction_duration;
+      fhg::metrics::counter& _extracted_activities;
+      //! \note the time a net is held back from extraction to copy
+      //! it for a snapshot
+      fhg::metrics::histogram& _snapshot_copy_duration;
+
       std::unordered_map<id_type, std::function<void()>>
         _finalize_job_cancellation;
 
@@ -309,7 +365,27 @@ namespace we
 
       std::unordered_set<id_type> _ignore_canceled_by_eureka;
 
+      boost::optional<snapshot_settings> _snapshot_settings;
+      std::unique_ptr<snapshot_directory> _snapshots;
+      void write_snapshots();
+      void write_snapshot_round();
+      void remove_snapshots_of_terminated_nets();
+      void snapshot_forget (id_type);
+
+      //! \note guards the snapshot state, never held while writing
+      std::mutex _snapshot_state_guard;
+      std::unordered_map<id_type, std::unordered_set<id_type>>
+        _snapshotted_children;
+      std::unordered_set<id_type> _snapshotted_structures;
+      std::unordered_set<id_type> _snapshot_failed;
+      std::unordered_set<id_type> _terminated_since_snapshot;
+      bool _snapshotting_interrupted {false};
+      std::condition_variable _snapshotting_interrupted_condition;
+
       boost::strict_scoped_thread<> _extract_from_nets_thread;
       fhg::util::finally_t<std::function<void()>> _stop_extracting;
+
+      std::unique_ptr<boost::strict_scoped_thread<>> _snapshot_thread;
+      fhg::util::finally_t<std::function<void()>> _stop_snapshotting;
     };
 }
@@ -0,0 +1,144 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <we/loader/global_memory_cache.hpp>
+
+namespace we
+{
+  namespace loader
+  {
+    global_memory_cache::global_memory_cache (std::size_t capacity)
+      : _capacity (capacity)
+    {}
+
+    std::size_t global_memory_cache::capacity() const
+    {
+      return _capacity;
+    }
+
+    boost::optional<std::size_t> global_memory_cache::lookup
+      (range const& range)
+    {
+      auto const entry (_entries.find (range));
+
+      if (entry == _entries.end())
+      {
+        ++_misses;
+
+        return boost::none;
+      }
+
+      ++_hits;
+
+      _recently_used.splice
+        ( _recently_used.begin()
+        , _recently_used
+        , entry->second.recently_used
+        );
+
+      return entry->second.position;
+    }
+
+    boost::optional<std::size_t> global_memory_cache::insert
+      (range const& range)
+    {
+      if (range.size == 0 || range.size > _capacity)
+      {
+        return boost::none;
+      }
+
+      auto const existing (_entries.find (range));
+
+      if (existing != _entries.end())
+      {
+        _recently_used.splice
+          ( _recently_used.begin()
+          , _recently_used
+          , existing->second.recently_used
+          );
+
+        return existing->second.position;
+      }
+
+      boost::optional<std::size_t> position (first_fit (range.size));
+
+      while (!position)
+      {
+        //! \note terminates: with everything evicted the range fits
+        evict (_entries.find (_recently_used.back()));
+
+        position = first_fit (range.size);
+      }
+
+      _recently_used.emplace_front (range);
+      _entries.emplace (range, entry {*position, _recently_used.begin()});
+      _occupied.emplace (*position, *position + range.size);
+
+      return position;
+    }
+
+    void global_memory_cache::drop (unsigned long handle)
+    {
+      auto entry
+        (_entries.lower_bound (range {handle, 0, 0}));
+
+      while (entry != _entries.end() && entry->first.handle == handle)
+      {
+        evict (entry++);
+      }
+    }
+
+    std::size_t global_memory_cache::hits() const
+    {
+      return _hits;
+    }
+    std::size_t global_memory_cache::misses() const
+    {
+      return _misses;
+    }
+
+    boost::optional<std::size_t> global_memory_cache::first_fit
+      (std::size_t size) const
+    {
+      std::size_t gap_begin (0);
+
+      for (auto const& copy : _occupied)
+      {
+        if (copy.first - gap_begin >= size)
+        {
+          return gap_begin;
+        }
+
+        gap_begin = copy.second;
+      }
+
+      if (_capacity - gap_begin >= size)
+      {
+        return gap_begin;
+      }
+
+      return boost::none;
+    }
+
+    void global_memory_cache::evict (std::map<range, entry>::iterator entry)
+    {
+      _occupied.erase (entry->second.position);
+      _recently_used.erase (entry->second.recently_used);
+      _entries.erase (entry);
+    }
+  }
+}
@@ -0,0 +1,100 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <tuple>
+
+namespace we
+{
+  namespace loader
+  {
+    //! Copies of global memory ranges, kept in a part of the shared
+    //! memory of a worker that is reserved for them, across tasks.
+    //! Only the bookkeeping lives here: positions are relative to the
+    //! start of the reserved part. Least recently used ranges are
+    //! evicted to make room.
+    //! \note a range is identified by handle, offset and size only and
+    //! is not invalidated: writes to the global memory by other
+    //! workers or processes are not detected. Using a cached range is
+    //! correct only as long as nobody writes it, which the transitions
+    //! opt into by declaring their gets read-only, see
+    //! we::type::transition_t::global_memory_gets_are_read_only()
+    class global_memory_cache
+    {
+    public:
+      struct range
+      {
+        unsigned long handle;
+        unsigned long offset;
+        unsigned long size;
+
+        bool operator< (range const& other) const
+        {
+          return std::tie (handle, offset, size)
+            < std::tie (other.handle, other.offset, other.size);
+        }
+      };
+
+      global_memory_cache (std::size_t capacity);
+
+      std::size_t capacity() const;
+
+      //! \returns the position of the cached copy, none if the range
+      //! is not cached
+      boost::optional<std::size_t> lookup (range const&);
+
+      //! \returns the position to store the copy of the range at,
+      //! evicting as many ranges as needed, none if the range exceeds
+      //! the capacity
+      boost::optional<std::size_t> insert (range const&);
+
+      //! \note drops all ranges of the given handle, e.g. when the
+      //! worker itself writes to it
+      void drop (unsigned long handle);
+
+      std::size_t hits() const;
+      std::size_t misses() const;
+
+    private:
+      std::size_t _capacity;
+
+      //! \note front: most recently used
+      std::list<range> _recently_used;
+
+      struct entry
+      {
+        std::size_t position;
+        std::list<range>::iterator recently_used;
+      };
+      std::map<range, entry> _entries;
+      //! position -> end of the copy
+      std::map<std::size_t, std::size_t> _occupied;
+
+      boost::optional<std::size_t> first_fit (std::size_t size) const;
+      void evict (std::map<range, entry>::iterator);
+
+      std::size_t _hits {0};
+      std::size_t _misses {0};
+    };
+  }
+}
@@ -48,24 +48,78 @@ namespace we
 
       const boost::filesystem::path file_name ("lib" + module + ".so");
 
+      if (boost::optional<boost::filesystem::path> const p = resolve (file_name))
+      {
+        return *_module_table
+          .emplace ( module
+                   , require_module_unloads_without_rest
+                   ? fhg::util::cxx14::make_unique<Module>
+                       (RequireModuleUnloadsWithoutRest{}, *p / file_name)
+                   : fhg::util::cxx14::make_unique<Module> (*p / file_name)
+                   )
+          .first->second;
+      }
+
+      throw module_not_found
+        (file_name.string(), fhg::util::join (_search_path, ':').string());
+    }
+
+    void loader::preload (std::list<std::string> const& modules)
+    {
+      for (std::string const& m : modules)
+      {
+        module (false, m);
+      }
+    }
+
+    boost::optional<boost::filesystem::path> loader::resolve
+      (boost::filesystem::path const& file_name)
+    {
+      if (!_search_path_is_indexed)
+      {
+        for (boost::filesystem::path const& p : _search_path)
+        {
+          boost::system::error_code ec;
+
+          for ( boost::filesystem::directory_iterator entry (p, ec), end
+              ; !ec && entry != end
+              ; entry.increment (ec)
+              )
+          {
+            //! \note emplace keeps the first, i.e. the search order
+            _search_path_index.emplace
+              (entry->path().filename().string(), p);
+          }
+        }
+
+        _search_path_is_indexed = true;
+      }
+
+      auto const indexed (_search_path_index.find (file_name.string()));
+
+      if (indexed != _search_path_index.end())
+      {
+        //! \note the index is a snapshot: a file removed or moved
+        //! since is probed for like one that was never indexed
+        if (boost::filesystem::exists (indexed->second / file_name))
+        {
+          return indexed->second;
+        }
+
+        _search_path_index.erase (indexed);
+      }
+
       for (boost::filesystem::path const& p : _search_path)
       {
         if (boost::filesystem::exists (p / file_name))
         {
-          return *_module_table
-            .emplace ( module
-                     , require_module_unloads_without_rest
-                     ? fhg::util::cxx14::make_unique<Module>
-                         (RequireModuleUnloadsWithoutRest{}, p / file_name)
-                     : fhg::util::cxx14::make_unique<Module>
-                         (p / file_name)
-                     )
-            .first->second;
+          _search_path_index.emplace (file_name.string(), p);
+
+          return p;
         }
       }
 
-      throw module_not_found
-        (file_name.string(), fhg::util::join (_search_path, ':').string());
+      return boost::none;
     }
   }
 }
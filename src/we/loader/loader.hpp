@@ -19,6 +19,7 @@
 #include <we/loader/Module.hpp>
 
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 
 #include <list>
 #include <mutex>
@@ -43,10 +44,25 @@ namespace we
         , const std::string &module
         );
 
+      //! \note loads the given modules ahead of their first use, e.g.
+      //! at worker startup, throws if any of them can not be loaded
+      void preload (std::list<std::string> const& modules);
+
    private:
       std::mutex _table_mutex;
       std::unordered_map<std::string, std::unique_ptr<Module>> _module_table;
       std::list<boost::filesystem::path> const _search_path;
+
+      //! \note the search path is listed once, instead of probing
+      //! every entry for every module: file name -> directory. A hit
+      //! is checked to still exist, files that appear or move later
+      //! are found by probing. A file that appears in an earlier
+      //! entry than an indexed one does not shadow the indexed one.
+      boost::optional<boost::filesystem::path> resolve
+        (boost::filesystem::path const& file_name);
+      bool _search_path_is_indexed {false};
+      std::unordered_map<std::string, boost::filesystem::path>
+        _search_path_index;
     };
   }
 }
@@ -17,6 +17,7 @@
 #include <we/loader/module_call.hpp>
 
 #include <we/loader/exceptions.hpp>
+#include <we/loader/global_memory_cache.hpp>
 
 #include <we/type/id.hpp>
 #include <we/type/port.hpp>
@@ -30,6 +31,7 @@
 
 #include <boost/format.hpp>
 
+#include <cstring>
 #include <functional>
 #include <unordered_map>
 
@@ -202,6 +204,8 @@ namespace we
       ( we::loader::loader& loader
       , gpi::pc::client::api_t /*const*/* virtual_memory_api
       , gspc::scoped_allocation /*const*/* shared_memory
+      , global_memory_cache* cache
+      , bool global_memory_gets_are_read_only
       , drts::worker::context* context
       , expr::eval::context const& input
       , const we::type::module_call_t& module_call
@@ -209,6 +213,7 @@ namespace we
     {
       std::map<std::string, void*> pointers;
       std::unordered_map<std::string, buffer> memory_buffer;
+      char* local_memory (nullptr);
 
       if (!module_call.memory_buffers().empty())
       {
@@ -244,7 +249,9 @@ namespace we
             );
         }
 
-        std::size_t const shared_memory_size (shared_memory->size());
+        //! \note the cache is kept at the end of the shared memory
+        std::size_t const shared_memory_size
+          (shared_memory->size() - (cache ? cache->capacity() : 0));
         auto const total_size_required
           (module_call.memory_buffer_size_total (input));
         if (total_size_required > shared_memory_size)
@@ -260,8 +267,8 @@ namespace we
             );
          }
 
-        char* const local_memory
-          ((static_cast<char*> (virtual_memory_api->ptr (*shared_memory))));
+        local_memory
+          = static_cast<char*> (virtual_memory_api->ptr (*shared_memory));
         char* buffer_ptr (local_memory);
         std::size_t space (shared_memory_size);
 
@@ -298,7 +305,84 @@ namespace we
         }
       }
 
-      transfer ( get_global_data, virtual_memory_api, shared_memory
+      auto const get_global_data_cached
+        ( [&] ( gpi::pc::client::api_t /*const*/& virtual_memory
+              , gspc::scoped_allocation /*const*/& shm
+              , const fvmAllocHandle_t global_memory_handle
+              , const fvmOffset_t global_memory_offset
+              , const fvmSize_t size
+              , const fvmShmemOffset_t shared_memory_offset
+              )
+          {
+            if (!cache || !global_memory_gets_are_read_only)
+            {
+              return get_global_data
+                ( virtual_memory, shm
+                , global_memory_handle, global_memory_offset, size
+                , shared_memory_offset
+                );
+            }
+
+            char* const cached_copies
+              (local_memory + shared_memory->size() - cache->capacity());
+            global_memory_cache::range const range
+              {global_memory_handle, global_memory_offset, size};
+
+            if (auto const position = cache->lookup (range))
+            {
+              std::memcpy ( local_memory + shared_memory_offset
+                          , cached_copies + *position
+                          , size
+                          );
+
+              return;
+            }
+
+            get_global_data
+              ( virtual_memory, shm
+              , global_memory_handle, global_memory_offset, size
+              , shared_memory_offset
+              );
+
+            if (auto const position = cache->insert (range))
+            {
+              std::memcpy ( cached_copies + *position
+                          , local_memory + shared_memory_offset
+                          , size
+                          );
+            }
+          }
+        );
+      auto const put_global_data_dropping_cached
+        ( [&] ( gpi::pc::client::api_t /*const*/& virtual_memory
+              , gspc::scoped_allocation /*const*/& shm
+              , const fvmAllocHandle_t global_memory_handle
+              , const fvmOffset_t global_memory_offset
+              , const fvmSize_t size
+              , const fvmShmemOffset_t shared_memory_offset
+              )
+          {
+            //! \note not an invalidation: writes of other workers are
+            //! not seen, the cached ranges rely on the transitions'
+            //! promise that nobody writes them. Dropping the ranges of
+            //! the worker's own writes only keeps a transition that
+            //! breaks the promise from reading its own stale data. Any
+            //! write drops all ranges of the handle, also those cached
+            //! for other transitions.
+            if (cache)
+            {
+              cache->drop (global_memory_handle);
+            }
+
+            put_global_data
+              ( virtual_memory, shm
+              , global_memory_handle, global_memory_offset, size
+              , shared_memory_offset
+              );
+          }
+        );
+
+      transfer ( get_global_data_cached, virtual_memory_api, shared_memory
                , memory_buffer, module_call.gets (input)
                );
 
@@ -336,10 +420,10 @@ namespace we
         }
       }
 
-      transfer ( put_global_data, virtual_memory_api, shared_memory
+      transfer ( put_global_data_dropping_cached, virtual_memory_api, shared_memory
                , memory_buffer, puts_evaluated_before_call
                );
-      transfer ( put_global_data, virtual_memory_api, shared_memory
+      transfer ( put_global_data_dropping_cached, virtual_memory_api, shared_memory
                , memory_buffer, module_call.puts_evaluated_after_call (out)
                );
 
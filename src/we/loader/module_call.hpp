@@ -17,6 +17,7 @@
 #pragma once
 
 #include <we/expr/eval/context.hpp>
+#include <we/loader/global_memory_cache.hpp>
 #include <we/loader/loader.hpp>
 #include <we/type/module_call.hpp>
 
@@ -31,6 +32,11 @@ namespace we
       ( we::loader::loader& loader
       , gpi::pc::client::api_t /*const*/*
       , gspc::scoped_allocation /*const*/*
+      //! \note optional, reserves the end of the shared memory
+      , global_memory_cache*
+      //! \note gets are served from the cache only if set, puts
+      //! always drop the cached ranges of their handle
+      , bool global_memory_gets_are_read_only
       , drts::worker::context* context
       , expr::eval::context const& input
       , const we::type::module_call_t& module_call
@@ -0,0 +1,129 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <we/loader/global_memory_cache.hpp>
+
+#include <util-generic/testing/printer/optional.hpp>
+
+namespace we
+{
+  namespace loader
+  {
+    BOOST_AUTO_TEST_CASE (inserted_range_is_found_at_its_position)
+    {
+      global_memory_cache cache (100);
+
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 0, 10}), boost::none);
+
+      auto const position (cache.insert ({1, 0, 10}));
+
+      BOOST_REQUIRE (position);
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 0, 10}), position);
+      BOOST_REQUIRE_EQUAL (cache.hits(), 1);
+      BOOST_REQUIRE_EQUAL (cache.misses(), 1);
+    }
+
+    BOOST_AUTO_TEST_CASE (ranges_differing_in_any_component_are_distinct)
+    {
+      global_memory_cache cache (100);
+
+      cache.insert ({1, 0, 10});
+
+      BOOST_REQUIRE_EQUAL (cache.lookup ({2, 0, 10}), boost::none);
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 5, 10}), boost::none);
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 0, 5}), boost::none);
+    }
+
+    BOOST_AUTO_TEST_CASE (cached_ranges_do_not_overlap)
+    {
+      global_memory_cache cache (30);
+
+      auto const a (cache.insert ({1, 0, 10}));
+      auto const b (cache.insert ({1, 10, 10}));
+      auto const c (cache.insert ({1, 20, 10}));
+
+      BOOST_REQUIRE (a && b && c);
+      BOOST_REQUIRE (*a + 10 <= *b || *b + 10 <= *a);
+      BOOST_REQUIRE (*a + 10 <= *c || *c + 10 <= *a);
+      BOOST_REQUIRE (*b + 10 <= *c || *c + 10 <= *b);
+      BOOST_REQUIRE_LE (std::max ({*a, *b, *c}) + 10, cache.capacity());
+    }
+
+    BOOST_AUTO_TEST_CASE (least_recently_used_range_is_evicted)
+    {
+      global_memory_cache cache (30);
+
+      cache.insert ({1, 0, 10});
+      cache.insert ({1, 10, 10});
+      cache.insert ({1, 20, 10});
+
+      cache.lookup ({1, 0, 10});
+
+      BOOST_REQUIRE (cache.insert ({2, 0, 10}));
+
+      BOOST_REQUIRE (cache.lookup ({1, 0, 10}));
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 10, 10}), boost::none);
+      BOOST_REQUIRE (cache.lookup ({1, 20, 10}));
+      BOOST_REQUIRE (cache.lookup ({2, 0, 10}));
+    }
+
+    BOOST_AUTO_TEST_CASE (ranges_are_evicted_until_a_large_range_fits)
+    {
+      global_memory_cache cache (30);
+
+      cache.insert ({1, 0, 10});
+      cache.insert ({1, 10, 10});
+      cache.insert ({1, 20, 10});
+
+      BOOST_REQUIRE_EQUAL (cache.insert ({2, 0, 30}), std::size_t (0));
+
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 0, 10}), boost::none);
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 10, 10}), boost::none);
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 20, 10}), boost::none);
+    }
+
+    BOOST_AUTO_TEST_CASE (range_exceeding_the_capacity_is_not_cached)
+    {
+      global_memory_cache cache (30);
+
+      cache.insert ({1, 0, 10});
+
+      BOOST_REQUIRE_EQUAL (cache.insert ({2, 0, 31}), boost::none);
+      BOOST_REQUIRE (cache.lookup ({1, 0, 10}));
+    }
+
+    BOOST_AUTO_TEST_CASE (drop_removes_all_ranges_of_the_handle_only)
+    {
+      global_memory_cache cache (100);
+
+      cache.insert ({1, 0, 10});
+      cache.insert ({1, 50, 10});
+      cache.insert ({2, 0, 10});
+
+      cache.drop (1);
+
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 0, 10}), boost::none);
+      BOOST_REQUIRE_EQUAL (cache.lookup ({1, 50, 10}), boost::none);
+      BOOST_REQUIRE (cache.lookup ({2, 0, 10}));
+
+      //! \note the space of the dropped ranges is reused
+      BOOST_REQUIRE (cache.insert ({3, 0, 90}));
+    }
+  }
+}
@@ -23,9 +23,12 @@
 
 #include <we/type/value/boost/test/printer.hpp>
 
+#include <util-generic/temporary_path.hpp>
 #include <util-generic/testing/flatten_nested_exceptions.hpp>
 #include <util-generic/testing/require_exception.hpp>
 
+#include <boost/filesystem.hpp>
+
 BOOST_AUTO_TEST_CASE (answer_question)
 {
   we::loader::loader loader ({"."});
@@ -108,3 +111,68 @@ BOOST_AUTO_TEST_CASE (load_order)
 
   BOOST_REQUIRE_EQUAL (start().size(), 2);
 }
+
+BOOST_AUTO_TEST_CASE (preloaded_module_does_not_need_the_file_anymore)
+{
+  fhg::util::temporary_path const _directory;
+  boost::filesystem::path const directory (_directory);
+
+  boost::filesystem::copy_file ("libanswer.so", directory / "libanswer.so");
+
+  we::loader::loader loader ({directory});
+
+  loader.preload ({"answer"});
+
+  boost::filesystem::remove (directory / "libanswer.so");
+
+  expr::eval::context out;
+
+  loader["answer"].call ( "answer", nullptr, expr::eval::context(), out
+                        , std::map<std::string, void*>()
+                        );
+
+  BOOST_REQUIRE_EQUAL
+    (out.value ({"out"}), pnet::type::value::value_type (42L));
+}
+
+BOOST_AUTO_TEST_CASE (preload_throws_for_missing_module)
+{
+  we::loader::loader loader ({"<p>"});
+
+  fhg::util::testing::require_exception
+    ( [&loader] { loader.preload ({"name"}); }
+    , we::loader::module_not_found ("libname.so", "\"<p>\"")
+    );
+}
+
+BOOST_AUTO_TEST_CASE (module_that_appears_after_first_lookup_is_found)
+{
+  fhg::util::temporary_path const _directory;
+  boost::filesystem::path const directory (_directory);
+
+  we::loader::loader loader ({directory});
+
+  BOOST_REQUIRE_THROW (loader["answer"], we::loader::module_not_found);
+
+  boost::filesystem::copy_file ("libanswer.so", directory / "libanswer.so");
+
+  loader["answer"];
+}
+
+BOOST_AUTO_TEST_CASE (module_that_moves_after_first_lookup_is_found)
+{
+  fhg::util::temporary_path const _first;
+  boost::filesystem::path const first (_first);
+  fhg::util::temporary_path const _second;
+  boost::filesystem::path const second (_second);
+
+  boost::filesystem::copy_file ("libanswer.so", first / "libanswer.so");
+
+  we::loader::loader loader ({first, second});
+
+  BOOST_REQUIRE_THROW (loader["question"], we::loader::module_not_found);
+
+  boost::filesystem::rename (first / "libanswer.so", second / "libanswer.so");
+
+  loader["answer"];
+}
@@ -0,0 +1,482 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <we/snapshot.hpp>
+
+#include <util-generic/nest_exceptions.hpp>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/format.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace we
+{
+  namespace
+  {
+    constexpr char const snapshot_magic[] = "gspc-snapshot";
+    constexpr std::size_t const snapshot_magic_size
+      (sizeof (snapshot_magic) - 1);
+    //! \note increment on any change of the layout
+    constexpr std::uint32_t const snapshot_format_version (3);
+
+    //! \note job ids may contain any character, file names may not
+    std::string file_name (sdpa::job_id_t const& id)
+    {
+      std::ostringstream name;
+      name << std::hex << std::setfill ('0');
+      for (unsigned char c : id)
+      {
+        name << std::setw (2) << static_cast<unsigned int> (c);
+      }
+      return name.str();
+    }
+    sdpa::job_id_t job_id (std::string const& name)
+    {
+      if (name.size() % 2)
+      {
+        throw std::runtime_error ("not a snapshot file name: " + name);
+      }
+
+      sdpa::job_id_t id;
+      for (std::size_t i (0); i < name.size(); i += 2)
+      {
+        id.push_back (static_cast<char> (std::stoul (name.substr (i, 2), nullptr, 16)));
+      }
+      return id;
+    }
+
+    boost::filesystem::path children_directory
+      (boost::filesystem::path const& net_directory)
+    {
+      return net_directory / "children";
+    }
+    boost::filesystem::path structure_file
+      (boost::filesystem::path const& net_directory)
+    {
+      return net_directory / "structure";
+    }
+    boost::filesystem::path marking_file
+      (boost::filesystem::path const& net_directory)
+    {
+      return net_directory / "marking";
+    }
+    boost::filesystem::path annotation_file
+      (boost::filesystem::path const& net_directory)
+    {
+      return net_directory / "annotation";
+    }
+
+    //! \note write to a sibling and rename to never leave a partially
+    //! written file behind
+    template<typename Write>
+      void write_atomically (boost::filesystem::path const& path, Write&& write)
+    {
+      boost::filesystem::path const temporary (path.string() + ".tmp");
+      {
+        boost::filesystem::ofstream stream
+          (temporary, std::ios::binary | std::ios::trunc);
+        write (stream);
+        stream.flush();
+        if (!stream)
+        {
+          throw std::runtime_error
+            ((boost::format ("could not write '%1%'") % temporary).str());
+        }
+      }
+      boost::filesystem::rename (temporary, path);
+    }
+
+    void write_header (std::ostream& stream)
+    {
+      stream.write (snapshot_magic, snapshot_magic_size);
+      stream.write ( reinterpret_cast<char const*> (&snapshot_format_version)
+                   , sizeof (snapshot_format_version)
+                   );
+    }
+
+    //! \note prefixed by its size, to detect a change that was
+    //! interrupted while being appended
+    void write_change
+      ( std::ostream& stream
+      , std::vector<sdpa::job_id_t> const& outstanding_children
+      , type::net_marking_changes const& changes
+      )
+    {
+      std::ostringstream record;
+      {
+        boost::archive::binary_oarchive archive (record);
+        archive << outstanding_children;
+        archive << changes;
+      }
+      std::string const payload (record.str());
+      std::uint64_t const size (payload.size());
+
+      stream.write (reinterpret_cast<char const*> (&size), sizeof (size));
+      stream.write (payload.data(), payload.size());
+    }
+
+    struct marking_content
+    {
+      std::vector<sdpa::job_id_t> outstanding_children;
+      std::list<type::net_marking_changes> changes;
+      //! \note without a change interrupted while being appended
+      std::uintmax_t complete_size;
+    };
+
+    marking_content read_marking (boost::filesystem::path const& path)
+    {
+      boost::filesystem::ifstream stream (path, std::ios::binary);
+
+      char magic[snapshot_magic_size];
+      std::uint32_t version;
+
+      if ( !stream.read (magic, snapshot_magic_size)
+         || std::memcmp (magic, snapshot_magic, snapshot_magic_size)
+         || !stream.read (reinterpret_cast<char*> (&version), sizeof (version))
+         )
+      {
+        throw std::runtime_error ("corrupt snapshot header");
+      }
+
+      if (version != snapshot_format_version)
+      {
+        throw std::runtime_error
+          ( ( boost::format ("snapshot format version %1%"
+                            " unsupported, expected version %2%"
+                            )
+            % version
+            % snapshot_format_version
+            ).str()
+          );
+      }
+
+      marking_content content {{}, {}, 0};
+      content.complete_size = stream.tellg();
+
+      std::uint64_t size;
+      while (stream.read (reinterpret_cast<char*> (&size), sizeof (size)))
+      {
+        std::string payload (size, '\0');
+        if (!stream.read (&payload[0], payload.size()))
+        {
+          break;
+        }
+
+        std::istringstream record (payload);
+        boost::archive::binary_iarchive archive (record);
+        archive >> content.outstanding_children;
+        content.changes.emplace_back();
+        archive >> content.changes.back();
+
+        content.complete_size = stream.tellg();
+      }
+
+      if (content.changes.empty())
+      {
+        throw std::runtime_error ("snapshot without marking");
+      }
+
+      return content;
+    }
+  }
+
+  snapshot_directory::snapshot_directory (boost::filesystem::path directory)
+    : _directory (std::move (directory))
+  {
+    boost::filesystem::create_directories (_directory);
+  }
+
+  void snapshot_directory::write_structure
+    (sdpa::job_id_t const& net, type::activity_t const& activity) const
+  {
+    boost::filesystem::path const net_directory (_directory / file_name (net));
+
+    boost::filesystem::create_directories (net_directory);
+
+    write_atomically
+      ( structure_file (net_directory)
+      , [&] (std::ostream& stream)
+        {
+          activity.write (stream, type::activity_encoding::binary);
+        }
+      );
+  }
+
+  void snapshot_directory::write_child ( sdpa::job_id_t const& net
+                                       , sdpa::job_id_t const& child
+                                       , type::activity_t const& activity
+                                       ) const
+  {
+    boost::filesystem::path const children
+      (children_directory (_directory / file_name (net)));
+
+    boost::filesystem::create_directories (children);
+
+    write_atomically
+      ( children / file_name (child)
+      , [&] (std::ostream& stream)
+        {
+          activity.write (stream, type::activity_encoding::binary);
+        }
+      );
+  }
+
+  void snapshot_directory::write_marking
+    ( sdpa::job_id_t const& net
+    , std::vector<sdpa::job_id_t> const& outstanding_children
+    ) const
+  {
+    boost::filesystem::path const net_directory (_directory / file_name (net));
+
+    if (!boost::filesystem::exists (structure_file (net_directory)))
+    {
+      throw std::logic_error
+        ("write_marking: structure of net " + net + " not written");
+    }
+
+    write_atomically
+      ( marking_file (net_directory)
+      , [&] (std::ostream& stream)
+        {
+          write_header (stream);
+          write_change
+            (stream, outstanding_children, type::net_marking_changes());
+        }
+      );
+
+    remove_terminated_children (net_directory, outstanding_children);
+  }
+
+  void snapshot_directory::append_marking_changes
+    ( sdpa::job_id_t const& net
+    , type::net_marking_changes const& changes
+    , std::vector<sdpa::job_id_t> const& outstanding_children
+    ) const
+  {
+    boost::filesystem::path const net_directory (_directory / file_name (net));
+    boost::filesystem::path const marking (marking_file (net_directory));
+
+    if (!boost::filesystem::exists (marking))
+    {
+      throw std::logic_error
+        ("append_marking_changes: marking of net " + net + " not written");
+    }
+
+    {
+      boost::filesystem::ofstream stream
+        (marking, std::ios::binary | std::ios::app);
+      write_change (stream, outstanding_children, changes);
+      stream.flush();
+      if (!stream)
+      {
+        throw std::runtime_error
+          ((boost::format ("could not write '%1%'") % marking).str());
+      }
+    }
+
+    remove_terminated_children (net_directory, outstanding_children);
+
+    if ( boost::filesystem::file_size (marking)
+       > boost::filesystem::file_size (structure_file (net_directory))
+       )
+    {
+      compact (net_directory);
+    }
+  }
+
+  void snapshot_directory::remove_terminated_children
+    ( boost::filesystem::path const& net_directory
+    , std::vector<sdpa::job_id_t> const& outstanding_children
+    ) const
+  {
+    boost::filesystem::path const children (children_directory (net_directory));
+
+    if (!boost::filesystem::exists (children))
+    {
+      return;
+    }
+
+    std::set<std::string> const outstanding
+      ( [&]
+        {
+          std::set<std::string> names;
+          for (sdpa::job_id_t const& child : outstanding_children)
+          {
+            names.emplace (file_name (child));
+          }
+          return names;
+        }()
+      );
+
+    std::list<boost::filesystem::path> terminated;
+    for ( boost::filesystem::directory_entry const& entry
+        : boost::filesystem::directory_iterator (children)
+        )
+    {
+      if (!outstanding.count (entry.path().filename().string()))
+      {
+        terminated.emplace_back (entry.path());
+      }
+    }
+    for (boost::filesystem::path const& path : terminated)
+    {
+      boost::filesystem::remove (path);
+    }
+  }
+
+  void snapshot_directory::compact
+    (boost::filesystem::path const& net_directory) const
+  {
+    marking_content const content
+      (read_marking (marking_file (net_directory)));
+
+    type::activity_t activity (structure_file (net_directory));
+    activity.apply_marking_changes (content.changes);
+
+    write_atomically
+      ( structure_file (net_directory)
+      , [&] (std::ostream& stream)
+        {
+          activity.write (stream, type::activity_encoding::binary);
+        }
+      );
+
+    //! \note interrupted here, the changes are applied again when
+    //! loading, which has no effect
+    write_atomically
+      ( marking_file (net_directory)
+      , [&] (std::ostream& stream)
+        {
+          write_header (stream);
+          write_change
+            ( stream
+            , content.outstanding_children
+            , type::net_marking_changes()
+            );
+        }
+      );
+  }
+
+  void snapshot_directory::write_annotation
+    (sdpa::job_id_t const& net, std::string const& annotation) const
+  {
+    boost::filesystem::path const net_directory (_directory / file_name (net));
+
+    boost::filesystem::create_directories (net_directory);
+
+    write_atomically
+      ( annotation_file (net_directory)
+      , [&] (std::ostream& stream)
+        {
+          stream.write (annotation.data(), annotation.size());
+        }
+      );
+  }
+
+  void snapshot_directory::remove (sdpa::job_id_t const& net) const
+  {
+    boost::filesystem::remove_all (_directory / file_name (net));
+  }
+
+  std::list<net_snapshot> snapshot_directory::load() const
+  {
+    std::list<net_snapshot> snapshots;
+    std::list<boost::filesystem::path> incomplete;
+
+    for ( boost::filesystem::directory_entry const& entry
+        : boost::filesystem::directory_iterator (_directory)
+        )
+    {
+      boost::filesystem::path const& net_directory (entry.path());
+
+      if (!boost::filesystem::is_directory (net_directory))
+      {
+        continue;
+      }
+
+      if (!boost::filesystem::exists (marking_file (net_directory)))
+      {
+        incomplete.emplace_back (net_directory);
+        continue;
+      }
+
+      fhg::util::nest_exceptions<std::runtime_error>
+        ( [&]
+          {
+            boost::filesystem::path const marking
+              (marking_file (net_directory));
+            marking_content const content (read_marking (marking));
+
+            if (boost::filesystem::file_size (marking) > content.complete_size)
+            {
+              boost::filesystem::resize_file
+                (marking, content.complete_size);
+            }
+
+            net_snapshot snapshot
+              { job_id (net_directory.filename().string())
+              , type::activity_t (structure_file (net_directory))
+              , {}
+              , boost::none
+              };
+            snapshot.net.apply_marking_changes (content.changes);
+
+            if (boost::filesystem::exists (annotation_file (net_directory)))
+            {
+              boost::filesystem::ifstream annotation
+                (annotation_file (net_directory), std::ios::binary);
+              snapshot.annotation = std::string
+                ( std::istreambuf_iterator<char> (annotation)
+                , std::istreambuf_iterator<char>()
+                );
+            }
+
+            for (sdpa::job_id_t const& child : content.outstanding_children)
+            {
+              snapshot.outstanding_children.emplace
+                ( child
+                , type::activity_t
+                    (children_directory (net_directory) / file_name (child))
+                );
+            }
+
+            snapshots.emplace_back (std::move (snapshot));
+          }
+        , ( boost::format ("loading snapshot %1%") % net_directory
+          ).str()
+        );
+    }
+
+    for (boost::filesystem::path const& net_directory : incomplete)
+    {
+      boost::filesystem::remove_all (net_directory);
+    }
+
+    return snapshots;
+  }
+}
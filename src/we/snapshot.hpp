@@ -0,0 +1,110 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <we/type/activity.hpp>
+#include <we/type/net.hpp>
+
+#include <sdpa/types.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace we
+{
+  //! Where and how often the workflow engine writes snapshots of
+  //! the nets it interprets.
+  struct snapshot_settings
+  {
+    boost::filesystem::path directory;
+    std::chrono::milliseconds interval;
+  };
+
+  //! A top level net together with the child jobs extracted from
+  //! it that did not terminate yet. The net is in the wrapped form
+  //! the workflow engine interprets.
+  struct net_snapshot
+  {
+    sdpa::job_id_t id;
+    type::activity_t net;
+    std::unordered_map<sdpa::job_id_t, type::activity_t> outstanding_children;
+    //! \note whatever the submitter of the net wrote along with it
+    boost::optional<std::string> annotation;
+  };
+
+  //! Binary snapshots of nets, one directory per net. The structure
+  //! of a net, i.e. the whole activity, and a child are written once,
+  //! when the net first is written and when the child first is
+  //! outstanding. Afterwards only the changes of the marking of the
+  //! net are appended, each together with the ids of the outstanding
+  //! children, and only the children of the last complete change are
+  //! loaded, so that a crash in between writing files never leads to
+  //! a child being executed twice or being lost. Once the changes are
+  //! larger than the structure, they are applied to it and start anew.
+  class snapshot_directory
+  {
+  public:
+    explicit snapshot_directory (boost::filesystem::path);
+
+    void write_structure
+      (sdpa::job_id_t const& net, type::activity_t const&) const;
+    void write_child ( sdpa::job_id_t const& net
+                     , sdpa::job_id_t const& child
+                     , type::activity_t const&
+                     ) const;
+    //! \note requires the structure to be written and its marking to
+    //! be the current one, starts the changes anew. Both write_marking
+    //! and append_marking_changes remove the files of children not
+    //! outstanding anymore.
+    void write_marking
+      ( sdpa::job_id_t const& net
+      , std::vector<sdpa::job_id_t> const& outstanding_children
+      ) const;
+    //! \note requires write_marking, the changes are those taken from
+    //! the net since the previous call or write_marking
+    void append_marking_changes
+      ( sdpa::job_id_t const& net
+      , type::net_marking_changes const&
+      , std::vector<sdpa::job_id_t> const& outstanding_children
+      ) const;
+    //! \note opaque to the workflow engine, may be written any time
+    //! before or while the net runs and is removed together with it
+    void write_annotation
+      (sdpa::job_id_t const& net, std::string const&) const;
+    void remove (sdpa::job_id_t const& net) const;
+
+    //! \note skips and removes directories without a marking, which
+    //! were interrupted before the first snapshot was complete, and
+    //! drops a change that was interrupted while being appended
+    std::list<net_snapshot> load() const;
+
+  private:
+    boost::filesystem::path _directory;
+
+    void remove_terminated_children
+      ( boost::filesystem::path const& net_directory
+      , std::vector<sdpa::job_id_t> const& outstanding_children
+      ) const;
+    void compact (boost::filesystem::path const& net_directory) const;
+  };
+}
@@ -0,0 +1,126 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <we/type/activity.hpp>
+#include <we/type/expression.hpp>
+#include <we/type/net.hpp>
+#include <we/type/transition.hpp>
+
+#include <util-generic/testing/random.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace
+{
+  we::type::property::type no_properties()
+  {
+    return {};
+  }
+
+  //! \note a chain of transitions connected by places, with tokens
+  //! on the first place
+  we::type::activity_t make_chain (std::size_t transitions, std::size_t tokens)
+  {
+    pnet::type::signature::signature_type const signature
+      (std::string ("unsigned long"));
+
+    we::type::net_type net;
+
+    auto make_place
+      ( [&] (std::size_t i)
+        {
+          return net.add_place
+            ( place::type
+                ("p" + std::to_string (i), signature, false, no_properties())
+            );
+        }
+      );
+
+    we::place_id_type const first (make_place (0));
+    we::place_id_type previous (first);
+
+    for (std::size_t i (0); i < transitions; ++i)
+    {
+      we::type::transition_t transition
+        ( "t" + std::to_string (i)
+        , we::type::expression_t ("${out} := ${in} + 1UL")
+        , boost::none
+        , no_properties()
+        , we::priority_type()
+        );
+      we::port_id_type const in
+        ( transition.add_port
+            ( we::type::port_t ( std::string ("in")
+                               , we::type::PORT_IN
+                               , signature
+                               , no_properties()
+                               )
+            )
+        );
+      we::port_id_type const out
+        ( transition.add_port
+            ( we::type::port_t ( std::string ("out")
+                               , we::type::PORT_OUT
+                               , signature
+                               , no_properties()
+                               )
+            )
+        );
+
+      we::transition_id_type const id (net.add_transition (transition));
+      we::place_id_type const next (make_place (i + 1));
+
+      net.add_connection (we::edge::PT, id, previous, in, no_properties());
+      net.add_connection (we::edge::TP, id, next, out, no_properties());
+
+      previous = next;
+    }
+
+    for (std::size_t i (0); i < tokens; ++i)
+    {
+      net.put_value
+        ( first
+        , pnet::type::value::value_type
+            (fhg::util::testing::random<unsigned long>{}())
+        );
+    }
+
+    return we::type::activity_t
+      ( we::type::transition_t
+          ( "chain"
+          , net
+          , boost::none
+          , no_properties()
+          , we::priority_type()
+          )
+      );
+  }
+
+  void write ( we::type::activity_t const& activity
+             , we::type::activity_encoding encoding
+             , boost::filesystem::path const& path
+             )
+  {
+    std::ofstream stream (path.string(), std::ios::binary);
+    activity.write (stream, encoding);
+  }
+}
@@ -0,0 +1,172 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include <we/test/activity_encoding.common.hpp>
+
+#include <util-generic/temporary_path.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/require_exception.hpp>
+
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/data/test_case.hpp>
+
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+  std::vector<we::type::activity_encoding> const all_encodings
+    {we::type::activity_encoding::text, we::type::activity_encoding::binary};
+
+  //! \note nets are not serialized canonically: loading reorders
+  //! their unordered containers, but loading the same order twice
+  //! yields the same order
+  std::string reloaded (we::type::activity_t const& activity)
+  {
+    return we::type::activity_t (activity.to_string()).to_string();
+  }
+}
+
+namespace we
+{
+  namespace type
+  {
+    std::ostream& operator<< (std::ostream& os, activity_encoding encoding)
+    {
+      return os << ( encoding == activity_encoding::text ? "text"
+                   : encoding == activity_encoding::binary ? "binary"
+                   : throw std::logic_error ("invalid activity_encoding")
+                   );
+    }
+  }
+}
+
+BOOST_DATA_TEST_CASE
+  (activity_survives_round_trip_through_string, all_encodings, encoding)
+{
+  auto const activity (make_chain (10, 10));
+
+  BOOST_REQUIRE_EQUAL
+    ( we::type::activity_t (activity.to_string (encoding)).to_string()
+    , reloaded (activity)
+    );
+}
+
+BOOST_DATA_TEST_CASE
+  (activity_survives_round_trip_through_file, all_encodings, encoding)
+{
+  auto const activity (make_chain (10, 10));
+
+  fhg::util::temporary_path const directory;
+  boost::filesystem::path const path
+    (boost::filesystem::path (directory) / "activity");
+
+  write (activity, encoding, path);
+
+  BOOST_REQUIRE_EQUAL
+    (we::type::activity_t (path).to_string(), reloaded (activity));
+}
+
+BOOST_AUTO_TEST_CASE (encodings_convert_into_each_other)
+{
+  using we::type::activity_encoding;
+
+  auto const activity (make_chain (10, 10));
+
+  auto const convert
+    ( [] (std::string const& from, activity_encoding to)
+      {
+        return we::type::activity_t (from).to_string (to);
+      }
+    );
+
+  std::string const text (activity.to_string (activity_encoding::text));
+  std::string const binary (activity.to_string (activity_encoding::binary));
+
+  BOOST_REQUIRE_EQUAL
+    ( convert (convert (text, activity_encoding::binary), activity_encoding::text)
+    , convert (convert (text, activity_encoding::text), activity_encoding::text)
+    );
+  BOOST_REQUIRE_EQUAL
+    ( convert (convert (binary, activity_encoding::text), activity_encoding::binary)
+    , convert (convert (binary, activity_encoding::binary), activity_encoding::binary)
+    );
+}
+
+BOOST_AUTO_TEST_CASE (activity_is_read_from_stream_in_binary_encoding)
+{
+  auto const activity (make_chain (10, 10));
+
+  std::istringstream stream
+    (activity.to_string (we::type::activity_encoding::binary));
+
+  BOOST_REQUIRE_EQUAL
+    (we::type::activity_t (stream).to_string(), reloaded (activity));
+}
+
+BOOST_AUTO_TEST_CASE (binary_encoding_of_other_version_is_rejected)
+{
+  std::string binary
+    (make_chain (1, 1).to_string (we::type::activity_encoding::binary));
+
+  //! \note version follows the 8 byte magic
+  binary[8] = 2;
+
+  fhg::util::testing::require_exception
+    ( [&] { we::type::activity_t {binary}; }
+    , std::runtime_error
+        ( "deserialization error: 'binary activity format version 2"
+          " unsupported, expected version 1'"
+        )
+    );
+}
+
+BOOST_AUTO_TEST_CASE (truncated_binary_encoding_is_rejected)
+{
+  std::string const binary
+    (make_chain (10, 10).to_string (we::type::activity_encoding::binary));
+
+  BOOST_REQUIRE_THROW
+    ( we::type::activity_t {binary.substr (0, binary.size() / 2)}
+    , std::runtime_error
+    );
+}
+
+BOOST_AUTO_TEST_CASE (failing_to_open_a_file_keeps_the_reason)
+{
+  fhg::util::temporary_path const directory;
+  boost::filesystem::path const missing
+    (boost::filesystem::path (directory) / "missing");
+
+  try
+  {
+    we::type::activity_t {missing};
+  }
+  catch (std::runtime_error const& error)
+  {
+    BOOST_REQUIRE_NE
+      (std::string (error.what()).find ("could not open"), std::string::npos);
+    BOOST_REQUIRE_THROW (std::rethrow_if_nested (error), std::exception);
+
+    return;
+  }
+
+  BOOST_FAIL ("opening a missing file did not throw");
+}
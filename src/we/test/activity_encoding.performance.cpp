@@ -0,0 +1,72 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include <we/test/activity_encoding.common.hpp>
+
+#include <util-generic/temporary_path.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/measure_average_time.hpp>
+#include <util-generic/testing/printer/chrono.hpp>
+
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/data/test_case.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+  std::chrono::microseconds load_time
+    (boost::filesystem::path const& path, std::size_t repetitions)
+  {
+    return fhg::util::testing::measure_average_time<std::chrono::microseconds>
+      ([&] { we::type::activity_t {path}; }, repetitions);
+  }
+}
+
+BOOST_DATA_TEST_CASE
+  ( loading_binary_encoding_is_at_least_25_percent_faster_than_text
+  , std::vector<std::size_t> ({1000, 10000, 100000})
+  , size
+  )
+{
+  auto const activity (make_chain (size, 10 * size));
+
+  fhg::util::temporary_path const directory;
+  boost::filesystem::path const text
+    (boost::filesystem::path (directory) / "text");
+  boost::filesystem::path const binary
+    (boost::filesystem::path (directory) / "binary");
+
+  write (activity, we::type::activity_encoding::text, text);
+  write (activity, we::type::activity_encoding::binary, binary);
+
+  auto const text_time (load_time (text, 3));
+  auto const binary_time (load_time (binary, 3));
+
+  BOOST_TEST_MESSAGE
+    ( size << " transitions, " << 10 * size << " tokens: text "
+    << boost::filesystem::file_size (text) << " bytes in "
+    << text_time.count() << " us, binary "
+    << boost::filesystem::file_size (binary) << " bytes in "
+    << binary_time.count() << " us"
+    );
+
+  BOOST_REQUIRE_LE (binary_time * 5, text_time * 4);
+}
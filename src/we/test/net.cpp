@@ -16,6 +16,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <we/exception.hpp>
 #include <we/type/activity.hpp>
 #include <we/type/expression.hpp>
 #include <we/type/net.hpp>
@@ -23,10 +24,12 @@
 
 #include <util-generic/testing/flatten_nested_exceptions.hpp>
 #include <util-generic/testing/random/string.hpp>
+#include <util-generic/testing/require_exception.hpp>
 
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 
+#include <list>
 #include <sstream>
 
 #include <we/test/net.common.hpp>
@@ -180,5 +183,232 @@ namespace we
             (random_engine(), unexpected_workflow_response)
         );
     }
+
+    namespace
+    {
+      //! (in::unsigned long) -> [ eat: if ${x} :gt: 2UL ]
+      struct net_with_put_token_place
+      {
+        net_type net;
+        place_id_type const in
+          { net.add_place
+              ({"in", std::string ("unsigned long"), true, no_properties()})
+          };
+        place_id_type const not_for_put_token
+          { net.add_place
+              ( { "not_for_put_token"
+                , std::string ("unsigned long")
+                , boost::none
+                , no_properties()
+                }
+              )
+          };
+
+        net_with_put_token_place()
+        {
+          transition_t eat ( "eat"
+                           , expression_t()
+                           , expression_t ("${x} :gt: 2UL")
+                           , no_properties()
+                           , priority_type()
+                           );
+          port_id_type const x
+            ( eat.add_port
+                ( { "x"
+                  , PORT_IN
+                  , std::string ("unsigned long")
+                  , no_properties()
+                  }
+                )
+            );
+
+          net.add_connection
+            (edge::PT, net.add_transition (eat), in, x, no_properties());
+        }
+      };
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      (put_tokens_puts_all_values_and_enables_once, net_with_put_token_place)
+    {
+      net.put_tokens ("in", {1UL, 2UL, 3UL, 4UL});
+
+      BOOST_REQUIRE_EQUAL (net.get_token (in).size(), 4);
+
+      //! \note both tokens > 2 are seen although enabling has been
+      //! computed only once for the whole list
+      BOOST_REQUIRE
+        ( !net.fire_expressions_and_extract_activity_random
+            (random_engine(), unexpected_workflow_response)
+        );
+
+      BOOST_REQUIRE_EQUAL (net.get_token (in).size(), 2);
+
+      for (auto const& token : net.get_token (in))
+      {
+        BOOST_REQUIRE_LE
+          ( boost::get<unsigned long> (token.second)
+          , 2UL
+          );
+      }
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      (put_tokens_with_no_values_is_a_noop, net_with_put_token_place)
+    {
+      net.put_tokens ("in", {});
+
+      BOOST_REQUIRE (net.get_token (in).empty());
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      ( put_tokens_with_ill_typed_value_puts_no_value_at_all
+      , net_with_put_token_place
+      )
+    {
+      BOOST_REQUIRE_THROW
+        ( net.put_tokens ("in", {3UL, std::string ("not unsigned long")})
+        , pnet::exception::type_mismatch
+        );
+
+      BOOST_REQUIRE (net.get_token (in).empty());
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      (put_tokens_requires_marked_place, net_with_put_token_place)
+    {
+      fhg::util::testing::require_exception
+        ( [&]
+          {
+            net.put_tokens ("not_for_put_token", {1UL, 2UL});
+          }
+        , std::invalid_argument
+            ( "put_tokens (\"not_for_put_token\", 2 tokens): place not"
+              " marked with attribute put_token=\"true\""
+            )
+        );
+      fhg::util::testing::require_exception
+        ( [&]
+          {
+            net.put_tokens ("unknown", {1UL, 2UL});
+          }
+        , std::invalid_argument
+            ("put_tokens (\"unknown\", 2 tokens): place not found")
+        );
+
+      BOOST_REQUIRE (net.get_token (not_for_put_token).empty());
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      ( put_tokens_with_a_single_value_reports_the_value_like_put_token
+      , net_with_put_token_place
+      )
+    {
+      fhg::util::testing::require_exception
+        ( [&]
+          {
+            net.put_tokens ("not_for_put_token", {1UL});
+          }
+        , std::invalid_argument
+            ( "put_token (\"not_for_put_token\", 1UL): place not"
+              " marked with attribute put_token=\"true\""
+            )
+        );
+      fhg::util::testing::require_exception
+        ( [&]
+          {
+            net.put_tokens ("unknown", {1UL});
+          }
+        , std::invalid_argument
+            ("put_token (\"unknown\", 1UL): place not found")
+        );
+
+      net.put_tokens ("in", {1UL});
+
+      BOOST_REQUIRE_EQUAL (net.get_token (in).size(), 1);
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      ( marking_changes_applied_to_a_copy_reproduce_the_tokens
+      , net_with_put_token_place
+      )
+    {
+      net_type copy (net);
+
+      net.record_marking_changes();
+
+      net.put_tokens ("in", {1UL, 2UL, 3UL, 4UL});
+      std::list<net_marking_changes> changes {net.take_marking_changes()};
+
+      BOOST_REQUIRE_EQUAL (changes.back().put.at (in).size(), 4);
+      BOOST_REQUIRE (changes.back().deleted.empty());
+
+      BOOST_REQUIRE
+        ( !net.fire_expressions_and_extract_activity_random
+            (random_engine(), unexpected_workflow_response)
+        );
+      changes.emplace_back (net.take_marking_changes());
+
+      BOOST_REQUIRE (changes.back().put.empty());
+      BOOST_REQUIRE_EQUAL (changes.back().deleted.at (in).size(), 2);
+
+      copy.apply_marking_changes (changes);
+
+      BOOST_REQUIRE (copy.get_token (in) == net.get_token (in));
+
+      //! \note applying again has no effect
+      copy.apply_marking_changes (changes);
+
+      BOOST_REQUIRE (copy.get_token (in) == net.get_token (in));
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      ( applied_marking_changes_enable_transitions
+      , net_with_put_token_place
+      )
+    {
+      net_type copy (net);
+
+      net.record_marking_changes();
+      net.put_tokens ("in", {1UL, 3UL});
+
+      copy.apply_marking_changes ({net.take_marking_changes()});
+
+      BOOST_REQUIRE
+        ( !copy.fire_expressions_and_extract_activity_random
+            (random_engine(), unexpected_workflow_response)
+        );
+      BOOST_REQUIRE_EQUAL (copy.get_token (in).size(), 1);
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      ( tokens_put_and_deleted_in_between_are_no_change
+      , net_with_put_token_place
+      )
+    {
+      net.record_marking_changes();
+
+      net.put_token ("in", 3UL);
+      BOOST_REQUIRE
+        ( !net.fire_expressions_and_extract_activity_random
+            (random_engine(), unexpected_workflow_response)
+        );
+
+      net_marking_changes const changes (net.take_marking_changes());
+
+      BOOST_REQUIRE (changes.put.empty());
+      BOOST_REQUIRE (changes.deleted.empty());
+    }
+
+    BOOST_FIXTURE_TEST_CASE
+      ( marking_changes_are_only_taken_while_recording
+      , net_with_put_token_place
+      )
+    {
+      fhg::util::testing::require_exception
+        ( [&] { net.take_marking_changes(); }
+        , std::logic_error ("take_marking_changes: not recording")
+        );
+    }
   }
 }
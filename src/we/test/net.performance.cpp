@@ -27,7 +27,9 @@
 
 #include <algorithm>
 #include <chrono>
+#include <list>
 #include <random>
+#include <utility>
 #include <vector>
 
 #include <we/test/net.common.hpp>
@@ -212,5 +214,90 @@ namespace we
       // not depend on the number of tokens on place y
       BOOST_REQUIRE_LT (((*minmax.second) / (*minmax.first)), 100);
     }
+
+    BOOST_AUTO_TEST_CASE (put_tokens_is_faster_than_single_put_token)
+    {
+      using Clock = std::chrono::steady_clock;
+
+      std::size_t const number_of_tokens (100000);
+
+      //! (in::unsigned long) -> [ t: if ${x} :lt: 0UL ] <- (y::control)
+      //!                                               <- (z::control)
+      auto const make_net
+        ( []
+          {
+            net_type net;
+
+            auto const in
+              ( net.add_place
+                  ({"in", std::string ("unsigned long"), true, no_properties()})
+              );
+            auto const y
+              ( net.add_place
+                  ({"y", std::string ("control"), boost::none, no_properties()})
+              );
+
+            transition_t t ( "t"
+                           , expression_t()
+                           , expression_t ("${x} :lt: 0UL")
+                           , no_properties()
+                           , priority_type()
+                           );
+            auto const x
+              ( t.add_port
+                  ({"x", PORT_IN, std::string ("unsigned long"), no_properties()})
+              );
+            auto const c
+              ( t.add_port
+                  ({"c", PORT_IN, std::string ("control"), no_properties()})
+              );
+
+            auto const tid (net.add_transition (t));
+
+            net.add_connection (edge::PT, tid, in, x, no_properties());
+            net.add_connection (edge::PT, tid, y, c, no_properties());
+
+            net.put_value (y, type::literal::control());
+
+            return std::make_pair (net, in);
+          }
+        );
+
+      std::list<pnet::type::value::value_type> values;
+      for (unsigned long i (0); i < number_of_tokens; ++i)
+      {
+        values.emplace_back (i);
+      }
+
+      auto single (make_net());
+      auto const start_single (Clock::now());
+      for (auto const& value : values)
+      {
+        single.first.put_token ("in", value);
+      }
+      auto const duration_single (Clock::now() - start_single);
+
+      auto bulk (make_net());
+      auto const start_bulk (Clock::now());
+      bulk.first.put_tokens ("in", values);
+      auto const duration_bulk (Clock::now() - start_bulk);
+
+      BOOST_REQUIRE_EQUAL
+        (single.first.get_token (single.second).size(), number_of_tokens);
+      BOOST_REQUIRE_EQUAL
+        (bulk.first.get_token (bulk.second).size(), number_of_tokens);
+
+      BOOST_TEST_MESSAGE
+        ( "put_token: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>
+             (duration_single).count()
+        << " ms, put_tokens: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>
+             (duration_bulk).count()
+        << " ms for " << number_of_tokens << " tokens"
+        );
+
+      BOOST_REQUIRE_LT (duration_bulk, duration_single);
+    }
   }
 }
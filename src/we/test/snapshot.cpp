@@ -0,0 +1,539 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <we/layer.hpp>
+#include <we/snapshot.hpp>
+#include <we/type/activity.hpp>
+
+#include <we/test/layer.common.hpp>
+
+#include <util-generic/temporary_path.hpp>
+#include <util-generic/testing/flatten_nested_exceptions.hpp>
+#include <util-generic/testing/require_exception.hpp>
+#include <util-generic/testing/require_maximum_running_time.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  struct activities
+  {
+    activities()
+    {
+      std::tie (input, output, child, result) = activity_with_child (2);
+    }
+
+    we::type::activity_t input;
+    we::type::activity_t output;
+    we::type::activity_t child;
+    we::type::activity_t result;
+  };
+
+  std::set<sdpa::job_id_t> ids_of (we::net_snapshot const& snapshot)
+  {
+    std::set<sdpa::job_id_t> ids;
+    for (auto const& child : snapshot.outstanding_children)
+    {
+      ids.emplace (child.first);
+    }
+    return ids;
+  }
+
+  //! \note the text encoding depends on the iteration order of
+  //! unordered containers, which is the same after the same round trip
+  std::string round_tripped (we::type::activity_t const& activity)
+  {
+    return we::type::activity_t
+      (activity.to_string (we::type::activity_encoding::binary)).to_string();
+  }
+
+  std::size_t count_files (boost::filesystem::path const& directory)
+  {
+    return std::distance
+      ( boost::filesystem::recursive_directory_iterator (directory)
+      , boost::filesystem::recursive_directory_iterator()
+      );
+  }
+}
+
+namespace
+{
+  //! \note applied in the same order onto the same structure, the
+  //! unordered containers are the same as those of a loaded snapshot
+  std::string with_changes
+    ( std::string const& structure
+    , std::list<we::type::net_marking_changes> const& changes
+    )
+  {
+    we::type::activity_t activity (structure);
+    activity.apply_marking_changes (changes);
+    return activity.to_string();
+  }
+
+  boost::filesystem::path marking_file (boost::filesystem::path const& path)
+  {
+    return *boost::filesystem::directory_iterator (path) / "marking";
+  }
+}
+
+BOOST_AUTO_TEST_CASE (written_net_and_children_are_loaded)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  snapshots.write_structure ("net/1", activity.input);
+  snapshots.write_child ("net/1", "child 1", activity.child);
+  snapshots.write_child ("net/1", "child 2", activity.child);
+  snapshots.write_marking
+    ( "net/1"
+    , std::vector<sdpa::job_id_t> {"child 1", "child 2"}
+    );
+
+  auto const loaded (snapshots.load());
+
+  BOOST_REQUIRE_EQUAL (loaded.size(), 1);
+  BOOST_REQUIRE_EQUAL (loaded.front().id, "net/1");
+  BOOST_REQUIRE_EQUAL
+    ( loaded.front().net.to_string()
+    , with_changes
+        ( activity.input.to_string (we::type::activity_encoding::binary)
+        , {we::type::net_marking_changes()}
+        )
+    );
+  BOOST_REQUIRE (!loaded.front().annotation);
+  BOOST_REQUIRE
+    ( ids_of (loaded.front())
+    == (std::set<sdpa::job_id_t> {"child 1", "child 2"})
+    );
+  for (auto const& child : loaded.front().outstanding_children)
+  {
+    BOOST_REQUIRE_EQUAL
+      (child.second.to_string(), round_tripped (activity.child));
+  }
+}
+
+BOOST_AUTO_TEST_CASE (children_not_outstanding_anymore_are_removed)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  snapshots.write_structure ("net", activity.input);
+  snapshots.write_child ("net", "child 1", activity.child);
+  snapshots.write_child ("net", "child 2", activity.child);
+  snapshots.write_marking
+    ( "net"
+    , std::vector<sdpa::job_id_t> {"child 1", "child 2"}
+    );
+
+  //! \note net directory, structure and marking file, children
+  //! directory, two children
+  BOOST_REQUIRE_EQUAL (count_files (path), 6);
+
+  snapshots.write_marking ("net", std::vector<sdpa::job_id_t> {"child 2"});
+
+  BOOST_REQUIRE_EQUAL (count_files (path), 5);
+
+  auto const loaded (snapshots.load());
+
+  BOOST_REQUIRE_EQUAL (loaded.size(), 1);
+  BOOST_REQUIRE (ids_of (loaded.front()) == std::set<sdpa::job_id_t> {"child 2"});
+}
+
+BOOST_AUTO_TEST_CASE (appended_marking_changes_are_applied_to_the_structure)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  we::type::activity_t net (activity.input);
+  net.record_marking_changes();
+  std::string const structure
+    (net.to_string (we::type::activity_encoding::binary));
+
+  snapshots.write_structure ("net", net);
+  snapshots.write_marking ("net", {});
+
+  std::list<we::type::net_marking_changes> changes;
+  for (int i (0); i < 2; ++i)
+  {
+    net.put_token ("in", value::CONTROL);
+    changes.emplace_back (net.take_marking_changes());
+    snapshots.append_marking_changes ("net", changes.back(), {});
+  }
+
+  auto const loaded (snapshots.load());
+
+  BOOST_REQUIRE_EQUAL (loaded.size(), 1);
+  BOOST_REQUIRE_EQUAL
+    (loaded.front().net.to_string(), with_changes (structure, changes));
+  BOOST_REQUIRE_NE
+    ( loaded.front().net.to_string()
+    , with_changes (structure, {we::type::net_marking_changes()})
+    );
+}
+
+BOOST_AUTO_TEST_CASE (a_change_interrupted_while_being_appended_is_dropped)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  we::type::activity_t net (activity.input);
+  net.record_marking_changes();
+  std::string const structure
+    (net.to_string (we::type::activity_encoding::binary));
+
+  snapshots.write_structure ("net", net);
+  snapshots.write_child ("net", "child", activity.child);
+  snapshots.write_marking ("net", {"child"});
+
+  net.put_token ("in", value::CONTROL);
+  std::list<we::type::net_marking_changes> const changes
+    {net.take_marking_changes()};
+  snapshots.append_marking_changes ("net", changes.back(), {"child"});
+
+  auto const complete_size (boost::filesystem::file_size (marking_file (path)));
+
+  net.put_token ("in", value::CONTROL);
+  snapshots.append_marking_changes
+    ("net", net.take_marking_changes(), {"child"});
+  boost::filesystem::resize_file
+    ( marking_file (path)
+    , (complete_size + boost::filesystem::file_size (marking_file (path))) / 2
+    );
+
+  auto const loaded (snapshots.load());
+
+  BOOST_REQUIRE_EQUAL (loaded.size(), 1);
+  BOOST_REQUIRE_EQUAL
+    (loaded.front().net.to_string(), with_changes (structure, changes));
+  BOOST_REQUIRE (ids_of (loaded.front()) == std::set<sdpa::job_id_t> {"child"});
+  BOOST_REQUIRE_EQUAL
+    (boost::filesystem::file_size (marking_file (path)), complete_size);
+}
+
+BOOST_AUTO_TEST_CASE (changes_larger_than_the_structure_are_compacted)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  we::type::activity_t net (activity.input);
+  net.record_marking_changes();
+  std::string const structure
+    (net.to_string (we::type::activity_encoding::binary));
+
+  snapshots.write_structure ("net", net);
+  snapshots.write_marking ("net", {});
+
+  std::list<we::type::net_marking_changes> changes;
+  auto size (boost::filesystem::file_size (marking_file (path)));
+  auto const initial_size (size);
+
+  for (;;)
+  {
+    BOOST_REQUIRE_LT (changes.size(), 1000);
+
+    net.put_token ("in", value::CONTROL);
+    changes.emplace_back (net.take_marking_changes());
+    snapshots.append_marking_changes ("net", changes.back(), {});
+
+    auto const previous_size (size);
+    size = boost::filesystem::file_size (marking_file (path));
+    if (size < previous_size)
+    {
+      break;
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL (size, initial_size);
+
+  auto const loaded (snapshots.load());
+
+  BOOST_REQUIRE_EQUAL (loaded.size(), 1);
+  we::type::activity_t compacted (structure);
+  compacted.apply_marking_changes (changes);
+
+  BOOST_REQUIRE_EQUAL
+    ( loaded.front().net.to_string()
+    , with_changes
+        ( compacted.to_string (we::type::activity_encoding::binary)
+        , {we::type::net_marking_changes()}
+        )
+    );
+}
+
+BOOST_AUTO_TEST_CASE (the_marking_requires_the_structure)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  fhg::util::testing::require_exception
+    ( [&] { snapshots.write_marking ("net", {}); }
+    , std::logic_error ("write_marking: structure of net net not written")
+    );
+
+  snapshots.write_structure ("net", activity.input);
+
+  fhg::util::testing::require_exception
+    ( [&]
+      {
+        snapshots.append_marking_changes
+          ("net", we::type::net_marking_changes(), {});
+      }
+    , std::logic_error
+        ("append_marking_changes: marking of net net not written")
+    );
+}
+
+BOOST_AUTO_TEST_CASE (the_annotation_is_loaded_with_the_net)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  std::string const annotation ("source\0and parameters", 22);
+
+  snapshots.write_annotation ("net", annotation);
+  snapshots.write_structure ("net", activity.input);
+  snapshots.write_marking ("net", {});
+
+  auto const loaded (snapshots.load());
+
+  BOOST_REQUIRE_EQUAL (loaded.size(), 1);
+  BOOST_REQUIRE (loaded.front().annotation);
+  BOOST_REQUIRE_EQUAL (*loaded.front().annotation, annotation);
+}
+
+BOOST_AUTO_TEST_CASE (removed_nets_are_not_loaded)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  for (std::string const net : {"net 1", "net 2"})
+  {
+    snapshots.write_structure (net, activity.input);
+    snapshots.write_marking (net, {});
+  }
+  snapshots.remove ("net 1");
+
+  auto const loaded (snapshots.load());
+
+  BOOST_REQUIRE_EQUAL (loaded.size(), 1);
+  BOOST_REQUIRE_EQUAL (loaded.front().id, "net 2");
+}
+
+BOOST_AUTO_TEST_CASE (directories_without_net_are_skipped_and_removed)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  snapshots.write_annotation ("net", "annotation");
+  snapshots.write_structure ("net", activity.input);
+  snapshots.write_child ("net", "child", activity.child);
+
+  BOOST_REQUIRE (snapshots.load().empty());
+  BOOST_REQUIRE (boost::filesystem::is_empty (path));
+}
+
+BOOST_AUTO_TEST_CASE (corrupt_snapshot_throws)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_directory const snapshots (path);
+  activities const activity;
+
+  snapshots.write_structure ("net", activity.input);
+  snapshots.write_marking ("net", {});
+
+  boost::filesystem::path const net_directory
+    (*boost::filesystem::directory_iterator (path));
+  boost::filesystem::resize_file (net_directory / "marking", 4);
+
+  fhg::util::testing::require_exception
+    ( [&] { snapshots.load(); }
+    , fhg::util::testing::make_nested
+        ( std::runtime_error
+            ((boost::format ("loading snapshot %1%") % net_directory).str())
+        , std::runtime_error ("corrupt snapshot header")
+        )
+    );
+}
+
+namespace
+{
+  void cancel (we::layer::id_type){}
+  void failed (we::layer::id_type, std::string){}
+  void canceled (we::layer::id_type){}
+  void discover (we::layer::id_type, we::layer::id_type){}
+  void discovered (we::layer::id_type, sdpa::discovery_info_t){}
+  void token_put (std::string, boost::optional<std::exception_ptr>){}
+  void workflow_response_response (std::string, boost::variant<std::exception_ptr, pnet::type::value::value_type>){}
+
+  std::mutex generate_id_mutex;
+  we::layer::id_type generate_id()
+  {
+    std::unique_lock<std::mutex> const _ (generate_id_mutex);
+    static unsigned long _cnt (0);
+    return boost::lexical_cast<we::layer::id_type> (++_cnt);
+  }
+
+  struct recording_layer
+  {
+    recording_layer (we::snapshot_settings settings)
+      : _layer
+          ( [this] (we::layer::id_type id, we::type::activity_t)
+            {
+              std::lock_guard<std::mutex> const _ (_guard);
+              _submitted.emplace (id);
+            }
+          , &cancel
+          , [this] (we::layer::id_type id, we::type::activity_t)
+            {
+              std::lock_guard<std::mutex> const _ (_guard);
+              _finished.emplace (id);
+            }
+          , &failed
+          , &canceled
+          , &discover
+          , &discovered
+          , &token_put
+          , &workflow_response_response
+          , &generate_id
+          , _random_engine
+          , settings
+          )
+    {}
+
+    std::set<we::layer::id_type> submitted()
+    {
+      std::lock_guard<std::mutex> const _ (_guard);
+      return _submitted;
+    }
+    bool finished (we::layer::id_type const& id)
+    {
+      std::lock_guard<std::mutex> const _ (_guard);
+      return _finished.count (id);
+    }
+
+    std::mutex _guard;
+    std::set<we::layer::id_type> _submitted;
+    std::set<we::layer::id_type> _finished;
+    std::mt19937 _random_engine;
+    we::layer _layer;
+  };
+
+  template<typename Predicate>
+    void wait_until (Predicate&& predicate)
+  {
+    //! \todo Don't busy wait
+    while (!predicate())
+    {
+      std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+  }
+
+  bool has_marking_file (boost::filesystem::path const& path)
+  {
+    for ( boost::filesystem::directory_entry const& entry
+        : boost::filesystem::directory_iterator (path)
+        )
+    {
+      if (boost::filesystem::exists (entry.path() / "marking"))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+BOOST_AUTO_TEST_CASE (resumed_net_resubmits_outstanding_children_and_finishes)
+{
+  fhg::util::temporary_path const path;
+  we::snapshot_settings const settings {path, std::chrono::milliseconds (10)};
+  activities const activity;
+
+  we::layer::id_type const net_id (generate_id());
+  std::set<we::layer::id_type> children;
+
+  FHG_UTIL_TESTING_REQUIRE_MAXIMUM_RUNNING_TIME (std::chrono::seconds (10))
+  {
+    {
+      recording_layer first (settings);
+
+      first._layer.submit (net_id, activity.input);
+
+      wait_until ([&] { return first.submitted().size() == 2; });
+      children = first.submitted();
+
+      //! \note the net might have been snapshotted with only one child
+      //! extracted, wait for the next round
+      wait_until
+        ( [&]
+          {
+            if (!has_marking_file (path))
+            {
+              return false;
+            }
+            auto const loaded (we::snapshot_directory (path).load());
+            return loaded.size() == 1 && ids_of (loaded.front()) == children;
+          }
+        );
+    }
+
+    auto loaded (we::snapshot_directory (path).load());
+    BOOST_REQUIRE_EQUAL (loaded.size(), 1);
+    BOOST_REQUIRE_EQUAL (loaded.front().id, net_id);
+
+    recording_layer second (settings);
+
+    second._layer.resume (std::move (loaded.front()));
+
+    wait_until ([&] { return second.submitted().size() == 2; });
+    BOOST_REQUIRE (second.submitted() == children);
+
+    for (we::layer::id_type const& child : children)
+    {
+      second._layer.finished (child, activity.result);
+    }
+
+    wait_until ([&] { return second.finished (net_id); });
+    wait_until ([&] { return boost::filesystem::is_empty (path); });
+  };
+}
@@ -29,13 +29,20 @@
 
 #include <drts/worker/context.hpp>
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/format.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/stream.hpp>
 #include <boost/range/adaptor/map.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <iostream>
@@ -54,6 +61,8 @@ namespace
       ( we::loader::loader& loader
       , gpi::pc::client::api_t /*const*/* virtual_memory
       , gspc::scoped_allocation /*const*/* shared_memory
+      , we::loader::global_memory_cache* global_memory_cache
+      , bool global_memory_gets_are_read_only
       , boost::optional<std::string> target_implementation
       , drts::worker::context* worker_context
       , expr::eval::context const& evaluation_context
@@ -62,6 +71,8 @@ namespace
       : _loader (loader)
       , _virtual_memory (virtual_memory)
       , _shared_memory (shared_memory)
+      , _global_memory_cache (global_memory_cache)
+      , _global_memory_gets_are_read_only (global_memory_gets_are_read_only)
       , _target_implementation (target_implementation)
       , _worker_context (worker_context)
       , _evaluation_context (evaluation_context)
@@ -85,6 +96,8 @@ namespace
           ( _loader
           , _virtual_memory
           , _shared_memory
+          , _global_memory_cache
+          , _global_memory_gets_are_read_only
           , _worker_context
           , _evaluation_context
           , mod
@@ -137,6 +150,8 @@ namespace
     we::loader::loader& _loader;
     gpi::pc::client::api_t /*const*/* _virtual_memory;
     gspc::scoped_allocation /*const*/* _shared_memory;
+    we::loader::global_memory_cache* _global_memory_cache;
+    bool _global_memory_gets_are_read_only;
     boost::optional<std::string> _target_implementation;
     drts::worker::context* _worker_context;
     expr::eval::context const& _evaluation_context;
@@ -169,10 +184,54 @@ namespace we
 
     namespace
     {
+      //! \note starts with a byte no text archive starts with
+      constexpr char const binary_magic[] = "\x89pnet\r\n\x1a";
+      constexpr std::size_t const binary_magic_size
+        (sizeof (binary_magic) - 1);
+      //! \note increment on any change of the binary layout
+      constexpr std::uint32_t const binary_format_version (1);
+
+      void decode_binary (std::istream& s, activity_t& t)
+      {
+        char magic[binary_magic_size];
+        std::uint32_t version;
+
+        if ( !s.read (magic, binary_magic_size)
+           || std::memcmp (magic, binary_magic, binary_magic_size)
+           || !s.read (reinterpret_cast<char*> (&version), sizeof (version))
+           )
+        {
+          throw std::runtime_error ("corrupt binary activity header");
+        }
+
+        if (version != binary_format_version)
+        {
+          throw std::runtime_error
+            ( ( boost::format ("binary activity format version %1%"
+                              " unsupported, expected version %2%"
+                              )
+              % version
+              % binary_format_version
+              ).str()
+            );
+        }
+
+        boost::archive::binary_iarchive ar (s);
+
+        ar >> BOOST_SERIALIZATION_NVP (t);
+      }
+
       void decode (std::istream& s, activity_t& t)
       {
         try
         {
+          if ( s.peek()
+             == std::istream::traits_type::to_int_type (binary_magic[0])
+             )
+          {
+            return decode_binary (s, t);
+          }
+
           boost::archive::text_iarchive ar (s);
 
           ar >> BOOST_SERIALIZATION_NVP (t);
@@ -189,13 +248,35 @@ namespace we
 
     activity_t::activity_t (const boost::filesystem::path& path)
     {
-      std::ifstream stream (path.string().c_str());
+      //! \note mapping avoids copying large nets through a stream
+      //! buffer, but empty files can not be mapped
+      if ( boost::filesystem::exists (path)
+         && boost::filesystem::is_empty (path)
+         )
+      {
+        std::istringstream empty;
 
-      if (!stream)
+        decode (empty, *this);
+
+        return;
+      }
+
+      boost::iostreams::mapped_file_source file;
+
+      try
       {
-        throw std::runtime_error
-          ((boost::format ("could not open '%1%' for reading") % path).str());
+        file.open (path.string());
       }
+      catch (...)
+      {
+        std::throw_with_nested
+          ( std::runtime_error
+              ((boost::format ("could not open '%1%' for reading") % path).str())
+          );
+      }
+
+      boost::iostreams::stream<boost::iostreams::array_source> stream
+        (file.data(), file.size());
 
       decode (stream, *this);
     }
@@ -213,13 +294,42 @@ namespace we
     }
 
     std::string activity_t::to_string() const
+    {
+      return to_string (activity_encoding::text);
+    }
+
+    std::string activity_t::to_string (activity_encoding encoding) const
     {
       std::ostringstream oss;
-      boost::archive::text_oarchive ar (oss);
-      ar << BOOST_SERIALIZATION_NVP (*this);
+      write (oss, encoding);
       return oss.str();
     }
 
+    void activity_t::write (std::ostream& os, activity_encoding encoding) const
+    {
+      switch (encoding)
+      {
+      case activity_encoding::text:
+        {
+          boost::archive::text_oarchive ar (os);
+          ar << BOOST_SERIALIZATION_NVP (*this);
+        }
+        break;
+
+      case activity_encoding::binary:
+        {
+          os.write (binary_magic, binary_magic_size);
+          os.write ( reinterpret_cast<char const*> (&binary_format_version)
+                   , sizeof (binary_format_version)
+                   );
+
+          boost::archive::binary_oarchive ar (os);
+          ar << BOOST_SERIALIZATION_NVP (*this);
+        }
+        break;
+      }
+    }
+
     void activity_t::add_input
       ( std::string const& port_name
       , pnet::type::value::value_type const& value
@@ -293,6 +403,15 @@ namespace we
         . put_token (std::move (place_name), token)
         ;
     }
+    void activity_t::put_tokens
+      ( std::string place_name
+      , std::list<pnet::type::value::value_type> const& tokens
+      )
+    {
+      return mutable_transition().mutable_net()
+        . put_tokens (std::move (place_name), tokens)
+        ;
+    }
     void activity_t::inject ( activity_t const& result
                             , workflow_response_callback workflow_response
                             , eureka_response_callback eureka_response
@@ -326,6 +445,22 @@ namespace we
         ;
     }
 
+    void activity_t::record_marking_changes()
+    {
+      return mutable_transition().mutable_net().record_marking_changes();
+    }
+    net_marking_changes activity_t::take_marking_changes()
+    {
+      return mutable_transition().mutable_net().take_marking_changes();
+    }
+    void activity_t::apply_marking_changes
+      (std::list<net_marking_changes> const& changes)
+    {
+      return mutable_transition().mutable_net()
+        . apply_marking_changes (changes)
+        ;
+    }
+
     const TokensOnPorts& activity_t::input() const
     {
       return _input;
@@ -405,9 +540,14 @@ namespace we
       }
     }
 
+    bool activity_t::side_effect_free() const
+    {
+      return transition().side_effect_free();
+    }
+
     bool activity_t::wait_for_output() const
     {
-      if (!transition().prop().is_true ({"drts", "wait_for_output"}))
+      if (!transition().wait_for_output())
       {
         return false;
       }
@@ -433,6 +573,7 @@ namespace we
       ( we::loader::loader& loader
       , gpi::pc::client::api_t /*const*/ * virtual_memory
       , gspc::scoped_allocation /* const */ * shared_memory
+      , we::loader::global_memory_cache* global_memory_cache
       , boost::optional<std::string> target_implementation
       , drts::worker::context* worker_context
       )
@@ -442,6 +583,8 @@ namespace we
           ( wfe_exec_context ( loader
                              , virtual_memory
                              , shared_memory
+                             , global_memory_cache
+                             , transition().global_memory_gets_are_read_only()
                              , std::move (target_implementation)
                              , worker_context
                              , evaluation_context()
@@ -477,43 +620,17 @@ namespace we
     namespace
     {
       template<typename T>
-        boost::optional<T> eval_schedule_data
-        ( transition_t const& transition
+        boost::optional<T> eval_cached_expression
+        ( boost::optional<expression_t> const& expression
         , expr::eval::context context
-        , const std::string& key
         )
       {
-        boost::optional<const property::value_type&> expression_value
-          (transition.prop().get ({"fhg", "drts", "schedule", key}));
-
-        if (!expression_value)
+        if (!expression)
         {
           return boost::none;
         }
 
-        expression_t const expression
-          (boost::get<std::string> (expression_value.get()));
-
-        return boost::get<T> (expression.ast().eval_all (context));
-      }
-
-      boost::optional<std::string> eval_dynamic_requirement
-        ( transition_t const& transition
-        , expr::eval::context context
-        )
-      {
-        boost::optional<const property::value_type&> expression_value
-          (transition.prop().get ({"fhg", "drts", "require", "dynamic_requirement"}));
-
-        if (!expression_value)
-        {
-          return boost::none;
-        }
-
-        expression_t const expression
-          (boost::get<std::string> (expression_value.get()));
-
-        return boost::get<std::string> (expression.ast().eval_all (context));
+        return boost::get<T> (expression->ast().eval_all (context));
       }
     }
 
@@ -523,8 +640,8 @@ namespace we
       auto const context (evaluation_context());
 
       schedule_data const schedule_data
-        ( eval_schedule_data<unsigned long>
-            (transition(), context, "num_worker")
+        ( eval_cached_expression<unsigned long>
+            (transition().schedule_num_worker(), context)
         );
 
       auto const num_required_workers (schedule_data.num_worker());
@@ -543,13 +660,31 @@ namespace we
       auto requirements (transition().requirements());
 
       auto dynamic_requirement
-        (eval_dynamic_requirement (transition(), context));
+        ( eval_cached_expression<std::string>
+            (transition().dynamic_requirement(), context)
+        );
 
       if (dynamic_requirement)
       {
         requirements.emplace_back (dynamic_requirement.get(), true);
       }
 
+      std::list<std::pair<we::local::range, we::global::range>> const gets
+        ( transition().module_call()
+        ? transition().module_call()->gets (context)
+        : std::list<std::pair<we::local::range, we::global::range>>()
+        );
+
+      //! \note only those workers may cache
+      std::list<we::global::range> global_memory_gets;
+      if (transition().global_memory_gets_are_read_only())
+      {
+        for (auto const& get : gets)
+        {
+          global_memory_gets.emplace_back (get.second);
+        }
+      }
+
       return
         { requirements
         , std::move (schedule_data)
@@ -561,7 +696,7 @@ namespace we
               return null_transfer_cost;
             }
 
-            auto vm_transfers (transition().module_call()->gets (context));
+            auto vm_transfers (gets);
 
             auto puts_before
               (transition().module_call()->puts_evaluated_before_call (context));
@@ -586,6 +721,7 @@ namespace we
           ? 0UL
           : transition().module_call()->memory_buffer_size_total (context)
         , transition().preferences()
+        , std::move (global_memory_gets)
         };
     }
 
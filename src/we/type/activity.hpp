@@ -20,9 +20,11 @@
 
 #include <we/eureka_response.hpp>
 #include <we/expr/eval/context.hpp>
+#include <we/loader/global_memory_cache.hpp>
 #include <we/loader/loader.hpp>
 #include <we/plugin/Plugins.hpp>
 #include <we/type/eureka.hpp>
+#include <we/type/net.fwd.hpp>
 #include <we/type/schedule_data.hpp>
 #include <we/type/transition.hpp>
 #include <we/type/value/serialize.hpp>
@@ -40,6 +42,7 @@
 #include <iosfwd>
 #include <map>
 #include <random>
+#include <list>
 #include <string>
 #include <vector>
 
@@ -79,6 +82,17 @@ namespace we
   {
     struct TESTING_ONLY{};
 
+    //! \note binary is versioned and about 1.4 times faster to load
+    //! but not portable between architectures. Both are decoded
+    //! eagerly, loading a large net is dominated by building its
+    //! containers. Loading detects the encoding, so both may be used
+    //! wherever an activity is read.
+    enum class activity_encoding
+    {
+      text,
+      binary,
+    };
+
     class activity_t
     {
     public:
@@ -96,6 +110,8 @@ namespace we
       activity_t& operator= (activity_t&&) = default;
 
       std::string to_string() const;
+      std::string to_string (activity_encoding) const;
+      void write (std::ostream&, activity_encoding) const;
 
       boost::variant<we::type::transition_t> const& data() const;
 
@@ -107,6 +123,10 @@ namespace we
       void set_wait_for_output();
       void put_token
         (std::string place_name, pnet::type::value::value_type const&);
+      void put_tokens
+        ( std::string place_name
+        , std::list<pnet::type::value::value_type> const&
+        );
       void inject ( activity_t const&
                   , workflow_response_callback
                   , eureka_response_callback
@@ -119,6 +139,11 @@ namespace we
                 , gspc::we::plugin::PutToken
                 );
 
+      //! \note require the activity to be a net
+      void record_marking_changes();
+      net_marking_changes take_marking_changes();
+      void apply_marking_changes (std::list<net_marking_changes> const&);
+
       activity_t wrap() &&;
       activity_t unwrap() &&;
 
@@ -134,11 +159,13 @@ namespace we
       TokensOnPorts output() const;
 
       bool wait_for_output() const;
+      bool side_effect_free() const;
 
       void execute
         ( we::loader::loader&
         , gpi::pc::client::api_t /*const*/ *
         , gspc::scoped_allocation /* const */ *
+        , we::loader::global_memory_cache*
         , boost::optional<std::string> target_implementation
         , drts::worker::context*
         );
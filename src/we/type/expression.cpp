@@ -78,6 +78,12 @@ namespace we
       _expr = _ast.string();
     }
 
+    void expression_t::resolve_field_positions
+      (expr::parse::node::SignatureOfRoot const& signature_of)
+    {
+      _ast.resolve_field_positions (signature_of);
+    }
+
     std::ostream& operator<< (std::ostream& os, const expression_t& e)
     {
       return os << e.expression();
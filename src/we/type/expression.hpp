@@ -47,6 +47,8 @@ namespace we
 
       void rename (const std::string& from, const std::string& to);
 
+      void resolve_field_positions (expr::parse::node::SignatureOfRoot const&);
+
     private:
       std::string _expr;
       expr::parse::parser _ast;
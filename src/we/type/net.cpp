@@ -18,7 +18,6 @@
 #include <we/type/activity.hpp>
 #include <we/type/transition.hpp>
 #include <we/type/value.hpp>
-#include <we/type/value/peek.hpp>
 #include <we/type/value/show.hpp>
 #include <we/type/value/wrap.hpp>
 #include <we/type/value/unwrap.hpp>
@@ -35,9 +34,11 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <list>
 #include <stdexcept>
 #include <unordered_set>
+#include <vector>
 
 namespace gspc
 {
@@ -301,21 +302,17 @@ namespace we
       do_update (do_put_value (pid, value));
     }
 
-    void net_type::put_token ( std::string place_name
-                             , pnet::type::value::value_type const& value
-                             )
+    place_id_type net_type::place_for_put_token
+      ( std::string const& place_name
+      , std::function<std::string()> const& call
+      ) const
     {
       std::unordered_map<std::string, place_id_type>::const_iterator const
         pid (_place_id_by_name.find (place_name));
 
       if (pid == _place_id_by_name.end())
       {
-        throw std::invalid_argument
-          ( ( boost::format ("put_token (\"%1%\", %2%): place not found")
-            % place_name
-            % pnet::type::value::show (value)
-            ).str()
-          );
+        throw std::invalid_argument (call() + ": place not found");
       }
 
       place::type const& place (_pmap.at (pid->second));
@@ -323,17 +320,84 @@ namespace we
       if (!place.is_marked_for_put_token())
       {
         throw std::invalid_argument
-          ( ( boost::format
-              ("put_token (\"%1%\", %2%): place not marked with attribute"
-              " put_token=\"true\""
-              )
-            % place_name
-            % pnet::type::value::show (value)
-            ).str()
+          ( call()
+          + ": place not marked with attribute put_token=\"true\""
           );
       }
 
-      return put_value (pid->second, value);
+      return pid->second;
+    }
+
+    void net_type::put_token ( std::string place_name
+                             , pnet::type::value::value_type const& value
+                             )
+    {
+      return put_value
+        ( place_for_put_token
+            ( place_name
+            , [&]
+              {
+                return ( boost::format ("put_token (\"%1%\", %2%)")
+                       % place_name
+                       % pnet::type::value::show (value)
+                       ).str();
+              }
+            )
+        , value
+        );
+    }
+
+    void net_type::put_tokens
+      ( std::string place_name
+      , std::list<pnet::type::value::value_type> const& values
+      )
+    {
+      if (values.size() == 1)
+      {
+        return put_token (std::move (place_name), values.front());
+      }
+
+      place_id_type const pid
+        ( place_for_put_token
+            ( place_name
+            , [&]
+              {
+                return ( boost::format ("put_tokens (\"%1%\", %2% tokens)")
+                       % place_name
+                       % values.size()
+                       ).str();
+              }
+            )
+        );
+
+      place::type const& place (_pmap.at (pid));
+
+      std::list<pnet::type::value::value_type> tokens;
+
+      for (pnet::type::value::value_type const& value : values)
+      {
+        tokens.emplace_back
+          (pnet::require_type (value, place.signature(), place.name()));
+      }
+
+      if (tokens.empty())
+      {
+        return;
+      }
+
+      token_by_id_type& tokens_on_place (_token_by_place_id[pid]);
+      std::vector<token_id_type> token_ids;
+      token_ids.reserve (tokens.size());
+
+      for (pnet::type::value::value_type& token : tokens)
+      {
+        token_id_type const token_id (_token_id++);
+        record_put (pid, token_id, token);
+        tokens_on_place.emplace (token_id, std::move (token));
+        token_ids.emplace_back (token_id);
+      }
+
+      update_enabled_put_tokens (pid, token_ids);
     }
 
     net_type::to_be_updated_type net_type::do_put_value
@@ -342,8 +406,13 @@ namespace we
       const place::type& place (_pmap.at (pid));
       token_id_type const token_id (_token_id++);
 
-      _token_by_place_id[pid].emplace
-        (token_id, pnet::require_type (value, place.signature(), place.name()));
+      pnet::type::value::value_type const& token
+        ( _token_by_place_id[pid].emplace
+            ( token_id
+            , pnet::require_type (value, place.signature(), place.name())
+            ).first->second
+        );
+      record_put (pid, token_id, token);
 
       return {pid, token_id};
     }
@@ -381,6 +450,88 @@ namespace we
       return (pos != _token_by_place_id.end()) ? pos->second : no_tokens();
     }
 
+    void net_type::record_marking_changes()
+    {
+      _marking_changes = net_marking_changes {_token_id, {}, {}};
+    }
+    net_marking_changes net_type::take_marking_changes()
+    {
+      if (!_marking_changes)
+      {
+        throw std::logic_error ("take_marking_changes: not recording");
+      }
+
+      net_marking_changes changes (std::move (*_marking_changes));
+      changes.token_id = _token_id;
+      record_marking_changes();
+      return changes;
+    }
+    void net_type::record_put ( place_id_type pid
+                              , token_id_type token_id
+                              , pnet::type::value::value_type const& value
+                              )
+    {
+      if (_marking_changes)
+      {
+        _marking_changes->put[pid].emplace (token_id, value);
+      }
+    }
+    void net_type::record_delete (place_id_type pid, token_id_type token_id)
+    {
+      if (!_marking_changes)
+      {
+        return;
+      }
+
+      auto const put (_marking_changes->put.find (pid));
+      if (put != _marking_changes->put.end() && put->second.erase (token_id))
+      {
+        if (put->second.empty())
+        {
+          _marking_changes->put.erase (put);
+        }
+        return;
+      }
+
+      _marking_changes->deleted[pid].emplace (token_id);
+    }
+
+    void net_type::apply_marking_changes
+      (std::list<net_marking_changes> const& changes)
+    {
+      for (net_marking_changes const& change : changes)
+      {
+        _token_id = std::max (_token_id, change.token_id);
+
+        for (auto const& place : change.put)
+        {
+          for (auto const& token : place.second)
+          {
+            _token_by_place_id[place.first][token.first] = token.second;
+          }
+        }
+        for (auto const& place : change.deleted)
+        {
+          auto const tokens (_token_by_place_id.find (place.first));
+          if (tokens != _token_by_place_id.end())
+          {
+            for (token_id_type const& token_id : place.second)
+            {
+              tokens->second.erase (token_id);
+            }
+          }
+        }
+      }
+
+      //! \note the choices might refer to deleted tokens
+      _enabled.clear();
+      _enabled_choice.clear();
+      for (auto const& transition : _tmap)
+      {
+        update_enabled (transition.first);
+      }
+    }
+
     void net_type::update_enabled (transition_id_type tid)
     {
       cross_type cross (*this, tid);
@@ -489,6 +640,28 @@ namespace we
       }
     }
 
+    void net_type::update_enabled_put_tokens
+      (place_id_type pid, std::vector<token_id_type> const& token_ids)
+    {
+      for ( transition_id_type tid
+          : boost::join
+              ( _adj_pt_consume.left.equal_range (pid)
+              , _adj_pt_read.left.equal_range (pid)
+              )
+          | boost::adaptors::map_values
+          )
+      {
+        //! \note the tokens already on the place did not enable the
+        //! transition, so only the new ones are crossed. An enabled
+        //! transition stays enabled with its current choice and is
+        //! skipped by update_enabled_put_token.
+        for (token_id_type const& token_id : token_ids)
+        {
+          update_enabled_put_token (tid, {pid, token_id});
+        }
+      }
+    }
+
     void net_type::disable (transition_id_type tid)
     {
       enabled_type::iterator const pos
@@ -551,6 +724,8 @@ namespace we
       {
         _token_by_place_id
           .at (token_to_be_deleted.first).erase (token_to_be_deleted.second);
+        record_delete
+          (token_to_be_deleted.first, token_to_be_deleted.second);
 
         deleted_tokens.emplace (token_to_be_deleted.second);
       }
@@ -701,7 +876,6 @@ namespace we
       , gspc::we::plugin::PutToken put_token
       )
     {
-      using pnet::type::value::peek;
       using values = std::list<pnet::type::value::value_type>;
 
       expr::eval::context context;
@@ -709,32 +883,25 @@ namespace we
       std::forward_list<token_to_be_deleted_type> const tokens_to_be_deleted
         (do_extract (tid, context_bind (context, transition)));
 
-      auto const plugin_commands
-        (transition.prop().get ({"gspc", "we", "plugin"}));
+      auto const& plugin_directives (transition.plugin_directives());
 
-      if (plugin_commands)
+      if (plugin_directives)
       {
+        if (plugin_directives->call_before_eval)
         {
-          auto const call_before_eval
-            (peek ("call_before_eval", plugin_commands.get()));
+          auto const pids
+            (plugin_directives->call_before_eval->ast().eval_all (context));
 
-          if (call_before_eval)
+          for (auto const& pid : boost::get<values> (pids))
           {
-            expression_t const expression
-              (boost::get<std::string> (call_before_eval.get()));
-            auto const pids (expression.ast().eval_all (context));
-
-            for (auto const& pid : boost::get<values> (pids))
-            {
-              plugins.before_eval
-                ( gspc::we::plugin::ID {boost::get<unsigned long> (pid)}
-                , context
-                );
-            }
+            plugins.before_eval
+              ( gspc::we::plugin::ID {boost::get<unsigned long> (pid)}
+              , context
+              );
           }
         }
 
-        if (peek ("destroy", plugin_commands.get()))
+        if (plugin_directives->destroy)
         {
           plugins.destroy
             ( gspc::we::plugin::ID
@@ -745,9 +912,9 @@ namespace we
 
       transition.expression()->ast().eval_all (context);
 
-      if (plugin_commands)
+      if (plugin_directives)
       {
-        if (peek ("create", plugin_commands.get()))
+        if (plugin_directives->create)
         {
           context.bind_and_discard_ref
             ( {"plugin_id"}
@@ -761,23 +928,17 @@ namespace we
             );
         }
 
+        if (plugin_directives->call_after_eval)
         {
-          auto const call_after_eval
-            (peek ("call_after_eval", plugin_commands.get()));
+          auto const pids
+            (plugin_directives->call_after_eval->ast().eval_all (context));
 
-          if (call_after_eval)
+          for (auto const& pid : boost::get<values> (pids))
           {
-            expression_t const expression
-              (boost::get<std::string> (call_after_eval.get()));
-            auto const pids (expression.ast().eval_all (context));
-
-            for (auto const& pid : boost::get<values> (pids))
-            {
-              plugins.after_eval
-                ( gspc::we::plugin::ID {boost::get<unsigned long> (pid)}
-                , context
-                );
-            }
+            plugins.after_eval
+              ( gspc::we::plugin::ID {boost::get<unsigned long> (pid)}
+              , context
+              );
           }
         }
       }
@@ -20,6 +20,7 @@ namespace we
 {
   namespace type
   {
+    struct net_marking_changes;
     class net_type;
   }
 }
@@ -37,18 +37,48 @@
 
 #include <forward_list>
 #include <functional>
+#include <list>
+#include <map>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 #include <cstdlib>
 
 namespace we
 {
   namespace type
   {
+    //! The tokens put and deleted since the changes of a net were
+    //! taken last. Places, transitions and connections are fixed once
+    //! the net is submitted, so a copy of the net and its changes are
+    //! all that is needed to save the state of a running net.
+    struct net_marking_changes
+    {
+      using token_by_id_type =
+        std::unordered_map<token_id_type, pnet::type::value::value_type>;
+      using token_by_place_id_type =
+        std::unordered_map<place_id_type, token_by_id_type>;
+      using token_ids_by_place_id_type = std::unordered_map
+        <place_id_type, std::unordered_set<token_id_type>>;
+
+      token_id_type token_id;
+      //! \note tokens put and deleted again in between are in neither
+      token_by_place_id_type put;
+      token_ids_by_place_id_type deleted;
+
+      template<typename Archive>
+      void serialize (Archive& ar, const unsigned int)
+      {
+        ar & BOOST_SERIALIZATION_NVP (token_id);
+        ar & BOOST_SERIALIZATION_NVP (put);
+        ar & BOOST_SERIALIZATION_NVP (deleted);
+      }
+    };
+
     class net_type
     {
     public:
@@ -81,8 +111,7 @@ namespace we
                             , std::pair<port_id_type, we::type::property::type>
                             >
         > place_to_port_type;
-      using token_by_id_type =
-        std::unordered_map<token_id_type, pnet::type::value::value_type>;
+      using token_by_id_type = net_marking_changes::token_by_id_type;
 
 
       place_id_type add_place (const place::type&);
@@ -121,9 +150,29 @@ namespace we
       //! \note place must be marked with atribute put_token="true"
       void put_token
         (std::string place_name, pnet::type::value::value_type const&);
+      //! \note all values are type checked before any of them is put,
+      //! only transitions reading the place and not yet enabled are
+      //! crossed with the new tokens. A single value is put exactly
+      //! like put_token, including its error messages.
+      void put_tokens
+        ( std::string place_name
+        , std::list<pnet::type::value::value_type> const&
+        );
 
       token_by_id_type const& get_token (place_id_type) const;
 
+      //! \note starts to record the changes of the tokens, they are
+      //! only recorded by nets being snapshotted
+      void record_marking_changes();
+      //! \note requires record_marking_changes(), the changes are
+      //! recorded anew afterwards
+      net_marking_changes take_marking_changes();
+      //! \note the changes have to be taken from a net with the same
+      //! places and transitions, e.g. a copy of this net, in the order
+      //! they were taken. Applying changes again that are already
+      //! contained in the tokens has no effect.
+      void apply_marking_changes (std::list<net_marking_changes> const&);
+
       boost::optional<we::type::activity_t>
         fire_expressions_and_extract_activity_random
           ( std::mt19937&
@@ -169,9 +218,8 @@ namespace we
       port_to_response_type _port_to_response;
       place_to_port_type _place_to_port;
 
-      typedef std::unordered_map< place_id_type
-                                , token_by_id_type
-                                > token_by_place_id_type;
+      using token_by_place_id_type =
+        net_marking_changes::token_by_place_id_type;
 
       token_id_type _token_id;
       token_by_place_id_type _token_by_place_id;
@@ -188,6 +236,15 @@ namespace we
         , std::unordered_map<place_id_type, std::pair<token_id_type, bool>>
         > _enabled_choice;
 
+      //! \note not serialized, a net starts recording when snapshotted
+      boost::optional<net_marking_changes> _marking_changes;
+      void record_put
+        ( place_id_type
+        , token_id_type
+        , pnet::type::value::value_type const&
+        );
+      void record_delete (place_id_type, token_id_type);
+
       typedef std::pair<place_id_type, token_id_type> to_be_updated_type;
 
       void update_enabled (transition_id_type);
@@ -195,6 +252,8 @@ namespace we
         ( transition_id_type
         , to_be_updated_type const&
         );
+      void update_enabled_put_tokens
+        (place_id_type, std::vector<token_id_type> const&);
 
       void disable (transition_id_type);
 
@@ -218,6 +277,11 @@ namespace we
         ) const;
       void do_delete (std::forward_list<token_to_be_deleted_type> const&);
 
+      place_id_type place_for_put_token
+        ( std::string const& place_name
+        , std::function<std::string()> const& call
+        ) const;
+
       to_be_updated_type do_put_value
         (place_id_type, pnet::type::value::value_type const&);
       void do_update (to_be_updated_type const&);
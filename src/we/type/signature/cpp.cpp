@@ -570,10 +570,10 @@ namespace pnet
           public:
             print_from_value ( std::ostream& os
                              , fhg::util::indenter& indent
-                             , bool& first
+                             , std::size_t& position
                              )
               : printer (os, indent)
-              , _first (first)
+              , _position (position)
             {}
             void _struct (const std::pair<std::string, structure_type>& s) const
             {
@@ -581,7 +581,8 @@ namespace pnet
             }
             void _field (const std::pair<std::string, std::string>& f) const
             {
-              _os << fhg::util::deeper (_indent) << (_first ? '(' : ',') << ' ';
+              _os << fhg::util::deeper (_indent)
+                  << (_position == 0 ? '(' : ',') << ' ';
 
               if (!is_literal (f.second))
               {
@@ -593,7 +594,8 @@ namespace pnet
               }
 
               _os << " ("
-                  << "\"" << f.first << "\""
+                  << _position
+                  << ", \"" << f.first << "\""
                   << ", v"
                   << ", std::string(\"" << f.second << "\")"
                   << ")";
@@ -603,15 +605,16 @@ namespace pnet
                 _os << ")";
               }
 
-              _first = false;
+              ++_position;
             }
             void _field_struct (const std::pair<std::string, structure_type>& s) const
             {
               _os << fhg::util::deeper (_indent)
-                  << (_first ? '(' : ',') << ' '
+                  << (_position == 0 ? '(' : ',') << ' '
                   << s.first << "::from_value (pnet::field"
                   << " ("
-                  << "\"" << s.first << "\""
+                  << _position
+                  << ", \"" << s.first << "\""
                   << ", v"
                   << ", pnet::signature_of ("
                   << s.first << "::to_value (" << s.first << "::" << s.first << "())"
@@ -619,13 +622,15 @@ namespace pnet
                   << ")"
                   << ")";
 
-              _first = false;
+              ++_position;
             }
           private:
-            bool& _first;
+            //! \note fields are addressed by their position in the
+            //! signature, which is the position in values of it
+            std::size_t& _position;
           };
 
-          class impl_poke
+          class impl_emplace
           {
           public:
             void operator() ( std::ostream& os
@@ -636,9 +641,9 @@ namespace pnet
                             ) const
             {
               os << indent
-                 << "pnet::type::value::poke ("
+                 << "v.emplace_back ("
                  << "\"" << name << "\""
-                 << ", v, ";
+                 << ", ";
 
               if (is_literal (type))
               {
@@ -653,7 +658,7 @@ namespace pnet
             }
           };
 
-          typedef printer_for_field<impl_poke> print_impl_poke;
+          typedef printer_for_field<impl_emplace> print_impl_emplace;
 
           class print_impl : public printer
           {
@@ -700,9 +705,9 @@ namespace pnet
               }
               else
               {
-                bool first (true);
+                std::size_t position (0);
 
-                traverse (print_from_value (_os, _indent, first), s);
+                traverse (print_from_value (_os, _indent, position), s);
 
                 _os << fhg::util::deeper (_indent) << ");";
               }
@@ -716,10 +721,19 @@ namespace pnet
 
               _os << _indent
                   << "pnet::type::value::value_type to_value (const " << s.first << "& x)"
-                  << block::open (_indent)
-                  << _indent << "pnet::type::value::value_type v;";
+                  << block::open (_indent);
 
-              traverse (print_impl_poke (_os, _indent), s);
+              if (s.second.empty())
+              {
+                _os << _indent << "pnet::type::value::value_type v;";
+              }
+              else
+              {
+                _os << _indent << "pnet::type::value::structured_type v;"
+                    << _indent << "v.reserve (" << s.second.size() << ");";
+
+                traverse (print_impl_emplace (_os, _indent), s);
+              }
 
               _os << _indent << "return v;"
                   << block::close (_indent);
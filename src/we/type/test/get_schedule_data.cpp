@@ -148,3 +148,47 @@ BOOST_AUTO_TEST_CASE (get_schedule_data_expression_sum)
   BOOST_REQUIRE_EQUAL
     (activity.requirements_and_preferences (nullptr).numWorkers(), value1 + value2);
 }
+
+BOOST_AUTO_TEST_CASE (get_schedule_data_set_after_construction)
+{
+  unsigned long const value {fhg::util::testing::random<unsigned long>()()};
+
+  we::type::transition_t transition
+    ( fhg::util::testing::random_string()
+    , we::type::expression_t()
+    , boost::none
+    , we::type::property::type()
+    , we::priority_type()
+    );
+
+  transition.set_property ( {"fhg", "drts", "schedule", "num_worker"}
+                          , std::to_string (value) + "UL"
+                          );
+
+  we::type::activity_t activity (transition);
+
+  BOOST_REQUIRE_EQUAL (activity.requirements_and_preferences (nullptr).numWorkers(), value);
+}
+
+BOOST_AUTO_TEST_CASE (get_schedule_data_survives_serialization)
+{
+  unsigned long const value {fhg::util::testing::random<unsigned long>()()};
+
+  we::type::property::type properties;
+  properties.set ( {"fhg", "drts", "schedule", "num_worker"}
+                 , std::to_string (value) + "UL"
+                 );
+
+  we::type::transition_t const transition
+    ( fhg::util::testing::random_string()
+    , we::type::expression_t()
+    , boost::none
+    , properties
+    , we::priority_type()
+    );
+
+  we::type::activity_t activity
+    (we::type::activity_t (transition).to_string());
+
+  BOOST_REQUIRE_EQUAL (activity.requirements_and_preferences (nullptr).numWorkers(), value);
+}
@@ -395,15 +395,16 @@ BOOST_AUTO_TEST_CASE (signature_cpp)
      "      point2D from_value (const pnet::type::value::value_type& v)\n"
      "      {\n"
      "        return point2D\n"
-     "          ( pnet::field_as< float > (\"x\", v, std::string(\"float\"))\n"
-     "          , pnet::field_as< float > (\"y\", v, std::string(\"float\"))\n"
+     "          ( pnet::field_as< float > (0, \"x\", v, std::string(\"float\"))\n"
+     "          , pnet::field_as< float > (1, \"y\", v, std::string(\"float\"))\n"
      "          );\n"
      "      }\n"
      "      pnet::type::value::value_type to_value (const point2D& x)\n"
      "      {\n"
-     "        pnet::type::value::value_type v;\n"
-     "        pnet::type::value::poke (\"x\", v, x.x);\n"
-     "        pnet::type::value::poke (\"y\", v, x.y);\n"
+     "        pnet::type::value::structured_type v;\n"
+     "        v.reserve (2);\n"
+     "        v.emplace_back (\"x\", x.x);\n"
+     "        v.emplace_back (\"y\", x.y);\n"
      "        return v;\n"
      "      }\n"
      "      std::ostream& operator<< (std::ostream& os, const point2D& x)\n"
@@ -602,13 +603,14 @@ BOOST_AUTO_TEST_CASE (signature_cpp)
        "          a from_value (const pnet::type::value::value_type& v)\n"
        "          {\n"
        "            return a\n"
-       "              ( pnet::field_as< int > (\"i\", v, std::string(\"int\"))\n"
+       "              ( pnet::field_as< int > (0, \"i\", v, std::string(\"int\"))\n"
        "              );\n"
        "          }\n"
        "          pnet::type::value::value_type to_value (const a& x)\n"
        "          {\n"
-       "            pnet::type::value::value_type v;\n"
-       "            pnet::type::value::poke (\"i\", v, x.i);\n"
+       "            pnet::type::value::structured_type v;\n"
+       "            v.reserve (1);\n"
+       "            v.emplace_back (\"i\", x.i);\n"
        "            return v;\n"
        "          }\n"
        "          std::ostream& operator<< (std::ostream& os, const a& x)\n"
@@ -619,13 +621,14 @@ BOOST_AUTO_TEST_CASE (signature_cpp)
        "        b from_value (const pnet::type::value::value_type& v)\n"
        "        {\n"
        "          return b\n"
-       "            ( a::from_value (pnet::field (\"a\", v, pnet::signature_of (a::to_value (a::a()))))\n"
+       "            ( a::from_value (pnet::field (0, \"a\", v, pnet::signature_of (a::to_value (a::a()))))\n"
        "            );\n"
        "        }\n"
        "        pnet::type::value::value_type to_value (const b& x)\n"
        "        {\n"
-       "          pnet::type::value::value_type v;\n"
-       "          pnet::type::value::poke (\"a\", v, a::to_value (x.a));\n"
+       "          pnet::type::value::structured_type v;\n"
+       "          v.reserve (1);\n"
+       "          v.emplace_back (\"a\", a::to_value (x.a));\n"
        "          return v;\n"
        "        }\n"
        "        std::ostream& operator<< (std::ostream& os, const b& x)\n"
@@ -636,13 +639,14 @@ BOOST_AUTO_TEST_CASE (signature_cpp)
        "      c from_value (const pnet::type::value::value_type& v)\n"
        "      {\n"
        "        return c\n"
-       "          ( b::from_value (pnet::field (\"b\", v, pnet::signature_of (b::to_value (b::b()))))\n"
+       "          ( b::from_value (pnet::field (0, \"b\", v, pnet::signature_of (b::to_value (b::b()))))\n"
        "          );\n"
        "      }\n"
        "      pnet::type::value::value_type to_value (const c& x)\n"
        "      {\n"
-       "        pnet::type::value::value_type v;\n"
-       "        pnet::type::value::poke (\"b\", v, b::to_value (x.b));\n"
+       "        pnet::type::value::structured_type v;\n"
+       "        v.reserve (1);\n"
+       "        v.emplace_back (\"b\", b::to_value (x.b));\n"
        "        return v;\n"
        "      }\n"
        "      std::ostream& operator<< (std::ostream& os, const c& x)\n"
@@ -1152,3 +1152,34 @@ BOOST_AUTO_TEST_CASE (positions)
 
   BOOST_REQUIRE_EQUAL (pnet::type::value::positions (value), positions);
 }
+
+BOOST_AUTO_TEST_CASE (field_at_position_is_found_by_position_and_by_name)
+{
+  using pnet::type::value::value_type;
+
+  value_type value;
+  pnet::type::value::poke ("a", value, 0);
+  pnet::type::value::poke ("b", value, 1L);
+  pnet::type::value::poke ("c", value, std::string ("c"));
+
+  std::string const signature ("s");
+
+  BOOST_REQUIRE_EQUAL (pnet::field_as<int> (0, "a", value, signature), 0);
+  BOOST_REQUIRE_EQUAL (pnet::field_as<long> (1, "b", value, signature), 1L);
+  BOOST_REQUIRE_EQUAL
+    (pnet::field_as<std::string> (2, "c", value, signature), "c");
+
+  //! \note stale positions fall back to the lookup by name
+  BOOST_REQUIRE_EQUAL (pnet::field_as<int> (2, "a", value, signature), 0);
+  BOOST_REQUIRE_EQUAL
+    (pnet::field_as<std::string> (7, "c", value, signature), "c");
+
+  BOOST_REQUIRE_THROW
+    ( pnet::field (0, "d", value, signature)
+    , pnet::exception::missing_field
+    );
+  BOOST_REQUIRE_THROW
+    ( pnet::field_as<long> (0, "a", value, signature)
+    , pnet::exception::type_mismatch
+    );
+}
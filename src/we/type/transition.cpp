@@ -18,6 +18,7 @@
 
 #include <we/exception.hpp>
 #include <we/type/net.hpp>
+#include <we/type/value/peek.hpp>
 
 #include <fhg/util/boost/variant.hpp>
 
@@ -42,7 +43,55 @@ namespace we
       , _preferences()
       , _priority()
       , eureka_id_ (boost::none)
-    {}
+    {
+      update_cached_properties();
+    }
+
+    namespace
+    {
+      boost::optional<expression_t> expression_from_property
+        (boost::optional<property::value_type const&> const& value)
+      {
+        if (!value)
+        {
+          return boost::none;
+        }
+
+        return expression_t (boost::get<std::string> (value.get()));
+      }
+    }
+
+    void transition_t::update_cached_properties()
+    {
+      using pnet::type::value::peek;
+
+      auto const plugin_commands (prop_.get ({"gspc", "we", "plugin"}));
+
+      if (plugin_commands)
+      {
+        _plugin_directives = plugin_directives_t
+          { expression_from_property
+              (peek ("call_before_eval", plugin_commands.get()))
+          , !!peek ("destroy", plugin_commands.get())
+          , !!peek ("create", plugin_commands.get())
+          , expression_from_property
+              (peek ("call_after_eval", plugin_commands.get()))
+          };
+      }
+      else
+      {
+        _plugin_directives = boost::none;
+      }
+
+      _schedule_num_worker = expression_from_property
+        (prop_.get ({"fhg", "drts", "schedule", "num_worker"}));
+      _dynamic_requirement = expression_from_property
+        (prop_.get ({"fhg", "drts", "require", "dynamic_requirement"}));
+      _wait_for_output = prop_.is_true ({"drts", "wait_for_output"});
+      _side_effect_free = prop_.is_true ({"fhg", "drts", "side_effect_free"});
+      _global_memory_gets_are_read_only = prop_.is_true
+        ({"fhg", "drts", "global_memory_gets_are_read_only"});
+    }
 
     boost::optional<const expression_t&> transition_t::expression() const
     {
@@ -119,9 +168,45 @@ namespace we
         break;
       }
 
+      resolve_field_positions();
+
       return port_id;
     }
 
+    void transition_t::resolve_field_positions()
+    {
+      auto const signature_of
+        ( [this] (std::string const& root)
+            -> boost::optional<pnet::type::signature::signature_type const&>
+          {
+            for ( port_map_t const* ports
+                : {&_ports_input, &_ports_output, &_ports_tunnel}
+                )
+            {
+              for (port_map_t::value_type const& p : *ports)
+              {
+                if (p.second.name() == root)
+                {
+                  return p.second.signature();
+                }
+              }
+            }
+
+            return boost::none;
+          }
+        );
+
+      if (expression_t* expression = boost::get<expression_t> (&data_))
+      {
+        expression->resolve_field_positions (signature_of);
+      }
+
+      if (condition_)
+      {
+        condition_->resolve_field_positions (signature_of);
+      }
+    }
+
     we::port_id_type transition_t::input_port_by_name
       (const std::string& port_name) const
     {
@@ -175,5 +260,33 @@ namespace we
     {
       return _priority;
     }
+
+    boost::optional<plugin_directives_t> const&
+      transition_t::plugin_directives() const
+    {
+      return _plugin_directives;
+    }
+    boost::optional<expression_t> const&
+      transition_t::schedule_num_worker() const
+    {
+      return _schedule_num_worker;
+    }
+    boost::optional<expression_t> const&
+      transition_t::dynamic_requirement() const
+    {
+      return _dynamic_requirement;
+    }
+    bool transition_t::wait_for_output() const
+    {
+      return _wait_for_output;
+    }
+    bool transition_t::side_effect_free() const
+    {
+      return _side_effect_free;
+    }
+    bool transition_t::global_memory_gets_are_read_only() const
+    {
+      return _global_memory_gets_are_read_only;
+    }
   }
 }
@@ -46,6 +46,15 @@ namespace we
                                                    , module_call_t
                                                    >;
 
+    //! parsed form of the property subtree {"gspc", "we", "plugin"}
+    struct plugin_directives_t
+    {
+      boost::optional<expression_t> call_before_eval;
+      bool destroy;
+      bool create;
+      boost::optional<expression_t> call_after_eval;
+    };
+
     struct transition_t
     {
     private:
@@ -101,6 +110,8 @@ namespace we
           throw std::runtime_error
             ("preferences defined without multiple modules with target");
         }
+
+        update_cached_properties();
       }
       catch (...)
       {
@@ -137,11 +148,28 @@ namespace we
 
       we::priority_type priority() const;
 
+      // cached lookups into prop(), refreshed whenever the properties change
+      boost::optional<plugin_directives_t> const& plugin_directives() const;
+      boost::optional<expression_t> const& schedule_num_worker() const;
+      boost::optional<expression_t> const& dynamic_requirement() const;
+      bool wait_for_output() const;
+      //! \note fhg.drts.side_effect_free: the module call may be run
+      //! more than once concurrently, e.g. as a speculative backup
+      bool side_effect_free() const;
+      //! \note fhg.drts.global_memory_gets_are_read_only: a promise
+      //! of the application that nobody writes the global memory
+      //! ranges the module call gets while workers might hold them, so
+      //! workers with a cache of global memory may serve them from it.
+      //! Nothing checks the promise, writes are not detected.
+      bool global_memory_gets_are_read_only() const;
+
       void set_property ( property::path_type const& path
                         , property::value_type const& value
                         )
       {
         prop_.set (path, value);
+
+        update_cached_properties();
       }
 
     private:
@@ -162,6 +190,20 @@ namespace we
 
       boost::optional<eureka_id_type> eureka_id_;
 
+      //! \note not serialized but recomputed from prop_
+      boost::optional<plugin_directives_t> _plugin_directives;
+      boost::optional<expression_t> _schedule_num_worker;
+      boost::optional<expression_t> _dynamic_requirement;
+      bool _wait_for_output;
+      bool _side_effect_free;
+      bool _global_memory_gets_are_read_only;
+
+      void update_cached_properties();
+
+      //! \note of the expression and the condition, against the
+      //! signatures of the ports, whenever the ports change
+      void resolve_field_positions();
+
       friend class boost::serialization::access;
       template <typename Archive>
       void serialize(Archive & ar, const unsigned int)
@@ -178,6 +220,12 @@ namespace we
         ar & BOOST_SERIALIZATION_NVP(_preferences);
         ar & BOOST_SERIALIZATION_NVP(_priority);
         ar & BOOST_SERIALIZATION_NVP(eureka_id_);
+
+        if (typename Archive::is_loading())
+        {
+          update_cached_properties();
+          resolve_field_positions();
+        }
       }
     };
   }
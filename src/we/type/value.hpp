@@ -26,6 +26,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace pnet
 {
@@ -49,10 +50,12 @@ namespace pnet
               , std::list<boost::recursive_variant_>
               , std::set<boost::recursive_variant_>
               , std::map<boost::recursive_variant_, boost::recursive_variant_>
-              , std::list<std::pair<std::string, boost::recursive_variant_> >
+              , std::vector<std::pair<std::string, boost::recursive_variant_> >
               >::type value_type;
 
-      typedef std::list<std::pair<std::string, value_type> > structured_type;
+      //! \note Fields are stored contiguously in signature order, so
+      //! accessors knowing the signature may address them by position.
+      typedef std::vector<std::pair<std::string, value_type> > structured_type;
     }
   }
 }
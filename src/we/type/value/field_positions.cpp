@@ -0,0 +1,106 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include <we/type/value/field_positions.hpp>
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include <utility>
+
+namespace pnet
+{
+  namespace type
+  {
+    namespace value
+    {
+      namespace
+      {
+        class visitor_field_name
+          : public boost::static_visitor<std::string const&>
+        {
+        public:
+          template<typename Field>
+            std::string const& operator() (Field const& field) const
+          {
+            return field.first;
+          }
+        };
+
+        class visitor_field_structure
+          : public boost::static_visitor<signature::structure_type const*>
+        {
+        public:
+          signature::structure_type const* operator()
+            (std::pair<std::string, std::string> const&) const
+          {
+            return nullptr;
+          }
+          signature::structure_type const* operator()
+            (std::pair<std::string, signature::structure_type> const& field) const
+          {
+            return &field.second;
+          }
+        };
+      }
+
+      field_positions resolve_field_positions
+        ( std::list<std::string>::const_iterator field
+        , std::list<std::string>::const_iterator const& end
+        , signature::signature_type const& signature
+        )
+      {
+        field_positions positions;
+
+        signature::structured_type const* const structured
+          (boost::get<signature::structured_type> (&signature));
+        signature::structure_type const* structure
+          (structured ? &structured->second : nullptr);
+
+        for (; structure && field != end; ++field)
+        {
+          std::vector<std::string> fields;
+          boost::optional<std::size_t> position;
+          signature::structure_type const* inner (nullptr);
+
+          for (signature::field_type const& f : *structure)
+          {
+            std::string const& name
+              (boost::apply_visitor (visitor_field_name(), f));
+
+            if (name == *field)
+            {
+              position = fields.size();
+              inner = boost::apply_visitor (visitor_field_structure(), f);
+            }
+
+            fields.emplace_back (name);
+          }
+
+          if (!position)
+          {
+            break;
+          }
+
+          positions.emplace_back (field_position {*position, std::move (fields)});
+          structure = inner;
+        }
+
+        return positions;
+      }
+    }
+  }
+}
@@ -0,0 +1,79 @@
+// This file is part of GPI-Space.
+// Copyright (C) 2020 Fraunhofer ITWM
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <we/type/signature.hpp>
+#include <we/type/value.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace pnet
+{
+  namespace type
+  {
+    namespace value
+    {
+      //! \note Where a field is stored in a structured value with the
+      //! fields of its signature in signature order.
+      struct field_position
+      {
+        std::size_t position;
+        //! all fields of the enclosing structure, in signature order
+        std::vector<std::string> fields;
+      };
+
+      //! \note one per field along a path, as far as the signature
+      //! describes the path, i.e. possibly fewer than fields
+      using field_positions = std::vector<field_position>;
+
+      field_positions resolve_field_positions
+        ( std::list<std::string>::const_iterator field
+        , std::list<std::string>::const_iterator const& end
+        , signature::signature_type const&
+        );
+
+      //! \note looks at the position first and falls back to the
+      //! lookup by name if the field is not stored there
+      template<typename Fields>
+        auto find_field ( Fields& fields
+                        , std::string const& name
+                        , field_position const* position
+                        ) -> decltype (fields.begin())
+      {
+        if ( position
+           && position->position < fields.size()
+           && fields[position->position].first == name
+           )
+        {
+          return fields.begin() + position->position;
+        }
+
+        return std::find_if
+          ( fields.begin(), fields.end()
+          , [&name] (typename Fields::value_type const& field)
+            {
+              return field.first == name;
+            }
+          );
+      }
+    }
+  }
+}
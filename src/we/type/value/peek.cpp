@@ -111,6 +111,44 @@ namespace pnet
       {
         return peek (path::split (path), node);
       }
+      boost::optional<const value_type&>
+      peek ( const std::list<std::string>::const_iterator& key
+           , const std::list<std::string>::const_iterator& end
+           , const field_positions& positions
+           , const value_type& node
+           )
+      {
+        const value_type* current (&node);
+        field_positions::const_iterator position (positions.begin());
+
+        for (std::list<std::string>::const_iterator field (key); field != end; ++field)
+        {
+          const structured_type* const fields
+            (boost::get<structured_type> (current));
+
+          if (!fields)
+          {
+            return boost::none;
+          }
+
+          structured_type::const_iterator const pos
+            ( find_field
+                ( *fields
+                , *field
+                , position != positions.end() ? &*position++ : nullptr
+                )
+            );
+
+          if (pos == fields->end())
+          {
+            return boost::none;
+          }
+
+          current = &pos->second;
+        }
+
+        return *current;
+      }
 
       boost::optional<value_type&>
       peek ( const std::list<std::string>::const_iterator& key
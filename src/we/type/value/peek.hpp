@@ -17,6 +17,7 @@
 #pragma once
 
 #include <we/type/value.hpp>
+#include <we/type/value/field_positions.hpp>
 
 #include <boost/optional.hpp>
 
@@ -35,6 +36,13 @@ namespace pnet
       peek (const std::list<std::string>& path, const value_type& node);
       boost::optional<const value_type&>
       peek (const std::string&, const value_type&);
+      //! \note addresses the fields by their resolved positions first
+      boost::optional<const value_type&>
+      peek ( const std::list<std::string>::const_iterator&
+           , const std::list<std::string>::const_iterator&
+           , const field_positions&
+           , const value_type&
+           );
 
       boost::optional<value_type&>
       peek ( const std::list<std::string>::const_iterator&
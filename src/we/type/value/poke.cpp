@@ -17,6 +17,8 @@
 #include <we/type/value/poke.hpp>
 #include <we/type/value/path/split.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iterator>
 
@@ -119,6 +121,68 @@ namespace pnet
       {
         return poke (path::split (path), node, value);
       }
+
+      namespace
+      {
+        //! \note before the first field that comes later in signature
+        //! order, fields unknown to the signature count as last
+        structured_type::iterator in_signature_order
+          (structured_type& fields, field_position const& position)
+        {
+          return std::find_if
+            ( fields.begin(), fields.end()
+            , [&position] (structured_type::value_type const& field)
+              {
+                return std::size_t
+                  ( std::find ( position.fields.begin()
+                              , position.fields.end()
+                              , field.first
+                              )
+                  - position.fields.begin()
+                  ) > position.position;
+              }
+            );
+        }
+      }
+
+      value_type& poke ( const std::list<std::string>::const_iterator& key
+                       , const std::list<std::string>::const_iterator& end
+                       , const field_positions& positions
+                       , value_type& node
+                       , const value_type& value
+                       )
+      {
+        value_type* current (&node);
+        field_positions::const_iterator position (positions.begin());
+
+        for (std::list<std::string>::const_iterator field (key); field != end; ++field)
+        {
+          structured_type* fields (boost::get<structured_type> (current));
+
+          if (!fields)
+          {
+            fields = &boost::get<structured_type> (*current = structured_type());
+          }
+
+          field_position const* const known
+            (position != positions.end() ? &*position++ : nullptr);
+
+          structured_type::iterator pos (find_field (*fields, *field, known));
+
+          if (pos == fields->end())
+          {
+            pos = fields->emplace
+              ( known ? in_signature_order (*fields, *known) : fields->end()
+              , *field
+              , value_type()
+              );
+          }
+
+          current = &pos->second;
+        }
+
+        return *current = value;
+      }
     }
   }
 }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <we/type/value.hpp>
+#include <we/type/value/field_positions.hpp>
 
 namespace pnet
 {
@@ -34,6 +35,14 @@ namespace pnet
                        , const value_type& value
                        );
       value_type& poke (const std::string&, value_type&, const value_type&);
+      //! \note addresses the fields by their resolved positions first
+      //! and inserts missing fields in signature order
+      value_type& poke ( const std::list<std::string>::const_iterator&
+                       , const std::list<std::string>::const_iterator&
+                       , const field_positions&
+                       , value_type&
+                       , const value_type&
+                       );
     }
   }
 }